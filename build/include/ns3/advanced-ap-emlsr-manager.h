@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/eht/advanced-ap-emlsr-manager.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/eht/advanced-emlsr-manager.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/energy/helper/basic-energy-source-helper.h"
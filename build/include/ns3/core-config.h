@@ -0,0 +1,15 @@
+#ifndef NS3_CORE_CONFIG_H
+#define NS3_CORE_CONFIG_H
+
+/* #undef HAVE_UINT128_T */
+#define HAVE___UINT128_T 0
+/* #undef INT64X64_USE_128 */
+/* #undef INT64X64_USE_DOUBLE */
+#define INT64X64_USE_CAIRO
+#define HAVE_SYS_TYPES_H 0
+#define HAVE_SYS_STAT_H 0
+#define HAVE_DIRENT_H 0
+#define HAVE_GETENV 0
+#define HAVE_SIGNAL_H 0
+
+#endif // NS3_CORE_CONFIG_H
@@ -0,0 +1,49 @@
+
+#ifndef CORE_EXPORT_H
+#define CORE_EXPORT_H
+
+#ifdef CORE_STATIC_DEFINE
+#  define CORE_EXPORT
+#  define CORE_NO_EXPORT
+#else
+#  ifndef CORE_EXPORT
+#    ifdef core_EXPORTS
+        /* We are building this library */
+#      define CORE_EXPORT 
+#    else
+        /* We are using this library */
+#      define CORE_EXPORT 
+#    endif
+#  endif
+
+#  ifndef CORE_NO_EXPORT
+#    define CORE_NO_EXPORT 
+#  endif
+#endif
+
+#ifndef CORE_DEPRECATED
+#  define CORE_DEPRECATED 
+#endif
+
+#ifndef CORE_DEPRECATED_EXPORT
+#  define CORE_DEPRECATED_EXPORT CORE_EXPORT CORE_DEPRECATED
+#endif
+
+#ifndef CORE_DEPRECATED_NO_EXPORT
+#  define CORE_DEPRECATED_NO_EXPORT CORE_NO_EXPORT CORE_DEPRECATED
+#endif
+
+#if 0 /* DEFINE_NO_DEPRECATED */
+#  ifndef CORE_NO_DEPRECATED
+#    define CORE_NO_DEPRECATED
+#  endif
+#endif
+
+// Undefine the *_EXPORT symbols for non-Windows based builds
+#ifndef NS_MSVC
+#undef CORE_EXPORT
+#define CORE_EXPORT
+#undef CORE_NO_EXPORT
+#define CORE_NO_EXPORT
+#endif
+#endif /* CORE_EXPORT_H */
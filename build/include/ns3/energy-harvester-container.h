@@ -0,0 +1 @@
+#include "/root/repo/src/energy/helper/energy-harvester-container.h"
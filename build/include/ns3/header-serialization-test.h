@@ -0,0 +1 @@
+#include "/root/repo/src/network/utils/header-serialization-test.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/traffic-control/model/htb-queue-disc.h"
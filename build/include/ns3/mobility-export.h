@@ -0,0 +1,49 @@
+
+#ifndef MOBILITY_EXPORT_H
+#define MOBILITY_EXPORT_H
+
+#ifdef MOBILITY_STATIC_DEFINE
+#  define MOBILITY_EXPORT
+#  define MOBILITY_NO_EXPORT
+#else
+#  ifndef MOBILITY_EXPORT
+#    ifdef mobility_EXPORTS
+        /* We are building this library */
+#      define MOBILITY_EXPORT 
+#    else
+        /* We are using this library */
+#      define MOBILITY_EXPORT 
+#    endif
+#  endif
+
+#  ifndef MOBILITY_NO_EXPORT
+#    define MOBILITY_NO_EXPORT 
+#  endif
+#endif
+
+#ifndef MOBILITY_DEPRECATED
+#  define MOBILITY_DEPRECATED 
+#endif
+
+#ifndef MOBILITY_DEPRECATED_EXPORT
+#  define MOBILITY_DEPRECATED_EXPORT MOBILITY_EXPORT MOBILITY_DEPRECATED
+#endif
+
+#ifndef MOBILITY_DEPRECATED_NO_EXPORT
+#  define MOBILITY_DEPRECATED_NO_EXPORT MOBILITY_NO_EXPORT MOBILITY_DEPRECATED
+#endif
+
+#if 0 /* DEFINE_NO_DEPRECATED */
+#  ifndef MOBILITY_NO_DEPRECATED
+#    define MOBILITY_NO_DEPRECATED
+#  endif
+#endif
+
+// Undefine the *_EXPORT symbols for non-Windows based builds
+#ifndef NS_MSVC
+#undef MOBILITY_EXPORT
+#define MOBILITY_EXPORT
+#undef MOBILITY_NO_EXPORT
+#define MOBILITY_NO_EXPORT
+#endif
+#endif /* MOBILITY_EXPORT_H */
@@ -0,0 +1 @@
+#include "/root/repo/src/mobility/model/mobility-grid-index.h"
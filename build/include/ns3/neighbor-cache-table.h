@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/neighbor-cache-table.h"
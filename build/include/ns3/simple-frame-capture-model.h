@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/simple-frame-capture-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/spectrum-propagation-loss-model.h"
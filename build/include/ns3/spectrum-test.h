@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/utils/spectrum-test.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/stats/model/sqlite-data-output.h"
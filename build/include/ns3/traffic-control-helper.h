@@ -0,0 +1 @@
+#include "/root/repo/src/traffic-control/helper/traffic-control-helper.h"
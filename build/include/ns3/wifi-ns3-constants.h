@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/wifi-ns3-constants.h"
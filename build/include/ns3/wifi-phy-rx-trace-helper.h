@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/helper/wifi-phy-rx-trace-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/helper/wifi-static-setup-helper.h"
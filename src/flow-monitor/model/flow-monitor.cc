@@ -8,15 +8,22 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
+#define EXPIRY_SLOT_DURATION (MilliSeconds(100))
 
 namespace ns3
 {
@@ -70,12 +77,76 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("EnableHistograms",
+                          "Whether the histograms of the flows are updated. Disabling them "
+                          "saves memory and time in simulations with many flows.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&FlowMonitor::m_enableHistograms),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxTrackedPackets",
+                          "The maximum number of packets in flight that are tracked (0 means "
+                          "no limit). When the limit is reached, the packet last seen the "
+                          "earliest is considered lost to make room for a new packet.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowMonitor::m_maxTrackedPackets),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SnapshotInterval",
+                          "The interval between the snapshots of the stats of the flows "
+                          "written to the SnapshotFile.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&FlowMonitor::m_snapshotInterval),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("SnapshotFile",
+                          "The name of the CSV file to which the stats of the flows updated "
+                          "since the previous snapshot are written every SnapshotInterval "
+                          "(no snapshots are written if empty).",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_snapshotFile),
+                          MakeStringChecker())
+            .AddAttribute("EnableSketches",
+                          "Whether the packets are accounted in per-probe sketches (see "
+                          "GetDelaySketch, GetTxBytesSketch and GetHeavyHitters) instead of "
+                          "exact per-flow statistics.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_enableSketches),
+                          MakeBooleanChecker())
+            .AddAttribute("SamplingRatio",
+                          "The fraction of the packets tracked to measure the delays when "
+                          "using sketches.",
+                          DoubleValue(1),
+                          MakeDoubleAccessor(&FlowMonitor::m_samplingRatio),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("SketchWidth",
+                          "The number of counters per row of the Count-Min sketches.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchWidth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchDepth",
+                          "The number of rows of the Count-Min sketches.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchDepth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchRelativeAccuracy",
+                          "The relative accuracy of the quantiles of the delay sketches.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_sketchRelativeAccuracy),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("HeavyHitterCandidates",
+                          "The number of flows with the most transmitted bytes kept as "
+                          "candidate heavy hitters when using sketches.",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&FlowMonitor::m_heavyHitterCandidates),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_expiryWheelBase(0),
+      m_enabled(false),
+      m_minCandidateBytes(0),
+      m_sampledPackets(0),
+      m_sampledLostPackets(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -86,6 +157,13 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_snapshotEvent);
+    if (m_snapshotStream.is_open())
+    {
+        m_snapshotStream.close();
+    }
+    m_trackedPackets.clear();
+    m_expiryWheel.clear();
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -141,13 +219,34 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_enableSketches)
+    {
+        probe->AddTxSketch(flowId, packetSize);
+        UpdateHeavyHitterCandidates(flowId, probe->GetSketches().txBytes.Estimate(flowId));
+        if (!IsSampled(flowId, packetId))
+        {
+            return;
+        }
+        m_sampledPackets++;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    uint64_t key = GetPacketKey(flowId, packetId);
+    if (m_maxTrackedPackets > 0 && m_trackedPackets.size() >= m_maxTrackedPackets &&
+        m_trackedPackets.find(key) == m_trackedPackets.end())
+    {
+        EvictOldestTrackedPacket();
+    }
+    TrackedPacket& tracked = m_trackedPackets[key];
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
+    AddToExpiryWheel(key, now);
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
+    if (m_enableSketches)
+    {
+        return;
+    }
 
     probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
@@ -159,6 +258,7 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         stats.timeFirstTxPacket = now;
     }
     stats.timeLastTxPacket = now;
+    NotifyFlowUpdated(flowId);
 }
 
 void
@@ -173,8 +273,11 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
+    if (m_enableSketches && !IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    auto tracked = m_trackedPackets.find(GetPacketKey(flowId, packetId));
     if (tracked == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet forward report (flowId="
@@ -183,10 +286,17 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
     }
 
     tracked->second.timesForwarded++;
+    if (GetExpirySlot(tracked->second.lastSeenTime) != GetExpirySlot(Simulator::Now()))
+    {
+        AddToExpiryWheel(tracked->first, Simulator::Now());
+    }
     tracked->second.lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    if (!m_enableSketches)
+    {
+        Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+        probe->AddPacketStats(flowId, packetSize, delay);
+    }
 }
 
 void
@@ -201,7 +311,15 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
+    if (m_enableSketches)
+    {
+        probe->AddRxSketch(flowId, packetSize);
+        if (!IsSampled(flowId, packetId))
+        {
+            return;
+        }
+    }
+    auto tracked = m_trackedPackets.find(GetPacketKey(flowId, packetId));
     if (tracked == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
@@ -211,23 +329,43 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
 
     Time now = Simulator::Now();
     Time delay = (now - tracked->second.firstSeenTime);
+    if (m_enableSketches)
+    {
+        // the jitter is measured between consecutive sampled packets
+        Time jitter = Seconds(-1);
+        auto [lastDelay, isFirst] = m_lastSampledDelay.emplace(flowId, delay);
+        if (!isFirst)
+        {
+            jitter = lastDelay->second - delay;
+            if (jitter.IsNegative())
+            {
+                jitter = Time(0) - jitter;
+            }
+            lastDelay->second = delay;
+        }
+        probe->AddDelaySketch(delay, jitter);
+        m_trackedPackets.erase(tracked);
+        return;
+    }
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
+    if (m_enableHistograms)
+    {
+        stats.delayHistogram.AddValue(delay.GetSeconds());
+    }
     if (stats.rxPackets > 0)
     {
         Time jitter = stats.lastDelay - delay;
-        if (jitter.IsStrictlyPositive())
+        if (!jitter.IsStrictlyPositive())
         {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
+            jitter = Time(0) - jitter;
         }
-        else
+        stats.jitterSum += jitter;
+        if (m_enableHistograms)
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            stats.jitterHistogram.AddValue(jitter.GetSeconds());
         }
     }
     stats.lastDelay = delay;
@@ -241,7 +379,10 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     stats.rxBytes += packetSize;
-    stats.packetSizeHistogram.AddValue((double)packetSize);
+    if (m_enableHistograms)
+    {
+        stats.packetSizeHistogram.AddValue((double)packetSize);
+    }
     stats.rxPackets++;
     if (stats.rxPackets == 1)
     {
@@ -251,7 +392,7 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     {
         // measure possible flow interruptions
         Time interArrivalTime = now - stats.timeLastRxPacket;
-        if (interArrivalTime > m_flowInterruptionsMinTime)
+        if (m_enableHistograms && interArrivalTime > m_flowInterruptionsMinTime)
         {
             stats.flowInterruptionsHistogram.AddValue(interArrivalTime.GetSeconds());
         }
@@ -263,6 +404,7 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
                                                                   << packetId << ").");
 
     m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    NotifyFlowUpdated(flowId);
 }
 
 void
@@ -278,6 +420,16 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_enableSketches)
+    {
+        auto tracked = m_trackedPackets.find(GetPacketKey(flowId, packetId));
+        if (tracked != m_trackedPackets.end())
+        {
+            m_sampledLostPackets++;
+            m_trackedPackets.erase(tracked);
+        }
+        return;
+    }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
@@ -293,7 +445,9 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
+    NotifyFlowUpdated(flowId);
+
+    auto tracked = m_trackedPackets.find(GetPacketKey(flowId, packetId));
     if (tracked != m_trackedPackets.end())
     {
         // we don't need to track this packet anymore
@@ -310,28 +464,115 @@ FlowMonitor::GetFlowStats() const
     return m_flowStats;
 }
 
+uint64_t
+FlowMonitor::GetPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+int64_t
+FlowMonitor::GetExpirySlot(Time time)
+{
+    return time.GetTimeStep() / EXPIRY_SLOT_DURATION.GetTimeStep();
+}
+
+void
+FlowMonitor::AddToExpiryWheel(uint64_t key, Time lastSeenTime)
+{
+    int64_t slot = GetExpirySlot(lastSeenTime);
+    if (m_expiryWheel.empty())
+    {
+        m_expiryWheelBase = slot;
+    }
+    NS_ASSERT(slot >= m_expiryWheelBase);
+    if (static_cast<std::size_t>(slot - m_expiryWheelBase) >= m_expiryWheel.size())
+    {
+        m_expiryWheel.resize(slot - m_expiryWheelBase + 1);
+    }
+    m_expiryWheel[slot - m_expiryWheelBase].push_back(key);
+}
+
+void
+FlowMonitor::ExpireTrackedPacket(TrackedPacketMap::iterator iter)
+{
+    if (m_enableSketches)
+    {
+        m_sampledLostPackets++;
+        m_trackedPackets.erase(iter);
+        return;
+    }
+    FlowId flowId = iter->first >> 32;
+    auto flow = m_flowStats.find(flowId);
+    NS_ASSERT(flow != m_flowStats.end());
+    flow->second.lostPackets++;
+    NotifyFlowUpdated(flowId);
+    m_trackedPackets.erase(iter);
+}
+
+void
+FlowMonitor::EvictOldestTrackedPacket()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_expiryWheel.empty())
+    {
+        auto& keys = m_expiryWheel.front();
+        while (!keys.empty())
+        {
+            auto iter = m_trackedPackets.find(keys.back());
+            keys.pop_back();
+            if (iter != m_trackedPackets.end() &&
+                GetExpirySlot(iter->second.lastSeenTime) == m_expiryWheelBase)
+            {
+                NS_LOG_DEBUG("Too many tracked packets, considering packet "
+                             << (iter->first & 0xffffffff) << " of flow " << (iter->first >> 32)
+                             << " lost");
+                ExpireTrackedPacket(iter);
+                return;
+            }
+        }
+        m_expiryWheel.pop_front();
+        m_expiryWheelBase++;
+    }
+}
+
 void
 FlowMonitor::CheckForLostPackets(Time maxDelay)
 {
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // only the slots covering times at least maxDelay before now are visited
+    while (!m_expiryWheel.empty() &&
+           now - EXPIRY_SLOT_DURATION * m_expiryWheelBase >= maxDelay)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+        auto& keys = m_expiryWheel.front();
+        bool expired = (now - EXPIRY_SLOT_DURATION * (m_expiryWheelBase + 1) >= maxDelay);
+        auto last = std::remove_if(keys.begin(), keys.end(), [&](uint64_t key) {
+            auto iter = m_trackedPackets.find(key);
+            if (iter == m_trackedPackets.end() ||
+                GetExpirySlot(iter->second.lastSeenTime) != m_expiryWheelBase)
+            {
+                // the packet is no longer tracked, or it was seen again later
+                return true;
+            }
+            if (now - iter->second.lastSeenTime >= maxDelay)
+            {
+                // packet is considered lost, add it to the loss statistics
+                // and we won't track it anymore
+                ExpireTrackedPacket(iter);
+                return true;
+            }
+            return false;
+        });
+        keys.erase(last, keys.end());
+        if (!expired)
         {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
+            // the slot is only partially expired
+            break;
         }
+        NS_ASSERT(keys.empty());
+        m_expiryWheel.pop_front();
+        m_expiryWheelBase++;
     }
 }
 
@@ -348,19 +589,203 @@ FlowMonitor::PeriodicCheckForLostPackets()
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::NotifyFlowUpdated(FlowId flowId)
+{
+    if (m_snapshotStream.is_open())
+    {
+        m_updatedFlows.insert(flowId);
+    }
+}
+
+void
+FlowMonitor::WriteSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<FlowId> flowIds(m_updatedFlows.begin(), m_updatedFlows.end());
+    std::sort(flowIds.begin(), flowIds.end());
+    double now = Simulator::Now().GetSeconds();
+    for (FlowId flowId : flowIds)
+    {
+        const FlowStats& stats = m_flowStats[flowId];
+        m_snapshotStream << now << "," << flowId << "," << stats.txPackets << "," << stats.txBytes
+                         << "," << stats.rxPackets << "," << stats.rxBytes << ","
+                         << stats.lostPackets << "," << stats.delaySum.GetNanoSeconds() << ","
+                         << stats.jitterSum.GetNanoSeconds() << "\n";
+    }
+    m_updatedFlows.clear();
+    m_snapshotStream.flush();
+}
+
+void
+FlowMonitor::PeriodicWriteSnapshot()
+{
+    WriteSnapshot();
+    m_snapshotEvent =
+        Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicWriteSnapshot, this);
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (!m_snapshotFile.empty())
+    {
+        NS_ABORT_MSG_IF(!m_snapshotInterval.IsStrictlyPositive(),
+                        "The snapshot interval must be positive");
+        m_snapshotStream.open(m_snapshotFile, std::ios::out);
+        NS_ABORT_MSG_IF(!m_snapshotStream.is_open(),
+                        "Unable to open the snapshot file " << m_snapshotFile);
+        m_snapshotStream << "time,flowId,txPackets,txBytes,rxPackets,rxBytes,lostPackets,"
+                            "delaySum,jitterSum\n";
+        m_snapshotEvent =
+            Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicWriteSnapshot, this);
+    }
 }
 
 void
 FlowMonitor::AddProbe(Ptr<FlowProbe> probe)
 {
+    if (m_enableSketches)
+    {
+        probe->SetSketches({CountMinSketch(m_sketchWidth, m_sketchDepth),
+                            CountMinSketch(m_sketchWidth, m_sketchDepth),
+                            DdSketch(m_sketchRelativeAccuracy),
+                            DdSketch(m_sketchRelativeAccuracy)});
+    }
     m_flowProbes.push_back(probe);
 }
 
+bool
+FlowMonitor::IsSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    if (m_samplingRatio >= 1)
+    {
+        return true;
+    }
+    // the decision only depends on the packet, hence all the probes agree
+    uint64_t key = GetPacketKey(flowId, packetId);
+    uint64_t hash = Hash64(reinterpret_cast<const char*>(&key), sizeof(key));
+    return hash < m_samplingRatio * std::numeric_limits<uint64_t>::max();
+}
+
+void
+FlowMonitor::UpdateHeavyHitterCandidates(FlowId flowId, uint64_t bytes)
+{
+    auto it = m_candidates.find(flowId);
+    if (it != m_candidates.end())
+    {
+        it->second = bytes;
+        return;
+    }
+    if (m_candidates.size() < m_heavyHitterCandidates)
+    {
+        m_candidates.emplace(flowId, bytes);
+        m_minCandidateBytes = std::min(m_minCandidateBytes, bytes);
+        return;
+    }
+    if (m_heavyHitterCandidates == 0 || bytes <= m_minCandidateBytes)
+    {
+        return;
+    }
+    // m_minCandidateBytes is a lower bound, since the bytes of the candidates
+    // only increase: find the actual minimum
+    auto min = std::min_element(m_candidates.begin(),
+                                m_candidates.end(),
+                                [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (bytes > min->second)
+    {
+        m_candidates.erase(min);
+        m_candidates.emplace(flowId, bytes);
+        min = std::min_element(m_candidates.begin(),
+                               m_candidates.end(),
+                               [](const auto& a, const auto& b) { return a.second < b.second; });
+    }
+    m_minCandidateBytes = min->second;
+}
+
+CountMinSketch
+FlowMonitor::GetTxBytesSketch() const
+{
+    CountMinSketch sketch;
+    for (const auto& probe : m_flowProbes)
+    {
+        sketch.Merge(probe->GetSketches().txBytes);
+    }
+    return sketch;
+}
+
+CountMinSketch
+FlowMonitor::GetRxBytesSketch() const
+{
+    CountMinSketch sketch;
+    for (const auto& probe : m_flowProbes)
+    {
+        sketch.Merge(probe->GetSketches().rxBytes);
+    }
+    return sketch;
+}
+
+DdSketch
+FlowMonitor::GetDelaySketch() const
+{
+    DdSketch sketch(m_sketchRelativeAccuracy);
+    for (const auto& probe : m_flowProbes)
+    {
+        if (probe->GetSketches().delay.GetCount() > 0)
+        {
+            sketch.Merge(probe->GetSketches().delay);
+        }
+    }
+    return sketch;
+}
+
+DdSketch
+FlowMonitor::GetJitterSketch() const
+{
+    DdSketch sketch(m_sketchRelativeAccuracy);
+    for (const auto& probe : m_flowProbes)
+    {
+        if (probe->GetSketches().jitter.GetCount() > 0)
+        {
+            sketch.Merge(probe->GetSketches().jitter);
+        }
+    }
+    return sketch;
+}
+
+std::vector<std::pair<FlowId, uint64_t>>
+FlowMonitor::GetHeavyHitters(double fraction) const
+{
+    CountMinSketch txBytes = GetTxBytesSketch();
+    std::vector<std::pair<FlowId, uint64_t>> heavyHitters;
+    for (const auto& [flowId, bytes] : m_candidates)
+    {
+        uint64_t estimate = txBytes.Estimate(flowId);
+        if (estimate >= fraction * txBytes.GetTotal())
+        {
+            heavyHitters.emplace_back(flowId, estimate);
+        }
+    }
+    std::sort(heavyHitters.begin(), heavyHitters.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    return heavyHitters;
+}
+
+uint64_t
+FlowMonitor::GetSampledPackets() const
+{
+    return m_sampledPackets;
+}
+
+uint64_t
+FlowMonitor::GetSampledLostPackets() const
+{
+    return m_sampledLostPackets;
+}
+
 const FlowMonitor::FlowProbeContainer&
 FlowMonitor::GetAllProbes() const
 {
@@ -413,6 +838,10 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+    if (m_snapshotStream.is_open())
+    {
+        WriteSnapshot();
+    }
 }
 
 void
@@ -489,6 +918,29 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_enableSketches)
+    {
+        DdSketch delay = GetDelaySketch();
+        DdSketch jitter = GetJitterSketch();
+        os << std::string(indent, ' ') << "<FlowSketches"
+           << " sampledPackets=\"" << m_sampledPackets << "\""
+           << " sampledLostPackets=\"" << m_sampledLostPackets << "\">\n";
+        indent += 2;
+        for (double q : {0.5, 0.9, 0.99})
+        {
+            os << std::string(indent, ' ') << "<quantile q=\"" << q << "\""
+               << " delay=\"" << Seconds(delay.GetQuantile(q)).As(Time::NS) << "\""
+               << " jitter=\"" << Seconds(jitter.GetQuantile(q)).As(Time::NS) << "\" />\n";
+        }
+        for (const auto& [flowId, bytes] : GetHeavyHitters(0.01))
+        {
+            os << std::string(indent, ' ') << "<heavyHitter flowId=\"" << flowId << "\""
+               << " txBytes=\"" << bytes << "\" />\n";
+        }
+        indent -= 2;
+        os << std::string(indent, ' ') << "</FlowSketches>\n";
+    }
+
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         (*iter)->SerializeToXmlStream(os, indent);
@@ -11,6 +11,7 @@
 
 #include "flow-classifier.h"
 #include "flow-probe.h"
+#include "flow-sketch.h"
 
 #include "ns3/event-id.h"
 #include "ns3/histogram.h"
@@ -18,7 +19,12 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <deque>
+#include <fstream>
+#include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace ns3
@@ -36,6 +42,20 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * The packets in flight are kept in a hash table and in a timing wheel
+ * ordered by the time they were last seen, so that the check for lost
+ * packets only visits the packets that may have expired. For long
+ * simulations with many flows, the memory used can be bounded by capping
+ * the number of packets in flight (MaxTrackedPackets) and by disabling the
+ * histograms (EnableHistograms), and the statistics of the flows can be
+ * streamed to a CSV file (SnapshotFile) every SnapshotInterval instead of
+ * being serialized at the end of the simulation.
+ *
+ * When EnableSketches is set, the exact per-flow statistics are replaced
+ * by mergeable sketches kept by each probe: Count-Min sketches of the bytes
+ * transmitted and received per flow, and DDSketches of the end-to-end delay
+ * and jitter of a fraction (SamplingRatio) of the packets. The sketches of
+ * the probes are merged when the results are requested.
  */
 class FlowMonitor : public Object
 {
@@ -269,6 +289,44 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    // --- methods to get the results when using sketches ---
+
+    /// Get the bytes transmitted per flow, merging the sketches of all the
+    /// probes. Only available if EnableSketches is set.
+    /// @returns the sketch of the transmitted bytes per flow
+    CountMinSketch GetTxBytesSketch() const;
+
+    /// Get the bytes received per flow, merging the sketches of all the
+    /// probes. Only available if EnableSketches is set.
+    /// @returns the sketch of the received bytes per flow
+    CountMinSketch GetRxBytesSketch() const;
+
+    /// Get the end-to-end delays (in seconds) of the sampled packets of all
+    /// the flows, merging the sketches of all the probes. Only available if
+    /// EnableSketches is set.
+    /// @returns the sketch of the delays
+    DdSketch GetDelaySketch() const;
+
+    /// Get the jitters (in seconds) between consecutive sampled packets of
+    /// the flows, merging the sketches of all the probes. Only available if
+    /// EnableSketches is set.
+    /// @returns the sketch of the jitters
+    DdSketch GetJitterSketch() const;
+
+    /// Get the flows whose transmitted bytes are at least a fraction of the
+    /// bytes of all the flows, among the HeavyHitterCandidates flows with the
+    /// most transmitted bytes. Only available if EnableSketches is set.
+    /// @param fraction the fraction of the total bytes
+    /// @returns the flows and their estimated bytes, by decreasing bytes
+    std::vector<std::pair<FlowId, uint64_t>> GetHeavyHitters(double fraction) const;
+
+    /// @returns the number of sampled packets, when using sketches
+    uint64_t GetSampledPackets() const;
+
+    /// @returns the number of sampled packets that were dropped or lost,
+    ///          when using sketches
+    uint64_t GetSampledLostPackets() const;
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -286,11 +344,18 @@ class FlowMonitor : public Object
     FlowStatsContainer m_flowStats;
 
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef std::unordered_map<uint64_t, TrackedPacket> TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
+    uint32_t m_maxTrackedPackets;      //!< Maximum number of tracked packets
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
 
+    /// Timing wheel of the tracked packets: each slot holds the keys of the
+    /// packets last seen during the slot. The keys of the packets seen again
+    /// in a later slot, or no longer tracked, are skipped when the slot expires.
+    std::deque<std::vector<uint64_t>> m_expiryWheel;
+    int64_t m_expiryWheelBase; //!< Index of the slot at the front of the wheel
+
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
 
@@ -302,6 +367,25 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    bool m_enableHistograms;            //!< Whether the histograms are updated
+
+    Time m_snapshotInterval;                   //!< Interval between snapshots
+    std::string m_snapshotFile;                //!< Name of the snapshot file
+    std::ofstream m_snapshotStream;            //!< Stream of the snapshots
+    std::unordered_set<FlowId> m_updatedFlows; //!< Flows updated since the last snapshot
+    EventId m_snapshotEvent;                   //!< Snapshot event
+
+    bool m_enableSketches;                               //!< Whether sketches are used
+    double m_samplingRatio;                              //!< Fraction of the sampled packets
+    uint32_t m_sketchWidth;                              //!< Width of the Count-Min sketches
+    uint32_t m_sketchDepth;                              //!< Depth of the Count-Min sketches
+    double m_sketchRelativeAccuracy;                     //!< Accuracy of the delay sketches
+    uint32_t m_heavyHitterCandidates;                    //!< Max number of candidates
+    std::unordered_map<FlowId, uint64_t> m_candidates;   //!< Candidate heavy hitters
+    uint64_t m_minCandidateBytes;                        //!< Lower bound of their bytes
+    std::unordered_map<FlowId, Time> m_lastSampledDelay; //!< Delay of the last sampled packet
+    uint64_t m_sampledPackets;                           //!< Number of sampled packets
+    uint64_t m_sampledLostPackets;                       //!< Number of lost sampled packets
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
@@ -310,6 +394,53 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Get the key of a packet in the tracked packet table
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet ID
+    /// @returns the key of the packet
+    static uint64_t GetPacketKey(FlowId flowId, FlowPacketId packetId);
+
+    /// Get the slot of the timing wheel covering a given time
+    /// @param time the time
+    /// @returns the index of the slot
+    static int64_t GetExpirySlot(Time time);
+
+    /// Add a tracked packet to the slot of the timing wheel covering the
+    /// time it was last seen
+    /// @param key the key of the packet
+    /// @param lastSeenTime the time the packet was last seen
+    void AddToExpiryWheel(uint64_t key, Time lastSeenTime);
+
+    /// Stop tracking a packet and account it as lost
+    /// @param iter the tracked packet
+    void ExpireTrackedPacket(TrackedPacketMap::iterator iter);
+
+    /// Stop tracking the packet last seen the earliest (or nearly so), and
+    /// account it as lost, to make room for a new packet
+    void EvictOldestTrackedPacket();
+
+    /// Record that the stats of a flow changed since the last snapshot
+    /// @param flowId the Flow identification
+    void NotifyFlowUpdated(FlowId flowId);
+
+    /// Write the stats of the flows updated since the last snapshot to the
+    /// snapshot file
+    void WriteSnapshot();
+
+    /// Periodic function to write the snapshots
+    void PeriodicWriteSnapshot();
+
+    /// Check whether a packet is sampled, when using sketches
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet ID
+    /// @returns true if the packet is sampled
+    bool IsSampled(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Update the candidate heavy hitters after a packet is transmitted
+    /// @param flowId the Flow identification
+    /// @param bytes the estimated bytes transmitted by the flow
+    void UpdateHeavyHitterCandidates(FlowId flowId, uint64_t bytes);
 };
 
 } // namespace ns3
@@ -64,6 +64,40 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
     flow.bytesDropped[reasonCode] += packetSize;
 }
 
+void
+FlowProbe::SetSketches(const Sketches& sketches)
+{
+    m_sketches = sketches;
+}
+
+void
+FlowProbe::AddTxSketch(FlowId flowId, uint32_t packetSize)
+{
+    m_sketches.txBytes.Add(flowId, packetSize);
+}
+
+void
+FlowProbe::AddRxSketch(FlowId flowId, uint32_t packetSize)
+{
+    m_sketches.rxBytes.Add(flowId, packetSize);
+}
+
+void
+FlowProbe::AddDelaySketch(Time delay, Time jitter)
+{
+    m_sketches.delay.Add(delay.GetSeconds());
+    if (!jitter.IsNegative())
+    {
+        m_sketches.jitter.Add(jitter.GetSeconds());
+    }
+}
+
+const FlowProbe::Sketches&
+FlowProbe::GetSketches() const
+{
+    return m_sketches;
+}
+
 FlowProbe::Stats
 FlowProbe::GetStats() const
 {
@@ -10,6 +10,7 @@
 #define FLOW_PROBE_H
 
 #include "flow-classifier.h"
+#include "flow-sketch.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -82,6 +83,41 @@ class FlowProbe : public Object
     /// @param reasonCode reason code for the drop
     void AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode);
 
+    /// Structure to hold the sketches of the packets seen by the probe,
+    /// used instead of the flow stats when the FlowMonitor is configured
+    /// to use sketches
+    struct Sketches
+    {
+        /// bytes per flow of the packets transmitted from this probe
+        CountMinSketch txBytes;
+        /// bytes per flow of the packets received at this probe
+        CountMinSketch rxBytes;
+        /// end-to-end delays (in seconds) of the sampled packets received at this probe
+        DdSketch delay;
+        /// jitters (in seconds) of the sampled packets received at this probe
+        DdSketch jitter;
+    };
+
+    /// Set the (empty) sketches of the probe
+    /// @param sketches the sketches
+    void SetSketches(const Sketches& sketches);
+    /// Add a transmitted packet to the sketches
+    /// @param flowId the flow Identifier
+    /// @param packetSize the packet size
+    void AddTxSketch(FlowId flowId, uint32_t packetSize);
+    /// Add a received packet to the sketches
+    /// @param flowId the flow Identifier
+    /// @param packetSize the packet size
+    void AddRxSketch(FlowId flowId, uint32_t packetSize);
+    /// Add the delay and, for all but the first packet of a flow, the
+    /// jitter of a received sampled packet to the sketches
+    /// @param delay the end-to-end delay of the packet
+    /// @param jitter the jitter of the packet, or a negative time if none
+    void AddDelaySketch(Time delay, Time jitter);
+    /// Get the sketches of the packets seen by this probe
+    /// @returns the sketches
+    const Sketches& GetSketches() const;
+
     /// Get the partial flow statistics stored in this probe.  With this
     /// information you can, for example, find out what is the delay
     /// from the first probe to this one.
@@ -97,6 +133,7 @@ class FlowProbe : public Object
   protected:
     Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
     Stats m_stats;                  //!< The flow stats
+    Sketches m_sketches;            //!< The sketches
 };
 
 } // namespace ns3
@@ -0,0 +1,190 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "flow-sketch.h"
+
+#include "ns3/assert.h"
+#include "ns3/hash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+DdSketch::DdSketch(double relativeAccuracy)
+    : m_relativeAccuracy(relativeAccuracy),
+      m_gamma((1 + relativeAccuracy) / (1 - relativeAccuracy)),
+      m_logGamma(std::log(m_gamma)),
+      m_zeroCount(0),
+      m_count(0)
+{
+    NS_ASSERT_MSG(relativeAccuracy > 0 && relativeAccuracy < 1,
+                  "The relative accuracy must be between 0 and 1");
+}
+
+DdSketch::DdSketch()
+    : DdSketch(0.01)
+{
+}
+
+void
+DdSketch::Add(double value)
+{
+    m_count++;
+    if (value < MIN_VALUE)
+    {
+        m_zeroCount++;
+        return;
+    }
+    m_bins[static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma))]++;
+}
+
+void
+DdSketch::Merge(const DdSketch& other)
+{
+    NS_ASSERT_MSG(m_relativeAccuracy == other.m_relativeAccuracy,
+                  "Cannot merge sketches with different accuracies");
+    for (const auto& [index, count] : other.m_bins)
+    {
+        m_bins[index] += count;
+    }
+    m_zeroCount += other.m_zeroCount;
+    m_count += other.m_count;
+}
+
+double
+DdSketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(q * (m_count - 1));
+    uint64_t seen = m_zeroCount;
+    if (seen > rank)
+    {
+        return 0;
+    }
+    for (const auto& [index, count] : m_bins)
+    {
+        seen += count;
+        if (seen > rank)
+        {
+            // the value with the smallest relative error within the bucket
+            return 2 * std::pow(m_gamma, index) / (m_gamma + 1);
+        }
+    }
+    return 2 * std::pow(m_gamma, m_bins.rbegin()->first) / (m_gamma + 1);
+}
+
+uint64_t
+DdSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+DdSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+void
+DdSketch::Clear()
+{
+    m_bins.clear();
+    m_zeroCount = 0;
+    m_count = 0;
+}
+
+CountMinSketch::CountMinSketch(uint32_t width, uint32_t depth)
+    : m_width(width),
+      m_depth(depth),
+      m_counters(static_cast<std::size_t>(width) * depth, 0),
+      m_total(0)
+{
+    NS_ASSERT_MSG(width > 0 && depth > 0, "The dimensions of the sketch must be positive");
+}
+
+CountMinSketch::CountMinSketch()
+    : m_width(0),
+      m_depth(0),
+      m_total(0)
+{
+}
+
+std::size_t
+CountMinSketch::GetIndex(uint64_t hash, uint32_t row) const
+{
+    // the rows use independent-enough hashes derived from a single one
+    // (Kirsch and Mitzenmacher, "Less hashing, same performance")
+    uint64_t h1 = hash & 0xffffffff;
+    uint64_t h2 = (hash >> 32) | 1;
+    return static_cast<std::size_t>(row) * m_width + (h1 + row * h2) % m_width;
+}
+
+void
+CountMinSketch::Add(uint64_t key, uint64_t count)
+{
+    NS_ASSERT_MSG(m_width > 0, "The dimensions of the sketch are not set");
+    uint64_t hash = Hash64(reinterpret_cast<const char*>(&key), sizeof(key));
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        m_counters[GetIndex(hash, row)] += count;
+    }
+    m_total += count;
+}
+
+uint64_t
+CountMinSketch::Estimate(uint64_t key) const
+{
+    if (m_width == 0)
+    {
+        return 0;
+    }
+    uint64_t hash = Hash64(reinterpret_cast<const char*>(&key), sizeof(key));
+    uint64_t estimate = m_counters[GetIndex(hash, 0)];
+    for (uint32_t row = 1; row < m_depth; row++)
+    {
+        estimate = std::min(estimate, m_counters[GetIndex(hash, row)]);
+    }
+    return estimate;
+}
+
+void
+CountMinSketch::Merge(const CountMinSketch& other)
+{
+    if (m_width == 0)
+    {
+        *this = other;
+        return;
+    }
+    if (other.m_width == 0)
+    {
+        return;
+    }
+    NS_ASSERT_MSG(m_width == other.m_width && m_depth == other.m_depth,
+                  "Cannot merge sketches with different dimensions");
+    for (std::size_t i = 0; i < m_counters.size(); i++)
+    {
+        m_counters[i] += other.m_counters[i];
+    }
+    m_total += other.m_total;
+}
+
+uint64_t
+CountMinSketch::GetTotal() const
+{
+    return m_total;
+}
+
+void
+CountMinSketch::Clear()
+{
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_total = 0;
+}
+
+} // namespace ns3
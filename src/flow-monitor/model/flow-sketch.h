@@ -0,0 +1,155 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef FLOW_SKETCH_H
+#define FLOW_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup flow-monitor
+ * @brief A quantile sketch with relative accuracy guarantees (DDSketch)
+ *
+ * The positive values are counted in buckets whose bounds grow
+ * geometrically, so that any quantile is estimated within the given
+ * relative accuracy, using a number of buckets logarithmic in the range of
+ * the values. Values smaller than the minimum indexable value (including
+ * zero) are counted separately. Two sketches with the same accuracy can be
+ * merged, e.g., to combine the sketches of several probes.
+ *
+ * See C. Masson, J. E. Rim and H. K. Lee, "DDSketch: A Fast and
+ * Fully-Mergeable Quantile Sketch with Relative-Error Guarantees", VLDB 2019.
+ */
+class DdSketch
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param relativeAccuracy the relative accuracy of the quantiles
+     */
+    DdSketch(double relativeAccuracy);
+    DdSketch();
+
+    /**
+     * @brief Add a value
+     * @param value the value (negative values are counted as zero)
+     */
+    void Add(double value);
+
+    /**
+     * @brief Add the values of another sketch
+     * @param other the sketch, with the same relative accuracy
+     */
+    void Merge(const DdSketch& other);
+
+    /**
+     * @brief Estimate a quantile of the values
+     * @param q the quantile, between 0 and 1
+     * @return the estimated quantile, or 0 if the sketch is empty
+     */
+    double GetQuantile(double q) const;
+
+    /**
+     * @return the number of values
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * @return the relative accuracy of the sketch
+     */
+    double GetRelativeAccuracy() const;
+
+    /// Remove all the values
+    void Clear();
+
+  private:
+    static constexpr double MIN_VALUE = 1e-12; //!< the smallest indexable value
+
+    double m_relativeAccuracy;          //!< the relative accuracy
+    double m_gamma;                     //!< the ratio between the bounds of a bucket
+    double m_logGamma;                  //!< the logarithm of m_gamma
+    std::map<int32_t, uint64_t> m_bins; //!< the counts of the buckets
+    uint64_t m_zeroCount;               //!< the count of the values below MIN_VALUE
+    uint64_t m_count;                   //!< the number of values
+};
+
+/**
+ * @ingroup flow-monitor
+ * @brief A Count-Min sketch of the bytes (or packets) per flow
+ *
+ * The counts are added to one counter per row, selected by a hash of the
+ * key, and the count of a key is estimated as the minimum of its counters,
+ * which never underestimates it. The overestimate is at most a fraction
+ * e/width of the total count with probability 1 - exp(-depth). Two sketches
+ * with the same dimensions can be merged, and merging a sketch into an empty
+ * (default constructed) one copies it.
+ *
+ * See G. Cormode and S. Muthukrishnan, "An improved data stream summary: the
+ * count-min sketch and its applications", Journal of Algorithms, 2005.
+ */
+class CountMinSketch
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param width the number of counters per row
+     * @param depth the number of rows
+     */
+    CountMinSketch(uint32_t width, uint32_t depth);
+    /// Constructor of an empty sketch without counters, which can only be
+    /// assigned or merged with another sketch
+    CountMinSketch();
+
+    /**
+     * @brief Add a count to a key
+     * @param key the key
+     * @param count the count
+     */
+    void Add(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Estimate the count of a key
+     * @param key the key
+     * @return the estimated count, never lower than the actual count
+     */
+    uint64_t Estimate(uint64_t key) const;
+
+    /**
+     * @brief Add the counts of another sketch
+     * @param other the sketch, with the same dimensions
+     */
+    void Merge(const CountMinSketch& other);
+
+    /**
+     * @return the sum of the counts of all the keys
+     */
+    uint64_t GetTotal() const;
+
+    /// Remove all the counts
+    void Clear();
+
+  private:
+    /**
+     * @brief Get the index of the counter of a key in a row
+     * @param hash the hash of the key
+     * @param row the row
+     * @return the index of the counter
+     */
+    std::size_t GetIndex(uint64_t hash, uint32_t row) const;
+
+    uint32_t m_width;                 //!< the number of counters per row
+    uint32_t m_depth;                 //!< the number of rows
+    std::vector<uint64_t> m_counters; //!< the counters, row by row
+    uint64_t m_total;                 //!< the sum of the counts
+};
+
+} // namespace ns3
+
+#endif /* FLOW_SKETCH_H */
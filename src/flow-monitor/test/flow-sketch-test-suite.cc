@@ -0,0 +1,147 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/flow-sketch.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor
+ * @defgroup flow-monitor-test Flow Monitor module unit tests
+ */
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief DdSketch unit tests.
+ */
+class DdSketchTestCase : public TestCase
+{
+  public:
+    DdSketchTestCase();
+    void DoRun() override;
+};
+
+DdSketchTestCase::DdSketchTestCase()
+    : TestCase("Check the accuracy of the quantiles of the DdSketch")
+{
+}
+
+void
+DdSketchTestCase::DoRun()
+{
+    const double accuracy = 0.01;
+    DdSketch empty(accuracy);
+    NS_TEST_EXPECT_MSG_EQ(empty.GetQuantile(0.5), 0, "The quantiles of an empty sketch are 0");
+
+    // values spread over four orders of magnitude, split between two sketches
+    std::vector<double> values;
+    DdSketch first(accuracy);
+    DdSketch second(accuracy);
+    for (uint32_t i = 1; i <= 10000; i++)
+    {
+        double value = 1e-6 * i * i;
+        values.push_back(value);
+        (i % 3 == 0 ? first : second).Add(value);
+    }
+    values.push_back(0);
+    first.Add(0);
+    std::sort(values.begin(), values.end());
+
+    first.Merge(second);
+    NS_TEST_EXPECT_MSG_EQ(first.GetCount(), values.size(), "Unexpected number of values");
+    NS_TEST_EXPECT_MSG_EQ(first.GetQuantile(0), 0, "The minimum should be zero");
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.99, 1.0})
+    {
+        double expected = values[static_cast<std::size_t>(q * (values.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(first.GetQuantile(q),
+                                  expected,
+                                  expected * accuracy,
+                                  "Quantile " << q << " beyond the relative accuracy");
+    }
+
+    first.Clear();
+    NS_TEST_EXPECT_MSG_EQ(first.GetCount(), 0, "The sketch should be empty");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief CountMinSketch unit tests.
+ */
+class CountMinSketchTestCase : public TestCase
+{
+  public:
+    CountMinSketchTestCase();
+    void DoRun() override;
+};
+
+CountMinSketchTestCase::CountMinSketchTestCase()
+    : TestCase("Check the estimates of the CountMinSketch")
+{
+}
+
+void
+CountMinSketchTestCase::DoRun()
+{
+    // a few heavy keys and many light keys, split between two sketches
+    CountMinSketch first(1024, 4);
+    CountMinSketch second(1024, 4);
+    const uint64_t heavyCount = 100000;
+    for (uint64_t key = 0; key < 10; key++)
+    {
+        first.Add(key, heavyCount);
+    }
+    for (uint64_t key = 10; key < 10010; key++)
+    {
+        second.Add(key, 10);
+    }
+
+    CountMinSketch merged;
+    merged.Merge(first);
+    merged.Merge(second);
+    NS_TEST_EXPECT_MSG_EQ(merged.GetTotal(), 10 * heavyCount + 10000 * 10, "Unexpected total");
+
+    // the error is at most e/width of the total with high probability
+    uint64_t maxError = 3 * merged.GetTotal() / 1024;
+    for (uint64_t key = 0; key < 10; key++)
+    {
+        uint64_t estimate = merged.Estimate(key);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(estimate, heavyCount, "A count cannot be underestimated");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(estimate, heavyCount + maxError, "Overestimated count");
+    }
+    uint32_t accurate = 0;
+    for (uint64_t key = 10; key < 10010; key++)
+    {
+        uint64_t estimate = merged.Estimate(key);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(estimate, 10, "A count cannot be underestimated");
+        accurate += (estimate <= 10 + maxError);
+    }
+    NS_TEST_EXPECT_MSG_GT(accurate, 9900, "Too many overestimated counts");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief Flow sketches TestSuite
+ */
+class FlowSketchTestSuite : public TestSuite
+{
+  public:
+    FlowSketchTestSuite()
+        : TestSuite("flow-sketch", Type::UNIT)
+    {
+        AddTestCase(new DdSketchTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new CountMinSketchTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static FlowSketchTestSuite g_flowSketchTestSuite; //!< Static variable for test initialization
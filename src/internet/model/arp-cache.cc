@@ -88,11 +88,10 @@ void
 ArpCache::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto& iter : m_arpCache)
-    {
-        delete iter.second; /* delete the pointer ArpCache::Entry */
-    }
-    m_arpCache.clear();
+    m_arpCache.Clear();
+    m_waitReplyEntries.clear();
+    m_freeEntries.clear();
+    m_entryPool.clear();
     m_device = nullptr;
     m_interface = nullptr;
     if (!m_waitReplyTimer.IsPending())
@@ -190,40 +189,45 @@ void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // only the entries that entered the WaitReply state need to be visited;
+    // the set is ordered by address, like the cache used to be
+    for (auto i = m_waitReplyEntries.begin(); i != m_waitReplyEntries.end();)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        ArpCache::Entry* entry = m_arpCache.Find(*i);
+        if (entry == nullptr || !entry->IsWaitReply())
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            i = m_waitReplyEntries.erase(i);
+            continue;
+        }
+        if (entry->GetRetries() < m_maxRetries)
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+            i++;
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            entry->MarkDead();
+            entry->ClearRetries();
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
+            i = m_waitReplyEntries.erase(i);
         }
     }
     if (restartWaitReplyTimer)
@@ -238,19 +242,13 @@ void
 ArpCache::Flush()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
-    {
-        if (!i->second->IsAutoGenerated())
-        {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
-            i = m_arpCache.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    m_arpCache.EraseIf(
+        [](Ipv4Address, ArpCache::Entry* entry) { return !entry->IsAutoGenerated(); },
+        [this](ArpCache::Entry* entry) {
+            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            ReleaseEntry(entry);
+        });
+    m_waitReplyEntries.clear();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -265,7 +263,9 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries in address order, regardless of the table layout
+    auto entries = m_arpCache.GetSortedEntries();
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -307,19 +307,12 @@ void
 ArpCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
-    {
-        if (i->second->IsAutoGenerated())
-        {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
-            i = m_arpCache.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    m_arpCache.EraseIf(
+        [](Ipv4Address, ArpCache::Entry* entry) { return entry->IsAutoGenerated(); },
+        [this](ArpCache::Entry* entry) {
+            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            ReleaseEntry(entry);
+        });
 }
 
 std::list<ArpCache::Entry*>
@@ -328,14 +321,12 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
-    {
-        ArpCache::Entry* entry = (*i).second;
+    m_arpCache.ForEach([&](Ipv4Address, ArpCache::Entry* entry) {
         if (entry->GetMacAddress() == to)
         {
             entryList.push_back(entry);
         }
-    }
+    });
     return entryList;
 }
 
@@ -343,22 +334,17 @@ ArpCache::Entry*
 ArpCache::Lookup(Ipv4Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    auto it = m_arpCache.find(to);
-    if (it != m_arpCache.end())
-    {
-        return it->second;
-    }
-    return nullptr;
+    return m_arpCache.Find(to);
 }
 
 ArpCache::Entry*
 ArpCache::Add(Ipv4Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    NS_ASSERT(m_arpCache.find(to) == m_arpCache.end());
+    NS_ASSERT(m_arpCache.Find(to) == nullptr);
 
-    auto entry = new ArpCache::Entry(this);
-    m_arpCache[to] = entry;
+    ArpCache::Entry* entry = AllocateEntry();
+    m_arpCache.Insert(to, entry);
     entry->SetIpv4Address(to);
     return entry;
 }
@@ -368,17 +354,49 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    Ipv4Address key = entry->GetIpv4Address();
+    if (m_arpCache.Find(key) != entry)
     {
-        if ((*i).second == entry)
+        // the address of the entry has been changed after its insertion
+        bool found = false;
+        m_arpCache.ForEach([&](Ipv4Address address, ArpCache::Entry* e) {
+            if (e == entry)
+            {
+                key = address;
+                found = true;
+            }
+        });
+        if (!found)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
+            NS_LOG_WARN("Entry not found in this ARP Cache");
             return;
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
+    m_arpCache.Erase(key);
+    entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+    ReleaseEntry(entry);
+}
+
+ArpCache::Entry*
+ArpCache::AllocateEntry()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_freeEntries.empty())
+    {
+        m_entryPool.emplace_back(this);
+        return &m_entryPool.back();
+    }
+    ArpCache::Entry* entry = m_freeEntries.back();
+    m_freeEntries.pop_back();
+    *entry = ArpCache::Entry(this);
+    return entry;
+}
+
+void
+ArpCache::ReleaseEntry(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    m_freeEntries.push_back(entry);
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -495,6 +513,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     m_state = WAIT_REPLY;
     m_pending.push_back(waiting);
     UpdateSeen();
+    m_arp->m_waitReplyEntries.insert(m_ipv4Address);
     m_arp->StartWaitReplyTimer();
 }
 
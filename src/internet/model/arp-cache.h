@@ -8,6 +8,8 @@
 #ifndef ARP_CACHE_H
 #define ARP_CACHE_H
 
+#include "neighbor-cache-table.h"
+
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
@@ -20,9 +22,11 @@
 #include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
+#include <deque>
 #include <list>
-#include <map>
+#include <set>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -322,14 +326,21 @@ class ArpCache : public Object
     /**
      * @brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
-    /**
-     * @brief ARP Cache container iterator
-     */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef NeighborCacheTable<Ipv4Address, ArpCache::Entry, Ipv4AddressHash> Cache;
 
     void DoDispose() override;
 
+    /**
+     * @brief Get an unused entry from the entry pool
+     * @returns a pointer to a fresh ARP Entry
+     */
+    ArpCache::Entry* AllocateEntry();
+    /**
+     * @brief Return an entry to the entry pool
+     * @param entry the entry, which must not be referenced by the cache anymore
+     */
+    void ReleaseEntry(ArpCache::Entry* entry);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -348,6 +359,9 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    std::deque<ArpCache::Entry> m_entryPool;   //!< storage of the ARP entries
+    std::vector<ArpCache::Entry*> m_freeEntries; //!< unused entries of the pool
+    std::set<Ipv4Address> m_waitReplyEntries;  //!< addresses of the entries waiting for a reply
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
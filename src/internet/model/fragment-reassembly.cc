@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fragment-reassembly.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FragmentReassembly");
+
+FragmentReassembly::FragmentReassembly()
+    : m_moreFragment(false),
+      m_overlaps(false)
+{
+}
+
+void
+FragmentReassembly::AddFragment(Ptr<Packet> fragment, uint32_t fragmentOffset, bool moreFragment)
+{
+    NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
+
+    // fragments with the same offset are kept in arrival order
+    auto it = m_fragments.emplace(fragmentOffset, fragment);
+    if (std::next(it) == m_fragments.end())
+    {
+        m_moreFragment = moreFragment;
+    }
+
+    // merge the new range with the ranges it overlaps or touches
+    uint32_t start = fragmentOffset;
+    uint32_t end = fragmentOffset + fragment->GetSize();
+    uint32_t mergedStart = start;
+    uint32_t mergedEnd = end;
+    auto range = m_received.upper_bound(start);
+    if (range != m_received.begin() && std::prev(range)->second >= start)
+    {
+        range = std::prev(range);
+    }
+    while (range != m_received.end() && range->first <= mergedEnd)
+    {
+        if (std::min(end, range->second) > std::max(start, range->first))
+        {
+            m_overlaps = true;
+        }
+        mergedStart = std::min(mergedStart, range->first);
+        mergedEnd = std::max(mergedEnd, range->second);
+        range = m_received.erase(range);
+    }
+    m_received.emplace(mergedStart, mergedEnd);
+}
+
+bool
+FragmentReassembly::IsEntire() const
+{
+    return !m_moreFragment && !m_fragments.empty() && m_received.size() == 1 &&
+           m_received.begin()->first == 0;
+}
+
+bool
+FragmentReassembly::HasOverlaps() const
+{
+    return m_overlaps;
+}
+
+std::size_t
+FragmentReassembly::GetNFragments() const
+{
+    return m_fragments.size();
+}
+
+std::vector<Ptr<Packet>>
+FragmentReassembly::GetPieces() const
+{
+    std::vector<Ptr<Packet>> pieces;
+    pieces.reserve(m_fragments.size() + 1);
+    uint32_t lastEndOffset = 0;
+    for (const auto& [offset, fragment] : m_fragments)
+    {
+        if (offset > lastEndOffset)
+        {
+            // missing bytes
+            break;
+        }
+        uint32_t fragmentEnd = offset + fragment->GetSize();
+        if (fragmentEnd <= lastEndOffset)
+        {
+            continue;
+        }
+        // The fragments are overlapping.
+        // We do not overwrite the "old" with the "new" because we do not know when each
+        // arrived. This is different from what Linux does. It is not possible to emulate a
+        // fragmentation attack.
+        uint32_t newStart = lastEndOffset - offset;
+        if (newStart > 0)
+        {
+            pieces.push_back(fragment->CreateFragment(newStart, fragmentEnd - lastEndOffset));
+        }
+        else
+        {
+            pieces.push_back(fragment->Copy());
+        }
+        lastEndOffset = fragmentEnd;
+    }
+    return pieces;
+}
+
+Ptr<Packet>
+FragmentReassembly::GetPacket(Ptr<const Packet> prefix) const
+{
+    NS_LOG_FUNCTION(this << prefix);
+    NS_ASSERT_MSG(IsEntire(), "The packet has not been entirely received");
+    return GetPartialPacket(prefix);
+}
+
+Ptr<Packet>
+FragmentReassembly::GetPartialPacket(Ptr<const Packet> prefix) const
+{
+    NS_LOG_FUNCTION(this << prefix);
+
+    std::vector<Ptr<Packet>> pieces = GetPieces();
+    if (prefix)
+    {
+        pieces.insert(pieces.begin(), prefix->Copy());
+    }
+    return Concatenate(pieces);
+}
+
+Ptr<Packet>
+FragmentReassembly::Concatenate(std::vector<Ptr<Packet>>& pieces)
+{
+    if (pieces.empty())
+    {
+        return Create<Packet>();
+    }
+    while (pieces.size() > 1)
+    {
+        std::size_t n = pieces.size();
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            if (i + 1 < n)
+            {
+                pieces[i]->AddAtEnd(pieces[i + 1]);
+            }
+            pieces[i / 2] = pieces[i];
+        }
+        pieces.resize((n + 1) / 2);
+    }
+    return pieces.front();
+}
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FRAGMENT_REASSEMBLY_H
+#define FRAGMENT_REASSEMBLY_H
+
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ * @brief Reassembly state of the fragments of a single IPv4 or IPv6 packet.
+ *
+ * The fragments are kept sorted by offset, and the ranges of bytes received
+ * so far are kept coalesced, so that adding a fragment and checking whether
+ * the packet is entire cost O(log n) and O(1) respectively, n being the number
+ * of fragments.
+ *
+ * Overlapping fragments are accepted. When assembling the packet, the bytes
+ * of the fragment with the lowest offset are kept, and among fragments with
+ * the same offset the bytes of the first arrived one are kept. The packet is
+ * assembled by merging the fragments pairwise, hence each byte is copied
+ * O(log n) times instead of O(n) times with a sequential concatenation.
+ */
+class FragmentReassembly
+{
+  public:
+    FragmentReassembly();
+
+    /**
+     * @brief Add a fragment.
+     * @param fragment the fragment
+     * @param fragmentOffset the offset of the fragment, in bytes
+     * @param moreFragment the bit "More Fragment"
+     */
+    void AddFragment(Ptr<Packet> fragment, uint32_t fragmentOffset, bool moreFragment);
+
+    /**
+     * @brief If all the fragments have been received.
+     * @returns true if the packet is entire
+     */
+    bool IsEntire() const;
+
+    /**
+     * @brief If some of the received fragments overlap.
+     * @returns true if at least one received byte has been received twice
+     */
+    bool HasOverlaps() const;
+
+    /**
+     * @brief Get the entire packet.
+     * @param prefix an optional packet placed before the reassembled payload
+     * @return the entire packet
+     */
+    Ptr<Packet> GetPacket(Ptr<const Packet> prefix = nullptr) const;
+
+    /**
+     * @brief Get the contiguous part of the packet received from offset 0.
+     * @param prefix an optional packet placed before the partial payload
+     * @return the partial packet (empty if the first fragment is missing)
+     */
+    Ptr<Packet> GetPartialPacket(Ptr<const Packet> prefix = nullptr) const;
+
+    /**
+     * @return the number of fragments received
+     */
+    std::size_t GetNFragments() const;
+
+  private:
+    /**
+     * @brief Collect the contiguous bytes received from offset 0, dropping the
+     * bytes already provided by a previous fragment.
+     * @return the pieces to concatenate, in order
+     */
+    std::vector<Ptr<Packet>> GetPieces() const;
+
+    /**
+     * @brief Concatenate packets by merging them pairwise.
+     * @param pieces the packets to concatenate (consumed)
+     * @return the concatenation
+     */
+    static Ptr<Packet> Concatenate(std::vector<Ptr<Packet>>& pieces);
+
+    bool m_moreFragment; //!< the "More Fragment" bit of the fragment with the highest offset
+    bool m_overlaps;     //!< true if some fragments overlap
+    std::multimap<uint32_t, Ptr<Packet>> m_fragments; //!< fragments, by offset
+    std::map<uint32_t, uint32_t> m_received; //!< coalesced [start, end) ranges received
+};
+
+} // namespace ns3
+
+#endif /* FRAGMENT_REASSEMBLY_H */
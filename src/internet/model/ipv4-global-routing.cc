@@ -11,6 +11,8 @@
 #include "ipv4-routing-table-entry.h"
 
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
@@ -18,7 +20,10 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <vector>
 
@@ -38,10 +43,33 @@ Ipv4GlobalRouting::GetTypeId()
             .SetGroupName("Internet")
             .AddAttribute("RandomEcmpRouting",
                           "Set to true if packets are randomly routed among ECMP; set to false for "
-                          "using only one route consistently",
+                          "using only one route consistently (unless EcmpMode is set)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_randomEcmpRouting),
                           MakeBooleanChecker())
+            .AddAttribute("EcmpMode",
+                          "Selection of a route among ECMP routes. RandomEcmpRouting=true is "
+                          "equivalent to Random.",
+                          EnumValue(Ipv4GlobalRouting::ECMP_NONE),
+                          MakeEnumAccessor<EcmpMode>(&Ipv4GlobalRouting::m_ecmpMode),
+                          MakeEnumChecker(Ipv4GlobalRouting::ECMP_NONE,
+                                          "None",
+                                          Ipv4GlobalRouting::ECMP_RANDOM,
+                                          "Random",
+                                          Ipv4GlobalRouting::ECMP_FLOW_HASH,
+                                          "FlowHash"))
+            .AddAttribute("EcmpHashSeed",
+                          "Seed of the flow hash used by the FlowHash ECMP mode. The node id is "
+                          "mixed into the hash as well, to avoid correlated choices across hops.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv4GlobalRouting::m_ecmpHashSeed),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("EcmpBuckets",
+                          "Number of hash buckets of the ECMP next-hop groups. More buckets "
+                          "follow the ECMP weights more accurately.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&Ipv4GlobalRouting::m_ecmpBuckets),
+                          MakeUintegerChecker<uint16_t>(1))
             .AddAttribute("RespondToInterfaceEvents",
                           "Set to true if you want to dynamically recompute the global routes upon "
                           "Interface notification events (up/down, or add/remove address)",
@@ -53,7 +81,13 @@ Ipv4GlobalRouting::GetTypeId()
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_ecmpMode(ECMP_NONE),
+      m_ecmpHashSeed(0),
+      m_ecmpBuckets(64),
+      m_ecmpWeighted(false),
+      m_routesVersion(1),
+      m_flowHashSalt(-1)
 {
     NS_LOG_FUNCTION(this);
 
@@ -81,6 +115,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
         }
     }
     m_hostRoutes.push_back(route);
+    RoutesChanged();
 }
 
 void
@@ -99,6 +134,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
         }
     }
     m_hostRoutes.push_back(route);
+    RoutesChanged();
 }
 
 void
@@ -120,6 +156,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
         }
     }
     m_networkRoutes.push_back(route);
+    RoutesChanged();
 }
 
 void
@@ -138,6 +175,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
         }
     }
     m_networkRoutes.push_back(route);
+    RoutesChanged();
 }
 
 void
@@ -159,12 +197,13 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
         }
     }
     m_ASexternalRoutes.push_back(route);
+    RoutesChanged();
 }
 
 Ptr<Ipv4Route>
-Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif, uint32_t flowHash)
 {
-    NS_LOG_FUNCTION(this << dest << oif);
+    NS_LOG_FUNCTION(this << dest << oif << flowHash);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
     Ptr<Ipv4Route> rtentry = nullptr;
     // store all available routes that bring packets to their destination
@@ -255,16 +294,35 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     if (!allRoutes.empty()) // if route(s) is found
     {
         // pick up one of the routes uniformly at random if random
+        // ECMP routing is enabled, by hashing the flow if flow-hashed
         // ECMP routing is enabled, or always select the first route
-        // consistently if random ECMP routing is disabled
-        uint32_t selectIndex;
-        if (m_randomEcmpRouting)
+        // consistently otherwise.  Weighted selections go through the
+        // next-hop group of the routes (not used if an output interface
+        // is given, since only part of the routes are considered).
+        uint32_t selectIndex = 0;
+        if (m_randomEcmpRouting || m_ecmpMode == ECMP_RANDOM)
         {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+            if (m_ecmpWeighted && !oif && allRoutes.size() > 1)
+            {
+                const EcmpGroup& group = GetEcmpGroup(allRoutes);
+                selectIndex = group.buckets[m_rand->GetInteger(0, group.buckets.size() - 1)];
+            }
+            else
+            {
+                selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+            }
         }
-        else
+        else if (m_ecmpMode == ECMP_FLOW_HASH && allRoutes.size() > 1)
         {
-            selectIndex = 0;
+            if (!oif)
+            {
+                const EcmpGroup& group = GetEcmpGroup(allRoutes);
+                selectIndex = group.buckets[flowHash % group.buckets.size()];
+            }
+            else
+            {
+                selectIndex = flowHash % allRoutes.size();
+            }
         }
         Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
         // create a Ipv4Route object from the selected routing table entry
@@ -352,6 +410,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
                 delete *i;
                 m_hostRoutes.erase(i);
+                RoutesChanged();
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -368,6 +427,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
             delete *j;
             m_networkRoutes.erase(j);
+            RoutesChanged();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -383,6 +443,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
             delete *k;
             m_ASexternalRoutes.erase(k);
+            RoutesChanged();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -400,6 +461,190 @@ Ipv4GlobalRouting::AssignStreams(int64_t stream)
     return 1;
 }
 
+void
+Ipv4GlobalRouting::SetEcmpWeight(uint32_t interface, uint32_t weight)
+{
+    NS_LOG_FUNCTION(this << interface << weight);
+    if (interface >= m_ecmpWeights.size())
+    {
+        m_ecmpWeights.resize(interface + 1, 1);
+    }
+    m_ecmpWeights[interface] = weight;
+    m_ecmpWeighted = std::any_of(m_ecmpWeights.begin(), m_ecmpWeights.end(), [](uint32_t w) {
+        return w != 1;
+    });
+    RoutesChanged();
+}
+
+uint32_t
+Ipv4GlobalRouting::GetEcmpWeight(uint32_t interface) const
+{
+    return interface < m_ecmpWeights.size() ? m_ecmpWeights[interface] : 1;
+}
+
+void
+Ipv4GlobalRouting::RoutesChanged()
+{
+    // the groups are rebuilt lazily, keeping their buckets when possible
+    m_routesVersion++;
+}
+
+const Ipv4GlobalRouting::EcmpGroup&
+Ipv4GlobalRouting::GetEcmpGroup(const std::vector<Ipv4RoutingTableEntry*>& routes)
+{
+    NS_ASSERT(routes.size() > 1);
+    const Ipv4RoutingTableEntry* first = routes.front();
+    uint64_t key = (static_cast<uint64_t>(first->GetDestNetwork().Get()) << 32) |
+                   first->GetDestNetworkMask().Get();
+    EcmpGroup& group = m_ecmpGroups[key];
+    if (group.version == m_routesVersion)
+    {
+        return group;
+    }
+
+    NS_LOG_LOGIC("Building the ECMP group of " << first->GetDestNetwork() << "/"
+                                               << first->GetDestNetworkMask().GetPrefixLength());
+    std::size_t n = routes.size();
+    std::vector<EcmpNextHop> nextHops;
+    std::vector<uint32_t> weights;
+    uint64_t totalWeight = 0;
+    for (const auto route : routes)
+    {
+        nextHops.push_back({route->GetInterface(), route->GetGateway()});
+        weights.push_back(GetEcmpWeight(route->GetInterface()));
+        totalWeight += weights.back();
+    }
+    if (totalWeight == 0)
+    {
+        weights.assign(n, 1);
+        totalWeight = n;
+    }
+
+    // number of buckets of each next hop, proportional to its weight
+    std::size_t nBuckets = std::max<std::size_t>(m_ecmpBuckets, n);
+    std::vector<std::size_t> quota(n);
+    std::size_t assigned = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        quota[i] = nBuckets * weights[i] / totalWeight;
+        assigned += quota[i];
+    }
+    for (std::size_t i = 0; assigned < nBuckets; i = (i + 1) % n)
+    {
+        if (weights[i] > 0)
+        {
+            quota[i]++;
+            assigned++;
+        }
+    }
+
+    // the layout of a freshly built group: contiguous runs of buckets
+    std::vector<uint16_t> layout;
+    layout.reserve(nBuckets);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        layout.insert(layout.end(), quota[i], i);
+    }
+
+    // keep the buckets of the next hops that are still members, within their
+    // quota, preferring the buckets where the fresh layout agrees: this way a
+    // group returns to its original layout when the changes are undone
+    std::vector<uint16_t> buckets(nBuckets, UINT16_MAX);
+    std::vector<std::size_t> count(n, 0);
+    if (group.buckets.size() == nBuckets)
+    {
+        std::vector<uint16_t> remap(group.nextHops.size(), UINT16_MAX);
+        for (std::size_t j = 0; j < group.nextHops.size(); j++)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (group.nextHops[j].interface == nextHops[i].interface &&
+                    group.nextHops[j].gateway == nextHops[i].gateway)
+                {
+                    remap[j] = i;
+                    break;
+                }
+            }
+        }
+        for (bool agreeing : {true, false})
+        {
+            for (std::size_t b = 0; b < nBuckets; b++)
+            {
+                uint16_t i = remap[group.buckets[b]];
+                if (buckets[b] == UINT16_MAX && i != UINT16_MAX && count[i] < quota[i] &&
+                    (!agreeing || i == layout[b]))
+                {
+                    buckets[b] = i;
+                    count[i]++;
+                }
+            }
+        }
+    }
+
+    // give the remaining buckets to the next hops below their quota
+    std::size_t next = 0;
+    for (std::size_t b = 0; b < nBuckets; b++)
+    {
+        if (buckets[b] != UINT16_MAX)
+        {
+            continue;
+        }
+        uint16_t i = layout[b];
+        if (count[i] == quota[i])
+        {
+            while (count[next] == quota[next])
+            {
+                next++;
+            }
+            i = next;
+        }
+        buckets[b] = i;
+        count[i]++;
+    }
+
+    group.version = m_routesVersion;
+    group.routes = routes;
+    group.nextHops = std::move(nextHops);
+    group.buckets = std::move(buckets);
+    return group;
+}
+
+uint32_t
+Ipv4GlobalRouting::GetFlowHash(const Ipv4Header& header,
+                               Ptr<const Packet> p,
+                               bool hasL4Header) const
+{
+    if (m_ecmpMode != ECMP_FLOW_HASH || m_randomEcmpRouting)
+    {
+        return 0;
+    }
+
+    if (m_flowHashSalt < 0)
+    {
+        Ptr<Node> node = m_ipv4->GetObject<Node>();
+        m_flowHashSalt = node ? node->GetId() : 0;
+    }
+
+    // seed, salt, source, destination, protocol and ports
+    char buffer[21] = {};
+    uint32_t words[4] = {m_ecmpHashSeed,
+                         static_cast<uint32_t>(m_flowHashSalt),
+                         header.GetSource().Get(),
+                         header.GetDestination().Get()};
+    std::memcpy(buffer, words, sizeof(words));
+    uint8_t protocol = header.GetProtocol();
+    buffer[16] = protocol;
+
+    // all the fragments of a packet must take the same path, but only the
+    // first one carries the ports
+    bool fragmented = !header.IsLastFragment() || header.GetFragmentOffset() != 0;
+    if (hasL4Header && p && !fragmented && (protocol == 6 || protocol == 17) && p->GetSize() >= 4)
+    {
+        p->CopyData(reinterpret_cast<uint8_t*>(buffer + 17), 4);
+    }
+    return Hash32(buffer, sizeof(buffer));
+}
+
 void
 Ipv4GlobalRouting::DoDispose()
 {
@@ -417,6 +662,7 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_ecmpGroups.clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -509,7 +755,9 @@ Ipv4GlobalRouting::RouteOutput(Ptr<Packet> p,
     // See if this is a unicast packet we have a route for.
     //
     NS_LOG_LOGIC("Unicast destination- looking up");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), oif);
+    // the packets sent by TCP already carry the transport header
+    uint32_t flowHash = GetFlowHash(header, p, header.GetProtocol() == 6);
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), oif, flowHash);
     if (rtentry)
     {
         sockerr = Socket::ERROR_NOTERROR;
@@ -564,7 +812,8 @@ Ipv4GlobalRouting::RouteInput(Ptr<const Packet> p,
     }
     // Next, try to find a route
     NS_LOG_LOGIC("Unicast destination- looking up global route");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination());
+    Ptr<Ipv4Route> rtentry =
+        LookupGlobal(header.GetDestination(), nullptr, GetFlowHash(header, p, true));
     if (rtentry)
     {
         NS_LOG_LOGIC("Found unicast destination- calling unicast callback");
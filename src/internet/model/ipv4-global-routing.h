@@ -17,6 +17,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -54,12 +56,30 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When several equal-cost routes lead to a destination, the EcmpMode
+ * attribute selects how the route is picked: always the first one, at
+ * random for each packet, or by hashing the flow 5-tuple so that all the
+ * packets of a flow take the same path.  The routes toward a destination
+ * prefix form a next-hop group: a table of hash buckets filled in
+ * proportion to the ECMP weight of the output interfaces, so that the
+ * selection cost does not depend on the number of paths.  When the routes
+ * are recomputed, the buckets of the next hops still present are kept
+ * (resilient hashing), hence only the flows of the removed next hops move.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
 class Ipv4GlobalRouting : public Ipv4RoutingProtocol
 {
   public:
+    /// Selection of a route among equal-cost multipath (ECMP) routes
+    enum EcmpMode
+    {
+        ECMP_NONE,      //!< Always use the first route
+        ECMP_RANDOM,    //!< Pick a route at random for each packet
+        ECMP_FLOW_HASH, //!< Pick a route by hashing the flow 5-tuple
+    };
+
     /**
      * @brief Get the type ID.
      * @return the object TypeId
@@ -220,6 +240,27 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * @brief Set the ECMP weight of an output interface.
+     *
+     * The share of flows (or of packets, with random ECMP) sent through each
+     * of several equal-cost routes is proportional to the weight of its
+     * output interface.  All the interfaces have weight 1 by default; an
+     * interface with weight 0 is used only if all the candidate routes have
+     * weight 0.
+     *
+     * @param interface the interface index
+     * @param weight the weight
+     */
+    void SetEcmpWeight(uint32_t interface, uint32_t weight);
+
+    /**
+     * @brief Get the ECMP weight of an output interface.
+     * @param interface the interface index
+     * @return the weight
+     */
+    uint32_t GetEcmpWeight(uint32_t interface) const;
+
   protected:
     void DoDispose() override;
 
@@ -232,6 +273,20 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     bool m_respondToInterfaceEvents;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
+    /// Selection of a route among ECMP routes
+    EcmpMode m_ecmpMode;
+    /// Seed of the flow hash
+    uint32_t m_ecmpHashSeed;
+    /// Number of hash buckets of the next-hop groups
+    uint16_t m_ecmpBuckets;
+    /// ECMP weight of each interface (1 if not set)
+    std::vector<uint32_t> m_ecmpWeights;
+    /// True if some interface has an ECMP weight different from 1
+    bool m_ecmpWeighted;
+    /// Incremented each time the routes or the ECMP weights change
+    uint32_t m_routesVersion;
+    /// Node id, mixed into the flow hash to avoid polarization across hops
+    mutable int64_t m_flowHashSalt;
 
     /// container of Ipv4RoutingTableEntry (routes to hosts)
     typedef std::list<Ipv4RoutingTableEntry*> HostRoutes;
@@ -260,7 +315,59 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      * @param oif output interface if any (put 0 otherwise)
      * @return Ipv4Route to route the packet to reach dest address
      */
-    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
+    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest,
+                                Ptr<NetDevice> oif = nullptr,
+                                uint32_t flowHash = 0);
+
+    /// A next hop of an ECMP next-hop group
+    struct EcmpNextHop
+    {
+        uint32_t interface;  //!< output interface
+        Ipv4Address gateway; //!< gateway
+    };
+
+    /// The ECMP routes toward a destination prefix and the buckets mapping flows to them
+    struct EcmpGroup
+    {
+        uint32_t version{0};                        //!< m_routesVersion the group was built for
+        std::vector<Ipv4RoutingTableEntry*> routes; //!< member routes
+        std::vector<EcmpNextHop> nextHops;          //!< next hops of the member routes
+        std::vector<uint16_t> buckets;              //!< member index of each bucket
+    };
+
+    /**
+     * @brief Get the next-hop group of a set of ECMP routes, (re)building it
+     * if the routes changed.
+     *
+     * The buckets of the next hops that are still members of the group keep
+     * their next hop, unless the weights changed the next hop share.
+     *
+     * @param routes the ECMP routes (at least two) toward a destination prefix
+     * @return the next-hop group
+     */
+    const EcmpGroup& GetEcmpGroup(const std::vector<Ipv4RoutingTableEntry*>& routes);
+
+    /**
+     * @brief Hash the flow a packet belongs to.
+     *
+     * The hash covers the source and destination addresses, the protocol and,
+     * for unfragmented TCP and UDP packets whose transport header is available,
+     * the ports.
+     *
+     * @param header the IPv4 header
+     * @param p the packet, starting with the transport header (may be null)
+     * @param hasL4Header true if the packet starts with the transport header
+     * @return the flow hash, or 0 if flow hashing is not enabled
+     */
+    uint32_t GetFlowHash(const Ipv4Header& header, Ptr<const Packet> p, bool hasL4Header) const;
+
+    /**
+     * @brief Invalidate the ECMP next-hop groups after a route or weight change.
+     */
+    void RoutesChanged();
+
+    /// ECMP next-hop groups, indexed by destination network and mask
+    std::unordered_map<uint64_t, EcmpGroup> m_ecmpGroups;
 
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
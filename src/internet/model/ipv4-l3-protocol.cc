@@ -1440,7 +1440,8 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_FUNCTION(this << *packet << outIfaceMtu << &listFragments);
 
-    Ptr<Packet> p = packet->Copy();
+    // the fragments are views on the buffer of the packet, which is never modified
+    Ptr<const Packet> p = packet;
 
     NS_ASSERT_MSG((ipv4Header.GetSerializedSize() == 5 * 4),
                   "IPv4 fragmentation implementation only works without option headers.");
@@ -1498,10 +1499,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
         NS_LOG_LOGIC("New fragment Header " << fragmentHeader);
 
-        std::ostringstream oss;
-        oss << fragmentHeader;
-        fragment->Print(oss);
-
         NS_LOG_LOGIC("New fragment " << *fragment);
 
         listFragments.emplace_back(fragment, fragmentHeader);
@@ -1561,7 +1558,6 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
 }
 
 Ipv4L3Protocol::Fragments::Fragments()
-    : m_moreFragment(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -1572,126 +1568,28 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
                                        bool moreFragment)
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
-
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
-    {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
-    }
-
-    if (it == m_fragments.end())
-    {
-        m_moreFragment = moreFragment;
-    }
-
-    m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    m_reassembly.AddFragment(fragment, fragmentOffset, moreFragment);
 }
 
 bool
 Ipv4L3Protocol::Fragments::IsEntire() const
 {
     NS_LOG_FUNCTION(this);
-
-    bool ret = !m_moreFragment && !m_fragments.empty();
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (auto it = m_fragments.begin(); it != m_fragments.end(); it++)
-        {
-            // overlapping fragments do exist
-            NS_LOG_LOGIC("Checking overlaps " << lastEndOffset << " - " << it->second);
-
-            if (lastEndOffset < it->second)
-            {
-                ret = false;
-                break;
-            }
-            // fragments might overlap in strange ways
-            uint16_t fragmentEnd = it->first->GetSize() + it->second;
-            lastEndOffset = std::max(lastEndOffset, fragmentEnd);
-        }
-    }
-
-    return ret;
+    return m_reassembly.IsEntire();
 }
 
 Ptr<Packet>
 Ipv4L3Protocol::Fragments::GetPacket() const
 {
     NS_LOG_FUNCTION(this);
-
-    auto it = m_fragments.begin();
-
-    Ptr<Packet> p = it->first->Copy();
-    uint16_t lastEndOffset = p->GetSize();
-    it++;
-
-    for (; it != m_fragments.end(); it++)
-    {
-        if (lastEndOffset > it->second)
-        {
-            // The fragments are overlapping.
-            // We do not overwrite the "old" with the "new" because we do not know when each
-            // arrived. This is different from what Linux does. It is not possible to emulate a
-            // fragmentation attack.
-            uint32_t newStart = lastEndOffset - it->second;
-            if (it->first->GetSize() > newStart)
-            {
-                uint32_t newSize = it->first->GetSize() - newStart;
-                Ptr<Packet> tempFragment = it->first->CreateFragment(newStart, newSize);
-                p->AddAtEnd(tempFragment);
-            }
-        }
-        else
-        {
-            NS_LOG_LOGIC("Adding: " << *(it->first));
-            p->AddAtEnd(it->first);
-        }
-        lastEndOffset = p->GetSize();
-    }
-
-    return p;
+    return m_reassembly.GetPacket();
 }
 
 Ptr<Packet>
 Ipv4L3Protocol::Fragments::GetPartialPacket() const
 {
     NS_LOG_FUNCTION(this);
-
-    auto it = m_fragments.begin();
-
-    Ptr<Packet> p = Create<Packet>();
-    uint16_t lastEndOffset = 0;
-
-    if (m_fragments.begin()->second > 0)
-    {
-        return p;
-    }
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
-    {
-        if (lastEndOffset > it->second)
-        {
-            uint32_t newStart = lastEndOffset - it->second;
-            uint32_t newSize = it->first->GetSize() - newStart;
-            Ptr<Packet> tempFragment = it->first->CreateFragment(newStart, newSize);
-            p->AddAtEnd(tempFragment);
-        }
-        else if (lastEndOffset == it->second)
-        {
-            NS_LOG_LOGIC("Adding: " << *(it->first));
-            p->AddAtEnd(it->first);
-        }
-        lastEndOffset = p->GetSize();
-    }
-
-    return p;
+    return m_reassembly.GetPartialPacket();
 }
 
 void
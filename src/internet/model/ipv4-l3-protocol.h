@@ -9,6 +9,7 @@
 #ifndef IPV4_L3_PROTOCOL_H
 #define IPV4_L3_PROTOCOL_H
 
+#include "fragment-reassembly.h"
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -583,14 +584,9 @@ class Ipv4L3Protocol : public Ipv4
 
       private:
         /**
-         * @brief True if other fragments will be sent.
+         * @brief The fragments received so far.
          */
-        bool m_moreFragment;
-
-        /**
-         * @brief The current fragments.
-         */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
+        FragmentReassembly m_reassembly;
 
         /**
          * @brief Timeout iterator to "event" handler
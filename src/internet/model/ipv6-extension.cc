@@ -611,10 +611,6 @@ Ipv6ExtensionFragment::GetFragments(Ptr<Packet> packet,
 
         ipv6Header.SetPayloadLength(fragment->GetSize());
 
-        std::ostringstream oss;
-        oss << ipv6Header;
-        fragment->Print(oss);
-
         listFragments.emplace_back(fragment, ipv6Header);
     } while (moreFragment);
 
@@ -709,7 +705,6 @@ Ipv6ExtensionFragment::HandleTimeout()
 }
 
 Ipv6ExtensionFragment::Fragments::Fragments()
-    : m_moreFragment(false)
 {
 }
 
@@ -723,22 +718,7 @@ Ipv6ExtensionFragment::Fragments::AddFragment(Ptr<Packet> fragment,
                                               bool moreFragment)
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
-    {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
-    }
-
-    if (it == m_packetFragments.end())
-    {
-        m_moreFragment = moreFragment;
-    }
-
-    m_packetFragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    m_reassembly.AddFragment(fragment, fragmentOffset, moreFragment);
 }
 
 void
@@ -751,38 +731,14 @@ Ipv6ExtensionFragment::Fragments::SetUnfragmentablePart(Ptr<Packet> unfragmentab
 bool
 Ipv6ExtensionFragment::Fragments::IsEntire() const
 {
-    bool ret = !m_moreFragment && !m_packetFragments.empty();
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
-        {
-            if (lastEndOffset != it->second)
-            {
-                ret = false;
-                break;
-            }
-
-            lastEndOffset += it->first->GetSize();
-        }
-    }
-
-    return ret;
+    // overlapping fragments are not allowed in IPv6 (RFC 8200, Section 4.5)
+    return m_reassembly.IsEntire() && !m_reassembly.HasOverlaps();
 }
 
 Ptr<Packet>
 Ipv6ExtensionFragment::Fragments::GetPacket() const
 {
-    Ptr<Packet> p = m_unfragmentable->Copy();
-
-    for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
-    {
-        p->AddAtEnd(it->first);
-    }
-
-    return p;
+    return m_reassembly.GetPacket(m_unfragmentable);
 }
 
 Ptr<Packet>
@@ -790,28 +746,12 @@ Ipv6ExtensionFragment::Fragments::GetPartialPacket() const
 {
     Ptr<Packet> p;
 
-    if (m_unfragmentable)
-    {
-        p = m_unfragmentable->Copy();
-    }
-    else
+    if (!m_unfragmentable)
     {
         return p;
     }
 
-    uint16_t lastEndOffset = 0;
-
-    for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
-    {
-        if (lastEndOffset != it->second)
-        {
-            break;
-        }
-        p->AddAtEnd(it->first);
-        lastEndOffset += it->first->GetSize();
-    }
-
-    return p;
+    return m_reassembly.GetPartialPacket(m_unfragmentable);
 }
 
 void
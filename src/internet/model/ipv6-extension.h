@@ -9,6 +9,7 @@
 #ifndef IPV6_EXTENSION_H
 #define IPV6_EXTENSION_H
 
+#include "fragment-reassembly.h"
 #include "ipv6-extension-header.h"
 #include "ipv6-header.h"
 #include "ipv6-interface.h"
@@ -389,14 +390,9 @@ class Ipv6ExtensionFragment : public Ipv6Extension
 
       private:
         /**
-         * @brief If other fragments will be sent.
+         * @brief The fragments received so far.
          */
-        bool m_moreFragment;
-
-        /**
-         * @brief The current fragments.
-         */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_packetFragments;
+        FragmentReassembly m_reassembly;
 
         /**
          * @brief The unfragmentable part.
@@ -53,11 +53,10 @@ void
 NdiscCache::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto& iter : m_ndCache)
-    {
-        delete iter.second; /* delete the pointer NdiscCache::Entry */
-    }
-    m_ndCache.clear();
+    m_ndCache.ForEach([](Ipv6Address, NdiscCache::Entry* entry) {
+        delete entry; /* delete the pointer NdiscCache::Entry */
+    });
+    m_ndCache.Clear();
     m_device = nullptr;
     m_interface = nullptr;
     m_icmpv6 = nullptr;
@@ -94,9 +93,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    NdiscCache::Entry* entry = m_ndCache.Find(dst);
+    if (entry)
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        entry->UpdateReachableState();
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -111,15 +111,14 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
-    {
-        NdiscCache::Entry* entry = (*i).second;
+    m_ndCache.ForEach([&](Ipv6Address, NdiscCache::Entry* entry) {
         if (entry->GetMacAddress() == dst)
         {
+            entry->UpdateReachableState();
             NS_LOG_LOGIC("Found an entry:" << (*entry));
             entryList.push_back(entry);
         }
-    }
+    });
     return entryList;
 }
 
@@ -127,11 +126,11 @@ NdiscCache::Entry*
 NdiscCache::Add(Ipv6Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    NS_ASSERT(m_ndCache.find(to) == m_ndCache.end());
+    NS_ASSERT(m_ndCache.Find(to) == nullptr);
 
     auto entry = new NdiscCache::Entry(this);
     entry->SetIpv6Address(to);
-    m_ndCache[to] = entry;
+    m_ndCache.Insert(to, entry);
     return entry;
 }
 
@@ -140,16 +139,26 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    Ipv6Address key = entry->GetIpv6Address();
+    if (m_ndCache.Find(key) != entry)
     {
-        if ((*i).second == entry)
+        // the address of the entry has been changed after its insertion
+        bool found = false;
+        m_ndCache.ForEach([&](Ipv6Address address, NdiscCache::Entry* e) {
+            if (e == entry)
+            {
+                key = address;
+                found = true;
+            }
+        });
+        if (!found)
         {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
             return;
         }
     }
+    m_ndCache.Erase(key);
+    entry->ClearWaitingPacket();
+    delete entry;
 }
 
 void
@@ -157,19 +166,12 @@ NdiscCache::Flush()
 {
     NS_LOG_FUNCTION(this);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end();)
-    {
-        if (!i->second->IsAutoGenerated())
-        {
-            i->second->ClearWaitingPacket();
-            delete i->second;
-            i = m_ndCache.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    m_ndCache.EraseIf(
+        [](Ipv6Address, NdiscCache::Entry* entry) { return !entry->IsAutoGenerated(); },
+        [](NdiscCache::Entry* entry) {
+            entry->ClearWaitingPacket();
+            delete entry;
+        });
 }
 
 void
@@ -192,8 +194,11 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries in address order, regardless of the table layout
+    auto entries = m_ndCache.GetSortedEntries();
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
+        i->second->UpdateReachableState();
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
         if (!Names::FindName(m_device).empty())
@@ -297,6 +302,24 @@ NdiscCache::Entry::FunctionReachableTimeout()
     this->MarkStale();
 }
 
+bool
+NdiscCache::Entry::IsReachableExpired() const
+{
+    return m_state == REACHABLE && m_ndCache->m_icmpv6 &&
+           Simulator::Now() >=
+               m_lastReachabilityConfirmation + m_ndCache->m_icmpv6->GetReachableTime();
+}
+
+void
+NdiscCache::Entry::UpdateReachableState()
+{
+    NS_LOG_FUNCTION(this);
+    if (IsReachableExpired())
+    {
+        FunctionReachableTimeout();
+    }
+}
+
 void
 NdiscCache::Entry::FunctionRetransmitTimeout()
 {
@@ -475,9 +498,6 @@ NdiscCache::Entry::StartReachableTimer()
     }
 
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
 }
 
 void
@@ -485,14 +505,10 @@ NdiscCache::Entry::UpdateReachableTimer()
 {
     NS_LOG_FUNCTION(this);
 
+    UpdateReachableState();
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
-        {
-            m_nudTimer.Cancel();
-        }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -624,14 +640,14 @@ bool
 NdiscCache::Entry::IsStale() const
 {
     NS_LOG_FUNCTION(this);
-    return (m_state == STALE);
+    return (m_state == STALE) || IsReachableExpired();
 }
 
 bool
 NdiscCache::Entry::IsReachable() const
 {
     NS_LOG_FUNCTION(this);
-    return (m_state == REACHABLE);
+    return (m_state == REACHABLE) && !IsReachableExpired();
 }
 
 bool
@@ -717,19 +733,12 @@ void
 NdiscCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end();)
-    {
-        if (i->second->IsAutoGenerated())
-        {
-            i->second->ClearWaitingPacket();
-            delete i->second;
-            i = m_ndCache.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    m_ndCache.EraseIf(
+        [](Ipv6Address, NdiscCache::Entry* entry) { return entry->IsAutoGenerated(); },
+        [](NdiscCache::Entry* entry) {
+            entry->ClearWaitingPacket();
+            delete entry;
+        });
 }
 
 std::ostream&
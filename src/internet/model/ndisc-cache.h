@@ -9,6 +9,8 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "neighbor-cache-table.h"
+
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -18,7 +20,6 @@
 #include "ns3/timer.h"
 
 #include <list>
-#include <map>
 #include <stdint.h>
 
 namespace ns3
@@ -324,6 +325,10 @@ class NdiscCache : public Object
 
         /**
          * @brief Start the reachable timer.
+         *
+         * No event is scheduled: the REACHABLE state expires lazily, i.e.,
+         * the entry is turned into STALE the first time it is looked up
+         * after ReachableTime since the last reachability confirmation.
          */
         void StartReachableTimer();
 
@@ -332,6 +337,12 @@ class NdiscCache : public Object
          */
         void UpdateReachableTimer();
 
+        /**
+         * @brief Apply the REACHABLE to STALE transition if the reachable
+         * time has elapsed since the last reachability confirmation.
+         */
+        void UpdateReachableState();
+
         /**
          * @brief Start retransmit timer.
          */
@@ -427,7 +438,13 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * @brief Timer (used for NUD).
+         * @brief Check whether the REACHABLE state has expired.
+         * @return true if the reachable time has elapsed
+         */
+        bool IsReachableExpired() const;
+
+        /**
+         * @brief Timer (used for NUD in the DELAY, PROBE and INCOMPLETE states).
          */
         Timer m_nudTimer;
 
@@ -451,11 +468,7 @@ class NdiscCache : public Object
     /**
      * @brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
-    /**
-     * @brief Neighbor Discovery Cache container iterator
-     */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef NeighborCacheTable<Ipv6Address, NdiscCache::Entry, Ipv6AddressHash> Cache;
 
     /**
      * @brief A list of Entry.
@@ -0,0 +1,292 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NEIGHBOR_CACHE_TABLE_H
+#define NEIGHBOR_CACHE_TABLE_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ * @brief Flat, open-addressing table mapping L3 addresses to neighbor cache entries.
+ *
+ * ArpCache and NdiscCache used to rely on node-based maps, which need one
+ * heap allocation per neighbor and a pointer chase per tree level on every
+ * lookup. This table stores (key, entry pointer) pairs contiguously in a
+ * power-of-two sized array and resolves collisions with linear probing, so a
+ * lookup usually touches a single cache line. Deletion uses backward shifting,
+ * hence no tombstones are ever left behind.
+ *
+ * The table does not own the entries it points to. Iteration follows the slot
+ * order, which is deterministic but unrelated to the address order; use
+ * GetSortedEntries() when the address order is observable (e.g., printing).
+ *
+ * @tparam Key the L3 address type (Ipv4Address or Ipv6Address)
+ * @tparam T the entry type
+ * @tparam Hash the hash functor for Key (Ipv4AddressHash or Ipv6AddressHash)
+ */
+template <typename Key, typename T, typename Hash>
+class NeighborCacheTable
+{
+  public:
+    NeighborCacheTable()
+        : m_size(0)
+    {
+    }
+
+    /**
+     * @brief Find the entry associated with the given key.
+     * @param key the key
+     * @return the entry, or nullptr if the key is not in the table
+     */
+    T* Find(const Key& key) const
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = GetHome(key);; i = (i + 1) & mask)
+        {
+            const Slot& slot = m_slots[i];
+            if (slot.value == nullptr)
+            {
+                return nullptr;
+            }
+            if (slot.key == key)
+            {
+                return slot.value;
+            }
+        }
+    }
+
+    /**
+     * @brief Insert a new entry. The key must not be in the table already.
+     * @param key the key
+     * @param value the entry (not null)
+     */
+    void Insert(const Key& key, T* value)
+    {
+        NS_ASSERT(value != nullptr);
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            Rehash(std::max<std::size_t>(MIN_CAPACITY, m_slots.size() * 2));
+        }
+        DoInsert(key, value);
+        m_size++;
+    }
+
+    /**
+     * @brief Remove the entry associated with the given key.
+     * @param key the key
+     * @return the removed entry, or nullptr if the key is not in the table
+     */
+    T* Erase(const Key& key)
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t i = GetHome(key);
+        while (m_slots[i].value != nullptr && !(m_slots[i].key == key))
+        {
+            i = (i + 1) & mask;
+        }
+        T* value = m_slots[i].value;
+        if (value == nullptr)
+        {
+            return nullptr;
+        }
+        // backward shift the following entries of the cluster, if needed
+        for (std::size_t j = (i + 1) & mask; m_slots[j].value != nullptr; j = (j + 1) & mask)
+        {
+            std::size_t home = GetHome(m_slots[j].key);
+            // the entry in j can be moved to i only if its home is not in (i, j]
+            bool homeInRange = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!homeInRange)
+            {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i] = Slot();
+        m_size--;
+        return value;
+    }
+
+    /**
+     * @brief Remove all the entries satisfying the given predicate.
+     * @param pred the predicate, invoked with the key and the entry
+     * @param removed the functor invoked on each removed entry
+     */
+    template <typename Pred, typename Removed>
+    void EraseIf(Pred pred, Removed removed)
+    {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.assign(old.size(), Slot());
+        m_size = 0;
+        for (auto& slot : old)
+        {
+            if (slot.value == nullptr)
+            {
+                continue;
+            }
+            if (pred(slot.key, slot.value))
+            {
+                removed(slot.value);
+            }
+            else
+            {
+                DoInsert(slot.key, slot.value);
+                m_size++;
+            }
+        }
+    }
+
+    /**
+     * @brief Invoke the given functor on every entry, in slot order.
+     *
+     * The table must not be modified while iterating.
+     *
+     * @param f the functor, invoked with the key and the entry
+     */
+    template <typename F>
+    void ForEach(F f) const
+    {
+        for (const auto& slot : m_slots)
+        {
+            if (slot.value != nullptr)
+            {
+                f(slot.key, slot.value);
+            }
+        }
+    }
+
+    /**
+     * @brief Get a copy of the table content sorted by key.
+     * @return the (key, entry) pairs sorted by key
+     */
+    std::vector<std::pair<Key, T*>> GetSortedEntries() const
+    {
+        std::vector<std::pair<Key, T*>> entries;
+        entries.reserve(m_size);
+        ForEach([&entries](const Key& key, T* value) { entries.emplace_back(key, value); });
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        return entries;
+    }
+
+    /**
+     * @brief Make room for the given number of entries without rehashing.
+     * @param n the number of entries
+     */
+    void Reserve(std::size_t n)
+    {
+        std::size_t capacity = MIN_CAPACITY;
+        while (capacity < n * 2)
+        {
+            capacity *= 2;
+        }
+        if (capacity > m_slots.size())
+        {
+            Rehash(capacity);
+        }
+    }
+
+    /**
+     * @brief Remove all the entries (the entries are not deleted).
+     */
+    void Clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @return the number of entries in the table
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+  private:
+    /// A table slot; a null value marks an empty slot
+    struct Slot
+    {
+        Key key;            //!< the key
+        T* value{nullptr};  //!< the entry
+    };
+
+    static constexpr std::size_t MIN_CAPACITY = 8; //!< initial number of slots
+
+    /**
+     * @brief Get the preferred slot for a key.
+     *
+     * The address hashes may be weak (e.g., identity for IPv4), hence they
+     * are spread with a Fibonacci multiplicative step before masking.
+     *
+     * @param key the key
+     * @return the index of the preferred slot
+     */
+    std::size_t GetHome(const Key& key) const
+    {
+        uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(h >> 32) & (m_slots.size() - 1);
+    }
+
+    /**
+     * @brief Place an entry in the first free slot of its probe sequence.
+     * @param key the key
+     * @param value the entry
+     */
+    void DoInsert(const Key& key, T* value)
+    {
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t i = GetHome(key);
+        while (m_slots[i].value != nullptr)
+        {
+            NS_ASSERT_MSG(!(m_slots[i].key == key), "Key already in the neighbor cache");
+            i = (i + 1) & mask;
+        }
+        m_slots[i].key = key;
+        m_slots[i].value = value;
+    }
+
+    /**
+     * @brief Resize the slot array and re-insert all the entries.
+     * @param capacity the new number of slots (a power of two)
+     */
+    void Rehash(std::size_t capacity)
+    {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.assign(capacity, Slot());
+        for (const auto& slot : old)
+        {
+            if (slot.value != nullptr)
+            {
+                DoInsert(slot.key, slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots; //!< the slots
+    std::size_t m_size;        //!< number of entries
+};
+
+} // namespace ns3
+
+#endif /* NEIGHBOR_CACHE_TABLE_H */
@@ -23,7 +23,10 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <tuple>
+#include <vector>
 
 #define RIP_ALL_NODE "224.0.0.9"
 #define RIP_PORT 520
@@ -586,6 +589,9 @@ Rip::DoDispose()
         delete j->first;
     }
     m_routes.clear();
+    m_routeIndex.clear();
+    m_masks.clear();
+    m_changedRoutes.clear();
 
     m_nextTriggeredUpdate.Cancel();
     m_nextUnsolicitedUpdate.Cancel();
@@ -612,7 +618,6 @@ Rip::Lookup(Ipv4Address dst, bool setSource, Ptr<NetDevice> interface)
     NS_LOG_FUNCTION(this << dst << interface);
 
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
 
     /* when sending on local multicast, there have to be interface specified */
     if (dst.IsLocalMulticast())
@@ -628,57 +633,51 @@ Rip::Lookup(Ipv4Address dst, bool setSource, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    // search the masks from the longest one, the first valid match is the longest
+    for (const auto& [maskValue, count] : m_masks)
     {
-        RipRoutingTableEntry* j = it->first;
+        Ipv4Mask mask(maskValue);
+        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length "
+                                               << mask.GetPrefixLength());
 
-        if (j->GetRouteStatus() == RipRoutingTableEntry::RIP_VALID)
+        RipRoutingTableEntry* route = nullptr;
+        auto range = m_routeIndex.equal_range({dst.CombineMask(mask), maskValue});
+        for (auto it = range.first; it != range.second; it++)
         {
-            Ipv4Mask mask = j->GetDestNetworkMask();
-            uint16_t maskLen = mask.GetPrefixLength();
-            Ipv4Address entry = j->GetDestNetwork();
-
-            NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen);
-
-            if (mask.IsMatch(dst, entry))
+            RipRoutingTableEntry* j = it->second->first;
+            /* if interface is given, check the route will output on this interface */
+            if (j->GetRouteStatus() == RipRoutingTableEntry::RIP_VALID &&
+                (!interface || interface == m_ipv4->GetNetDevice(j->GetInterface())))
             {
-                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << maskLen);
-
-                /* if interface is given, check the route will output on this interface */
-                if (!interface || interface == m_ipv4->GetNetDevice(j->GetInterface()))
-                {
-                    if (maskLen < longestMask)
-                    {
-                        NS_LOG_LOGIC("Previous match longer, skipping");
-                        continue;
-                    }
-
-                    longestMask = maskLen;
-
-                    Ipv4RoutingTableEntry* route = j;
-                    uint32_t interfaceIdx = route->GetInterface();
-                    rtentry = Create<Ipv4Route>();
+                NS_LOG_LOGIC("Found global network route " << j);
+                route = j;
+            }
+        }
+        if (!route)
+        {
+            continue;
+        }
 
-                    if (setSource)
-                    {
-                        if (route->GetDest().IsAny()) /* default route */
-                        {
-                            rtentry->SetSource(
-                                m_ipv4->SourceAddressSelection(interfaceIdx, route->GetGateway()));
-                        }
-                        else
-                        {
-                            rtentry->SetSource(
-                                m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                        }
-                    }
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
 
-                    rtentry->SetDestination(route->GetDest());
-                    rtentry->SetGateway(route->GetGateway());
-                    rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-                }
+        if (setSource)
+        {
+            if (route->GetDest().IsAny()) /* default route */
+            {
+                rtentry->SetSource(
+                    m_ipv4->SourceAddressSelection(interfaceIdx, route->GetGateway()));
+            }
+            else
+            {
+                rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
             }
         }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
+        break;
     }
 
     if (rtentry)
@@ -700,9 +699,9 @@ Rip::AddNetworkRouteTo(Ipv4Address network,
     auto route = new RipRoutingTableEntry(network, networkPrefix, nextHop, interface);
     route->SetRouteMetric(1);
     route->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
-    route->SetRouteChanged(true);
 
-    m_routes.emplace_back(route, EventId());
+    InsertRoute(route, false);
+    MarkRouteChanged(route);
 }
 
 void
@@ -713,9 +712,9 @@ Rip::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkPrefix, uint32_t int
     auto route = new RipRoutingTableEntry(network, networkPrefix, interface);
     route->SetRouteMetric(1);
     route->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
-    route->SetRouteChanged(true);
 
-    m_routes.emplace_back(route, EventId());
+    InsertRoute(route, false);
+    MarkRouteChanged(route);
 }
 
 void
@@ -723,23 +722,17 @@ Rip::InvalidateRoute(RipRoutingTableEntry* route)
 {
     NS_LOG_FUNCTION(this << *route);
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    auto it = FindRoute(route);
+    NS_ABORT_MSG_IF(it == m_routes.end(), "RIP::InvalidateRoute - cannot find the route to update");
+
+    route->SetRouteStatus(RipRoutingTableEntry::RIP_INVALID);
+    route->SetRouteMetric(m_linkDown);
+    MarkRouteChanged(route);
+    if (it->second.IsPending())
     {
-        if (it->first == route)
-        {
-            route->SetRouteStatus(RipRoutingTableEntry::RIP_INVALID);
-            route->SetRouteMetric(m_linkDown);
-            route->SetRouteChanged(true);
-            if (it->second.IsPending())
-            {
-                it->second.Cancel();
-            }
-            it->second =
-                Simulator::Schedule(m_garbageCollectionDelay, &Rip::DeleteRoute, this, route);
-            return;
-        }
+        it->second.Cancel();
     }
-    NS_ABORT_MSG("RIP::InvalidateRoute - cannot find the route to update");
+    it->second = Simulator::Schedule(m_garbageCollectionDelay, &Rip::DeleteRoute, this, route);
 }
 
 void
@@ -747,18 +740,81 @@ Rip::DeleteRoute(RipRoutingTableEntry* route)
 {
     NS_LOG_FUNCTION(this << *route);
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    RouteKey_t key = GetRouteKey(route);
+    auto range = m_routeIndex.equal_range(key);
+    for (auto index = range.first; index != range.second; index++)
     {
-        if (it->first == route)
+        if (index->second->first == route)
         {
+            m_routes.erase(index->second);
+            m_routeIndex.erase(index);
+            if (--m_masks[key.second] == 0)
+            {
+                m_masks.erase(key.second);
+            }
             delete route;
-            m_routes.erase(it);
             return;
         }
     }
     NS_ABORT_MSG("RIP::DeleteRoute - cannot find the route to delete");
 }
 
+Rip::RouteKey_t
+Rip::GetRouteKey(const RipRoutingTableEntry* route)
+{
+    Ipv4Mask mask = route->GetDestNetworkMask();
+    return {route->GetDestNetwork().CombineMask(mask), mask.Get()};
+}
+
+Rip::RoutesI
+Rip::InsertRoute(RipRoutingTableEntry* route, bool front)
+{
+    RoutesI it = front ? m_routes.emplace(m_routes.begin(), route, EventId())
+                       : m_routes.emplace(m_routes.end(), route, EventId());
+    RouteKey_t key = GetRouteKey(route);
+    m_routeIndex.emplace(key, it);
+    m_masks[key.second]++;
+    return it;
+}
+
+Rip::RoutesI
+Rip::FindRoute(RipRoutingTableEntry* route)
+{
+    auto range = m_routeIndex.equal_range(GetRouteKey(route));
+    for (auto index = range.first; index != range.second; index++)
+    {
+        if (index->second->first == route)
+        {
+            return index->second;
+        }
+    }
+    return m_routes.end();
+}
+
+void
+Rip::MarkRouteChanged(RipRoutingTableEntry* route)
+{
+    route->SetRouteChanged(true);
+    m_changedRoutes.insert(GetRouteKey(route));
+}
+
+void
+Rip::SendResponse(Ptr<Socket> socket,
+                  RipHeader& hdr,
+                  const InetSocketAddress& destination,
+                  uint8_t ttl)
+{
+    // a new packet for each Response, instead of removing (and parsing) the previous header
+    Ptr<Packet> p = Create<Packet>();
+    SocketIpTtlTag tag;
+    tag.SetTtl(ttl);
+    p->AddPacketTag(tag);
+    p->AddHeader(hdr);
+    NS_LOG_DEBUG("SendTo: " << *p);
+    socket->SendTo(p, 0, destination);
+    hdr.ClearRtes();
+}
+
 void
 Rip::Receive(Ptr<Socket> socket)
 {
@@ -874,18 +930,8 @@ Rip::HandleRequests(RipHeader requestHdr,
                      RipHeader().GetSerializedSize()) /
                     RipRte().GetSerializedSize();
 
-                Ptr<Packet> p = Create<Packet>();
-                SocketIpTtlTag tag;
-                p->RemovePacketTag(tag);
-                if (senderAddress == Ipv4Address(RIP_ALL_NODE))
-                {
-                    tag.SetTtl(1);
-                }
-                else
-                {
-                    tag.SetTtl(255);
-                }
-                p->AddPacketTag(tag);
+                uint8_t ttl = (senderAddress == Ipv4Address(RIP_ALL_NODE)) ? 1 : 255;
+                InetSocketAddress destination(senderAddress, RIP_PORT);
 
                 RipHeader hdr;
                 hdr.SetCommand(RipHeader::RESPONSE);
@@ -927,18 +973,12 @@ Rip::HandleRequests(RipHeader requestHdr,
                     }
                     if (hdr.GetRteNumber() == maxRte)
                     {
-                        p->AddHeader(hdr);
-                        NS_LOG_DEBUG("SendTo: " << *p);
-                        sendingSocket->SendTo(p, 0, InetSocketAddress(senderAddress, RIP_PORT));
-                        p->RemoveHeader(hdr);
-                        hdr.ClearRtes();
+                        SendResponse(sendingSocket, hdr, destination, ttl);
                     }
                 }
                 if (hdr.GetRteNumber() > 0)
                 {
-                    p->AddHeader(hdr);
-                    NS_LOG_DEBUG("SendTo: " << *p);
-                    sendingSocket->SendTo(p, 0, InetSocketAddress(senderAddress, RIP_PORT));
+                    SendResponse(sendingSocket, hdr, destination, ttl);
                 }
             }
         }
@@ -966,23 +1006,22 @@ Rip::HandleRequests(RipHeader requestHdr,
         for (auto iter = rtes.begin(); iter != rtes.end(); iter++)
         {
             bool found = false;
-            for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+            Ipv4Address requestedAddress = iter->GetPrefix();
+            requestedAddress.CombineMask(iter->GetSubnetMask());
+            for (auto maskIter = m_masks.begin(); maskIter != m_masks.end() && !found; maskIter++)
             {
-                Ipv4InterfaceAddress rtDestAddr =
-                    Ipv4InterfaceAddress(rtIter->first->GetDestNetwork(),
-                                         rtIter->first->GetDestNetworkMask());
-                if ((rtDestAddr.GetScope() == Ipv4InterfaceAddress::GLOBAL) &&
-                    (rtIter->first->GetRouteStatus() == RipRoutingTableEntry::RIP_VALID))
+                auto range = m_routeIndex.equal_range({requestedAddress, maskIter->first});
+                for (auto index = range.first; index != range.second; index++)
                 {
-                    Ipv4Address requestedAddress = iter->GetPrefix();
-                    requestedAddress.CombineMask(iter->GetSubnetMask());
-                    Ipv4Address rtAddress = rtIter->first->GetDestNetwork();
-                    rtAddress.CombineMask(rtIter->first->GetDestNetworkMask());
-
-                    if (requestedAddress == rtAddress)
+                    RipRoutingTableEntry* route = index->second->first;
+                    Ipv4InterfaceAddress rtDestAddr =
+                        Ipv4InterfaceAddress(route->GetDestNetwork(),
+                                             route->GetDestNetworkMask());
+                    if ((rtDestAddr.GetScope() == Ipv4InterfaceAddress::GLOBAL) &&
+                        (route->GetRouteStatus() == RipRoutingTableEntry::RIP_VALID))
                     {
-                        iter->SetRouteMetric(rtIter->first->GetRouteMetric());
-                        iter->SetRouteTag(rtIter->first->GetRouteTag());
+                        iter->SetRouteMetric(route->GetRouteMetric());
+                        iter->SetRouteTag(route->GetRouteTag());
                         hdr.AddRte(*iter);
                         found = true;
                         break;
@@ -1056,12 +1095,12 @@ Rip::HandleResponses(RipHeader hdr,
             rteMetric = m_linkDown;
         }
 
-        RoutesI it;
         bool found = false;
-        for (it = m_routes.begin(); it != m_routes.end(); it++)
+        auto range = m_routeIndex.equal_range({rteAddr, rtePrefixMask.Get()});
+        for (auto index = range.first; index != range.second; index++)
         {
-            if (it->first->GetDestNetwork() == rteAddr &&
-                it->first->GetDestNetworkMask() == rtePrefixMask)
+            RoutesI it = index->second;
+            if (it->first->GetDestNetwork() == rteAddr)
             {
                 found = true;
                 if (rteMetric < it->first->GetRouteMetric())
@@ -1078,7 +1117,7 @@ Rip::HandleResponses(RipHeader hdr,
                     it->first->SetRouteMetric(rteMetric);
                     it->first->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
                     it->first->SetRouteTag(iter->GetRouteTag());
-                    it->first->SetRouteChanged(true);
+                    MarkRouteChanged(it->first);
                     it->second.Cancel();
                     it->second =
                         Simulator::Schedule(m_timeoutDelay, &Rip::InvalidateRoute, this, it->first);
@@ -1105,9 +1144,9 @@ Rip::HandleResponses(RipHeader hdr,
                             route->SetRouteMetric(rteMetric);
                             route->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
                             route->SetRouteTag(iter->GetRouteTag());
-                            route->SetRouteChanged(true);
                             delete it->first;
                             it->first = route;
+                            MarkRouteChanged(route);
                             it->second.Cancel();
                             it->second = Simulator::Schedule(m_timeoutDelay,
                                                              &Rip::InvalidateRoute,
@@ -1126,7 +1165,7 @@ Rip::HandleResponses(RipHeader hdr,
                         it->first->SetRouteMetric(rteMetric);
                         it->first->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
                         it->first->SetRouteTag(iter->GetRouteTag());
-                        it->first->SetRouteChanged(true);
+                        MarkRouteChanged(it->first);
                         it->second.Cancel();
                         it->second = Simulator::Schedule(m_timeoutDelay,
                                                          &Rip::InvalidateRoute,
@@ -1149,11 +1188,9 @@ Rip::HandleResponses(RipHeader hdr,
                 new RipRoutingTableEntry(rteAddr, rtePrefixMask, senderAddress, incomingInterface);
             route->SetRouteMetric(rteMetric);
             route->SetRouteStatus(RipRoutingTableEntry::RIP_VALID);
-            route->SetRouteChanged(true);
-            m_routes.emplace_front(route, EventId());
-            EventId invalidateEvent =
-                Simulator::Schedule(m_timeoutDelay, &Rip::InvalidateRoute, this, route);
-            (m_routes.begin())->second = invalidateEvent;
+            RoutesI it = InsertRoute(route, true);
+            MarkRouteChanged(route);
+            it->second = Simulator::Schedule(m_timeoutDelay, &Rip::InvalidateRoute, this, route);
             changed = true;
         }
     }
@@ -1169,6 +1206,55 @@ Rip::DoSendRouteUpdate(bool periodic)
 {
     NS_LOG_FUNCTION(this << (periodic ? " periodic" : " triggered"));
 
+    // the routes to advertise: all of them for a periodic update, only the
+    // changed ones (found through the index) for a triggered update
+    std::vector<RipRoutingTableEntry*> routes;
+    if (periodic)
+    {
+        for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+        {
+            routes.push_back(rtIter->first);
+        }
+    }
+    else
+    {
+        for (const auto& key : m_changedRoutes)
+        {
+            auto range = m_routeIndex.equal_range(key);
+            for (auto index = range.first; index != range.second; index++)
+            {
+                if (index->second->first->IsRouteChanged())
+                {
+                    routes.push_back(index->second->first);
+                }
+            }
+        }
+    }
+
+    // the RTEs are built once, and filtered for each interface
+    std::vector<std::tuple<RipRoutingTableEntry*, RipRte, bool>> candidates;
+    candidates.reserve(routes.size());
+    for (auto route : routes)
+    {
+        Ipv4InterfaceAddress rtDestAddr =
+            Ipv4InterfaceAddress(route->GetDestNetwork(), route->GetDestNetworkMask());
+
+        NS_LOG_DEBUG("Processing RT " << rtDestAddr << " " << int(route->IsRouteChanged()));
+
+        bool isGlobal = (rtDestAddr.GetScope() == Ipv4InterfaceAddress::GLOBAL);
+        bool isDefaultRoute = ((route->GetDestNetwork() == Ipv4Address::GetAny()) &&
+                               (route->GetDestNetworkMask() == Ipv4Mask::GetZero()));
+        if (isGlobal || isDefaultRoute)
+        {
+            RipRte rte;
+            rte.SetPrefix(route->GetDestNetwork());
+            rte.SetSubnetMask(route->GetDestNetworkMask());
+            rte.SetRouteMetric(route->GetRouteMetric());
+            rte.SetRouteTag(route->GetRouteTag());
+            candidates.emplace_back(route, rte, isGlobal);
+        }
+    }
+
     for (auto iter = m_unicastSocketList.begin(); iter != m_unicastSocketList.end(); iter++)
     {
         uint32_t interface = iter->second;
@@ -1180,83 +1266,54 @@ Rip::DoSendRouteUpdate(bool periodic)
                                UdpHeader().GetSerializedSize() - RipHeader().GetSerializedSize()) /
                               RipRte().GetSerializedSize();
 
-            Ptr<Packet> p = Create<Packet>();
-            SocketIpTtlTag tag;
-            tag.SetTtl(1);
-            p->AddPacketTag(tag);
+            std::vector<Ipv4Address> networks;
+            for (uint32_t index = 0; index < m_ipv4->GetNAddresses(interface); index++)
+            {
+                Ipv4InterfaceAddress addr = m_ipv4->GetAddress(interface, index);
+                networks.push_back(addr.GetLocal().CombineMask(addr.GetMask()));
+            }
 
             RipHeader hdr;
             hdr.SetCommand(RipHeader::RESPONSE);
+            InetSocketAddress destination(RIP_ALL_NODE, RIP_PORT);
 
-            for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+            for (const auto& [route, rte, isGlobal] : candidates)
             {
-                bool splitHorizoning = (rtIter->first->GetInterface() == interface);
-                Ipv4InterfaceAddress rtDestAddr =
-                    Ipv4InterfaceAddress(rtIter->first->GetDestNetwork(),
-                                         rtIter->first->GetDestNetworkMask());
-
-                NS_LOG_DEBUG("Processing RT " << rtDestAddr << " "
-                                              << int(rtIter->first->IsRouteChanged()));
-
-                bool isGlobal = (rtDestAddr.GetScope() == Ipv4InterfaceAddress::GLOBAL);
-                bool isDefaultRoute =
-                    ((rtIter->first->GetDestNetwork() == Ipv4Address::GetAny()) &&
-                     (rtIter->first->GetDestNetworkMask() == Ipv4Mask::GetZero()) &&
-                     (rtIter->first->GetInterface() != interface));
-
-                bool sameNetwork = false;
-                for (uint32_t index = 0; index < m_ipv4->GetNAddresses(interface); index++)
-                {
-                    Ipv4InterfaceAddress addr = m_ipv4->GetAddress(interface, index);
-                    if (addr.GetLocal().CombineMask(addr.GetMask()) ==
-                        rtIter->first->GetDestNetwork())
-                    {
-                        sameNetwork = true;
-                    }
-                }
+                bool splitHorizoning = (route->GetInterface() == interface);
+                bool sameNetwork = std::find(networks.begin(),
+                                             networks.end(),
+                                             route->GetDestNetwork()) != networks.end();
 
-                if ((isGlobal || isDefaultRoute) && (periodic || rtIter->first->IsRouteChanged()) &&
-                    !sameNetwork)
+                // non-global candidates are default routes, not sent on their own interface
+                if ((isGlobal || !splitHorizoning) && !sameNetwork)
                 {
-                    RipRte rte;
-                    rte.SetPrefix(rtIter->first->GetDestNetwork());
-                    rte.SetSubnetMask(rtIter->first->GetDestNetworkMask());
+                    RipRte interfaceRte = rte;
                     if (m_splitHorizonStrategy == POISON_REVERSE && splitHorizoning)
                     {
-                        rte.SetRouteMetric(m_linkDown);
-                    }
-                    else
-                    {
-                        rte.SetRouteMetric(rtIter->first->GetRouteMetric());
+                        interfaceRte.SetRouteMetric(m_linkDown);
                     }
-                    rte.SetRouteTag(rtIter->first->GetRouteTag());
                     if ((m_splitHorizonStrategy == SPLIT_HORIZON && !splitHorizoning) ||
                         (m_splitHorizonStrategy != SPLIT_HORIZON))
                     {
-                        hdr.AddRte(rte);
+                        hdr.AddRte(interfaceRte);
                     }
                 }
                 if (hdr.GetRteNumber() == maxRte)
                 {
-                    p->AddHeader(hdr);
-                    NS_LOG_DEBUG("SendTo: " << *p);
-                    iter->first->SendTo(p, 0, InetSocketAddress(RIP_ALL_NODE, RIP_PORT));
-                    p->RemoveHeader(hdr);
-                    hdr.ClearRtes();
+                    SendResponse(iter->first, hdr, destination, 1);
                 }
             }
             if (hdr.GetRteNumber() > 0)
             {
-                p->AddHeader(hdr);
-                NS_LOG_DEBUG("SendTo: " << *p);
-                iter->first->SendTo(p, 0, InetSocketAddress(RIP_ALL_NODE, RIP_PORT));
+                SendResponse(iter->first, hdr, destination, 1);
             }
         }
     }
-    for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+    for (auto route : routes)
     {
-        rtIter->first->SetRouteChanged(false);
+        route->SetRouteChanged(false);
     }
+    m_changedRoutes.clear();
 }
 
 void
@@ -18,7 +18,11 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/random-variable-stream.h"
 
+#include <functional>
 #include <list>
+#include <map>
+#include <set>
+#include <utility>
 
 namespace ns3
 {
@@ -272,6 +276,9 @@ class Rip : public Ipv4RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<RipRoutingTableEntry*, EventId>>::iterator RoutesI;
 
+    /// Key of the route index: network address (masked) and network mask
+    typedef std::pair<Ipv4Address, uint32_t> RouteKey_t;
+
     /**
      * @brief Receive RIP packets.
      *
@@ -380,7 +387,50 @@ class Rip : public Ipv4RoutingProtocol
      */
     void DeleteRoute(RipRoutingTableEntry* route);
 
+    /**
+     * @brief Get the key of a route in the route index.
+     * @param route the route
+     * @return the key
+     */
+    static RouteKey_t GetRouteKey(const RipRoutingTableEntry* route);
+
+    /**
+     * @brief Insert a route in the forwarding table and in the route index.
+     * @param route the route
+     * @param front true to insert the route at the beginning of the table
+     * @return the position of the route in the table
+     */
+    RoutesI InsertRoute(RipRoutingTableEntry* route, bool front);
+
+    /**
+     * @brief Find a route in the forwarding table through the route index.
+     * @param route the route
+     * @return the position of the route, or the end of the table if not found
+     */
+    RoutesI FindRoute(RipRoutingTableEntry* route);
+
+    /**
+     * @brief Mark a route as changed, so that the next triggered update includes it.
+     * @param route the route
+     */
+    void MarkRouteChanged(RipRoutingTableEntry* route);
+
+    /**
+     * @brief Send a Response and clear the RTEs of its header.
+     * @param socket the socket
+     * @param hdr the header of the Response
+     * @param destination the destination
+     * @param ttl the TTL of the packet
+     */
+    void SendResponse(Ptr<Socket> socket,
+                      RipHeader& hdr,
+                      const InetSocketAddress& destination,
+                      uint8_t ttl);
+
     Routes m_routes;                //!<  the forwarding table for network.
+    std::multimap<RouteKey_t, RoutesI> m_routeIndex; //!< the routes, by destination
+    std::map<uint32_t, uint32_t, std::greater<>> m_masks; //!< route count by mask, longest first
+    std::set<RouteKey_t> m_changedRoutes; //!< destinations changed since the last update
     Ptr<Ipv4> m_ipv4;               //!< IPv4 reference
     Time m_startupDelay;            //!< Random delay before protocol startup.
     Time m_minTriggeredUpdateDelay; //!< Min cooldown delay after a Triggered Update.
@@ -24,6 +24,8 @@
 #include "ns3/uinteger.h"
 
 #include <iomanip>
+#include <tuple>
+#include <vector>
 
 #define RIPNG_ALL_NODE "ff02::9"
 #define RIPNG_PORT 521
@@ -570,6 +572,9 @@ RipNg::DoDispose()
         delete j->first;
     }
     m_routes.clear();
+    m_routeIndex.clear();
+    m_prefixLengths.clear();
+    m_changedRoutes.clear();
 
     m_nextTriggeredUpdate.Cancel();
     m_nextUnsolicitedUpdate.Cancel();
@@ -596,7 +601,6 @@ RipNg::Lookup(Ipv6Address dst, bool setSource, Ptr<NetDevice> interface)
     NS_LOG_FUNCTION(this << dst << interface);
 
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -613,64 +617,57 @@ RipNg::Lookup(Ipv6Address dst, bool setSource, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    // search the prefixes from the longest one, the first valid match is the longest
+    for (const auto& [prefixLength, count] : m_prefixLengths)
     {
-        RipNgRoutingTableEntry* j = it->first;
+        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << int(prefixLength));
 
-        if (j->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID)
+        RipNgRoutingTableEntry* route = nullptr;
+        auto range =
+            m_routeIndex.equal_range({dst.CombinePrefix(Ipv6Prefix(prefixLength)), prefixLength});
+        for (auto it = range.first; it != range.second; it++)
         {
-            Ipv6Prefix mask = j->GetDestNetworkPrefix();
-            uint16_t maskLen = mask.GetPrefixLength();
-            Ipv6Address entry = j->GetDestNetwork();
-
-            NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen);
-
-            if (mask.IsMatch(dst, entry))
+            RipNgRoutingTableEntry* j = it->second->first;
+            /* if interface is given, check the route will output on this interface */
+            if (j->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID &&
+                (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface())))
             {
-                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << maskLen);
-
-                /* if interface is given, check the route will output on this interface */
-                if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
-                {
-                    if (maskLen < longestMask)
-                    {
-                        NS_LOG_LOGIC("Previous match longer, skipping");
-                        continue;
-                    }
-
-                    longestMask = maskLen;
-
-                    Ipv6RoutingTableEntry* route = j;
-                    uint32_t interfaceIdx = route->GetInterface();
-                    rtentry = Create<Ipv6Route>();
+                NS_LOG_LOGIC("Found global network route " << j);
+                route = j;
+            }
+        }
+        if (!route)
+        {
+            continue;
+        }
 
-                    if (setSource)
-                    {
-                        // GetGateway().IsAny() means that the destination is reachable without a
-                        // gateway (is on-link). GetDest().IsAny() means that the route is the
-                        // default route. Having both true is very strange, but possible.
-                        // If the RT entry is specific for a destination, use that as a hint for the
-                        // source address to be used. Else, use the destination or the prefix to be
-                        // used stated in the RT entry.
-                        if (!route->GetDest().IsAny())
-                        {
-                            rtentry->SetSource(
-                                m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                        }
-                        else
-                        {
-                            rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                                interfaceIdx,
-                                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                        }
-                    }
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                    rtentry->SetDestination(route->GetDest());
-                    rtentry->SetGateway(route->GetGateway());
-                    rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                }
+        if (setSource)
+        {
+            // GetGateway().IsAny() means that the destination is reachable without a
+            // gateway (is on-link). GetDest().IsAny() means that the route is the
+            // default route. Having both true is very strange, but possible.
+            // If the RT entry is specific for a destination, use that as a hint for the
+            // source address to be used. Else, use the destination or the prefix to be
+            // used stated in the RT entry.
+            if (!route->GetDest().IsAny())
+            {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
+            }
+            else
+            {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                    interfaceIdx,
+                    route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
             }
         }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
+        break;
     }
 
     if (rtentry)
@@ -699,9 +696,9 @@ RipNg::AddNetworkRouteTo(Ipv6Address network,
         new RipNgRoutingTableEntry(network, networkPrefix, nextHop, interface, prefixToUse);
     route->SetRouteMetric(1);
     route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
-    route->SetRouteChanged(true);
 
-    m_routes.emplace_back(route, EventId());
+    InsertRoute(route, false);
+    MarkRouteChanged(route);
 }
 
 void
@@ -712,9 +709,9 @@ RipNg::AddNetworkRouteTo(Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t
     auto route = new RipNgRoutingTableEntry(network, networkPrefix, interface);
     route->SetRouteMetric(1);
     route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
-    route->SetRouteChanged(true);
 
-    m_routes.emplace_back(route, EventId());
+    InsertRoute(route, false);
+    MarkRouteChanged(route);
 }
 
 void
@@ -722,23 +719,18 @@ RipNg::InvalidateRoute(RipNgRoutingTableEntry* route)
 {
     NS_LOG_FUNCTION(this << *route);
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    auto it = FindRoute(route);
+    NS_ABORT_MSG_IF(it == m_routes.end(),
+                    "Ripng::InvalidateRoute - cannot find the route to update");
+
+    route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_INVALID);
+    route->SetRouteMetric(m_linkDown);
+    MarkRouteChanged(route);
+    if (it->second.IsPending())
     {
-        if (it->first == route)
-        {
-            route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_INVALID);
-            route->SetRouteMetric(m_linkDown);
-            route->SetRouteChanged(true);
-            if (it->second.IsPending())
-            {
-                it->second.Cancel();
-            }
-            it->second =
-                Simulator::Schedule(m_garbageCollectionDelay, &RipNg::DeleteRoute, this, route);
-            return;
-        }
+        it->second.Cancel();
     }
-    NS_ABORT_MSG("Ripng::InvalidateRoute - cannot find the route to update");
+    it->second = Simulator::Schedule(m_garbageCollectionDelay, &RipNg::DeleteRoute, this, route);
 }
 
 void
@@ -746,18 +738,78 @@ RipNg::DeleteRoute(RipNgRoutingTableEntry* route)
 {
     NS_LOG_FUNCTION(this << *route);
 
-    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+    RouteKey_t key = GetRouteKey(route);
+    auto range = m_routeIndex.equal_range(key);
+    for (auto index = range.first; index != range.second; index++)
     {
-        if (it->first == route)
+        if (index->second->first == route)
         {
+            m_routes.erase(index->second);
+            m_routeIndex.erase(index);
+            if (--m_prefixLengths[key.second] == 0)
+            {
+                m_prefixLengths.erase(key.second);
+            }
             delete route;
-            m_routes.erase(it);
             return;
         }
     }
     NS_ABORT_MSG("Ripng::DeleteRoute - cannot find the route to delete");
 }
 
+RipNg::RouteKey_t
+RipNg::GetRouteKey(const RipNgRoutingTableEntry* route)
+{
+    Ipv6Prefix prefix = route->GetDestNetworkPrefix();
+    return {route->GetDestNetwork().CombinePrefix(prefix), prefix.GetPrefixLength()};
+}
+
+RipNg::RoutesI
+RipNg::InsertRoute(RipNgRoutingTableEntry* route, bool front)
+{
+    RoutesI it = front ? m_routes.emplace(m_routes.begin(), route, EventId())
+                       : m_routes.emplace(m_routes.end(), route, EventId());
+    RouteKey_t key = GetRouteKey(route);
+    m_routeIndex.emplace(key, it);
+    m_prefixLengths[key.second]++;
+    return it;
+}
+
+RipNg::RoutesI
+RipNg::FindRoute(RipNgRoutingTableEntry* route)
+{
+    auto range = m_routeIndex.equal_range(GetRouteKey(route));
+    for (auto index = range.first; index != range.second; index++)
+    {
+        if (index->second->first == route)
+        {
+            return index->second;
+        }
+    }
+    return m_routes.end();
+}
+
+void
+RipNg::MarkRouteChanged(RipNgRoutingTableEntry* route)
+{
+    route->SetRouteChanged(true);
+    m_changedRoutes.insert(GetRouteKey(route));
+}
+
+void
+RipNg::SendResponse(Ptr<Socket> socket, RipNgHeader& hdr, const Inet6SocketAddress& destination)
+{
+    // a new packet for each Response, instead of removing (and parsing) the previous header
+    Ptr<Packet> p = Create<Packet>();
+    SocketIpv6HopLimitTag tag;
+    tag.SetHopLimit(255);
+    p->AddPacketTag(tag);
+    p->AddHeader(hdr);
+    NS_LOG_DEBUG("SendTo: " << *p);
+    socket->SendTo(p, 0, destination);
+    hdr.ClearRtes();
+}
+
 void
 RipNg::Receive(Ptr<Socket> socket)
 {
@@ -858,11 +910,7 @@ RipNg::HandleRequests(RipNgHeader requestHdr,
                      RipNgHeader().GetSerializedSize()) /
                     RipNgRte().GetSerializedSize();
 
-                Ptr<Packet> p = Create<Packet>();
-                SocketIpv6HopLimitTag tag;
-                p->RemovePacketTag(tag);
-                tag.SetHopLimit(255);
-                p->AddPacketTag(tag);
+                Inet6SocketAddress destination(senderAddress, RIPNG_PORT);
 
                 RipNgHeader hdr;
                 hdr.SetCommand(RipNgHeader::RESPONSE);
@@ -904,18 +952,12 @@ RipNg::HandleRequests(RipNgHeader requestHdr,
                     }
                     if (hdr.GetRteNumber() == maxRte)
                     {
-                        p->AddHeader(hdr);
-                        NS_LOG_DEBUG("SendTo: " << *p);
-                        sendingSocket->SendTo(p, 0, Inet6SocketAddress(senderAddress, RIPNG_PORT));
-                        p->RemoveHeader(hdr);
-                        hdr.ClearRtes();
+                        SendResponse(sendingSocket, hdr, destination);
                     }
                 }
                 if (hdr.GetRteNumber() > 0)
                 {
-                    p->AddHeader(hdr);
-                    NS_LOG_DEBUG("SendTo: " << *p);
-                    sendingSocket->SendTo(p, 0, Inet6SocketAddress(senderAddress, RIPNG_PORT));
+                    SendResponse(sendingSocket, hdr, destination);
                 }
             }
         }
@@ -954,23 +996,23 @@ RipNg::HandleRequests(RipNgHeader requestHdr,
         for (auto iter = rtes.begin(); iter != rtes.end(); iter++)
         {
             bool found = false;
-            for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+            Ipv6Address requestedAddress = iter->GetPrefix();
+            for (auto lengthIter = m_prefixLengths.begin();
+                 lengthIter != m_prefixLengths.end() && !found;
+                 lengthIter++)
             {
-                Ipv6InterfaceAddress rtDestAddr =
-                    Ipv6InterfaceAddress(rtIter->first->GetDestNetwork(),
-                                         rtIter->first->GetDestNetworkPrefix());
-                if ((rtDestAddr.GetScope() == Ipv6InterfaceAddress::GLOBAL) &&
-                    (rtIter->first->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID))
+                auto range = m_routeIndex.equal_range({requestedAddress, lengthIter->first});
+                for (auto index = range.first; index != range.second; index++)
                 {
-                    Ipv6Address requestedAddress = iter->GetPrefix();
-                    requestedAddress.CombinePrefix(Ipv6Prefix(iter->GetPrefixLen()));
-                    Ipv6Address rtAddress = rtIter->first->GetDestNetwork();
-                    rtAddress.CombinePrefix(rtIter->first->GetDestNetworkPrefix());
-
-                    if (requestedAddress == rtAddress)
+                    RipNgRoutingTableEntry* route = index->second->first;
+                    Ipv6InterfaceAddress rtDestAddr =
+                        Ipv6InterfaceAddress(route->GetDestNetwork(),
+                                             route->GetDestNetworkPrefix());
+                    if ((rtDestAddr.GetScope() == Ipv6InterfaceAddress::GLOBAL) &&
+                        (route->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID))
                     {
-                        iter->SetRouteMetric(rtIter->first->GetRouteMetric());
-                        iter->SetRouteTag(rtIter->first->GetRouteTag());
+                        iter->SetRouteMetric(route->GetRouteMetric());
+                        iter->SetRouteTag(route->GetRouteTag());
                         hdr.AddRte(*iter);
                         found = true;
                         break;
@@ -1061,10 +1103,11 @@ RipNg::HandleResponses(RipNgHeader hdr,
         {
             rteMetric = m_linkDown;
         }
-        RoutesI it;
         bool found = false;
-        for (it = m_routes.begin(); it != m_routes.end(); it++)
+        auto range = m_routeIndex.equal_range({rteAddr, rtePrefix.GetPrefixLength()});
+        for (auto index = range.first; index != range.second; index++)
         {
+            RoutesI it = index->second;
             if (it->first->GetDestNetwork() == rteAddr &&
                 it->first->GetDestNetworkPrefix() == rtePrefix)
             {
@@ -1084,7 +1127,7 @@ RipNg::HandleResponses(RipNgHeader hdr,
                     it->first->SetRouteMetric(rteMetric);
                     it->first->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
                     it->first->SetRouteTag(iter->GetRouteTag());
-                    it->first->SetRouteChanged(true);
+                    MarkRouteChanged(it->first);
                     it->second.Cancel();
                     it->second = Simulator::Schedule(m_timeoutDelay,
                                                      &RipNg::InvalidateRoute,
@@ -1114,9 +1157,9 @@ RipNg::HandleResponses(RipNgHeader hdr,
                             route->SetRouteMetric(rteMetric);
                             route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
                             route->SetRouteTag(iter->GetRouteTag());
-                            route->SetRouteChanged(true);
                             delete it->first;
                             it->first = route;
+                            MarkRouteChanged(route);
                             it->second.Cancel();
                             it->second = Simulator::Schedule(m_timeoutDelay,
                                                              &RipNg::InvalidateRoute,
@@ -1135,7 +1178,7 @@ RipNg::HandleResponses(RipNgHeader hdr,
                         it->first->SetRouteMetric(rteMetric);
                         it->first->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
                         it->first->SetRouteTag(iter->GetRouteTag());
-                        it->first->SetRouteChanged(true);
+                        MarkRouteChanged(it->first);
                         it->second.Cancel();
                         it->second = Simulator::Schedule(m_timeoutDelay,
                                                          &RipNg::InvalidateRoute,
@@ -1161,11 +1204,9 @@ RipNg::HandleResponses(RipNgHeader hdr,
                                                     Ipv6Address::GetAny());
             route->SetRouteMetric(rteMetric);
             route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
-            route->SetRouteChanged(true);
-            m_routes.emplace_front(route, EventId());
-            EventId invalidateEvent =
-                Simulator::Schedule(m_timeoutDelay, &RipNg::InvalidateRoute, this, route);
-            (m_routes.begin())->second = invalidateEvent;
+            RoutesI it = InsertRoute(route, true);
+            MarkRouteChanged(route);
+            it->second = Simulator::Schedule(m_timeoutDelay, &RipNg::InvalidateRoute, this, route);
             changed = true;
         }
     }
@@ -1181,6 +1222,55 @@ RipNg::DoSendRouteUpdate(bool periodic)
 {
     NS_LOG_FUNCTION(this << (periodic ? " periodic" : " triggered"));
 
+    // the routes to advertise: all of them for a periodic update, only the
+    // changed ones (found through the index) for a triggered update
+    std::vector<RipNgRoutingTableEntry*> routes;
+    if (periodic)
+    {
+        for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+        {
+            routes.push_back(rtIter->first);
+        }
+    }
+    else
+    {
+        for (const auto& key : m_changedRoutes)
+        {
+            auto range = m_routeIndex.equal_range(key);
+            for (auto index = range.first; index != range.second; index++)
+            {
+                if (index->second->first->IsRouteChanged())
+                {
+                    routes.push_back(index->second->first);
+                }
+            }
+        }
+    }
+
+    // the RTEs are built once, and filtered for each interface
+    std::vector<std::tuple<RipNgRoutingTableEntry*, RipNgRte, bool>> candidates;
+    candidates.reserve(routes.size());
+    for (auto route : routes)
+    {
+        Ipv6InterfaceAddress rtDestAddr =
+            Ipv6InterfaceAddress(route->GetDestNetwork(), route->GetDestNetworkPrefix());
+
+        NS_LOG_DEBUG("Processing RT " << rtDestAddr << " " << int(route->IsRouteChanged()));
+
+        bool isGlobal = (rtDestAddr.GetScope() == Ipv6InterfaceAddress::GLOBAL);
+        bool isDefaultRoute = ((route->GetDestNetwork() == Ipv6Address::GetAny()) &&
+                               (route->GetDestNetworkPrefix() == Ipv6Prefix::GetZero()));
+        if (isGlobal || isDefaultRoute)
+        {
+            RipNgRte rte;
+            rte.SetPrefix(route->GetDestNetwork());
+            rte.SetPrefixLen(route->GetDestNetworkPrefix().GetPrefixLength());
+            rte.SetRouteMetric(route->GetRouteMetric());
+            rte.SetRouteTag(route->GetRouteTag());
+            candidates.emplace_back(route, rte, isGlobal);
+        }
+    }
+
     for (auto iter = m_unicastSocketList.begin(); iter != m_unicastSocketList.end(); iter++)
     {
         uint32_t interface = iter->second;
@@ -1193,71 +1283,44 @@ RipNg::DoSendRouteUpdate(bool periodic)
                  RipNgHeader().GetSerializedSize()) /
                 RipNgRte().GetSerializedSize();
 
-            Ptr<Packet> p = Create<Packet>();
-            SocketIpv6HopLimitTag tag;
-            tag.SetHopLimit(255);
-            p->AddPacketTag(tag);
-
             RipNgHeader hdr;
             hdr.SetCommand(RipNgHeader::RESPONSE);
+            Inet6SocketAddress destination(RIPNG_ALL_NODE, RIPNG_PORT);
 
-            for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+            for (const auto& [route, rte, isGlobal] : candidates)
             {
-                bool splitHorizoning = (rtIter->first->GetInterface() == interface);
-                Ipv6InterfaceAddress rtDestAddr =
-                    Ipv6InterfaceAddress(rtIter->first->GetDestNetwork(),
-                                         rtIter->first->GetDestNetworkPrefix());
+                bool splitHorizoning = (route->GetInterface() == interface);
 
-                NS_LOG_DEBUG("Processing RT " << rtDestAddr << " "
-                                              << int(rtIter->first->IsRouteChanged()));
-
-                bool isGlobal = (rtDestAddr.GetScope() == Ipv6InterfaceAddress::GLOBAL);
-                bool isDefaultRoute =
-                    ((rtIter->first->GetDestNetwork() == Ipv6Address::GetAny()) &&
-                     (rtIter->first->GetDestNetworkPrefix() == Ipv6Prefix::GetZero()) &&
-                     (rtIter->first->GetInterface() != interface));
-
-                if ((isGlobal || isDefaultRoute) && (periodic || rtIter->first->IsRouteChanged()))
+                // non-global candidates are default routes, not sent on their own interface
+                if (isGlobal || !splitHorizoning)
                 {
-                    RipNgRte rte;
-                    rte.SetPrefix(rtIter->first->GetDestNetwork());
-                    rte.SetPrefixLen(rtIter->first->GetDestNetworkPrefix().GetPrefixLength());
+                    RipNgRte interfaceRte = rte;
                     if (m_splitHorizonStrategy == POISON_REVERSE && splitHorizoning)
                     {
-                        rte.SetRouteMetric(m_linkDown);
-                    }
-                    else
-                    {
-                        rte.SetRouteMetric(rtIter->first->GetRouteMetric());
+                        interfaceRte.SetRouteMetric(m_linkDown);
                     }
-                    rte.SetRouteTag(rtIter->first->GetRouteTag());
                     if ((m_splitHorizonStrategy == SPLIT_HORIZON && !splitHorizoning) ||
                         (m_splitHorizonStrategy != SPLIT_HORIZON))
                     {
-                        hdr.AddRte(rte);
+                        hdr.AddRte(interfaceRte);
                     }
                 }
                 if (hdr.GetRteNumber() == maxRte)
                 {
-                    p->AddHeader(hdr);
-                    NS_LOG_DEBUG("SendTo: " << *p);
-                    iter->first->SendTo(p, 0, Inet6SocketAddress(RIPNG_ALL_NODE, RIPNG_PORT));
-                    p->RemoveHeader(hdr);
-                    hdr.ClearRtes();
+                    SendResponse(iter->first, hdr, destination);
                 }
             }
             if (hdr.GetRteNumber() > 0)
             {
-                p->AddHeader(hdr);
-                NS_LOG_DEBUG("SendTo: " << *p);
-                iter->first->SendTo(p, 0, Inet6SocketAddress(RIPNG_ALL_NODE, RIPNG_PORT));
+                SendResponse(iter->first, hdr, destination);
             }
         }
     }
-    for (auto rtIter = m_routes.begin(); rtIter != m_routes.end(); rtIter++)
+    for (auto route : routes)
     {
-        rtIter->first->SetRouteChanged(false);
+        route->SetRouteChanged(false);
     }
+    m_changedRoutes.clear();
 }
 
 void
@@ -18,7 +18,11 @@
 #include "ns3/inet6-socket-address.h"
 #include "ns3/random-variable-stream.h"
 
+#include <functional>
 #include <list>
+#include <map>
+#include <set>
+#include <utility>
 
 namespace ns3
 {
@@ -284,6 +288,9 @@ class RipNg : public Ipv6RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<RipNgRoutingTableEntry*, EventId>>::iterator RoutesI;
 
+    /// Key of the route index: network address (masked) and prefix length
+    typedef std::pair<Ipv6Address, uint8_t> RouteKey_t;
+
     /**
      * @brief Receive RIPng packets.
      *
@@ -394,7 +401,46 @@ class RipNg : public Ipv6RoutingProtocol
      */
     void DeleteRoute(RipNgRoutingTableEntry* route);
 
+    /**
+     * @brief Get the key of a route in the route index.
+     * @param route the route
+     * @return the key
+     */
+    static RouteKey_t GetRouteKey(const RipNgRoutingTableEntry* route);
+
+    /**
+     * @brief Insert a route in the forwarding table and in the route index.
+     * @param route the route
+     * @param front true to insert the route at the beginning of the table
+     * @return the position of the route in the table
+     */
+    RoutesI InsertRoute(RipNgRoutingTableEntry* route, bool front);
+
+    /**
+     * @brief Find a route in the forwarding table through the route index.
+     * @param route the route
+     * @return the position of the route, or the end of the table if not found
+     */
+    RoutesI FindRoute(RipNgRoutingTableEntry* route);
+
+    /**
+     * @brief Mark a route as changed, so that the next triggered update includes it.
+     * @param route the route
+     */
+    void MarkRouteChanged(RipNgRoutingTableEntry* route);
+
+    /**
+     * @brief Send a Response and clear the RTEs of its header.
+     * @param socket the socket
+     * @param hdr the header of the Response
+     * @param destination the destination
+     */
+    void SendResponse(Ptr<Socket> socket, RipNgHeader& hdr, const Inet6SocketAddress& destination);
+
     Routes m_routes;                //!<  the forwarding table for network.
+    std::multimap<RouteKey_t, RoutesI> m_routeIndex; //!< the routes, by destination
+    std::map<uint8_t, uint32_t, std::greater<>> m_prefixLengths; //!< route count by prefix length
+    std::set<RouteKey_t> m_changedRoutes; //!< destinations changed since the last update
     Ptr<Ipv6> m_ipv6;               //!< IPv6 reference
     Time m_startupDelay;            //!< Random delay before protocol startup.
     Time m_minTriggeredUpdateDelay; //!< Min cooldown delay after a Triggered Update.
@@ -13,6 +13,7 @@
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/error-channel.h"
+#include "ns3/fragment-reassembly.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
@@ -39,8 +40,10 @@
 #include <netinet/in.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -564,6 +567,77 @@ Ipv4FragmentationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Fragment reassembly Test: out-of-order, duplicated and overlapping
+ * fragments of a 64 KB datagram.
+ */
+class FragmentReassemblyTest : public TestCase
+{
+  public:
+    FragmentReassemblyTest();
+
+  private:
+    void DoRun() override;
+};
+
+FragmentReassemblyTest::FragmentReassemblyTest()
+    : TestCase("Fragment reassembly with out-of-order and overlapping fragments")
+{
+}
+
+void
+FragmentReassemblyTest::DoRun()
+{
+    const uint32_t size = 65000;
+    const uint32_t fragmentSize = 552;
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        data[i] = i % 251;
+    }
+    Ptr<Packet> packet = Create<Packet>(data.data(), size);
+
+    // every fragment overlaps the next one by 8 bytes, and they are added in reverse order
+    FragmentReassembly reassembly;
+    std::vector<uint32_t> offsets;
+    for (uint32_t offset = 0; offset < size; offset += fragmentSize)
+    {
+        offsets.push_back(offset);
+    }
+    for (auto it = offsets.rbegin(); it != offsets.rend(); it++)
+    {
+        uint32_t length = std::min(fragmentSize + 8, size - *it);
+        NS_TEST_EXPECT_MSG_EQ(reassembly.IsEntire(), false, "Packet entire too early");
+        reassembly.AddFragment(packet->CreateFragment(*it, length), *it, *it + length < size);
+    }
+    NS_TEST_EXPECT_MSG_EQ(reassembly.IsEntire(), true, "Packet not entire");
+    NS_TEST_EXPECT_MSG_EQ(reassembly.HasOverlaps(), true, "Overlaps not detected");
+
+    // a duplicate of the first fragment does not change anything
+    reassembly.AddFragment(packet->CreateFragment(0, fragmentSize), 0, true);
+    NS_TEST_EXPECT_MSG_EQ(reassembly.IsEntire(), true, "Packet not entire");
+
+    Ptr<Packet> reassembled = reassembly.GetPacket();
+    NS_TEST_ASSERT_MSG_EQ(reassembled->GetSize(), size, "Wrong reassembled size");
+    std::vector<uint8_t> buffer(size);
+    reassembled->CopyData(buffer.data(), size);
+    NS_TEST_EXPECT_MSG_EQ((buffer == data), true, "Wrong reassembled content");
+
+    // a hole leaves only the first part available
+    FragmentReassembly partial;
+    partial.AddFragment(packet->CreateFragment(0, 1000), 0, true);
+    partial.AddFragment(packet->CreateFragment(2000, 1000), 2000, false);
+    NS_TEST_EXPECT_MSG_EQ(partial.IsEntire(), false, "Packet with a hole is entire");
+    NS_TEST_EXPECT_MSG_EQ(partial.HasOverlaps(), false, "Wrong overlap detected");
+    NS_TEST_EXPECT_MSG_EQ(partial.GetPartialPacket()->GetSize(), 1000, "Wrong partial packet");
+    partial.AddFragment(packet->CreateFragment(1000, 1000), 1000, true);
+    NS_TEST_EXPECT_MSG_EQ(partial.IsEntire(), true, "Packet not entire");
+    NS_TEST_EXPECT_MSG_EQ(partial.HasOverlaps(), false, "Wrong overlap detected");
+    NS_TEST_EXPECT_MSG_EQ(partial.GetPacket()->GetSize(), 3000, "Wrong reassembled size");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -580,6 +654,7 @@ Ipv4FragmentationTestSuite::Ipv4FragmentationTestSuite()
 {
     AddTestCase(new Ipv4FragmentationTest(false), TestCase::Duration::QUICK);
     AddTestCase(new Ipv4FragmentationTest(true), TestCase::Duration::QUICK);
+    AddTestCase(new FragmentReassemblyTest, TestCase::Duration::QUICK);
 }
 
 static Ipv4FragmentationTestSuite
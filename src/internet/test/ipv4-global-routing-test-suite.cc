@@ -5,6 +5,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/enum.h"
 #include "ns3/global-route-manager.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
@@ -1397,6 +1398,151 @@ EcmpRouteCalculationTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Flow-hashed and weighted ECMP TestCase.
+ *
+ * Checks that the packets of a flow always follow the same path, that the
+ * flows are spread over the equal-cost paths, that the ECMP weights are
+ * honored, and that the flows that do not need to move keep their path when
+ * the weights change.
+ */
+class EcmpFlowHashTestCase : public TestCase
+{
+  public:
+    EcmpFlowHashTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Get the gateway chosen for a TCP flow from n0 toward n4.
+     * @param srcPort the source port of the flow
+     * @return the gateway
+     */
+    Ipv4Address GetGateway(uint16_t srcPort);
+
+    Ptr<Ipv4GlobalRouting> m_routing; //!< global routing of n0
+};
+
+EcmpFlowHashTestCase::EcmpFlowHashTestCase()
+    : TestCase("Flow-hashed and weighted ECMP")
+{
+}
+
+Ipv4Address
+EcmpFlowHashTestCase::GetGateway(uint16_t srcPort)
+{
+    // TCP header: source port and destination port, followed by the rest of the header
+    uint8_t tcpHeader[20] = {};
+    tcpHeader[0] = srcPort >> 8;
+    tcpHeader[1] = srcPort & 0xff;
+    tcpHeader[2] = 0;
+    tcpHeader[3] = 80;
+    Ptr<Packet> p = Create<Packet>(tcpHeader, sizeof(tcpHeader));
+
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.1.1.1"));
+    header.SetDestination(Ipv4Address("10.1.5.2"));
+    header.SetProtocol(6);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(p, header, nullptr, sockerr);
+    NS_TEST_EXPECT_MSG_NE(route, nullptr, "No route found toward n4");
+    return route ? route->GetGateway() : Ipv4Address();
+}
+
+void
+EcmpFlowHashTestCase::DoRun()
+{
+    /*
+              ------n1------
+             /              \
+           n0                n3----n4
+             \              /
+              ------n2------
+
+        Link n0-n1: 10.1.1.0/30 (interface 1 of n0)
+        Link n0-n2: 10.1.2.0/30 (interface 2 of n0)
+        Link n1-n3: 10.1.3.0/30
+        Link n2-n3: 10.1.4.0/30
+        Link n3-n4: 10.1.5.0/30
+    */
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    Ipv4GlobalRoutingHelper globalhelper;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelper);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.252");
+    const uint32_t links[][2] = {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}};
+    for (const auto& link : links)
+    {
+        NetDeviceContainer devices =
+            devHelper.Install(NodeContainer(nodes.Get(link[0]), nodes.Get(link[1])));
+        address.Assign(devices);
+        address.NewNetwork();
+    }
+
+    m_routing = nodes.Get(0)
+                    ->GetObject<Ipv4>()
+                    ->GetRoutingProtocol()
+                    ->GetObject<Ipv4GlobalRouting>();
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_FLOW_HASH));
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    const Ipv4Address viaN1("10.1.1.2");
+    const Ipv4Address viaN2("10.1.2.2");
+    const uint16_t flows = 200;
+    std::vector<Ipv4Address> gateways;
+    uint32_t countN1 = 0;
+    for (uint16_t port = 1000; port < 1000 + flows; port++)
+    {
+        gateways.push_back(GetGateway(port));
+        NS_TEST_ASSERT_MSG_EQ(GetGateway(port), gateways.back(), "Flow changed its path");
+        countN1 += (gateways.back() == viaN1);
+    }
+    NS_TEST_ASSERT_MSG_GT(countN1, flows / 4, "Too few flows via n1");
+    NS_TEST_ASSERT_MSG_LT(countN1, flows * 3 / 4, "Too few flows via n2");
+
+    // no flow via n1 anymore, and the flows via n2 stay there
+    m_routing->SetEcmpWeight(1, 0);
+    for (uint16_t i = 0; i < flows; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetGateway(1000 + i), viaN2, "Flow not moved away from n1");
+    }
+
+    // back to the original spreading
+    m_routing->SetEcmpWeight(1, 1);
+    for (uint16_t i = 0; i < flows; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetGateway(1000 + i), gateways[i], "Flow not restored");
+    }
+
+    // a 3:1 weighting moves flows from n2 to n1 only
+    m_routing->SetEcmpWeight(1, 3);
+    uint32_t weightedN1 = 0;
+    for (uint16_t i = 0; i < flows; i++)
+    {
+        Ipv4Address gateway = GetGateway(1000 + i);
+        if (gateways[i] == viaN1)
+        {
+            NS_TEST_ASSERT_MSG_EQ(gateway, viaN1, "Flow moved away from the heavier path");
+        }
+        weightedN1 += (gateway == viaN1);
+    }
+    NS_TEST_ASSERT_MSG_GT(weightedN1, countN1, "Weight not honored");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1783,6 +1929,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new EcmpFlowHashTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingProtocolTestCase, TestCase::Duration::QUICK);
 }
 
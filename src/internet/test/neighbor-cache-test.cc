@@ -1277,6 +1277,98 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Neighbor Cache with many entries Test
+ */
+class LargeCacheTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    LargeCacheTest();
+};
+
+LargeCacheTest::LargeCacheTest()
+    : TestCase("The LargeCacheTest checks insertion, lookup and removal of many entries "
+               "in the ARP and NDISC caches.")
+{
+}
+
+void
+LargeCacheTest::DoRun()
+{
+    const uint32_t nEntries = 10000;
+
+    Ptr<ArpCache> arpCache = CreateObject<ArpCache>();
+    Ptr<NdiscCache> ndiscCache = CreateObject<NdiscCache>();
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        arpCache->Add(Ipv4Address(0x0a000000 + i))->SetMacAddress(Mac48Address::Allocate());
+        ndiscCache->Add(Ipv6Address::MakeIpv4MappedAddress(Ipv4Address(0x0a000000 + i)))
+            ->SetMacAddress(Mac48Address::Allocate());
+    }
+
+    // remove every other ARP entry, then check that the remaining ones are still found
+    for (uint32_t i = 0; i < nEntries; i += 2)
+    {
+        ArpCache::Entry* entry = arpCache->Lookup(Ipv4Address(0x0a000000 + i));
+        NS_TEST_ASSERT_MSG_NE(entry, nullptr, "ARP entry not found");
+        arpCache->Remove(entry);
+    }
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        ArpCache::Entry* entry = arpCache->Lookup(Ipv4Address(0x0a000000 + i));
+        if (entry)
+        {
+            NS_TEST_EXPECT_MSG_EQ(entry->GetIpv4Address(),
+                                  Ipv4Address(0x0a000000 + i),
+                                  "Wrong ARP entry returned");
+            found++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(found, nEntries / 2, "Wrong number of ARP entries after removal");
+
+    // the removed entries are recycled, and must come back in their initial state
+    for (uint32_t i = 0; i < nEntries; i += 2)
+    {
+        ArpCache::Entry* entry = arpCache->Add(Ipv4Address(0x0a000000 + i));
+        NS_TEST_EXPECT_MSG_EQ(entry->IsAlive(), true, "Recycled ARP entry not reset");
+        NS_TEST_EXPECT_MSG_EQ(entry->GetMacAddress().IsInvalid(),
+                              true,
+                              "Recycled ARP entry not reset");
+    }
+    arpCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(Ipv4Address(0x0a000001)),
+                          nullptr,
+                          "ARP cache not flushed");
+
+    // remove one NDISC entry out of three, checking the other ones after each removal
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        Ipv6Address address = Ipv6Address::MakeIpv4MappedAddress(Ipv4Address(0x0a000000 + i));
+        NdiscCache::Entry* entry = ndiscCache->Lookup(address);
+        NS_TEST_ASSERT_MSG_NE(entry, nullptr, "NDISC entry not found");
+        NS_TEST_EXPECT_MSG_EQ(entry->GetIpv6Address(), address, "Wrong NDISC entry returned");
+        if (i % 3 == 0)
+        {
+            ndiscCache->Remove(entry);
+            NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(address),
+                                  nullptr,
+                                  "NDISC entry not removed");
+        }
+    }
+    ndiscCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(
+        ndiscCache->Lookup(Ipv6Address::MakeIpv4MappedAddress(Ipv4Address(0x0a000001))),
+        nullptr,
+        "NDISC cache not flushed");
+
+    arpCache->Dispose();
+    ndiscCache->Dispose();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1295,6 +1387,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new LargeCacheTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "mobility-grid-index.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityGridIndex");
+
+MobilityGridIndex::MobilityGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MobilityGridIndex::~MobilityGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+MobilityGridIndex::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The size of the cells must be positive");
+    Clear();
+    m_cellSize = cellSize;
+}
+
+double
+MobilityGridIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+uint32_t
+MobilityGridIndex::Add(Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    NS_ASSERT_MSG(m_cellSize > 0, "The size of the cells must be set first");
+    auto id = static_cast<uint32_t>(m_items.size());
+    m_items.emplace_back();
+    m_items.back().mobility = mobility;
+    if (mobility)
+    {
+        auto& ids = m_itemsByMobility[PeekPointer(mobility)];
+        if (ids.empty())
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&MobilityGridIndex::CourseChanged, this));
+        }
+        ids.push_back(id);
+    }
+    Insert(id);
+    return id;
+}
+
+void
+MobilityGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, ids] : m_itemsByMobility)
+    {
+        m_items[ids.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGridIndex::CourseChanged, this));
+    }
+    m_itemsByMobility.clear();
+    m_items.clear();
+    m_cells.clear();
+    m_unindexed.clear();
+}
+
+uint32_t
+MobilityGridIndex::GetN() const
+{
+    return static_cast<uint32_t>(m_items.size());
+}
+
+int32_t
+MobilityGridIndex::GetCellCoordinate(double x) const
+{
+    double cell = std::floor(x / m_cellSize);
+    cell = std::clamp<double>(cell,
+                              std::numeric_limits<int32_t>::min(),
+                              std::numeric_limits<int32_t>::max());
+    return static_cast<int32_t>(cell);
+}
+
+uint64_t
+MobilityGridIndex::GetCellKey(int32_t cx, int32_t cy)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+void
+MobilityGridIndex::Insert(uint32_t id)
+{
+    Item& item = m_items[id];
+    if (!item.mobility || item.mobility->GetVelocity().GetLength() > 0)
+    {
+        item.indexed = false;
+        m_unindexed.push_back(id);
+        return;
+    }
+    item.indexed = true;
+    item.position = item.mobility->GetPosition();
+    item.cell = GetCellKey(GetCellCoordinate(item.position.x), GetCellCoordinate(item.position.y));
+    m_cells[item.cell].push_back(id);
+}
+
+void
+MobilityGridIndex::Remove(uint32_t id)
+{
+    const Item& item = m_items[id];
+    if (!item.indexed)
+    {
+        m_unindexed.erase(std::find(m_unindexed.begin(), m_unindexed.end(), id));
+        return;
+    }
+    auto cell = m_cells.find(item.cell);
+    NS_ASSERT(cell != m_cells.end());
+    cell->second.erase(std::find(cell->second.begin(), cell->second.end(), id));
+    if (cell->second.empty())
+    {
+        m_cells.erase(cell);
+    }
+}
+
+void
+MobilityGridIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_itemsByMobility.find(PeekPointer(mobility));
+    if (it == m_itemsByMobility.end())
+    {
+        return;
+    }
+    for (auto id : it->second)
+    {
+        Remove(id);
+        Insert(id);
+    }
+}
+
+std::vector<uint32_t>
+MobilityGridIndex::GetCandidates(const Vector& position, double range) const
+{
+    NS_LOG_FUNCTION(this << position << range);
+    std::vector<uint32_t> candidates;
+    if (!std::isfinite(range))
+    {
+        candidates.resize(m_items.size());
+        for (uint32_t id = 0; id < candidates.size(); id++)
+        {
+            candidates[id] = id;
+        }
+        return candidates;
+    }
+
+    candidates = m_unindexed;
+    auto addIfInRange = [&](uint32_t id) {
+        if (CalculateDistance(position, m_items[id].position) <= range)
+        {
+            candidates.push_back(id);
+        }
+    };
+    int32_t xMin = GetCellCoordinate(position.x - range);
+    int32_t xMax = GetCellCoordinate(position.x + range);
+    int32_t yMin = GetCellCoordinate(position.y - range);
+    int32_t yMax = GetCellCoordinate(position.y + range);
+    double nCells = (static_cast<double>(xMax) - xMin + 1) * (static_cast<double>(yMax) - yMin + 1);
+    if (nCells > m_cells.size())
+    {
+        // there are fewer occupied cells than cells in range, visit them all
+        for (const auto& [cell, ids] : m_cells)
+        {
+            std::for_each(ids.begin(), ids.end(), addIfInRange);
+        }
+    }
+    else
+    {
+        for (int64_t cx = xMin; cx <= xMax; cx++)
+        {
+            for (int64_t cy = yMin; cy <= yMax; cy++)
+            {
+                auto cell = m_cells.find(
+                    GetCellKey(static_cast<int32_t>(cx), static_cast<int32_t>(cy)));
+                if (cell != m_cells.end())
+                {
+                    std::for_each(cell->second.begin(), cell->second.end(), addIfInRange);
+                }
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    NS_LOG_DEBUG(candidates.size() << " candidates out of " << m_items.size() << " items");
+    return candidates;
+}
+
+} // namespace ns3
@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef MOBILITY_GRID_INDEX_H
+#define MOBILITY_GRID_INDEX_H
+
+#include "mobility-model.h"
+
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Spatial index of a set of items, each with a MobilityModel, used to
+ * find the items that may be within a given distance of a position without
+ * visiting all of them.
+ *
+ * Items are identified by the order in which they are added (0, 1, ...).
+ * An item whose MobilityModel has a zero velocity is stored, with its
+ * position, in the square cell of the x-y plane containing it, and is moved
+ * to another cell when its MobilityModel notifies a course change. An item
+ * whose MobilityModel is moving, or which has no MobilityModel, is not
+ * indexed and is always returned as a candidate.
+ *
+ * This relies on the CourseChange trace source being fired whenever the
+ * position or the velocity of a still MobilityModel changes, as is the case
+ * for all the mobility models of this module.
+ */
+class MobilityGridIndex
+{
+  public:
+    MobilityGridIndex();
+    ~MobilityGridIndex();
+
+    // Delete copy constructor and assignment operator, the trace sources
+    // of the mobility models are connected to this object
+    MobilityGridIndex(const MobilityGridIndex&) = delete;
+    MobilityGridIndex& operator=(const MobilityGridIndex&) = delete;
+
+    /**
+     * Set the size of the side of the cells. All the items are removed.
+     * @param cellSize the size of the side of the cells (m)
+     */
+    void SetCellSize(double cellSize);
+
+    /**
+     * @return the size of the side of the cells (m)
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add an item to the index.
+     * @param mobility the mobility model of the item, possibly null
+     * @return the identifier of the item, i.e., the number of items added before it
+     */
+    uint32_t Add(Ptr<MobilityModel> mobility);
+
+    /**
+     * Remove all the items and disconnect from the mobility models.
+     */
+    void Clear();
+
+    /**
+     * @return the number of items
+     */
+    uint32_t GetN() const;
+
+    /**
+     * Get the items that may be within a given distance of a position: the
+     * indexed items at most range meters away from the position and all the
+     * items that are not indexed. All the items are returned if the range is
+     * not finite.
+     * @param position the position
+     * @param range the distance (m)
+     * @return the identifiers of the items, in increasing order
+     */
+    std::vector<uint32_t> GetCandidates(const Vector& position, double range) const;
+
+  private:
+    /// An item of the index
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model of the item
+        bool indexed{false};         //!< whether the item is stored in a cell
+        uint64_t cell{0};            //!< the key of the cell storing the item
+        Vector position;             //!< the position of the item, if indexed
+    };
+
+    /**
+     * @param x the x coordinate (m)
+     * @return the coordinate of the cell containing x
+     */
+    int32_t GetCellCoordinate(double x) const;
+
+    /**
+     * @param cx the x coordinate of the cell
+     * @param cy the y coordinate of the cell
+     * @return the key of the cell
+     */
+    static uint64_t GetCellKey(int32_t cx, int32_t cy);
+
+    /**
+     * Store an item in the cell containing its position, if it is still, or
+     * in the list of the items that are not indexed.
+     * @param id the identifier of the item
+     */
+    void Insert(uint32_t id);
+
+    /**
+     * Remove an item from its cell or from the list of the items that are not indexed.
+     * @param id the identifier of the item
+     */
+    void Remove(uint32_t id);
+
+    /**
+     * Move the items of a mobility model after it has notified a course change.
+     * @param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize{0};                                     //!< the size of the cells (m)
+    std::vector<Item> m_items;                                //!< the items, by identifier
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; //!< the items, by cell
+    std::vector<uint32_t> m_unindexed; //!< the items that are not indexed
+    std::unordered_map<const MobilityModel*, std::vector<uint32_t>>
+        m_itemsByMobility; //!< the items, by mobility model
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_INDEX_H */
@@ -12,6 +12,8 @@
  */
 
 #include "ns3/boolean.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/mobility-grid-index.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/mobility-model.h"
 #include "ns3/scheduler.h"
@@ -20,6 +22,9 @@
 #include "ns3/vector.h"
 #include "ns3/waypoint-mobility-model.h"
 
+#include <limits>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -461,6 +466,78 @@ WaypointMobilityModelViaHelper::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Mobility Grid Index Test
+ *
+ * Check that the MobilityGridIndex returns the still items within range and
+ * all the moving ones, and that it follows the course changes.
+ */
+class MobilityGridIndexTest : public TestCase
+{
+  public:
+    MobilityGridIndexTest();
+
+  private:
+    void DoRun() override;
+};
+
+MobilityGridIndexTest::MobilityGridIndexTest()
+    : TestCase("Check the candidates returned by the MobilityGridIndex")
+{
+}
+
+void
+MobilityGridIndexTest::DoRun()
+{
+    MobilityGridIndex index;
+    index.SetCellSize(10);
+    std::vector<Ptr<ConstantVelocityMobilityModel>> mobilities;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        mobilities.push_back(CreateObject<ConstantVelocityMobilityModel>());
+        mobilities.back()->SetPosition(Vector(7.0 * i, 0, 0));
+        index.Add(mobilities.back());
+    }
+    index.Add(nullptr);
+
+    using Ids = std::vector<uint32_t>;
+    NS_TEST_ASSERT_MSG_EQ(index.GetN(), 11, "Unexpected number of items");
+    NS_TEST_EXPECT_MSG_EQ((index.GetCandidates(Vector(20, 0, 0), 7.5) == Ids{2, 3, 10}),
+                          true,
+                          "Unexpected candidates");
+    NS_TEST_EXPECT_MSG_EQ(index.GetCandidates(Vector(0, 0, 0), 1e9).size(),
+                          11,
+                          "All the items should be in range");
+    const double infinity = std::numeric_limits<double>::infinity();
+    NS_TEST_EXPECT_MSG_EQ(index.GetCandidates(Vector(0, 0, 0), infinity).size(),
+                          11,
+                          "All the items should be returned for an infinite range");
+
+    // moved items are found at their new position
+    mobilities[9]->SetPosition(Vector(21, 5, 0));
+    NS_TEST_EXPECT_MSG_EQ((index.GetCandidates(Vector(20, 0, 0), 7.5) == Ids{2, 3, 9, 10}),
+                          true,
+                          "The moved item should be a candidate");
+    // moving items are always candidates
+    mobilities[0]->SetVelocity(Vector(1, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ((index.GetCandidates(Vector(20, 0, 0), 7.5) == Ids{0, 2, 3, 9, 10}),
+                          true,
+                          "The moving item should be a candidate");
+    mobilities[0]->SetVelocity(Vector(0, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ((index.GetCandidates(Vector(20, 0, 0), 7.5) == Ids{2, 3, 9, 10}),
+                          true,
+                          "The stopped item should not be a candidate");
+
+    index.Clear();
+    mobilities[9]->SetPosition(Vector(0, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ(index.GetCandidates(Vector(0, 0, 0), 8).empty(),
+                          true,
+                          "There should be no candidate after clearing the index");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup mobility-test
  *
@@ -479,6 +556,7 @@ MobilityTestSuite::MobilityTestSuite()
     AddTestCase(new WaypointLazyNotifyTrue, TestCase::Duration::QUICK);
     AddTestCase(new WaypointInitialPositionIsWaypoint, TestCase::Duration::QUICK);
     AddTestCase(new WaypointMobilityModelViaHelper, TestCase::Duration::QUICK);
+    AddTestCase(new MobilityGridIndexTest, TestCase::Duration::QUICK);
 }
 
 /**
@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ring-buffer.h"
+#include "ns3/test.h"
+
+#include <list>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * RingBuffer unit tests.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Check that the content of the buffer matches the content of a list.
+     * @param buffer the buffer
+     * @param expected the expected content
+     * @param msg the message to print on failure
+     */
+    void CheckContent(const RingBuffer<int>& buffer,
+                      const std::list<int>& expected,
+                      const std::string& msg);
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Sanity check on the ring buffer implementation")
+{
+}
+
+void
+RingBufferTestCase::CheckContent(const RingBuffer<int>& buffer,
+                                 const std::list<int>& expected,
+                                 const std::string& msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(buffer.size(), expected.size(), msg << ": unexpected size");
+    auto it = buffer.begin();
+    for (int value : expected)
+    {
+        NS_TEST_EXPECT_MSG_EQ(*it, value, msg << ": unexpected element");
+        ++it;
+    }
+    NS_TEST_EXPECT_MSG_EQ((it == buffer.end()), true, msg << ": end not reached");
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<int> buffer;
+    std::list<int> expected;
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+
+    // FIFO operations across several growths of the buffer, with the head moving
+    // through the array
+    for (int i = 0; i < 100; i++)
+    {
+        buffer.insert(buffer.end(), i);
+        expected.push_back(i);
+        if (i % 3 == 0)
+        {
+            buffer.erase(buffer.begin());
+            expected.pop_front();
+        }
+    }
+    CheckContent(buffer, expected, "FIFO operations");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 128, "Unexpected capacity");
+
+    // iterators to the elements are not invalidated by insertions and removals
+    // at both ends, including those causing the buffer to grow
+    auto it = buffer.begin();
+    ++it;
+    int value = *it;
+    for (int i = 0; i < 200; i++)
+    {
+        buffer.push_back(1000 + i);
+        expected.push_back(1000 + i);
+    }
+    buffer.push_front(-1);
+    expected.push_front(-1);
+    buffer.pop_back();
+    expected.pop_back();
+    NS_TEST_EXPECT_MSG_EQ(*it, value, "The iterator should still point to the same element");
+    CheckContent(buffer, expected, "Growth");
+
+    // insertion and removal in the middle
+    auto ret = buffer.insert(it, 5000);
+    expected.insert(std::next(expected.begin(), 2), 5000);
+    NS_TEST_EXPECT_MSG_EQ(*ret, 5000, "The returned iterator should point to the new element");
+    CheckContent(buffer, expected, "Insertion in the middle");
+    ret = buffer.erase(std::next(buffer.begin(), 10));
+    auto expectedRet = expected.erase(std::next(expected.begin(), 10));
+    NS_TEST_EXPECT_MSG_EQ(*ret, *expectedRet, "Unexpected element after the erased one");
+    CheckContent(buffer, expected, "Removal in the middle");
+
+    // removal of the last element
+    ret = buffer.erase(std::prev(buffer.end()));
+    expected.pop_back();
+    NS_TEST_EXPECT_MSG_EQ((ret == buffer.end()), true, "The end should be returned");
+    CheckContent(buffer, expected, "Removal of the last element");
+
+    buffer.clear();
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+    buffer.insert(buffer.begin(), 1);
+    CheckContent(buffer, {1}, "Insertion after clear");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief RingBuffer TestSuite
+ */
+class RingBufferTestSuite : public TestSuite
+{
+  public:
+    RingBufferTestSuite()
+        : TestSuite("ring-buffer", Type::UNIT)
+    {
+        AddTestCase(new RingBufferTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static RingBufferTestSuite g_ringBufferTestSuite; //!< Static variable for test initialization
@@ -235,7 +235,10 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is RingBuffer (as defined in queue-fwd.h), which stores the items in a growable
+ * circular array and does not allocate memory for each enqueued item; a different
+ * container (e.g., std::list) can be specified as the second template argument.
+ * In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
@@ -0,0 +1,402 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup queue
+ * ns3::RingBuffer declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup queue
+ *
+ * @brief A growable circular buffer, used as the default container of the
+ * items stored by a Queue.
+ *
+ * The elements are stored in a contiguous array whose capacity is a power of
+ * two, hence no memory is allocated when an element is inserted, unless the
+ * buffer is full, in which case the capacity is doubled.
+ *
+ * Iterators identify an element through its logical position, which is not
+ * changed by the insertion or removal of elements at either end of the buffer,
+ * nor by the growth of the buffer. Therefore, inserting and erasing elements
+ * at the front or at the back (as done by a FIFO queue) invalidates no iterator
+ * but those pointing to the erased elements. Inserting or erasing an element in
+ * the middle of the buffer shifts the subsequent elements, hence iterators
+ * pointing to such elements point to a different element afterwards.
+ *
+ * @tparam T \explicit the type of the elements
+ */
+template <typename T>
+class RingBuffer
+{
+  private:
+    /**
+     * @brief Iterator over the elements of a RingBuffer.
+     * @tparam Const \explicit whether this is a const iterator
+     */
+    template <bool Const>
+    class IteratorImpl
+    {
+      public:
+        /// Iterator category
+        using iterator_category = std::bidirectional_iterator_tag;
+        /// Value type
+        using value_type = T;
+        /// Difference type
+        using difference_type = std::ptrdiff_t;
+        /// Pointer type
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        /// Reference type
+        using reference = std::conditional_t<Const, const T&, T&>;
+        /// Type of the pointer to the buffer
+        using BufferPtr = std::conditional_t<Const, const RingBuffer*, RingBuffer*>;
+
+        IteratorImpl() = default;
+
+        /**
+         * Constructor
+         * @param buffer the buffer
+         * @param pos the logical position of the element
+         */
+        IteratorImpl(BufferPtr buffer, std::size_t pos)
+            : m_buffer(buffer),
+              m_pos(pos)
+        {
+        }
+
+        /**
+         * Conversion from a non-const iterator to a const iterator.
+         * @tparam C \deduced whether the other iterator is a const iterator
+         * @param other the non-const iterator
+         */
+        template <bool C, typename = std::enable_if_t<Const && !C>>
+        IteratorImpl(const IteratorImpl<C>& other)
+            : m_buffer(other.m_buffer),
+              m_pos(other.m_pos)
+        {
+        }
+
+        /// @return a reference to the element
+        reference operator*() const
+        {
+            return m_buffer->At(m_pos);
+        }
+
+        /// @return a pointer to the element
+        pointer operator->() const
+        {
+            return &m_buffer->At(m_pos);
+        }
+
+        /// @return this iterator, advanced to the next element
+        IteratorImpl& operator++()
+        {
+            ++m_pos;
+            return *this;
+        }
+
+        /// @return a copy of this iterator, which is advanced to the next element
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl ret = *this;
+            ++m_pos;
+            return ret;
+        }
+
+        /// @return this iterator, moved to the previous element
+        IteratorImpl& operator--()
+        {
+            --m_pos;
+            return *this;
+        }
+
+        /// @return a copy of this iterator, which is moved to the previous element
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl ret = *this;
+            --m_pos;
+            return ret;
+        }
+
+        /**
+         * @param other another iterator
+         * @return true if the two iterators point to the same element
+         */
+        bool operator==(const IteratorImpl& other) const
+        {
+            return m_pos == other.m_pos && m_buffer == other.m_buffer;
+        }
+
+        /**
+         * @param other another iterator
+         * @return true if the two iterators point to different elements
+         */
+        bool operator!=(const IteratorImpl& other) const
+        {
+            return !(*this == other);
+        }
+
+      private:
+        friend class RingBuffer;
+        template <bool>
+        friend class IteratorImpl;
+
+        BufferPtr m_buffer{nullptr}; //!< the buffer
+        std::size_t m_pos{0};        //!< the logical position of the element
+    };
+
+  public:
+    /// Value type
+    using value_type = T;
+    /// Size type
+    using size_type = std::size_t;
+    /// Reference type
+    using reference = T&;
+    /// Const reference type
+    using const_reference = const T&;
+    /// Iterator
+    using iterator = IteratorImpl<false>;
+    /// Const iterator
+    using const_iterator = IteratorImpl<true>;
+
+    /// @return an iterator to the first element
+    iterator begin()
+    {
+        return iterator(this, m_head);
+    }
+
+    /// @return a const iterator to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(this, m_head);
+    }
+
+    /// @return an iterator past the last element
+    iterator end()
+    {
+        return iterator(this, m_tail);
+    }
+
+    /// @return a const iterator past the last element
+    const_iterator end() const
+    {
+        return const_iterator(this, m_tail);
+    }
+
+    /// @return a const iterator to the first element
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// @return a const iterator past the last element
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /// @return the number of elements
+    size_type size() const
+    {
+        return m_tail - m_head;
+    }
+
+    /// @return true if there is no element
+    bool empty() const
+    {
+        return m_tail == m_head;
+    }
+
+    /// @return the number of elements that can be stored without growing the buffer
+    size_type capacity() const
+    {
+        return m_data.size();
+    }
+
+    /// @return a reference to the first element
+    reference front()
+    {
+        NS_ASSERT(!empty());
+        return At(m_head);
+    }
+
+    /// @return a const reference to the first element
+    const_reference front() const
+    {
+        NS_ASSERT(!empty());
+        return At(m_head);
+    }
+
+    /// @return a reference to the last element
+    reference back()
+    {
+        NS_ASSERT(!empty());
+        return At(m_tail - 1);
+    }
+
+    /// @return a const reference to the last element
+    const_reference back() const
+    {
+        NS_ASSERT(!empty());
+        return At(m_tail - 1);
+    }
+
+    /**
+     * @brief Append an element.
+     * @param value the element
+     */
+    void push_back(T value)
+    {
+        Grow();
+        At(m_tail) = std::move(value);
+        ++m_tail;
+    }
+
+    /**
+     * @brief Prepend an element.
+     * @param value the element
+     */
+    void push_front(T value)
+    {
+        Grow();
+        --m_head;
+        At(m_head) = std::move(value);
+    }
+
+    /// @brief Remove the first element.
+    void pop_front()
+    {
+        NS_ASSERT(!empty());
+        At(m_head) = T();
+        ++m_head;
+    }
+
+    /// @brief Remove the last element.
+    void pop_back()
+    {
+        NS_ASSERT(!empty());
+        --m_tail;
+        At(m_tail) = T();
+    }
+
+    /**
+     * @brief Insert an element before the given position.
+     * @param pos the position
+     * @param value the element
+     * @return an iterator to the inserted element
+     */
+    iterator insert(const_iterator pos, T value)
+    {
+        NS_ASSERT(pos.m_buffer == this && pos.m_pos - m_head <= size());
+        if (pos.m_pos == m_tail)
+        {
+            push_back(std::move(value));
+            return iterator(this, m_tail - 1);
+        }
+        if (pos.m_pos == m_head)
+        {
+            push_front(std::move(value));
+            return begin();
+        }
+        // shift the elements from pos to the back by one position
+        Grow();
+        for (std::size_t p = m_tail; p != pos.m_pos; --p)
+        {
+            At(p) = std::move(At(p - 1));
+        }
+        ++m_tail;
+        At(pos.m_pos) = std::move(value);
+        return iterator(this, pos.m_pos);
+    }
+
+    /**
+     * @brief Erase the element at the given position.
+     * @param pos the position
+     * @return an iterator to the element following the erased one
+     */
+    iterator erase(const_iterator pos)
+    {
+        NS_ASSERT(pos.m_buffer == this && pos.m_pos - m_head < size());
+        if (pos.m_pos == m_head)
+        {
+            pop_front();
+            return begin();
+        }
+        // shift the elements following pos to the front by one position
+        for (std::size_t p = pos.m_pos; p + 1 != m_tail; ++p)
+        {
+            At(p) = std::move(At(p + 1));
+        }
+        pop_back();
+        return iterator(this, pos.m_pos);
+    }
+
+    /// @brief Remove all the elements, keeping the allocated memory.
+    void clear()
+    {
+        while (!empty())
+        {
+            pop_back();
+        }
+        m_head = m_tail = 0;
+    }
+
+  private:
+    /**
+     * @param pos a logical position
+     * @return a reference to the slot of the array storing the given position
+     */
+    T& At(std::size_t pos)
+    {
+        return m_data[pos & (m_data.size() - 1)];
+    }
+
+    /**
+     * @param pos a logical position
+     * @return a const reference to the slot of the array storing the given position
+     */
+    const T& At(std::size_t pos) const
+    {
+        return m_data[pos & (m_data.size() - 1)];
+    }
+
+    /// @brief Double the capacity of the buffer if it is full.
+    void Grow()
+    {
+        if (size() < m_data.size())
+        {
+            return;
+        }
+        // the logical positions of the elements do not change, as the capacity
+        // is a power of two dividing the range of the logical positions
+        std::vector<T> data(m_data.empty() ? 16 : 2 * m_data.size());
+        for (std::size_t p = m_head; p != m_tail; ++p)
+        {
+            data[p & (data.size() - 1)] = std::move(At(p));
+        }
+        m_data.swap(data);
+    }
+
+    std::vector<T> m_data; //!< the array storing the elements
+    std::size_t m_head{0}; //!< the logical position of the first element
+    std::size_t m_tail{0}; //!< the logical position past the last element
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
@@ -18,7 +18,9 @@
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <queue>
 
@@ -38,6 +40,10 @@ bool NixVectorRouting<T>::g_isCacheDirty = false;
 template <typename T>
 uint32_t NixVectorRouting<T>::g_epoch = 1;
 
+/// Interface state changes not processed yet
+template <typename T>
+std::vector<typename NixVectorRouting<T>::TopologyChange> NixVectorRouting<T>::g_topologyChanges;
+
 /// Mapping of IP address to ns-3 node
 template <typename T>
 typename NixVectorRouting<T>::IpAddressToNodeMap NixVectorRouting<T>::g_ipAddressToNodeMap;
@@ -63,13 +69,24 @@ NixVectorRouting<T>::GetTypeId()
     static TypeId tid = TypeId("ns3::" + name + "NixVectorRouting")
                             .SetParent<T>()
                             .SetGroupName("NixVectorRouting")
-                            .template AddConstructor<NixVectorRouting<T>>();
+                            .template AddConstructor<NixVectorRouting<T>>()
+                            .AddAttribute("MaxCacheMemory",
+                                          "Maximum memory, in bytes, used by the nix-vector and "
+                                          "IpRoute caches of a node (0 means unlimited). The "
+                                          "least recently used entries are evicted first.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&NixVectorRouting::m_maxCacheMemory),
+                                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting()
-    : m_totalNeighbors(0)
+    : m_cacheMemory(0),
+      m_bfsTreeMemory(0),
+      m_untrackedCache(false),
+      m_maxCacheMemory(0),
+      m_totalNeighbors(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -122,6 +139,10 @@ NixVectorRouting<T>::DoDispose()
 {
     NS_LOG_FUNCTION_NOARGS();
 
+    m_cache.clear();
+    m_lru.clear();
+    DropBfsTree();
+    m_cacheMemory = 0;
     m_node = nullptr;
     m_ip = nullptr;
 
@@ -160,6 +181,7 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
     // IP address to node mapping is potentially invalid so clear it.
     // Will be repopulated in lazy evaluation when mapping is needed.
     g_ipAddressToNodeMap.clear();
+    g_topologyChanges.clear();
 }
 
 template <typename T>
@@ -167,7 +189,23 @@ void
 NixVectorRouting<T>::FlushNixCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_nixCache.clear();
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        CacheEntry& entry = it->second;
+        if (!entry.ipRoute)
+        {
+            m_cacheMemory -= entry.memory;
+            m_lru.erase(entry.lruPosition);
+            it = m_cache.erase(it);
+            continue;
+        }
+        entry.nixVector = nullptr;
+        entry.destNode = UNREACHABLE;
+        UpdateCacheEntryMemory(entry);
+        it++;
+    }
+    DropBfsTree();
+    m_untrackedCache = false;
 }
 
 template <typename T>
@@ -175,7 +213,201 @@ void
 NixVectorRouting<T>::FlushIpRouteCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_ipRouteCache.clear();
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        CacheEntry& entry = it->second;
+        if (!entry.nixVector)
+        {
+            m_cacheMemory -= entry.memory;
+            m_lru.erase(entry.lruPosition);
+            it = m_cache.erase(it);
+            continue;
+        }
+        entry.ipRoute = nullptr;
+        UpdateCacheEntryMemory(entry);
+        it++;
+    }
+}
+
+template <typename T>
+typename NixVectorRouting<T>::CacheEntry&
+NixVectorRouting<T>::TouchCacheEntry(const IpAddress& address) const
+{
+    auto [it, inserted] = m_cache.try_emplace(address);
+    CacheEntry& entry = it->second;
+    if (inserted)
+    {
+        m_lru.push_front(address);
+        entry.lruPosition = m_lru.begin();
+        entry.destNode = UNREACHABLE;
+        entry.memory = 0;
+    }
+    else
+    {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+    }
+    return entry;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::CacheNixVector(const IpAddress& address,
+                                    Ptr<NixVector> nixVector,
+                                    uint32_t destNode) const
+{
+    NS_LOG_FUNCTION(this << address << nixVector << destNode);
+
+    CacheEntry& entry = TouchCacheEntry(address);
+    NS_ASSERT(!entry.nixVector);
+    entry.nixVector = nixVector;
+    entry.destNode = destNode;
+    if (destNode == UNREACHABLE)
+    {
+        m_untrackedCache = true;
+    }
+    else
+    {
+        CountCachedPath(destNode, true);
+    }
+    UpdateCacheEntryMemory(entry);
+    EnforceCacheMemoryLimit();
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::CacheIpRoute(const IpAddress& address, Ptr<IpRoute> ipRoute) const
+{
+    NS_LOG_FUNCTION(this << address << ipRoute);
+
+    CacheEntry& entry = TouchCacheEntry(address);
+    entry.ipRoute = ipRoute;
+    UpdateCacheEntryMemory(entry);
+    EnforceCacheMemoryLimit();
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::UpdateCacheEntryMemory(CacheEntry& entry) const
+{
+    // hash table node and LRU list node, plus the referenced objects
+    uint32_t memory = sizeof(CacheEntry) + 2 * sizeof(IpAddress) + 4 * sizeof(void*);
+    if (entry.nixVector)
+    {
+        memory += sizeof(NixVector) + entry.nixVector->GetSerializedSize();
+    }
+    if (entry.ipRoute)
+    {
+        memory += sizeof(IpRoute);
+    }
+    m_cacheMemory = m_cacheMemory - entry.memory + memory;
+    entry.memory = memory;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::EnforceCacheMemoryLimit() const
+{
+    if (m_maxCacheMemory == 0)
+    {
+        return;
+    }
+
+    // never evict the entry in use (the most recently used one)
+    while (GetCacheMemoryUsage() > m_maxCacheMemory && m_lru.size() > 1)
+    {
+        auto it = m_cache.find(m_lru.back());
+        NS_ASSERT(it != m_cache.end());
+        NS_LOG_LOGIC("Evicting " << it->first << " from the cache");
+        if (it->second.nixVector && it->second.destNode != UNREACHABLE)
+        {
+            CountCachedPath(it->second.destNode, false);
+        }
+        m_cacheMemory -= it->second.memory;
+        m_cache.erase(it);
+        m_lru.pop_back();
+    }
+
+    if (GetCacheMemoryUsage() > m_maxCacheMemory)
+    {
+        NS_LOG_LOGIC("Releasing the BFS tree");
+        DropBfsTree();
+    }
+}
+
+template <typename T>
+uint64_t
+NixVectorRouting<T>::GetCacheMemoryUsage() const
+{
+    return m_cacheMemory + m_bfsTreeMemory;
+}
+
+template <typename T>
+const typename NixVectorRouting<T>::BfsTree&
+NixVectorRouting<T>::GetBfsTree() const
+{
+    uint32_t numberOfNodes = NodeList::GetNNodes();
+    if (m_bfsTree.parent.size() == numberOfNodes)
+    {
+        return m_bfsTree;
+    }
+
+    NS_LOG_LOGIC("Building the BFS tree of node " << m_node->GetId());
+    BFS(numberOfNodes, m_node, nullptr, m_bfsTree, nullptr);
+    m_bfsTree.forwarding.assign(numberOfNodes, 0);
+    m_bfsTreeMemory = 3 * sizeof(uint32_t) * numberOfNodes;
+
+    // the tree may have been released while the cache still holds
+    // nix-vectors built from it: count their paths again
+    for (auto& [address, entry] : m_cache)
+    {
+        if (!entry.nixVector || entry.destNode == UNREACHABLE)
+        {
+            continue;
+        }
+        if (entry.destNode >= numberOfNodes || m_bfsTree.parent[entry.destNode] == UNREACHABLE)
+        {
+            entry.destNode = UNREACHABLE;
+            m_untrackedCache = true;
+            continue;
+        }
+        CountCachedPath(entry.destNode, true);
+    }
+    return m_bfsTree;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::DropBfsTree() const
+{
+    m_bfsTree = BfsTree();
+    m_bfsTreeMemory = 0;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::CountCachedPath(uint32_t dest, bool added) const
+{
+    if (m_bfsTree.parent.empty())
+    {
+        return;
+    }
+
+    // the destination itself does not forward the packet
+    uint32_t source = m_node->GetId();
+    uint32_t node = dest;
+    do
+    {
+        node = m_bfsTree.parent[node];
+        if (added)
+        {
+            m_bfsTree.forwarding[node]++;
+        }
+        else
+        {
+            NS_ASSERT(m_bfsTree.forwarding[node] > 0);
+            m_bfsTree.forwarding[node]--;
+        }
+    } while (node != source);
 }
 
 template <typename T>
@@ -209,25 +441,29 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
     {
         // otherwise proceed as normal
         // and build the nix vector
-        std::vector<Ptr<Node>> parentVector;
-
-        if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
+        bool found = false;
+        if (source == m_node && !oif)
         {
-            if (BuildNixVector(parentVector, source->GetId(), destNode->GetId(), nixVector))
-            {
-                return nixVector;
-            }
-            else
-            {
-                NS_LOG_ERROR("No routing path exists");
-                return nullptr;
-            }
+            // all the nix-vectors of this node share the same BFS tree,
+            // which is built only once
+            const BfsTree& tree = GetBfsTree();
+            found = tree.parent[destNode->GetId()] != UNREACHABLE &&
+                    BuildNixVector(tree.parent, source->GetId(), destNode->GetId(), nixVector);
+            EnforceCacheMemoryLimit();
         }
         else
+        {
+            BfsTree tree;
+            found = BFS(NodeList::GetNNodes(), source, destNode, tree, oif) &&
+                    BuildNixVector(tree.parent, source->GetId(), destNode->GetId(), nixVector);
+        }
+
+        if (!found)
         {
             NS_LOG_ERROR("No routing path exists");
             return nullptr;
         }
+        return nixVector;
     }
 }
 
@@ -239,12 +475,13 @@ NixVectorRouting<T>::GetNixVectorInCache(const IpAddress& address, bool& foundIn
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_nixCache.find(address);
-    if (iter != m_nixCache.end())
+    auto iter = m_cache.find(address);
+    if (iter != m_cache.end() && iter->second.nixVector)
     {
         NS_LOG_LOGIC("Found Nix-vector in cache.");
+        m_lru.splice(m_lru.begin(), m_lru, iter->second.lruPosition);
         foundInCache = true;
-        return iter->second;
+        return iter->second.nixVector;
     }
 
     // not in cache
@@ -260,11 +497,12 @@ NixVectorRouting<T>::GetIpRouteInCache(IpAddress address)
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_ipRouteCache.find(address);
-    if (iter != m_ipRouteCache.end())
+    auto iter = m_cache.find(address);
+    if (iter != m_cache.end() && iter->second.ipRoute)
     {
         NS_LOG_LOGIC("Found IpRoute in cache.");
-        return iter->second;
+        m_lru.splice(m_lru.begin(), m_lru, iter->second.lruPosition);
+        return iter->second.ipRoute;
     }
 
     // not in cache
@@ -273,7 +511,7 @@ NixVectorRouting<T>::GetIpRouteInCache(IpAddress address)
 
 template <typename T>
 bool
-NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
+NixVectorRouting<T>::BuildNixVector(const std::vector<uint32_t>& parentVector,
                                     uint32_t source,
                                     uint32_t dest,
                                     Ptr<NixVector> nixVector) const
@@ -285,12 +523,12 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
         return true;
     }
 
-    if (!parentVector.at(dest))
+    if (parentVector.at(dest) == UNREACHABLE)
     {
         return false;
     }
 
-    Ptr<Node> parentNode = parentVector.at(dest);
+    Ptr<Node> parentNode = NodeList::GetNode(parentVector.at(dest));
 
     uint32_t numberOfDevices = parentNode->GetNDevices();
     uint32_t destId = 0;
@@ -344,7 +582,7 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
 
     // recurse through T vector, grabbing the path
     // and building the nix vector
-    BuildNixVector(parentVector, source, (parentVector.at(dest))->GetId(), nixVector);
+    BuildNixVector(parentVector, source, parentVector.at(dest), nixVector);
     return true;
 }
 
@@ -752,8 +990,11 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         nixVectorInCache = GetNixVector(m_node, destAddress, oif);
         if (nixVectorInCache)
         {
-            // cache it
-            m_nixCache.insert(typename NixMap_t::value_type(destAddress, nixVectorInCache));
+            // cache it, keeping track of the tree path unless a specific
+            // output interface was requested
+            CacheNixVector(destAddress,
+                           nixVectorInCache,
+                           oif ? UNREACHABLE : GetNodeByIp(destAddress)->GetId());
         }
     }
 
@@ -785,14 +1026,8 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         if (!rtentry || !(rtentry->GetOutputDevice() == oif))
         {
             // not in cache or a different specified output
-            // device is to be used
-
-            // first, make sure we erase existing (incorrect)
-            // rtentry from the map
-            if (rtentry)
-            {
-                m_ipRouteCache.erase(destAddress);
-            }
+            // device is to be used; the existing (incorrect)
+            // rtentry is replaced below
 
             NS_LOG_LOGIC("IpRoute not in cache, build: ");
             IpAddress gatewayIp;
@@ -831,7 +1066,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             sockerr = Socket::ERROR_NOTERROR;
 
             // add rtentry to cache
-            m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+            CacheIpRoute(destAddress, rtentry);
         }
 
         NS_LOG_LOGIC("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: "
@@ -964,7 +1199,7 @@ NixVectorRouting<T>::RouteInput(Ptr<const Packet> p,
         rtentry->SetOutputDevice(m_ip->GetNetDevice(interfaceIndex));
 
         // add rtentry to cache
-        m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+        CacheIpRoute(destAddress, rtentry);
     }
 
     NS_LOG_LOGIC("At Node " << m_node->GetId() << ", Extracting " << numberOfBits
@@ -1004,56 +1239,73 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
     *os << "Node: " << m_node->GetId() << ", Time: " << Now().As(unit)
         << ", Local time: " << m_node->GetLocalTime().As(unit) << ", Nix Routing" << std::endl;
 
+    // print the entries sorted by destination
+    std::vector<std::pair<IpAddress, const CacheEntry*>> entries;
+    entries.reserve(m_cache.size());
+    for (const auto& [address, entry] : m_cache)
+    {
+        entries.emplace_back(address, &entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
     *os << "NixCache:" << std::endl;
-    if (m_nixCache.size() > 0)
+    bool header = true;
+    for (const auto& [address, entry] : entries)
     {
-        *os << std::setw(30) << "Destination";
-        *os << "NixVector" << std::endl;
-        for (auto it = m_nixCache.begin(); it != m_nixCache.end(); it++)
+        if (!entry->nixVector)
         {
-            std::ostringstream dest;
-            dest << it->first;
-            *os << std::setw(30) << dest.str();
-            if (it->second)
-            {
-                *os << *(it->second) << std::endl;
-            }
-            else
-            {
-                *os << "-" << std::endl;
-            }
+            continue;
         }
+        if (header)
+        {
+            *os << std::setw(30) << "Destination";
+            *os << "NixVector" << std::endl;
+            header = false;
+        }
+        std::ostringstream dest;
+        dest << address;
+        *os << std::setw(30) << dest.str();
+        *os << *(entry->nixVector) << std::endl;
     }
 
     *os << "IpRouteCache:" << std::endl;
-    if (m_ipRouteCache.size() > 0)
+    header = true;
+    for (const auto& [address, entry] : entries)
     {
-        *os << std::setw(30) << "Destination";
-        *os << std::setw(30) << "Gateway";
-        *os << std::setw(30) << "Source";
-        *os << "OutputDevice" << std::endl;
-        for (auto it = m_ipRouteCache.begin(); it != m_ipRouteCache.end(); it++)
+        Ptr<IpRoute> route = entry->ipRoute;
+        if (!route)
         {
-            std::ostringstream dest;
-            std::ostringstream gw;
-            std::ostringstream src;
-            dest << it->second->GetDestination();
-            *os << std::setw(30) << dest.str();
-            gw << it->second->GetGateway();
-            *os << std::setw(30) << gw.str();
-            src << it->second->GetSource();
-            *os << std::setw(30) << src.str();
-            *os << "  ";
-            if (Names::FindName(it->second->GetOutputDevice()) != "")
-            {
-                *os << Names::FindName(it->second->GetOutputDevice());
-            }
-            else
-            {
-                *os << it->second->GetOutputDevice()->GetIfIndex();
-            }
-            *os << std::endl;
+            continue;
         }
+        if (header)
+        {
+            *os << std::setw(30) << "Destination";
+            *os << std::setw(30) << "Gateway";
+            *os << std::setw(30) << "Source";
+            *os << "OutputDevice" << std::endl;
+            header = false;
+        }
+        std::ostringstream dest;
+        std::ostringstream gw;
+        std::ostringstream src;
+        dest << route->GetDestination();
+        *os << std::setw(30) << dest.str();
+        gw << route->GetGateway();
+        *os << std::setw(30) << gw.str();
+        src << route->GetSource();
+        *os << std::setw(30) << src.str();
+        *os << "  ";
+        if (Names::FindName(route->GetOutputDevice()) != "")
+        {
+            *os << Names::FindName(route->GetOutputDevice());
+        }
+        else
+        {
+            *os << route->GetOutputDevice()->GetIfIndex();
+        }
+        *os << std::endl;
     }
     *os << std::endl;
     // Restore the previous ostream state
@@ -1065,14 +1317,14 @@ template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceUp(uint32_t i)
 {
-    g_isCacheDirty = true;
+    RecordTopologyChange(i, true);
 }
 
 template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceDown(uint32_t i)
 {
-    g_isCacheDirty = true;
+    RecordTopologyChange(i, false);
 }
 
 template <typename T>
@@ -1116,20 +1368,26 @@ bool
 NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                          Ptr<Node> source,
                          Ptr<Node> dest,
-                         std::vector<Ptr<Node>>& parentVector,
+                         BfsTree& tree,
                          Ptr<NetDevice> oif) const
 {
-    NS_LOG_FUNCTION(this << numberOfNodes << source << dest << parentVector << oif);
+    NS_LOG_FUNCTION(this << numberOfNodes << source << dest << oif);
 
-    NS_LOG_LOGIC("Going from Node " << source->GetId() << " to Node " << dest->GetId());
+    NS_LOG_LOGIC("Going from Node " << source->GetId() << " to "
+                                    << (dest ? "Node " + std::to_string(dest->GetId())
+                                             : std::string("all the nodes")));
     std::queue<Ptr<Node>> greyNodeList; // discovered nodes with unexplored children
+    std::vector<uint32_t>& parentVector = tree.parent;
+    uint32_t discovered = 0;
 
     // reset the parent vector
-    parentVector.assign(numberOfNodes, nullptr); // initialize to 0
+    parentVector.assign(numberOfNodes, UNREACHABLE);
+    tree.order.assign(numberOfNodes, UNREACHABLE);
 
     // Add the source node to the queue, set its parent to itself
     greyNodeList.push(source);
-    parentVector.at(source->GetId()) = source;
+    parentVector.at(source->GetId()) = source->GetId();
+    tree.order.at(source->GetId()) = discovered++;
 
     // BFS loop
     while (!greyNodeList.empty())
@@ -1192,9 +1450,10 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                 // by checking to see if it has a parent
                 // if it doesn't (null or 0), then set its parent and
                 // push to the queue
-                if (!parentVector.at(remoteNode->GetId()))
+                if (parentVector.at(remoteNode->GetId()) == UNREACHABLE)
                 {
-                    parentVector.at(remoteNode->GetId()) = currNode;
+                    parentVector.at(remoteNode->GetId()) = currNode->GetId();
+                    tree.order.at(remoteNode->GetId()) = discovered++;
                     greyNodeList.push(remoteNode);
                 }
             }
@@ -1255,9 +1514,10 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                     // by checking to see if it has a parent
                     // if it doesn't (null or 0), then set its parent and
                     // push to the queue
-                    if (!parentVector.at(remoteNode->GetId()))
+                    if (parentVector.at(remoteNode->GetId()) == UNREACHABLE)
                     {
-                        parentVector.at(remoteNode->GetId()) = currNode;
+                        parentVector.at(remoteNode->GetId()) = currNode->GetId();
+                        tree.order.at(remoteNode->GetId()) = discovered++;
                         greyNodeList.push(remoteNode);
                     }
                 }
@@ -1269,8 +1529,8 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
         greyNodeList.pop();
     }
 
-    // Didn't find the dest...
-    return false;
+    // Didn't find the dest (or explored the whole network)
+    return !dest;
 }
 
 template <typename T>
@@ -1328,7 +1588,7 @@ NixVectorRouting<T>::PrintRoutingPath(Ptr<Node> source,
         {
             // Make a NixVector copy to work with. This is because
             // we don't want to extract the bits from nixVectorInCache
-            // which is stored in the m_nixCache.
+            // which is stored in the cache.
             nixVector = nixVectorInCache->Copy();
 
             *os << *nixVector;
@@ -1412,6 +1672,10 @@ template <typename T>
 void
 NixVectorRouting<T>::CheckCacheStateAndFlush() const
 {
+    if (!g_isCacheDirty && !g_topologyChanges.empty())
+    {
+        ApplyTopologyChanges();
+    }
     if (g_isCacheDirty)
     {
         FlushGlobalNixRoutingCache();
@@ -1420,11 +1684,190 @@ NixVectorRouting<T>::CheckCacheStateAndFlush() const
     }
 }
 
+template <typename T>
+void
+NixVectorRouting<T>::RecordTopologyChange(uint32_t interface, bool up)
+{
+    NS_LOG_FUNCTION(this << interface << up);
+
+    if (g_isCacheDirty)
+    {
+        // everything will be flushed anyway
+        return;
+    }
+    if (!m_node || g_topologyChanges.size() >= MAX_TOPOLOGY_CHANGES)
+    {
+        g_isCacheDirty = true;
+        g_topologyChanges.clear();
+        return;
+    }
+    g_topologyChanges.push_back({m_node->GetId(), interface, up});
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::ApplyTopologyChanges() const
+{
+    NS_LOG_FUNCTION(this << g_topologyChanges.size());
+
+    std::vector<TopologyChange> changes;
+    changes.swap(g_topologyChanges);
+
+    // An interface state change only alters the adjacency of the nodes
+    // attached to the same channel.  Bridges and mixed up/down changes
+    // are not handled selectively.
+    std::vector<std::vector<uint32_t>> affectedNodes;
+    for (const auto& change : changes)
+    {
+        if (change.up != changes.front().up || change.nodeId >= NodeList::GetNNodes())
+        {
+            g_isCacheDirty = true;
+            return;
+        }
+        Ptr<Ip> ip = NodeList::GetNode(change.nodeId)->template GetObject<Ip>();
+        if (!ip || change.interface >= ip->GetNInterfaces())
+        {
+            g_isCacheDirty = true;
+            return;
+        }
+        Ptr<NetDevice> device = ip->GetNetDevice(change.interface);
+        if (device->IsBridge() || NetDeviceIsBridged(device))
+        {
+            g_isCacheDirty = true;
+            return;
+        }
+        std::vector<uint32_t> nodes{change.nodeId};
+        Ptr<Channel> channel = device->GetChannel();
+        for (std::size_t i = 0; channel && i < channel->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> remoteDevice = channel->GetDevice(i);
+            if (remoteDevice == device)
+            {
+                continue;
+            }
+            if (NetDeviceIsBridged(remoteDevice))
+            {
+                g_isCacheDirty = true;
+                return;
+            }
+            nodes.push_back(remoteDevice->GetNode()->GetId());
+        }
+        affectedNodes.push_back(std::move(nodes));
+    }
+
+    // in-flight packets must rebuild their nix-vectors
+    g_epoch++;
+
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<NixVectorRouting<T>> rp = (*i)->GetObject<NixVectorRouting>();
+        if (!rp)
+        {
+            continue;
+        }
+        // IpRoutes of the transit nodes are indexed by destination only,
+        // hence they cannot be matched against a given source
+        rp->FlushIpRouteCache();
+        rp->InvalidateNixCache(affectedNodes, changes.front().up);
+        for (auto& [address, entry] : rp->m_cache)
+        {
+            entry.nixVector->SetEpoch(g_epoch);
+        }
+    }
+
+    for (const auto& nodes : affectedNodes)
+    {
+        for (auto id : nodes)
+        {
+            Ptr<NixVectorRouting<T>> rp = NodeList::GetNode(id)->GetObject<NixVectorRouting>();
+            if (rp)
+            {
+                rp->m_totalNeighbors = 0;
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::InvalidateNixCache(const std::vector<std::vector<uint32_t>>& changes,
+                                        bool up) const
+{
+    if (m_cache.empty())
+    {
+        DropBfsTree();
+        return;
+    }
+    if (m_bfsTree.parent.empty() || m_untrackedCache)
+    {
+        // the cached paths are not known
+        FlushNixCache();
+        return;
+    }
+
+    const BfsTree& tree = m_bfsTree;
+    bool affected = false;
+    bool reached = false;
+    for (const auto& nodes : changes)
+    {
+        uint32_t x = nodes.front();
+        for (auto n : nodes)
+        {
+            if (n >= tree.parent.size() || tree.forwarding[n] > 0)
+            {
+                // the neighbor indexes of a node forwarding a cached path
+                // changed, or a cached path lost a link
+                affected = true;
+                break;
+            }
+            reached = reached || tree.parent[n] != UNREACHABLE;
+            if (!up || n == x)
+            {
+                continue;
+            }
+            // A new link between x and n changes the BFS tree if either
+            // endpoint is discovered before the parent of the other one
+            bool xReached = tree.parent[x] != UNREACHABLE;
+            bool nReached = tree.parent[n] != UNREACHABLE;
+            if (xReached && nReached &&
+                (tree.order[x] < tree.order[tree.parent[n]] ||
+                 tree.order[n] < tree.order[tree.parent[x]]))
+            {
+                affected = true;
+                break;
+            }
+            if (xReached != nReached && changes.size() > 1)
+            {
+                affected = true;
+                break;
+            }
+        }
+        if (affected)
+        {
+            break;
+        }
+    }
+
+    if (affected)
+    {
+        NS_LOG_LOGIC("Flushing the nix-vector cache of node " << m_node->GetId());
+        FlushNixCache();
+    }
+    else if (reached)
+    {
+        // the cached paths are still valid, but the tree is not
+        DropBfsTree();
+        GetBfsTree();
+    }
+}
+
 /* Public template function declarations */
 template void NixVectorRouting<Ipv4RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv6RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv4RoutingProtocol>::FlushGlobalNixRoutingCache() const;
 template void NixVectorRouting<Ipv6RoutingProtocol>::FlushGlobalNixRoutingCache() const;
+template uint64_t NixVectorRouting<Ipv4RoutingProtocol>::GetCacheMemoryUsage() const;
+template uint64_t NixVectorRouting<Ipv6RoutingProtocol>::GetCacheMemoryUsage() const;
 template void NixVectorRouting<Ipv4RoutingProtocol>::PrintRoutingPath(
     Ptr<Node> source,
     IpAddress dest,
@@ -30,8 +30,10 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
-#include <map>
+#include <limits>
+#include <list>
 #include <unordered_map>
+#include <vector>
 
 // NOLINTBEGIN(modernize-use-override)
 
@@ -131,7 +133,59 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                           Ptr<OutputStreamWrapper> stream,
                           Time::Unit unit) const;
 
+    /**
+     * @brief Get the memory used by the routing caches of this node
+     *
+     * The estimate includes the nix-vector and IpRoute caches and the
+     * shortest-path tree shared by all the nix-vectors built by this node.
+     *
+     * @return the estimated memory usage, in bytes
+     */
+    uint64_t GetCacheMemoryUsage() const;
+
   private:
+    /// Marker for unreachable nodes and untracked cache entries
+    static constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Shortest-path tree computed by BFS from a source node, indexed by node id.
+     */
+    struct BfsTree
+    {
+        std::vector<uint32_t> parent;     //!< Parent of each node (UNREACHABLE if not reached)
+        std::vector<uint32_t> order;      //!< Discovery order of each node
+        std::vector<uint32_t> forwarding; //!< Number of cached paths forwarded by each node
+    };
+
+    /**
+     * An entry of the routing cache.  Transit nodes only cache the IpRoute,
+     * source nodes cache both the nix-vector and the IpRoute.
+     */
+    struct CacheEntry
+    {
+        Ptr<NixVector> nixVector; //!< Cached nix-vector (may be null)
+        Ptr<IpRoute> ipRoute;     //!< Cached IpRoute (may be null)
+        uint32_t destNode;        //!< Destination node id, UNREACHABLE if not in the tree
+        uint32_t memory;          //!< Estimated memory used by the entry
+        typename std::list<IpAddress>::iterator lruPosition; //!< Position in the LRU list
+    };
+
+    /**
+     * A run-time change of the state of an interface.
+     */
+    struct TopologyChange
+    {
+        uint32_t nodeId;    //!< Id of the node owning the interface
+        uint32_t interface; //!< Interface index
+        bool up;            //!< True if the interface went up, false if it went down
+    };
+
+    /**
+     * Maximum number of pending topology changes handled by targeted
+     * invalidation; beyond this, all the caches are flushed.
+     */
+    static constexpr std::size_t MAX_TOPOLOGY_CHANGES = 64;
+
     /**
      * Flushes the cache which stores nix-vector based on
      * destination IP
@@ -178,6 +232,86 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     Ptr<IpRoute> GetIpRouteInCache(IpAddress address);
 
+    /**
+     * Finds or creates the cache entry for the given destination and marks
+     * it as the most recently used one.
+     * @param address Destination address
+     * @returns The cache entry.
+     */
+    CacheEntry& TouchCacheEntry(const IpAddress& address) const;
+
+    /**
+     * Stores a nix-vector in the cache.
+     * @param address Destination address
+     * @param nixVector The nix-vector
+     * @param destNode Destination node id if the nix-vector was built from the
+     *        shared BFS tree, UNREACHABLE otherwise
+     */
+    void CacheNixVector(const IpAddress& address,
+                        Ptr<NixVector> nixVector,
+                        uint32_t destNode) const;
+
+    /**
+     * Stores an IpRoute in the cache.
+     * @param address Destination address
+     * @param ipRoute The IpRoute
+     */
+    void CacheIpRoute(const IpAddress& address, Ptr<IpRoute> ipRoute) const;
+
+    /**
+     * Updates the memory accounted for a cache entry.
+     * @param entry The cache entry
+     */
+    void UpdateCacheEntryMemory(CacheEntry& entry) const;
+
+    /**
+     * Evicts the least recently used cache entries, and then the shared BFS
+     * tree, until the memory usage is within the MaxCacheMemory attribute.
+     */
+    void EnforceCacheMemoryLimit() const;
+
+    /**
+     * Returns the shortest-path tree rooted at this node, building it if needed.
+     * @returns The shared BFS tree.
+     */
+    const BfsTree& GetBfsTree() const;
+
+    /**
+     * Releases the shared BFS tree.
+     */
+    void DropBfsTree() const;
+
+    /**
+     * Updates the number of cached paths forwarded by the nodes on the path
+     * from this node to the given destination.
+     * @param dest Destination node id
+     * @param added True if a path has been added, false if it has been removed
+     */
+    void CountCachedPath(uint32_t dest, bool added) const;
+
+    /**
+     * Records an interface state change, to be processed by
+     * CheckCacheStateAndFlush.
+     * @param interface Interface index
+     * @param up True if the interface went up, false if it went down
+     */
+    void RecordTopologyChange(uint32_t interface, bool up);
+
+    /**
+     * Invalidates only the caches affected by the pending topology changes.
+     * Sets g_isCacheDirty if the changes cannot be handled selectively.
+     */
+    void ApplyTopologyChanges() const;
+
+    /**
+     * Flushes the nix-vector cache of this node if it is affected by the
+     * given topology changes.
+     * @param changes Nodes affected by each change; the first node of each
+     *        set owns the interface that changed
+     * @param up True if the interfaces went up, false if they went down
+     */
+    void InvalidateNixCache(const std::vector<std::vector<uint32_t>>& changes, bool up) const;
+
     /**
      * Given a net-device returns all the adjacent net-devices,
      * essentially getting the neighbors on that channel
@@ -206,14 +340,14 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     Ptr<IpInterface> GetInterfaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
     /**
-     * Recurses the T vector, created by BFS and actually builds the nixvector
-     * @param [in] parentVector Parent vector for retracing routes
+     * Recurses the parent vector, created by BFS and actually builds the nixvector
+     * @param [in] parentVector Parent vector (node ids) for retracing routes
      * @param [in] source Source Node index
      * @param [in] dest Destination Node index
      * @param [out] nixVector the NixVector to be used for routing
      * @returns true on success, false otherwise.
      */
-    bool BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
+    bool BuildNixVector(const std::vector<uint32_t>& parentVector,
                         uint32_t source,
                         uint32_t dest,
                         Ptr<NixVector> nixVector) const;
@@ -249,15 +383,15 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      * @brief Breadth first search algorithm.
      * @param [in] numberOfNodes total number of nodes
      * @param [in] source Source Node
-     * @param [in] dest Destination Node
-     * @param [out] parentVector Parent vector for retracing routes
+     * @param [in] dest Destination Node, or null to explore the whole network
+     * @param [out] tree Parent vector and discovery order for retracing routes
      * @param [in] oif specific output interface to use from source node, if not null
      * @returns false if dest not found, true o.w.
      */
     bool BFS(uint32_t numberOfNodes,
              Ptr<Node> source,
              Ptr<Node> dest,
-             std::vector<Ptr<Node>>& parentVector,
+             BfsTree& tree,
              Ptr<NetDevice> oif) const;
 
     /**
@@ -272,10 +406,8 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void DoDispose();
 
-    /// Map of IpAddress to NixVector
-    typedef std::map<IpAddress, Ptr<NixVector>> NixMap_t;
-    /// Map of IpAddress to IpRoute
-    typedef std::map<IpAddress, Ptr<IpRoute>> IpRouteMap_t;
+    /// Map of IpAddress to cache entry
+    typedef std::unordered_map<IpAddress, CacheEntry, IpAddressHash> Cache_t;
 
     /// Callback for IPv4 unicast packets to be forwarded
     typedef Callback<void, Ptr<IpRoute>, Ptr<const Packet>, const IpHeader&>
@@ -480,11 +612,32 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     static uint32_t g_epoch;
 
-    /** Cache stores nix-vectors based on destination ip */
-    mutable NixMap_t m_nixCache;
+    /**
+     * Interface state changes not processed yet.  Unless g_isCacheDirty is set,
+     * they are used to invalidate only the caches they affect.
+     */
+    static std::vector<TopologyChange> g_topologyChanges;
+
+    /** Cache stores nix-vectors and IpRoutes based on destination ip */
+    mutable Cache_t m_cache;
+
+    /** Destinations in the cache, from the most to the least recently used */
+    mutable std::list<IpAddress> m_lru;
+
+    /** Shortest-path tree rooted at this node, shared by the cached nix-vectors */
+    mutable BfsTree m_bfsTree;
+
+    /** Estimated memory used by the cache entries */
+    mutable uint64_t m_cacheMemory;
+
+    /** Estimated memory used by the shared BFS tree */
+    mutable uint64_t m_bfsTreeMemory;
+
+    /** True if the cache holds nix-vectors not built from the shared BFS tree */
+    mutable bool m_untrackedCache;
 
-    /** Cache stores IpRoutes based on destination ip */
-    mutable IpRouteMap_t m_ipRouteCache;
+    /** Maximum memory used by the caches, in bytes (0 means unlimited) */
+    uint64_t m_maxCacheMemory;
 
     Ptr<Ip> m_ip;     //!< IP object
     Ptr<Node> m_node; //!< Node object
@@ -14,6 +14,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-routing.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -21,6 +22,7 @@
 #include "ns3/test.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -382,6 +384,151 @@ NixVectorRoutingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup nix-vector-routing-test
+ * @ingroup tests
+ *
+ * The topology is of the form:
+ * @verbatim
+                         n3
+                        /  |
+    n0 -- n1 -- n2 --<     |
+                        \  |
+                         n4
+   \endverbatim
+ *
+ * Following are the tests in this test case:
+ * - Test that a link not used by any cached path (n3-n4) going down
+ *   keeps the nix-vector cache of n0 and flushes the IpRoute caches.
+ * - Test that a link used by a cached path (n1-n2) going down flushes
+ *   the nix-vector cache of n0.
+ * - Test that the MaxCacheMemory attribute evicts the least recently
+ *   used entries.
+ *
+ * @brief IPv4 Nix-Vector Routing cache test
+ */
+class NixVectorRoutingCacheTest : public TestCase
+{
+  public:
+    NixVectorRoutingCacheTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Route a packet from the given node.
+     * @param node The source node.
+     * @param dest The destination address.
+     * @returns The route, or null if there is no route.
+     */
+    Ptr<Ipv4Route> RouteFrom(Ptr<Node> node, Ipv4Address dest);
+
+    /**
+     * @brief Print the routing caches of the given node.
+     * @param node The node.
+     * @returns The content of the caches.
+     */
+    std::string PrintCaches(Ptr<Node> node);
+};
+
+NixVectorRoutingCacheTest::NixVectorRoutingCacheTest()
+    : TestCase("targeted invalidation and eviction of the nix-vector caches")
+{
+}
+
+Ptr<Ipv4Route>
+NixVectorRoutingCacheTest::RouteFrom(Ptr<Node> node, Ipv4Address dest)
+{
+    Ipv4Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    return node->GetObject<Ipv4>()->GetRoutingProtocol()->RouteOutput(nullptr,
+                                                                      header,
+                                                                      nullptr,
+                                                                      sockerr);
+}
+
+std::string
+NixVectorRoutingCacheTest::PrintCaches(Ptr<Node> node)
+{
+    std::ostringstream stringStream;
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&stringStream);
+    node->GetObject<Ipv4>()->GetRoutingProtocol()->PrintRoutingTable(stream);
+    std::string caches = stringStream.str();
+    // skip the header line
+    return caches.substr(caches.find('\n') + 1);
+}
+
+void
+NixVectorRoutingCacheTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    Ipv4NixVectorHelper nixRouting;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(nixRouting);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    const std::vector<std::pair<uint32_t, uint32_t>> links{{0, 1}, {1, 2}, {2, 3}, {2, 4}, {3, 4}};
+    std::vector<NetDeviceContainer> devices;
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    for (const auto& [a, b] : links)
+    {
+        devices.push_back(devHelper.Install(NodeContainer(nodes.Get(a), nodes.Get(b))));
+        address.Assign(devices.back());
+        address.NewNetwork();
+    }
+
+    Ptr<Node> n0 = nodes.Get(0);
+    Ipv4Address n3Address("10.1.2.2");
+    Ipv4Address n4Address("10.1.3.2");
+
+    NS_TEST_ASSERT_MSG_NE(RouteFrom(n0, n3Address), nullptr, "n3 should be reachable");
+    NS_TEST_ASSERT_MSG_NE(RouteFrom(n0, n4Address), nullptr, "n4 should be reachable");
+    std::string caches = PrintCaches(n0);
+    NS_TEST_EXPECT_MSG_NE(caches.find("10.1.2.2"), std::string::npos, "n3 should be cached");
+    NS_TEST_EXPECT_MSG_NE(caches.find("10.1.3.2"), std::string::npos, "n4 should be cached");
+    Ptr<Ipv4NixVectorRouting> rp = n0->GetObject<Ipv4NixVectorRouting>();
+    NS_TEST_EXPECT_MSG_GT(rp->GetCacheMemoryUsage(), 0, "The caches should use some memory");
+
+    // n3 - n4 is not used by the cached paths
+    Ptr<Ipv4> ipv4 = nodes.Get(4)->GetObject<Ipv4>();
+    ipv4->SetDown(ipv4->GetInterfaceForDevice(devices[4].Get(1)));
+    caches = PrintCaches(n0);
+    const std::string keptNixCache = "NixCache:\n"
+                                     "Destination                   NixVector\n"
+                                     "10.1.2.2                      0101 (4 bits left)\n"
+                                     "10.1.3.2                      0110 (4 bits left)\n"
+                                     "IpRouteCache:\n\n";
+    NS_TEST_EXPECT_MSG_EQ(caches, keptNixCache, "Only the IpRoute cache should have been flushed");
+    NS_TEST_EXPECT_MSG_EQ(RouteFrom(n0, n4Address)->GetGateway(),
+                          Ipv4Address("10.1.0.2"),
+                          "The cached nix-vector should still be usable");
+
+    // n1 - n2 is used by the cached paths
+    ipv4 = nodes.Get(1)->GetObject<Ipv4>();
+    ipv4->SetDown(ipv4->GetInterfaceForDevice(devices[1].Get(0)));
+    NS_TEST_EXPECT_MSG_EQ(PrintCaches(n0),
+                          "NixCache:\nIpRouteCache:\n\n",
+                          "The caches should have been flushed");
+    NS_TEST_EXPECT_MSG_EQ(RouteFrom(n0, n3Address), nullptr, "n3 should not be reachable");
+
+    // keep a single entry in the cache
+    rp->SetAttribute("MaxCacheMemory", UintegerValue(1));
+    ipv4->SetUp(ipv4->GetInterfaceForDevice(devices[1].Get(0)));
+    NS_TEST_ASSERT_MSG_NE(RouteFrom(n0, n3Address), nullptr, "n3 should be reachable");
+    NS_TEST_ASSERT_MSG_NE(RouteFrom(n0, n4Address), nullptr, "n4 should be reachable");
+    caches = PrintCaches(n0);
+    NS_TEST_EXPECT_MSG_EQ(caches.find("10.1.2.2"), std::string::npos, "n3 should be evicted");
+    NS_TEST_EXPECT_MSG_NE(caches.find("10.1.3.2"), std::string::npos, "n4 should be cached");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup nix-vector-routing-test
  * @ingroup tests
@@ -395,6 +542,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingCacheTest(), TestCase::Duration::QUICK);
     }
 };
 
@@ -19,7 +19,9 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -72,6 +74,28 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+double
+PropagationLossModel::GetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    double range = DoGetMaxRange(txPowerDbm, rxPowerDbm);
+    if (m_next)
+    {
+        // models with a finite range never increase the power they receive,
+        // hence the power is lower than rxPowerDbm beyond the shortest range
+        double nextRange = m_next->GetMaxRange(txPowerDbm, rxPowerDbm);
+        range = (std::isfinite(range) && std::isfinite(nextRange))
+                    ? std::min(range, nextRange)
+                    : std::numeric_limits<double>::infinity();
+    }
+    return range;
+}
+
+double
+PropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -273,6 +297,23 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+double
+FriisPropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_minLoss < 0)
+    {
+        // the power is increased at short distances
+        return std::numeric_limits<double>::infinity();
+    }
+    if (txPowerDbm - m_minLoss < rxPowerDbm)
+    {
+        return 0;
+    }
+    // distance at which the loss is txPowerDbm - rxPowerDbm
+    return m_lambda / (4 * M_PI * std::sqrt(m_systemLoss)) *
+           std::pow(10, (txPowerDbm - rxPowerDbm) / 20);
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -550,6 +591,21 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+double
+LogDistancePropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_referenceLoss < 0 || m_exponent <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (txPowerDbm - m_referenceLoss < rxPowerDbm)
+    {
+        return 0;
+    }
+    return m_referenceDistance *
+           std::pow(10, (txPowerDbm - m_referenceLoss - rxPowerDbm) / (10 * m_exponent));
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -649,6 +705,40 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+double
+ThreeLogDistancePropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (m_referenceLoss < 0 || m_exponent0 <= 0 || m_exponent1 <= 0 || m_exponent2 <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    double maxLoss = txPowerDbm - rxPowerDbm;
+    if (maxLoss < 0)
+    {
+        return 0;
+    }
+    if (maxLoss < m_referenceLoss)
+    {
+        return m_distance0;
+    }
+    // find the field in which the path loss reaches maxLoss
+    const double distances[] = {m_distance0, m_distance1, m_distance2};
+    const double exponents[] = {m_exponent0, m_exponent1, m_exponent2};
+    double fieldLoss = m_referenceLoss; // path loss at the beginning of the field
+    std::size_t field = 0;
+    for (; field < 2; field++)
+    {
+        double nextFieldLoss =
+            fieldLoss + 10 * exponents[field] * std::log10(distances[field + 1] / distances[field]);
+        if (maxLoss < nextFieldLoss)
+        {
+            break;
+        }
+        fieldLoss = nextFieldLoss;
+    }
+    return distances[field] * std::pow(10, (maxLoss - fieldLoss) / (10 * exponents[field]));
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -947,6 +1037,18 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+double
+RangePropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const
+{
+    if (rxPowerDbm <= -1000 || txPowerDbm < -1000)
+    {
+        // the power returned beyond the range may not be lower than rxPowerDbm,
+        // or may be greater than txPowerDbm
+        return std::numeric_limits<double>::infinity();
+    }
+    return (txPowerDbm < rxPowerDbm) ? 0 : m_range;
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -90,6 +90,21 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns a distance beyond which the Rx power returned by CalcRxPower,
+     * taking into account all the PropagationLossModel(s) chained to the
+     * current one, is guaranteed to be lower than a given power.
+     *
+     * The bound is conservative: it is infinite as soon as one of the models
+     * of the chain cannot provide it, e.g., because it may increase the power
+     * it receives, like the fading models.
+     *
+     * @param txPowerDbm the transmission power (in dBm)
+     * @param rxPowerDbm the reception power (in dBm)
+     * @returns the distance (in meters), possibly infinite
+     */
+    double GetMaxRange(double txPowerDbm, double rxPowerDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -128,6 +143,18 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Subclasses that never increase the power they receive can override
+     * this method to return the distance beyond which DoCalcRxPower returns
+     * a power lower than rxPowerDbm when given txPowerDbm, or any lower power.
+     * The default implementation returns an infinite distance.
+     *
+     * @param txPowerDbm the transmission power (in dBm)
+     * @param rxPowerDbm the reception power (in dBm)
+     * @returns the distance (in meters), possibly infinite
+     */
+    virtual double DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -294,6 +321,7 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    double DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -485,6 +513,7 @@ class LogDistancePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    double DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -561,6 +590,7 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    double DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_distance0; //!< Beginning of the first (near) distance field
@@ -767,6 +797,7 @@ class RangePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    double DoGetMaxRange(double txPowerDbm, double rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_range; //!< Maximum Transmission Range (meters)
@@ -14,6 +14,9 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("PropagationLossModelsTest");
@@ -481,6 +484,91 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Check the maximum range of the propagation loss models and of their chains
+ */
+class MaxRangePropagationLossModelTestCase : public TestCase
+{
+  public:
+    MaxRangePropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the Rx power is below a threshold just beyond the maximum
+     * range, and above it just within.
+     * @param lossModel the loss model
+     * @param txPowerDbm the transmission power (dBm)
+     * @param rxPowerDbm the threshold (dBm)
+     */
+    void CheckMaxRange(Ptr<PropagationLossModel> lossModel, double txPowerDbm, double rxPowerDbm);
+};
+
+MaxRangePropagationLossModelTestCase::MaxRangePropagationLossModelTestCase()
+    : TestCase("Test the maximum range of the propagation loss models")
+{
+}
+
+void
+MaxRangePropagationLossModelTestCase::CheckMaxRange(Ptr<PropagationLossModel> lossModel,
+                                                    double txPowerDbm,
+                                                    double rxPowerDbm)
+{
+    double range = lossModel->GetMaxRange(txPowerDbm, rxPowerDbm);
+    NS_TEST_ASSERT_MSG_EQ(std::isfinite(range), true, "The range should be finite");
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(range * 1.001, 0, 0));
+    NS_TEST_EXPECT_MSG_LT(lossModel->CalcRxPower(txPowerDbm, a, b),
+                          rxPowerDbm,
+                          "The power should be below the threshold beyond " << range << " m");
+    b->SetPosition(Vector(range * 0.999, 0, 0));
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(lossModel->CalcRxPower(txPowerDbm, a, b),
+                                rxPowerDbm,
+                                "The range " << range << " m should be tight");
+}
+
+void
+MaxRangePropagationLossModelTestCase::DoRun()
+{
+    auto friis = CreateObject<FriisPropagationLossModel>();
+    CheckMaxRange(friis, 20, -82);
+    CheckMaxRange(friis, 16, -95);
+
+    auto logDistance = CreateObject<LogDistancePropagationLossModel>();
+    CheckMaxRange(logDistance, 20, -82);
+
+    auto threeLogDistance = CreateObject<ThreeLogDistancePropagationLossModel>();
+    // the threshold is reached in the near, middle and far fields
+    CheckMaxRange(threeLogDistance, 20, -60);
+    CheckMaxRange(threeLogDistance, 20, -80);
+    CheckMaxRange(threeLogDistance, 20, -110);
+
+    auto range =
+        CreateObjectWithAttributes<RangePropagationLossModel>("MaxRange", DoubleValue(250));
+    NS_TEST_EXPECT_MSG_EQ(range->GetMaxRange(20, -82), 250, "Unexpected range");
+    NS_TEST_EXPECT_MSG_EQ(range->GetMaxRange(-90, -82), 0, "Unexpected range");
+
+    // the range of a chain is the shortest range of its models
+    auto chain = CreateObject<LogDistancePropagationLossModel>();
+    chain->SetNext(range);
+    NS_TEST_EXPECT_MSG_EQ(chain->GetMaxRange(20, -82),
+                          std::min(logDistance->GetMaxRange(20, -82), 250.0),
+                          "Unexpected range of a chain");
+
+    // the range of a chain including a model which may increase the power is not bounded
+    auto fading = CreateObject<LogDistancePropagationLossModel>();
+    fading->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(fading->GetMaxRange(20, -82)),
+                          true,
+                          "The range of a chain with fading should not be bounded");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -492,6 +580,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - the maximum range of the models
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -507,6 +596,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MaxRangePropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -117,6 +117,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            InvalidateSpatialIndex();
             break; // there should be at most one entry
         }
     }
@@ -145,6 +146,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    InvalidateSpatialIndex();
 
     if (inserted)
     {
@@ -241,6 +243,20 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIterator->second.m_spectrumConverterMap.begin()->first);
 
+    // skip the receivers which cannot be within range, if the spatial index is used
+    std::vector<Ptr<SpectrumPhy>> candidates;
+    bool useCandidates = false;
+    if (IsSpatialIndexEnabled())
+    {
+        std::vector<Ptr<SpectrumPhy>> rxPhys;
+        for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+        {
+            rxPhys.insert(rxPhys.end(), rxInfo.m_rxPhys.begin(), rxInfo.m_rxPhys.end());
+        }
+        useCandidates = GetRxCandidates(txParams, rxPhys, candidates);
+        std::sort(candidates.begin(), candidates.end());
+    }
+
     std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds{};
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
@@ -292,6 +308,12 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
                           "(i.e., AddRx should be called again after model is changed)");
 
+            if (useCandidates &&
+                !std::binary_search(candidates.begin(), candidates.end(), *rxPhyIterator))
+            {
+                continue;
+            }
+
             auto txAntennaGain{0.0};
             if ((*rxPhyIterator) != txParams->txPhy)
             {
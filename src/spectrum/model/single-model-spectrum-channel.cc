@@ -69,6 +69,7 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        InvalidateSpatialIndex();
     }
 }
 
@@ -79,6 +80,7 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     if (std::find(m_phyList.cbegin(), m_phyList.cend(), phy) == m_phyList.cend())
     {
         m_phyList.push_back(phy);
+        InvalidateSpatialIndex();
     }
     else
     {
@@ -116,7 +118,12 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     Ptr<MobilityModel> refSenderMobility = txParams->txPhy->GetMobility();
     Ptr<MobilityModel> senderMobility = refSenderMobility;
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    // skip the receivers which cannot be within range, if the spatial index is used
+    PhyList candidates;
+    const PhyList& rxPhys =
+        GetRxCandidates(txParams, m_phyList, candidates) ? candidates : m_phyList;
+
+    for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
         Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
@@ -8,11 +8,15 @@
 
 #include "spectrum-channel.h"
 
+#include "wraparound-model.h"
+
 #include "ns3/abort.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 
+#include <cmath>
+
 namespace ns3
 {
 
@@ -45,6 +49,7 @@ SpectrumChannel::DoDispose()
         m_phasedArraySpectrumPropagationLoss->Dispose();
     }
     m_phasedArraySpectrumPropagationLoss = nullptr;
+    InvalidateSpatialIndex();
 }
 
 TypeId
@@ -69,6 +74,24 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("SpatialIndexCellSize",
+                          "If positive, the size (m) of the side of the cells of a spatial "
+                          "index of the receivers, used to skip the receivers beyond the "
+                          "distance at which the PropagationLossModel predicts a loss larger "
+                          "than MaxLossDb plus SpatialIndexMaxAntennaGain. It is best set close "
+                          "to that distance. The skipped receivers do not fire the Gain and "
+                          "PathLoss trace sources.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_spatialIndexCellSize),
+                          MakeDoubleChecker<double>(0))
+
+            .AddAttribute("SpatialIndexMaxAntennaGain",
+                          "An upper bound (dB) of the sum of the TX and RX antenna gains, "
+                          "used by the spatial index to compute the range of the signals.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_spatialIndexMaxAntennaGain),
+                          MakeDoubleChecker<double>())
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
@@ -262,4 +285,64 @@ SpectrumChannel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+SpectrumChannel::GetRxCandidates(Ptr<const SpectrumSignalParameters> txParams,
+                                 const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                 std::vector<Ptr<SpectrumPhy>>& candidates)
+{
+    NS_LOG_FUNCTION(this << txParams);
+    if (!IsSpatialIndexEnabled() || !m_propagationLoss || GetObject<WraparoundModel>())
+    {
+        return false;
+    }
+    auto txMobility = txParams->txPhy->GetMobility();
+    if (!txMobility)
+    {
+        return false;
+    }
+    // the propagation gain is independent of the TX power
+    double range =
+        m_propagationLoss->GetMaxRange(0, -(m_maxLossDb + m_spatialIndexMaxAntennaGain));
+    if (!std::isfinite(range))
+    {
+        return false;
+    }
+
+    if (m_spatialIndex.GetCellSize() != m_spatialIndexCellSize)
+    {
+        InvalidateSpatialIndex();
+    }
+    if (m_indexedPhys.empty())
+    {
+        m_spatialIndex.SetCellSize(m_spatialIndexCellSize);
+        for (const auto& phy : rxPhys)
+        {
+            m_spatialIndex.Add(phy->GetMobility());
+        }
+        m_indexedPhys = rxPhys;
+    }
+
+    candidates.clear();
+    for (auto id : m_spatialIndex.GetCandidates(txMobility->GetPosition(), range))
+    {
+        candidates.push_back(m_indexedPhys[id]);
+    }
+    NS_LOG_DEBUG(candidates.size() << " receivers within " << range << " m");
+    return true;
+}
+
+bool
+SpectrumChannel::IsSpatialIndexEnabled() const
+{
+    return m_spatialIndexCellSize > 0;
+}
+
+void
+SpectrumChannel::InvalidateSpatialIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_spatialIndex.Clear();
+    m_indexedPhys.clear();
+}
+
 } // namespace ns3
@@ -16,6 +16,7 @@
 #include "spectrum-transmit-filter.h"
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid-index.h"
 #include "ns3/mobility-model.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -23,6 +24,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -227,6 +230,38 @@ class SpectrumChannel : public Channel
      */
     virtual int64_t DoAssignStreams(int64_t stream);
 
+    /**
+     * Select, with the spatial index of the receivers, the receivers which
+     * may be within range of a transmission, i.e., for which the
+     * PropagationLossModel may not predict a loss larger than MaxLossDb plus
+     * SpatialIndexMaxAntennaGain.
+     *
+     * The spatial index is used if SpatialIndexCellSize is positive, the
+     * PropagationLossModel provides a maximum range, the transmitter has a
+     * mobility model and no WraparoundModel is aggregated to the channel. It
+     * is built from the given receivers when it is first used after
+     * InvalidateSpatialIndex has been called.
+     *
+     * @param txParams the parameters of the transmitted signal
+     * @param rxPhys all the receivers attached to the channel
+     * @param [out] candidates the receivers which may be within range, in the order of rxPhys
+     * @return whether the spatial index was used; if not, candidates is left unchanged
+     */
+    bool GetRxCandidates(Ptr<const SpectrumSignalParameters> txParams,
+                         const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                         std::vector<Ptr<SpectrumPhy>>& candidates);
+
+    /**
+     * @return whether the SpatialIndexCellSize attribute enables the spatial index of the receivers
+     */
+    bool IsSpatialIndexEnabled() const;
+
+    /**
+     * Invalidate the spatial index of the receivers. Must be called whenever
+     * a receiver is added or removed.
+     */
+    void InvalidateSpatialIndex();
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -282,6 +317,12 @@ class SpectrumChannel : public Channel
      * Transmit filter to be used with this channel
      */
     Ptr<SpectrumTransmitFilter> m_filter{nullptr};
+
+  private:
+    double m_spatialIndexCellSize;               //!< size of the cells of the spatial index (m)
+    double m_spatialIndexMaxAntennaGain;         //!< bound of the sum of the antenna gains (dB)
+    MobilityGridIndex m_spatialIndex;            //!< spatial index of the receivers
+    std::vector<Ptr<SpectrumPhy>> m_indexedPhys; //!< receivers of the spatial index, by identifier
 };
 
 } // namespace ns3
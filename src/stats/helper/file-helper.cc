@@ -164,6 +164,44 @@ FileHelper::WriteProbe(const std::string& typeId,
     }
 }
 
+void
+FileHelper::WriteProbe(const std::string& typeId,
+                       const std::vector<Ptr<Object>>& objects,
+                       const std::string& traceSource,
+                       const std::string& probeTraceSource)
+{
+    NS_LOG_FUNCTION(this << typeId << objects.size() << traceSource << probeTraceSource);
+
+    NS_ABORT_MSG_IF(objects.empty(), "No object to probe");
+
+    // Hook one probe per object and one or more aggregators together; the
+    // probes are connected to the objects directly, so there are no config
+    // paths to resolve nor wildcard matches to format.
+    bool onlyOneAggregator = (objects.size() == 1);
+    for (std::size_t i = 0; i < objects.size(); i++)
+    {
+        std::string matchIdentifier = std::to_string(i);
+        ConnectProbeToAggregator(typeId,
+                                 matchIdentifier,
+                                 objects[i],
+                                 traceSource,
+                                 probeTraceSource,
+                                 onlyOneAggregator
+                                     ? m_outputFileNameWithoutExtension
+                                     : m_outputFileNameWithoutExtension + "-" + matchIdentifier,
+                                 onlyOneAggregator);
+    }
+}
+
+void
+FileHelper::WriteProbe(const std::string& typeId,
+                       Ptr<Object> object,
+                       const std::string& traceSource,
+                       const std::string& probeTraceSource)
+{
+    WriteProbe(typeId, std::vector<Ptr<Object>>{object}, traceSource, probeTraceSource);
+}
+
 void
 FileHelper::AddProbe(const std::string& typeId,
                      const std::string& probeName,
@@ -171,6 +209,33 @@ FileHelper::AddProbe(const std::string& typeId,
 {
     NS_LOG_FUNCTION(this << typeId << probeName << path);
 
+    Ptr<Probe> probe = CreateProbe(typeId, probeName);
+
+    // Set the path.  Note that no return value is checked here.
+    probe->ConnectByPath(path);
+}
+
+void
+FileHelper::AddProbe(const std::string& typeId,
+                     const std::string& probeName,
+                     Ptr<Object> object,
+                     const std::string& traceSource)
+{
+    NS_LOG_FUNCTION(this << typeId << probeName << object << traceSource);
+
+    Ptr<Probe> probe = CreateProbe(typeId, probeName);
+
+    bool connected = probe->ConnectByObject(traceSource, object);
+    NS_ABORT_MSG_UNLESS(connected,
+                        "Cannot connect to trace source " << traceSource << " of "
+                                                          << object->GetInstanceTypeId());
+}
+
+Ptr<Probe>
+FileHelper::CreateProbe(const std::string& typeId, const std::string& probeName)
+{
+    NS_LOG_FUNCTION(this << typeId << probeName);
+
     // See if this probe had already been added.
     if (m_probeMap.count(probeName) > 0)
     {
@@ -190,14 +255,12 @@ FileHelper::AddProbe(const std::string& typeId,
     // Set the probe's name.
     probe->SetName(probeName);
 
-    // Set the path.  Note that no return value is checked here.
-    probe->ConnectByPath(path);
-
     // Enable logging of data for the probe.
     probe->Enable();
 
     // Add this probe to the map so that its values can be used.
     m_probeMap[probeName] = std::make_pair(probe, typeId);
+    return probe;
 }
 
 void
@@ -459,6 +522,55 @@ FileHelper::ConnectProbeToAggregator(const std::string& typeId,
     // memory after this function ends.
     AddProbe(typeId, probeName, path);
 
+    ConnectProbeToAdaptor(probeName,
+                          probeContext,
+                          probeTraceSource,
+                          outputFileNameWithoutExtension,
+                          onlyOneAggregator);
+}
+
+void
+FileHelper::ConnectProbeToAggregator(const std::string& typeId,
+                                     const std::string& matchIdentifier,
+                                     Ptr<Object> object,
+                                     const std::string& traceSource,
+                                     const std::string& probeTraceSource,
+                                     const std::string& outputFileNameWithoutExtension,
+                                     bool onlyOneAggregator)
+{
+    NS_LOG_FUNCTION(this << typeId << matchIdentifier << object << traceSource << probeTraceSource
+                         << outputFileNameWithoutExtension << onlyOneAggregator);
+
+    // Increment the total number of file probes that have been created.
+    m_fileProbeCount++;
+
+    // Create a unique name for this probe.
+    std::string probeName = "FileProbe-" + std::to_string(m_fileProbeCount);
+
+    // Create a unique dataset context string for this probe.
+    std::string probeContext = probeName + "/" + matchIdentifier + "/" + probeTraceSource;
+
+    // Add the probe to the map of probes, which will keep the probe in
+    // memory after this function ends.
+    AddProbe(typeId, probeName, object, traceSource);
+
+    ConnectProbeToAdaptor(probeName,
+                          probeContext,
+                          probeTraceSource,
+                          outputFileNameWithoutExtension,
+                          onlyOneAggregator);
+}
+
+void
+FileHelper::ConnectProbeToAdaptor(const std::string& probeName,
+                                  const std::string& probeContext,
+                                  const std::string& probeTraceSource,
+                                  const std::string& outputFileNameWithoutExtension,
+                                  bool onlyOneAggregator)
+{
+    NS_LOG_FUNCTION(this << probeName << probeContext << probeTraceSource
+                         << outputFileNameWithoutExtension << onlyOneAggregator);
+
     // Because the callbacks to the probes' trace sources don't use the
     // probe's context, a unique adaptor needs to be created for each
     // probe context so that information is not lost.
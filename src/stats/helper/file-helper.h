@@ -17,6 +17,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -97,6 +99,52 @@ class FileHelper
                     const std::string& path,
                     const std::string& probeTraceSource);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param objects the objects whose trace source is probed
+     * @param traceSource the name of the trace source of the objects
+     * @param probeTraceSource the probe trace source to access.
+     *
+     * Creates output files as WriteProbe with a config path matching each
+     * of the objects would do, but connecting the probes directly to the
+     * trace source of the objects, so that no config path is resolved.
+     * If there is more than one object, one output file is created for
+     * each of them, whose name is suffixed with the index of the object,
+     * e.g., "packet-byte-count-0.txt" or "packet-byte-count-12.txt".
+     */
+    void WriteProbe(const std::string& typeId,
+                    const std::vector<Ptr<Object>>& objects,
+                    const std::string& traceSource,
+                    const std::string& probeTraceSource);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param object the object whose trace source is probed
+     * @param traceSource the name of the trace source of the object
+     * @param probeTraceSource the probe trace source to access.
+     *
+     * Creates the output file of a single object.
+     */
+    void WriteProbe(const std::string& typeId,
+                    Ptr<Object> object,
+                    const std::string& traceSource,
+                    const std::string& probeTraceSource);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param objects a container of objects, such as a NodeContainer or a
+     * NetDeviceContainer
+     * @param traceSource the name of the trace source of the objects
+     * @param probeTraceSource the probe trace source to access.
+     *
+     * Creates one output file per object of the container.
+     */
+    template <typename Container, typename = decltype(std::declval<const Container&>().Begin())>
+    void WriteProbe(const std::string& typeId,
+                    const Container& objects,
+                    const std::string& traceSource,
+                    const std::string& probeTraceSource);
+
     /**
      * @param adaptorName the timeSeriesAdaptor's name.
      *
@@ -245,6 +293,28 @@ class FileHelper
      */
     void AddProbe(const std::string& typeId, const std::string& probeName, const std::string& path);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param probeName the probe's name.
+     * @param object the object to connect the probe to.
+     * @param traceSource the trace source of the object.
+     *
+     * @brief Adds a probe connected to the trace source of an object.
+     */
+    void AddProbe(const std::string& typeId,
+                  const std::string& probeName,
+                  Ptr<Object> object,
+                  const std::string& traceSource);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param probeName the probe's name.
+     * @return the probe, enabled and added to the map of probes
+     *
+     * @brief Creates a probe, which is not connected yet.
+     */
+    Ptr<Probe> CreateProbe(const std::string& typeId, const std::string& probeName);
+
     /**
      * @param typeId the type ID for the probe used when it is created.
      * @param matchIdentifier this string is used to make the probe's
@@ -267,6 +337,46 @@ class FileHelper
                                   const std::string& outputFileNameWithoutExtension,
                                   bool onlyOneAggregator);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param matchIdentifier this string is used to make the probe's
+     * context be unique.
+     * @param object the object to connect the probe to.
+     * @param traceSource the trace source of the object.
+     * @param probeTraceSource the probe trace source to access.
+     * @param outputFileNameWithoutExtension name of output file to
+     * write with no extension
+     * @param onlyOneAggregator indicates if more than one aggregator
+     * should be created or not.
+     *
+     * @brief Connects a probe of the trace source of an object to the aggregator.
+     */
+    void ConnectProbeToAggregator(const std::string& typeId,
+                                  const std::string& matchIdentifier,
+                                  Ptr<Object> object,
+                                  const std::string& traceSource,
+                                  const std::string& probeTraceSource,
+                                  const std::string& outputFileNameWithoutExtension,
+                                  bool onlyOneAggregator);
+
+    /**
+     * @param probeName the probe's name.
+     * @param probeContext the unique context of the probe.
+     * @param probeTraceSource the probe trace source to access.
+     * @param outputFileNameWithoutExtension name of output file to
+     * write with no extension
+     * @param onlyOneAggregator indicates if more than one aggregator
+     * should be created or not.
+     *
+     * @brief Connects an added probe to a new time series adaptor, and the
+     * adaptor to an aggregator.
+     */
+    void ConnectProbeToAdaptor(const std::string& probeName,
+                               const std::string& probeContext,
+                               const std::string& probeTraceSource,
+                               const std::string& outputFileNameWithoutExtension,
+                               bool onlyOneAggregator);
+
     /// Used to create the probes and collectors as they are added.
     ObjectFactory m_factory;
 
@@ -310,6 +420,19 @@ class FileHelper
     std::string m_10dFormat; //!< Format string for 10D format C-style sprintf() function.
 };
 
+template <typename Container, typename>
+void
+FileHelper::WriteProbe(const std::string& typeId,
+                       const Container& objects,
+                       const std::string& traceSource,
+                       const std::string& probeTraceSource)
+{
+    WriteProbe(typeId,
+               std::vector<Ptr<Object>>(objects.Begin(), objects.End()),
+               traceSource,
+               probeTraceSource);
+}
+
 } // namespace ns3
 
 #endif // FILE_HELPER_H
@@ -185,6 +185,62 @@ GnuplotHelper::PlotProbe(const std::string& typeId,
     }
 }
 
+void
+GnuplotHelper::PlotProbe(const std::string& typeId,
+                         const std::vector<Ptr<Object>>& objects,
+                         const std::string& traceSource,
+                         const std::string& probeTraceSource,
+                         const std::string& title,
+                         GnuplotAggregator::KeyLocation keyLocation)
+{
+    NS_LOG_FUNCTION(this << typeId << objects.size() << traceSource << probeTraceSource << title
+                         << keyLocation);
+
+    // Get a pointer to the aggregator.
+    Ptr<GnuplotAggregator> aggregator = GetAggregator();
+
+    // Add a subtitle to the title to show the trace source.
+    aggregator->SetTitle(m_title + " \\n\\nTrace Source: " + traceSource);
+
+    // Set the default dataset plotting style for the values.
+    GnuplotAggregator::Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES_POINTS);
+
+    // Set the location of the key in the plot.
+    aggregator->SetKeyLocation(keyLocation);
+
+    NS_ABORT_MSG_IF(objects.empty(), "No object to probe");
+
+    // Hook one probe per object and the aggregator together; the probes
+    // are connected to the objects directly, so there are no config paths
+    // to resolve nor wildcard matches to format.
+    for (std::size_t i = 0; i < objects.size(); i++)
+    {
+        std::string matchIdentifier = std::to_string(i);
+        ConnectProbeToAggregator(typeId,
+                                 matchIdentifier,
+                                 objects[i],
+                                 traceSource,
+                                 probeTraceSource,
+                                 objects.size() == 1 ? title : title + "-" + matchIdentifier);
+    }
+}
+
+void
+GnuplotHelper::PlotProbe(const std::string& typeId,
+                         Ptr<Object> object,
+                         const std::string& traceSource,
+                         const std::string& probeTraceSource,
+                         const std::string& title,
+                         GnuplotAggregator::KeyLocation keyLocation)
+{
+    PlotProbe(typeId,
+              std::vector<Ptr<Object>>{object},
+              traceSource,
+              probeTraceSource,
+              title,
+              keyLocation);
+}
+
 void
 GnuplotHelper::AddProbe(const std::string& typeId,
                         const std::string& probeName,
@@ -192,6 +248,33 @@ GnuplotHelper::AddProbe(const std::string& typeId,
 {
     NS_LOG_FUNCTION(this << typeId << probeName << path);
 
+    Ptr<Probe> probe = CreateProbe(typeId, probeName);
+
+    // Set the path.  Note that no return value is checked here.
+    probe->ConnectByPath(path);
+}
+
+void
+GnuplotHelper::AddProbe(const std::string& typeId,
+                        const std::string& probeName,
+                        Ptr<Object> object,
+                        const std::string& traceSource)
+{
+    NS_LOG_FUNCTION(this << typeId << probeName << object << traceSource);
+
+    Ptr<Probe> probe = CreateProbe(typeId, probeName);
+
+    bool connected = probe->ConnectByObject(traceSource, object);
+    NS_ABORT_MSG_UNLESS(connected,
+                        "Cannot connect to trace source " << traceSource << " of "
+                                                          << object->GetInstanceTypeId());
+}
+
+Ptr<Probe>
+GnuplotHelper::CreateProbe(const std::string& typeId, const std::string& probeName)
+{
+    NS_LOG_FUNCTION(this << typeId << probeName);
+
     // See if this probe had already been added.
     if (m_probeMap.count(probeName) > 0)
     {
@@ -211,14 +294,12 @@ GnuplotHelper::AddProbe(const std::string& typeId,
     // Set the probe's name.
     probe->SetName(probeName);
 
-    // Set the path.  Note that no return value is checked here.
-    probe->ConnectByPath(path);
-
     // Enable logging of data for the probe.
     probe->Enable();
 
     // Add this probe to the map so that its values can be used.
     m_probeMap[probeName] = std::make_pair(probe, typeId);
+    return probe;
 }
 
 void
@@ -299,8 +380,6 @@ GnuplotHelper::ConnectProbeToAggregator(const std::string& typeId,
 {
     NS_LOG_FUNCTION(this << typeId << matchIdentifier << path << probeTraceSource << title);
 
-    Ptr<GnuplotAggregator> aggregator = GetAggregator();
-
     // Increment the total number of plot probes that have been created.
     m_plotProbeCount++;
 
@@ -316,6 +395,46 @@ GnuplotHelper::ConnectProbeToAggregator(const std::string& typeId,
     // memory after this function ends.
     AddProbe(typeId, probeName, path);
 
+    ConnectProbeToAdaptor(probeName, probeContext, probeTraceSource, title);
+}
+
+void
+GnuplotHelper::ConnectProbeToAggregator(const std::string& typeId,
+                                        const std::string& matchIdentifier,
+                                        Ptr<Object> object,
+                                        const std::string& traceSource,
+                                        const std::string& probeTraceSource,
+                                        const std::string& title)
+{
+    NS_LOG_FUNCTION(this << typeId << matchIdentifier << object << traceSource
+                         << probeTraceSource << title);
+
+    // Increment the total number of plot probes that have been created.
+    m_plotProbeCount++;
+
+    // Create a unique name for this probe.
+    std::string probeName = "PlotProbe-" + std::to_string(m_plotProbeCount);
+
+    // Create a unique dataset context string for this probe.
+    std::string probeContext = probeName + "/" + matchIdentifier + "/" + probeTraceSource;
+
+    // Add the probe to the map of probes, which will keep the probe in
+    // memory after this function ends.
+    AddProbe(typeId, probeName, object, traceSource);
+
+    ConnectProbeToAdaptor(probeName, probeContext, probeTraceSource, title);
+}
+
+void
+GnuplotHelper::ConnectProbeToAdaptor(const std::string& probeName,
+                                     const std::string& probeContext,
+                                     const std::string& probeTraceSource,
+                                     const std::string& title)
+{
+    NS_LOG_FUNCTION(this << probeName << probeContext << probeTraceSource << title);
+
+    Ptr<GnuplotAggregator> aggregator = GetAggregator();
+
     // Because the callbacks to the probes' trace sources don't use the
     // probe's context, a unique adaptor needs to be created for each
     // probe context so that information is not lost.
@@ -18,6 +18,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -115,6 +116,64 @@ class GnuplotHelper
                    const std::string& title,
                    GnuplotAggregator::KeyLocation keyLocation = GnuplotAggregator::KEY_INSIDE);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param objects the objects whose trace source is probed
+     * @param traceSource the name of the trace source of the objects
+     * @param probeTraceSource the probe trace source to access.
+     * @param title the title to be associated to the datasets
+     * @param keyLocation the location of the key in the plot.
+     *
+     * Plots one dataset per object, as PlotProbe with a config path
+     * matching each of the objects would do, but connecting the probes
+     * directly to the trace source of the objects, so that no config path
+     * is resolved.  If there is more than one object, the dataset titles
+     * are suffixed with the index of the object, e.g., "bytes-0" or
+     * "bytes-12".
+     */
+    void PlotProbe(const std::string& typeId,
+                   const std::vector<Ptr<Object>>& objects,
+                   const std::string& traceSource,
+                   const std::string& probeTraceSource,
+                   const std::string& title,
+                   GnuplotAggregator::KeyLocation keyLocation = GnuplotAggregator::KEY_INSIDE);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param object the object whose trace source is probed
+     * @param traceSource the name of the trace source of the object
+     * @param probeTraceSource the probe trace source to access.
+     * @param title the title to be associated to this dataset
+     * @param keyLocation the location of the key in the plot.
+     *
+     * Plots the dataset of a single object.
+     */
+    void PlotProbe(const std::string& typeId,
+                   Ptr<Object> object,
+                   const std::string& traceSource,
+                   const std::string& probeTraceSource,
+                   const std::string& title,
+                   GnuplotAggregator::KeyLocation keyLocation = GnuplotAggregator::KEY_INSIDE);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param objects a container of objects, such as a NodeContainer or a
+     * NetDeviceContainer
+     * @param traceSource the name of the trace source of the objects
+     * @param probeTraceSource the probe trace source to access.
+     * @param title the title to be associated to the datasets
+     * @param keyLocation the location of the key in the plot.
+     *
+     * Plots one dataset per object of the container.
+     */
+    template <typename Container, typename = decltype(std::declval<const Container&>().Begin())>
+    void PlotProbe(const std::string& typeId,
+                   const Container& objects,
+                   const std::string& traceSource,
+                   const std::string& probeTraceSource,
+                   const std::string& title,
+                   GnuplotAggregator::KeyLocation keyLocation = GnuplotAggregator::KEY_INSIDE);
+
     /**
      * @param adaptorName the timeSeriesAdaptor's name.
      *
@@ -148,6 +207,28 @@ class GnuplotHelper
      */
     void AddProbe(const std::string& typeId, const std::string& probeName, const std::string& path);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param probeName the probe's name.
+     * @param object the object to connect the probe to.
+     * @param traceSource the trace source of the object.
+     *
+     * @brief Adds a probe connected to the trace source of an object.
+     */
+    void AddProbe(const std::string& typeId,
+                  const std::string& probeName,
+                  Ptr<Object> object,
+                  const std::string& traceSource);
+
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param probeName the probe's name.
+     * @return the probe, enabled and added to the map of probes
+     *
+     * @brief Creates a probe, which is not connected yet.
+     */
+    Ptr<Probe> CreateProbe(const std::string& typeId, const std::string& probeName);
+
     /**
      * @brief Constructs the aggregator.
      */
@@ -169,6 +250,38 @@ class GnuplotHelper
                                   const std::string& probeTraceSource,
                                   const std::string& title);
 
+    /**
+     * @param typeId the type ID for the probe used when it is created.
+     * @param matchIdentifier this string is used to make the probe's
+     * context be unique.
+     * @param object the object to connect the probe to.
+     * @param traceSource the trace source of the object.
+     * @param probeTraceSource the probe trace source to access.
+     * @param title the title to be associated to this dataset.
+     *
+     * @brief Connects a probe of the trace source of an object to the aggregator.
+     */
+    void ConnectProbeToAggregator(const std::string& typeId,
+                                  const std::string& matchIdentifier,
+                                  Ptr<Object> object,
+                                  const std::string& traceSource,
+                                  const std::string& probeTraceSource,
+                                  const std::string& title);
+
+    /**
+     * @param probeName the probe's name.
+     * @param probeContext the unique dataset context of the probe.
+     * @param probeTraceSource the probe trace source to access.
+     * @param title the title to be associated to this dataset.
+     *
+     * @brief Connects an added probe to a new time series adaptor, and the
+     * adaptor to the aggregator.
+     */
+    void ConnectProbeToAdaptor(const std::string& probeName,
+                               const std::string& probeContext,
+                               const std::string& probeTraceSource,
+                               const std::string& title);
+
     /// Used to create the probes and collectors as they are added.
     ObjectFactory m_factory;
 
@@ -200,6 +313,23 @@ class GnuplotHelper
     std::string m_terminalType;
 };
 
+template <typename Container, typename>
+void
+GnuplotHelper::PlotProbe(const std::string& typeId,
+                         const Container& objects,
+                         const std::string& traceSource,
+                         const std::string& probeTraceSource,
+                         const std::string& title,
+                         GnuplotAggregator::KeyLocation keyLocation)
+{
+    PlotProbe(typeId,
+              std::vector<Ptr<Object>>(objects.Begin(), objects.End()),
+              traceSource,
+              probeTraceSource,
+              title,
+              keyLocation);
+}
+
 } // namespace ns3
 
 #endif // GNUPLOT_HELPER_H
@@ -0,0 +1,237 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "columnar-aggregator.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ColumnarAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED(ColumnarAggregator);
+
+TypeId
+ColumnarAggregator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ColumnarAggregator")
+            .SetParent<DataCollectionObject>()
+            .SetGroupName("Stats")
+            .AddAttribute("ChunkSize",
+                          "The number of rows, over all the datasets, buffered before they are "
+                          "written to the file.",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&ColumnarAggregator::m_chunkSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Decimation",
+                          "Only one value out of Decimation is kept for each dataset.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ColumnarAggregator::m_decimation),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Window",
+                          "If positive, the width of the windows, along the first value, in "
+                          "which the second values are summarized by their count, minimum, "
+                          "mean and maximum. Must be set before the first value is received.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&ColumnarAggregator::m_window),
+                          MakeDoubleChecker<double>(0));
+
+    return tid;
+}
+
+ColumnarAggregator::ColumnarAggregator(const std::string& outputFileName)
+    : m_outputFileName(outputFileName)
+{
+    NS_LOG_FUNCTION(this << outputFileName);
+}
+
+ColumnarAggregator::~ColumnarAggregator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ColumnarAggregator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto& series : m_series)
+    {
+        CloseWindow(series);
+    }
+    Flush();
+    m_file.close();
+    m_series.clear();
+    m_ids.clear();
+    DataCollectionObject::DoDispose();
+}
+
+ColumnarAggregator::Series&
+ColumnarAggregator::GetSeries(const std::string& context)
+{
+    auto [it, inserted] = m_ids.try_emplace(context, static_cast<uint32_t>(m_series.size()));
+    if (inserted)
+    {
+        m_series.emplace_back();
+        m_series.back().context = context;
+        m_series.back().columns.resize(m_window > 0 ? 5 : 2);
+    }
+    return m_series[it->second];
+}
+
+void
+ColumnarAggregator::AddRow(Series& series, std::initializer_list<double> row)
+{
+    auto column = series.columns.begin();
+    for (double value : row)
+    {
+        (column++)->push_back(value);
+    }
+    if (++m_bufferedRows >= m_chunkSize)
+    {
+        Flush();
+    }
+}
+
+void
+ColumnarAggregator::CloseWindow(Series& series)
+{
+    if (series.count == 0)
+    {
+        return;
+    }
+    AddRow(series,
+           {series.window * m_window,
+            static_cast<double>(series.count),
+            series.min,
+            series.sum / series.count,
+            series.max});
+    series.count = 0;
+}
+
+void
+ColumnarAggregator::Write1d(std::string context, double v1)
+{
+    Write2d(std::move(context), Simulator::Now().GetSeconds(), v1);
+}
+
+void
+ColumnarAggregator::Write2d(std::string context, double v1, double v2)
+{
+    NS_LOG_FUNCTION(this << context << v1 << v2);
+
+    if (!m_enabled)
+    {
+        return;
+    }
+    Series& series = GetSeries(context);
+    if (series.received++ % m_decimation != 0)
+    {
+        return;
+    }
+    if (m_window <= 0)
+    {
+        AddRow(series, {v1, v2});
+        return;
+    }
+
+    auto window = static_cast<int64_t>(std::floor(v1 / m_window));
+    if (series.count > 0 && window != series.window)
+    {
+        CloseWindow(series);
+    }
+    if (series.count == 0)
+    {
+        series.window = window;
+        series.min = v2;
+        series.max = v2;
+        series.sum = 0;
+    }
+    series.count++;
+    series.min = std::min(series.min, v2);
+    series.max = std::max(series.max, v2);
+    series.sum += v2;
+}
+
+void
+ColumnarAggregator::WriteUint32(uint32_t value)
+{
+    m_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+ColumnarAggregator::WriteString(const std::string& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    m_file.write(value.data(), value.size());
+}
+
+void
+ColumnarAggregator::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_bufferedRows == 0)
+    {
+        return;
+    }
+    if (!m_file.is_open())
+    {
+        m_file.open(m_outputFileName, std::ios::binary);
+        NS_ABORT_MSG_UNLESS(m_file.is_open(), "Cannot open " << m_outputFileName);
+        m_file.write("NS3COLS", 8);
+        WriteUint32(1);
+    }
+
+    for (uint32_t id = 0; id < m_series.size(); id++)
+    {
+        Series& series = m_series[id];
+        auto rows = static_cast<uint32_t>(series.columns[0].size());
+        if (rows == 0)
+        {
+            continue;
+        }
+        if (!series.described)
+        {
+            WriteUint32(SERIES);
+            WriteUint32(id);
+            WriteString(series.context);
+            WriteUint32(static_cast<uint32_t>(series.columns.size()));
+            if (series.columns.size() == 2)
+            {
+                WriteString("x");
+                WriteString("y");
+            }
+            else
+            {
+                for (const char* name : {"start", "count", "min", "mean", "max"})
+                {
+                    WriteString(name);
+                }
+            }
+            series.described = true;
+        }
+        WriteUint32(CHUNK);
+        WriteUint32(id);
+        WriteUint32(rows);
+        for (auto& column : series.columns)
+        {
+            m_file.write(reinterpret_cast<const char*>(column.data()), rows * sizeof(double));
+            column.clear();
+        }
+    }
+    m_file.flush();
+    m_bufferedRows = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef COLUMNAR_AGGREGATOR_H
+#define COLUMNAR_AGGREGATOR_H
+
+#include "data-collection-object.h"
+
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup aggregator
+ *
+ * This aggregator buffers the values it receives in memory, one buffer per
+ * column of each dataset (context), and writes them to a binary columnar
+ * file in large chunks.
+ *
+ * Its Write1d and Write2d methods have the same signatures as those of
+ * FileAggregator, so that it can be connected to the "Output" trace source
+ * of a TimeSeriesAdaptor. The values of each context can be decimated
+ * (only one value out of Decimation is kept) and, if Window is positive,
+ * summarized in windows of that width along the first value (the time, for
+ * a TimeSeriesAdaptor): a row with the start of the window and the count,
+ * minimum, mean and maximum of the second value is then stored instead of
+ * each value.
+ *
+ * The file starts with the 8 bytes "NS3COLS" followed by a null character
+ * and a uint32_t version (1), followed by records starting with a uint32_t
+ * type:
+ *
+ * - SERIES (0): uint32_t series id, the context, uint32_t number of
+ *   columns and the name of each column, where each string is a uint32_t
+ *   length followed by the characters;
+ * - CHUNK (1): uint32_t series id, uint32_t number of rows n, and then, for
+ *   each column of the series, n doubles.
+ *
+ * All the numbers are in the byte order of the host. The SERIES record of a
+ * context precedes its first CHUNK record; a context may have any number of
+ * CHUNK records, whose rows are in the order they were received.
+ */
+class ColumnarAggregator : public DataCollectionObject
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @param outputFileName name of the file to write.
+     *
+     * Constructs a columnar aggregator that will create a file named
+     * outputFileName when the first chunk is written.
+     */
+    ColumnarAggregator(const std::string& outputFileName);
+
+    ~ColumnarAggregator() override;
+
+    // Below are hooked to connectors exporting data
+    // They are not overloaded since it confuses the compiler when made
+    // into callbacks
+
+    /**
+     * @param context specifies the dataset this value came from.
+     * @param v1 value for the new data point, stored with the current
+     *        simulation time in seconds as first value.
+     *
+     * @brief Buffers 1 value.
+     */
+    void Write1d(std::string context, double v1);
+
+    /**
+     * @param context specifies the dataset these values came from.
+     * @param v1 first value for the new data point.
+     * @param v2 second value for the new data point.
+     *
+     * @brief Buffers 2 values.
+     */
+    void Write2d(std::string context, double v1, double v2);
+
+    /**
+     * @brief Write the buffered rows to the file.
+     *
+     * The windows still open are not written, as more values may fall in
+     * them; they are written when the aggregator is disposed.
+     */
+    void Flush();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// The buffered values and the state of a dataset
+    struct Series
+    {
+        std::string context;                      //!< the dataset
+        bool described{false};                    //!< whether the SERIES record was written
+        std::vector<std::vector<double>> columns; //!< the buffered values, by column
+        uint64_t received{0};                     //!< the number of values received
+        int64_t window{0};                        //!< the index of the open window
+        uint64_t count{0};                        //!< the number of values in the window
+        double min{0};                            //!< the minimum value in the window
+        double max{0};                            //!< the maximum value in the window
+        double sum{0};                            //!< the sum of the values in the window
+    };
+
+    /**
+     * @param context the dataset
+     * @return the series of the dataset, which is created if needed
+     */
+    Series& GetSeries(const std::string& context);
+
+    /**
+     * @brief Buffer a row of a series
+     * @param series the series
+     * @param row the values of the row, one per column
+     */
+    void AddRow(Series& series, std::initializer_list<double> row);
+
+    /**
+     * @brief Buffer the summary of the open window of a series, if any
+     * @param series the series
+     */
+    void CloseWindow(Series& series);
+
+    /**
+     * @brief Write a uint32_t to the file
+     * @param value the value
+     */
+    void WriteUint32(uint32_t value);
+
+    /**
+     * @brief Write a string, preceded by its length, to the file
+     * @param value the string
+     */
+    void WriteString(const std::string& value);
+
+    /// The types of record of the file
+    enum RecordType : uint32_t
+    {
+        SERIES = 0,
+        CHUNK = 1
+    };
+
+    std::string m_outputFileName;                    //!< the name of the output file
+    std::ofstream m_file;                            //!< the output file
+    uint32_t m_chunkSize;                            //!< the number of rows buffered before writing
+    uint32_t m_decimation;                           //!< one value out of m_decimation is kept
+    double m_window;                                 //!< the width of the windows, or 0
+    std::vector<Series> m_series;                    //!< the series, by id
+    std::unordered_map<std::string, uint32_t> m_ids; //!< the ids of the series, by context
+    uint32_t m_bufferedRows{0};                      //!< the number of rows buffered
+};
+
+} // namespace ns3
+
+#endif // COLUMNAR_AGGREGATOR_H
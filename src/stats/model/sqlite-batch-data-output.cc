@@ -0,0 +1,415 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "sqlite-batch-data-output.h"
+
+#include "data-calculator.h"
+#include "data-collector.h"
+#include "sqlite-output.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SqliteBatchDataOutput");
+
+NS_OBJECT_ENSURE_REGISTERED(SqliteBatchDataOutput);
+
+namespace
+{
+
+/**
+ * @ingroup dataoutput
+ *
+ * @brief Inserts the singletons of the data calculators, reusing a prepared
+ * statement, within the transaction opened by the caller
+ */
+class SqliteBatchOutputCallback : public DataOutputCallback
+{
+  public:
+    /**
+     * Constructor
+     * @param db the database
+     * @param run the run label
+     */
+    SqliteBatchOutputCallback(const Ptr<SQLiteOutput>& db, const std::string& run)
+        : m_db(db),
+          m_runLabel(run)
+    {
+        m_db->SpinExec("CREATE TABLE IF NOT EXISTS Singletons "
+                       "( run text, name text, variable text, value )");
+        m_db->SpinPrepare(&m_stmt,
+                          "INSERT INTO Singletons "
+                          "(run, name, variable, value)"
+                          "values (?, ?, ?, ?)");
+        m_db->Bind(m_stmt, 1, m_runLabel);
+    }
+
+    ~SqliteBatchOutputCallback() override
+    {
+        SQLiteOutput::SpinFinalize(m_stmt);
+    }
+
+    void OutputStatistic(std::string key,
+                         std::string variable,
+                         const StatisticalSummary* statSum) override
+    {
+        OutputSingleton(key, variable + "-count", static_cast<double>(statSum->getCount()));
+        if (!std::isnan(statSum->getSum()))
+        {
+            OutputSingleton(key, variable + "-total", statSum->getSum());
+        }
+        if (!std::isnan(statSum->getMax()))
+        {
+            OutputSingleton(key, variable + "-max", statSum->getMax());
+        }
+        if (!std::isnan(statSum->getMin()))
+        {
+            OutputSingleton(key, variable + "-min", statSum->getMin());
+        }
+        if (!std::isnan(statSum->getSqrSum()))
+        {
+            OutputSingleton(key, variable + "-sqrsum", statSum->getSqrSum());
+        }
+        if (!std::isnan(statSum->getStddev()))
+        {
+            OutputSingleton(key, variable + "-stddev", statSum->getStddev());
+        }
+    }
+
+    void OutputSingleton(std::string key, std::string variable, int val) override
+    {
+        Insert(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, uint32_t val) override
+    {
+        Insert(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, double val) override
+    {
+        Insert(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, std::string val) override
+    {
+        Insert(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, Time val) override
+    {
+        Insert(key, variable, val.GetTimeStep());
+    }
+
+  private:
+    /**
+     * @brief Insert a singleton
+     * @param key the name of the data calculator
+     * @param variable the variable name
+     * @param val the value
+     */
+    template <typename T>
+    void Insert(const std::string& key, const std::string& variable, const T& val)
+    {
+        SQLiteOutput::SpinReset(m_stmt);
+        m_db->Bind(m_stmt, 2, key);
+        m_db->Bind(m_stmt, 3, variable);
+        m_db->Bind(m_stmt, 4, val);
+        SQLiteOutput::SpinStep(m_stmt);
+    }
+
+    Ptr<SQLiteOutput> m_db; //!< the database
+    std::string m_runLabel; //!< the run label
+    sqlite3_stmt* m_stmt;   //!< the prepared insertion of a singleton
+};
+
+} // namespace
+
+SqliteBatchDataOutput::SqliteBatchDataOutput()
+    : DataOutputInterface()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_filePrefix = "data";
+}
+
+SqliteBatchDataOutput::~SqliteBatchDataOutput()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+/* static */
+TypeId
+SqliteBatchDataOutput::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SqliteBatchDataOutput")
+            .SetParent<DataOutputInterface>()
+            .SetGroupName("Stats")
+            .AddConstructor<SqliteBatchDataOutput>()
+            .AddAttribute("BatchSize",
+                          "The number of time series values inserted in a single transaction.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&SqliteBatchDataOutput::m_batchSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("BackgroundCommit",
+                          "Whether the batches are committed by a writer thread, concurrently "
+                          "with the simulation.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SqliteBatchDataOutput::m_backgroundCommit),
+                          MakeBooleanChecker())
+            .AddAttribute("JournalMode",
+                          "The journal mode of the database. With WAL, readers can access the "
+                          "database while it is written, and commits do not rewrite the database.",
+                          StringValue("WAL"),
+                          MakeStringAccessor(&SqliteBatchDataOutput::m_journalMode),
+                          MakeStringChecker())
+            .AddAttribute("Synchronous",
+                          "The synchronous mode of the database (OFF, NORMAL or FULL).",
+                          StringValue("NORMAL"),
+                          MakeStringAccessor(&SqliteBatchDataOutput::m_synchronous),
+                          MakeStringChecker())
+            .AddAttribute("RunLabel",
+                          "The run label stored with the time series values.",
+                          StringValue(""),
+                          MakeStringAccessor(&SqliteBatchDataOutput::m_runLabel),
+                          MakeStringChecker());
+    return tid;
+}
+
+void
+SqliteBatchDataOutput::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    Close();
+    DataOutputInterface::DoDispose();
+}
+
+void
+SqliteBatchDataOutput::Open()
+{
+    if (m_db)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    m_db = Create<SQLiteOutput>(m_filePrefix + ".db");
+    if (!m_db->SetJournalMode(m_journalMode))
+    {
+        NS_LOG_WARN("Journal mode " << m_journalMode << " not supported");
+    }
+    m_db->SetSynchronous(m_synchronous);
+
+    bool res = m_db->SpinExec("CREATE TABLE IF NOT EXISTS TimeSeries "
+                              "( run text, context text, x real, y real )");
+    NS_ASSERT(res);
+    res = m_db->SpinPrepare(&m_insertRow,
+                            "INSERT INTO TimeSeries "
+                            "(run, context, x, y)"
+                            "values (?, ?, ?, ?)");
+    NS_ASSERT(res);
+    m_db->Bind(m_insertRow, 1, m_runLabel);
+    m_pending.reserve(m_batchSize);
+
+    if (m_backgroundCommit)
+    {
+        m_stopWriter = false;
+        m_writer = std::thread(&SqliteBatchDataOutput::WriterLoop, this);
+    }
+}
+
+void
+SqliteBatchDataOutput::Close()
+{
+    if (!m_db)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    SubmitPending();
+    if (m_writer.joinable())
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            m_stopWriter = true;
+        }
+        m_cv.notify_all();
+        m_writer.join();
+    }
+    SQLiteOutput::SpinFinalize(m_insertRow);
+    m_insertRow = nullptr;
+    m_db = nullptr;
+}
+
+void
+SqliteBatchDataOutput::Write1d(std::string context, double v1)
+{
+    Write2d(std::move(context), Simulator::Now().GetSeconds(), v1);
+}
+
+void
+SqliteBatchDataOutput::Write2d(std::string context, double v1, double v2)
+{
+    NS_LOG_FUNCTION(this << context << v1 << v2);
+
+    Open();
+    m_pending.push_back({std::move(context), v1, v2});
+    if (m_pending.size() >= m_batchSize)
+    {
+        SubmitPending();
+    }
+}
+
+void
+SqliteBatchDataOutput::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_db)
+    {
+        return;
+    }
+    SubmitPending();
+    WaitForWriter();
+}
+
+void
+SqliteBatchDataOutput::SubmitPending()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+    if (!m_writer.joinable())
+    {
+        CommitRows(m_pending);
+        m_pending.clear();
+        return;
+    }
+    std::vector<Row> batch;
+    batch.reserve(m_batchSize);
+    batch.swap(m_pending);
+    {
+        std::unique_lock lock{m_mutex};
+        m_batches.push_back(std::move(batch));
+    }
+    m_cv.notify_all();
+}
+
+void
+SqliteBatchDataOutput::WaitForWriter()
+{
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [this] { return m_batches.empty() && !m_writing; });
+}
+
+void
+SqliteBatchDataOutput::WriterLoop()
+{
+    std::unique_lock lock{m_mutex};
+    while (true)
+    {
+        m_cv.wait(lock, [this] { return !m_batches.empty() || m_stopWriter; });
+        if (m_batches.empty())
+        {
+            // stopping, and all the batches are committed
+            return;
+        }
+        std::vector<Row> batch = std::move(m_batches.front());
+        m_batches.pop_front();
+        m_writing = true;
+        lock.unlock();
+        CommitRows(batch);
+        lock.lock();
+        m_writing = false;
+        m_cv.notify_all();
+    }
+}
+
+void
+SqliteBatchDataOutput::CommitRows(const std::vector<Row>& rows)
+{
+    m_db->SpinExec("BEGIN");
+    for (const auto& row : rows)
+    {
+        SQLiteOutput::SpinReset(m_insertRow);
+        m_db->Bind(m_insertRow, 2, row.context);
+        m_db->Bind(m_insertRow, 3, row.x);
+        m_db->Bind(m_insertRow, 4, row.y);
+        SQLiteOutput::SpinStep(m_insertRow);
+    }
+    m_db->SpinExec("COMMIT");
+}
+
+void
+SqliteBatchDataOutput::Output(DataCollector& dc)
+{
+    NS_LOG_FUNCTION(this << &dc);
+
+    // the writer thread is idle after Flush, until new values are written
+    Open();
+    Flush();
+
+    std::string run = dc.GetRunLabel();
+    m_db->SpinExec("BEGIN");
+
+    m_db->SpinExec("CREATE TABLE IF NOT EXISTS Experiments (run, experiment, "
+                   "strategy, input, description text)");
+    sqlite3_stmt* stmt;
+    bool res = m_db->SpinPrepare(&stmt,
+                                 "INSERT INTO Experiments "
+                                 "(run, experiment, strategy, input, description)"
+                                 "values (?, ?, ?, ?, ?)");
+    NS_ASSERT(res);
+    std::string experimentLabel = dc.GetExperimentLabel();
+    std::string strategyLabel = dc.GetStrategyLabel();
+    std::string inputLabel = dc.GetInputLabel();
+    std::string description = dc.GetDescription();
+    m_db->Bind(stmt, 1, run);
+    m_db->Bind(stmt, 2, experimentLabel);
+    m_db->Bind(stmt, 3, strategyLabel);
+    m_db->Bind(stmt, 4, inputLabel);
+    m_db->Bind(stmt, 5, description);
+    SQLiteOutput::SpinStep(stmt);
+    SQLiteOutput::SpinFinalize(stmt);
+
+    m_db->SpinExec("CREATE TABLE IF NOT EXISTS "
+                   "Metadata ( run text, key text, value)");
+    res = m_db->SpinPrepare(&stmt,
+                            "INSERT INTO Metadata "
+                            "(run, key, value)"
+                            "values (?, ?, ?)");
+    NS_ASSERT(res);
+    m_db->Bind(stmt, 1, run);
+    for (auto i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
+    {
+        SQLiteOutput::SpinReset(stmt);
+        m_db->Bind(stmt, 2, i->first);
+        m_db->Bind(stmt, 3, i->second);
+        SQLiteOutput::SpinStep(stmt);
+    }
+    SQLiteOutput::SpinFinalize(stmt);
+
+    {
+        SqliteBatchOutputCallback callback(m_db, run);
+        for (auto i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd(); i++)
+        {
+            (*i)->Output(callback);
+        }
+    }
+    m_db->SpinExec("COMMIT");
+}
+
+} // namespace ns3
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SQLITE_BATCH_DATA_OUTPUT_H
+#define SQLITE_BATCH_DATA_OUTPUT_H
+
+#include "data-output-interface.h"
+
+#include "ns3/ptr.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct sqlite3_stmt;
+
+namespace ns3
+{
+
+class SQLiteOutput;
+
+/**
+ * @ingroup dataoutput
+ * @class SqliteBatchDataOutput
+ * @brief Outputs data and time series to an SQLite database in batches
+ *
+ * Besides the tables written by SqliteDataOutput (Experiments, Metadata and
+ * Singletons), this output stores the values received by its Write1d and
+ * Write2d methods, which have the same signatures as those of
+ * FileAggregator and can therefore be connected to the "Output" trace
+ * source of a TimeSeriesAdaptor, in a TimeSeries (run, context, x, y)
+ * table.
+ *
+ * The values are buffered and inserted BatchSize at a time, each batch in a
+ * single transaction, reusing the same prepared statement. If
+ * BackgroundCommit is true, the batches are committed by a writer thread,
+ * so that the simulation only pays for copying the values. The database is
+ * opened, with the configured JournalMode and Synchronous pragmas, when the
+ * first value is written; the pending values are committed by Flush,
+ * Output and when the object is disposed.
+ */
+class SqliteBatchDataOutput : public DataOutputInterface
+{
+  public:
+    SqliteBatchDataOutput();
+    ~SqliteBatchDataOutput() override;
+
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId();
+
+    void Output(DataCollector& dc) override;
+
+    /**
+     * @param context specifies the dataset this value came from.
+     * @param v1 value for the new data point, stored with the current
+     *        simulation time in seconds as x.
+     *
+     * @brief Buffers 1 value for insertion.
+     */
+    void Write1d(std::string context, double v1);
+
+    /**
+     * @param context specifies the dataset these values came from.
+     * @param v1 first value (x) for the new data point.
+     * @param v2 second value (y) for the new data point.
+     *
+     * @brief Buffers 2 values for insertion.
+     */
+    void Write2d(std::string context, double v1, double v2);
+
+    /**
+     * @brief Commit the buffered values and wait until they are written.
+     */
+    void Flush();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A buffered data point of a time series
+    struct Row
+    {
+        std::string context; //!< the dataset of the data point
+        double x;            //!< the first value
+        double y;            //!< the second value
+    };
+
+    /// Open the database, if not open yet, and start the writer thread
+    void Open();
+
+    /**
+     * @brief Insert rows in a single transaction
+     * @param rows the rows
+     */
+    void CommitRows(const std::vector<Row>& rows);
+
+    /// Hand the buffered rows over to the writer thread, or commit them
+    void SubmitPending();
+
+    /// Wait until the writer thread has committed all the submitted rows
+    void WaitForWriter();
+
+    /// The loop of the writer thread
+    void WriterLoop();
+
+    /// Stop the writer thread and close the database
+    void Close();
+
+    uint32_t m_batchSize;               //!< the number of rows per transaction
+    bool m_backgroundCommit;            //!< whether a writer thread commits the rows
+    std::string m_journalMode;          //!< the journal mode of the database
+    std::string m_synchronous;          //!< the synchronous mode of the database
+    std::string m_runLabel;             //!< the run label of the time series
+    Ptr<SQLiteOutput> m_db;             //!< the database
+    sqlite3_stmt* m_insertRow{nullptr}; //!< the prepared insertion of a row
+    std::vector<Row> m_pending;         //!< the rows not submitted yet
+
+    std::thread m_writer;                   //!< the writer thread
+    std::mutex m_mutex;                     //!< protects the members below
+    std::condition_variable m_cv;           //!< signals a change of the members below
+    std::deque<std::vector<Row>> m_batches; //!< the batches submitted to the writer
+    bool m_writing{false};                  //!< whether the writer is committing a batch
+    bool m_stopWriter{false};               //!< whether the writer must stop
+};
+
+} // namespace ns3
+
+#endif /* SQLITE_BATCH_DATA_OUTPUT_H */
@@ -37,7 +37,36 @@ void
 SQLiteOutput::SetJournalInMemory()
 {
     NS_LOG_FUNCTION(this);
-    SpinExec("PRAGMA journal_mode = MEMORY");
+    SetJournalMode("MEMORY");
+}
+
+bool
+SQLiteOutput::SetJournalMode(const std::string& mode)
+{
+    NS_LOG_FUNCTION(this << mode);
+
+    // the pragma returns the new journal mode, which is the old one if the
+    // requested mode is not supported (e.g., WAL for an in-memory database)
+    sqlite3_stmt* stmt;
+    std::string cmd = "PRAGMA journal_mode = " + mode;
+    if (CheckError(m_db, SpinPrepare(m_db, &stmt, cmd), cmd, false))
+    {
+        return false;
+    }
+    std::string result;
+    if (SpinStep(stmt) == SQLITE_ROW)
+    {
+        result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    }
+    SpinFinalize(stmt);
+    return sqlite3_stricmp(result.c_str(), mode.c_str()) == 0;
+}
+
+bool
+SQLiteOutput::SetSynchronous(const std::string& level)
+{
+    NS_LOG_FUNCTION(this << level);
+    return SpinExec("PRAGMA synchronous = " + level);
 }
 
 bool
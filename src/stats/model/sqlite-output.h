@@ -52,6 +52,22 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
      */
     void SetJournalInMemory();
 
+    /**
+     * @brief Set the journal mode of the database (e.g., "WAL" to let readers
+     * access the database while it is written)
+     * @param mode the journal mode, as accepted by "PRAGMA journal_mode"
+     * @return true if the database is now in the requested mode
+     */
+    bool SetJournalMode(const std::string& mode);
+
+    /**
+     * @brief Set how often SQLite waits for the data to reach the disk
+     * @param level the level, as accepted by "PRAGMA synchronous" (e.g.,
+     * "NORMAL", which is safe in WAL mode and syncs only at checkpoints)
+     * @return true in case of success
+     */
+    bool SetSynchronous(const std::string& level);
+
     /**
      * @brief Execute a command until the return value is OK or an ERROR
      *
@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/columnar-aggregator.h"
+#include "ns3/double.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief Check the file written by the ColumnarAggregator, with and without
+ * windows.
+ */
+class ColumnarAggregatorTestCase : public TestCase
+{
+  public:
+    ColumnarAggregatorTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// The columns of a series read back from a file
+    using Columns = std::map<std::string, std::vector<double>>;
+
+    /**
+     * Read a file written by a ColumnarAggregator
+     * @param fileName the name of the file
+     * @return the columns of the series, by context
+     */
+    std::map<std::string, Columns> ReadFile(const std::string& fileName);
+};
+
+ColumnarAggregatorTestCase::ColumnarAggregatorTestCase()
+    : TestCase("Check the columnar file written by the ColumnarAggregator")
+{
+}
+
+std::map<std::string, ColumnarAggregatorTestCase::Columns>
+ColumnarAggregatorTestCase::ReadFile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    auto readUint32 = [&file]() {
+        uint32_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    };
+    auto readString = [&file, &readUint32]() {
+        std::string value(readUint32(), '\0');
+        file.read(value.data(), value.size());
+        return value;
+    };
+
+    char magic[8];
+    file.read(magic, sizeof(magic));
+    NS_TEST_EXPECT_MSG_EQ(std::string(magic), "NS3COLS", "Unexpected magic");
+    NS_TEST_EXPECT_MSG_EQ(readUint32(), 1, "Unexpected version");
+
+    std::map<uint32_t, std::pair<std::string, std::vector<std::string>>> series;
+    std::map<std::string, Columns> result;
+    for (uint32_t type = readUint32(); file; type = readUint32())
+    {
+        uint32_t id = readUint32();
+        if (type == 0)
+        {
+            auto& [context, names] = series[id];
+            context = readString();
+            names.resize(readUint32());
+            for (auto& name : names)
+            {
+                name = readString();
+            }
+            continue;
+        }
+        NS_TEST_EXPECT_MSG_EQ(type, 1, "Unexpected record type");
+        NS_TEST_EXPECT_MSG_EQ(series.count(id), 1, "Chunk of an undescribed series");
+        if (type != 1 || series.count(id) == 0)
+        {
+            break;
+        }
+        uint32_t rows = readUint32();
+        const auto& [context, names] = series[id];
+        for (const auto& name : names)
+        {
+            auto& column = result[context][name];
+            std::size_t start = column.size();
+            column.resize(start + rows);
+            file.read(reinterpret_cast<char*>(column.data() + start), rows * sizeof(double));
+        }
+    }
+    return result;
+}
+
+void
+ColumnarAggregatorTestCase::DoRun()
+{
+    // raw values, decimated, written in several chunks
+    std::string rawFile = CreateTempDirFilename("raw.cols");
+    auto raw = CreateObject<ColumnarAggregator>(rawFile);
+    raw->SetAttribute("ChunkSize", UintegerValue(7));
+    raw->SetAttribute("Decimation", UintegerValue(2));
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        raw->Write2d("a", i, 10.0 * i);
+        raw->Write2d("b", i, -1.0 * i);
+    }
+    raw->Dispose();
+
+    auto series = ReadFile(rawFile);
+    NS_TEST_ASSERT_MSG_EQ(series.size(), 2, "Unexpected number of series");
+    NS_TEST_ASSERT_MSG_EQ(series["a"]["x"].size(), 10, "Unexpected number of rows");
+    NS_TEST_ASSERT_MSG_EQ(series["b"]["y"].size(), 10, "Unexpected number of rows");
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(series["a"]["x"][i], 2 * i, "Unexpected first value");
+        NS_TEST_EXPECT_MSG_EQ(series["a"]["y"][i], 20.0 * i, "Unexpected second value");
+        NS_TEST_EXPECT_MSG_EQ(series["b"]["y"][i], -2.0 * i, "Unexpected second value");
+    }
+
+    // values summarized in windows of width 1
+    std::string windowFile = CreateTempDirFilename("window.cols");
+    auto windowed = CreateObject<ColumnarAggregator>(windowFile);
+    windowed->SetAttribute("Window", DoubleValue(1));
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        windowed->Write2d("c", i / 10.0, i);
+    }
+    windowed->Dispose();
+
+    series = ReadFile(windowFile);
+    auto& columns = series["c"];
+    NS_TEST_ASSERT_MSG_EQ(columns.size(), 5, "Unexpected number of columns");
+    NS_TEST_ASSERT_MSG_EQ(columns["start"].size(), 3, "Unexpected number of windows");
+    std::vector<double> counts{10, 10, 5};
+    for (uint32_t w = 0; w < 3; w++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(columns["start"][w], w, "Unexpected window start");
+        NS_TEST_EXPECT_MSG_EQ(columns["count"][w], counts[w], "Unexpected window count");
+        NS_TEST_EXPECT_MSG_EQ(columns["min"][w], 10 * w, "Unexpected window minimum");
+        NS_TEST_EXPECT_MSG_EQ(columns["max"][w], 10 * w + counts[w] - 1, "Unexpected maximum");
+        NS_TEST_EXPECT_MSG_EQ_TOL(columns["mean"][w],
+                                  10 * w + (counts[w] - 1) / 2,
+                                  1e-9,
+                                  "Unexpected window mean");
+    }
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarAggregator TestSuite
+ */
+class ColumnarAggregatorTestSuite : public TestSuite
+{
+  public:
+    ColumnarAggregatorTestSuite();
+};
+
+ColumnarAggregatorTestSuite::ColumnarAggregatorTestSuite()
+    : TestSuite("columnar-aggregator", Type::UNIT)
+{
+    AddTestCase(new ColumnarAggregatorTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static ColumnarAggregatorTestSuite columnarAggregatorTestSuite;
@@ -1,5 +1,6 @@
 // Include a header file from your module to test.
 #include "ns3/double-probe.h"
+#include "ns3/file-helper.h"
 #include "ns3/names.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -10,6 +11,8 @@
 #include "ns3/traced-value.h"
 #include "ns3/type-id.h"
 
+#include <fstream>
+
 using namespace ns3;
 
 /**
@@ -197,6 +200,62 @@ ProbeTestCase1::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup stats-tests
+ *
+ * @brief DoubleProbe class - Test case for probes attached by a helper
+ * directly to a set of objects.
+ */
+class ProbeTestCase2 : public TestCase
+{
+  public:
+    ProbeTestCase2();
+
+  private:
+    void DoRun() override;
+};
+
+ProbeTestCase2::ProbeTestCase2()
+    : TestCase("probes attached to objects by the FileHelper")
+{
+}
+
+void
+ProbeTestCase2::DoRun()
+{
+    std::string prefix = CreateTempDirFilename("attached");
+    std::vector<Ptr<Object>> emitters;
+    {
+        FileHelper helper(prefix);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            Ptr<SampleEmitter> emitter = CreateObject<SampleEmitter>();
+            Simulator::Schedule(Seconds(1), &SampleEmitter::Start, emitter);
+            emitters.push_back(emitter);
+        }
+        helper.WriteProbe("ns3::DoubleProbe", emitters, "Emitter", "Output");
+        NS_TEST_ASSERT_MSG_NE(helper.GetProbe("FileProbe-3"), nullptr, "The probe was not added");
+        Simulator::Stop(Seconds(100));
+        Simulator::Run();
+        // the files are closed when the helper is destroyed
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        std::ifstream file(prefix + "-" + std::to_string(i) + ".txt");
+        NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Missing output file of object " << i);
+        double time;
+        double value;
+        uint32_t lines = 0;
+        while (file >> time >> value)
+        {
+            lines++;
+        }
+        NS_TEST_EXPECT_MSG_GT(lines, 0, "No value written for object " << i);
+    }
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup stats-tests
  *
@@ -212,6 +271,7 @@ ProbeTestSuite::ProbeTestSuite()
     : TestSuite("double-probe", Type::UNIT)
 {
     AddTestCase(new ProbeTestCase1, TestCase::Duration::QUICK);
+    AddTestCase(new ProbeTestCase2, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/basic-data-calculators.h"
+#include "ns3/boolean.h"
+#include "ns3/data-collector.h"
+#include "ns3/sqlite-batch-data-output.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief Check that SqliteBatchDataOutput writes all the values, in batches,
+ * with or without a writer thread.
+ */
+class SqliteBatchDataOutputTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param backgroundCommit whether the batches are committed by a writer thread
+     */
+    SqliteBatchDataOutputTestCase(bool backgroundCommit);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count the rows of a table
+     * @param db the database
+     * @param query the query counting the rows
+     * @return the number of rows
+     */
+    int Count(const Ptr<SQLiteOutput>& db, const std::string& query);
+
+    bool m_backgroundCommit; //!< whether the batches are committed by a writer thread
+};
+
+SqliteBatchDataOutputTestCase::SqliteBatchDataOutputTestCase(bool backgroundCommit)
+    : TestCase(std::string("Check the batched SQLite output ") +
+               (backgroundCommit ? "with" : "without") + " a writer thread"),
+      m_backgroundCommit(backgroundCommit)
+{
+}
+
+int
+SqliteBatchDataOutputTestCase::Count(const Ptr<SQLiteOutput>& db, const std::string& query)
+{
+    sqlite3_stmt* stmt;
+    NS_TEST_EXPECT_MSG_EQ(db->SpinPrepare(&stmt, query), true, "Cannot prepare " << query);
+    int count = -1;
+    if (SQLiteOutput::SpinStep(stmt) == SQLITE_ROW)
+    {
+        count = db->RetrieveColumn<int>(stmt, 0);
+    }
+    SQLiteOutput::SpinFinalize(stmt);
+    return count;
+}
+
+void
+SqliteBatchDataOutputTestCase::DoRun()
+{
+    std::string prefix = CreateTempDirFilename(m_backgroundCommit ? "background" : "inline");
+    auto output = CreateObjectWithAttributes<SqliteBatchDataOutput>(
+        "BatchSize",
+        UintegerValue(100),
+        "BackgroundCommit",
+        BooleanValue(m_backgroundCommit));
+    output->SetFilePrefix(prefix);
+
+    for (uint32_t i = 0; i < 1050; i++)
+    {
+        output->Write2d(i % 2 ? "odd" : "even", i, 2.0 * i);
+    }
+    output->Write1d("single", 1);
+
+    // WAL mode lets the database be read while the output keeps it open
+    auto db = Create<SQLiteOutput>(prefix + ".db");
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM TimeSeries") % 100,
+                          0,
+                          "Only complete batches should be committed before a flush");
+    output->Flush();
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM TimeSeries"),
+                          1051,
+                          "All the values should be committed after a flush");
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM TimeSeries WHERE context = 'odd'"),
+                          525,
+                          "Unexpected number of values of a context");
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM TimeSeries WHERE y != 2 * x"),
+                          1,
+                          "Unexpected values");
+
+    DataCollector data;
+    data.DescribeRun("experiment", "strategy", "input", "run");
+    data.AddMetadata("key", "value");
+    auto counter = CreateObject<CounterCalculator<>>();
+    counter->SetKey("counter");
+    counter->Update();
+    data.AddDataCalculator(counter);
+    output->Output(data);
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM Experiments WHERE run = 'run'"),
+                          1,
+                          "The run should be described");
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM Metadata"),
+                          1,
+                          "The metadata should be written");
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT value FROM Singletons WHERE variable = 'counter'"),
+                          1,
+                          "The counter should be written");
+
+    output->Write2d("last", 0, 0);
+    output->Dispose();
+    NS_TEST_EXPECT_MSG_EQ(Count(db, "SELECT COUNT(*) FROM TimeSeries"),
+                          1052,
+                          "The pending values should be committed when disposing");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief SqliteBatchDataOutput TestSuite
+ */
+class SqliteBatchDataOutputTestSuite : public TestSuite
+{
+  public:
+    SqliteBatchDataOutputTestSuite();
+};
+
+SqliteBatchDataOutputTestSuite::SqliteBatchDataOutputTestSuite()
+    : TestSuite("sqlite-batch-data-output", Type::UNIT)
+{
+    AddTestCase(new SqliteBatchDataOutputTestCase(false), TestCase::Duration::QUICK);
+    AddTestCase(new SqliteBatchDataOutputTestCase(true), TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SqliteBatchDataOutputTestSuite sqliteBatchDataOutputTestSuite;
@@ -0,0 +1,275 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "carousel-queue-disc.h"
+
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/queue.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CarouselQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED(CarouselQueueDisc);
+
+TypeId
+CarouselQueueDisc::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CarouselQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<CarouselQueueDisc>()
+            .AddAttribute("MaxSize",
+                          "The max queue size",
+                          QueueSizeValue(QueueSize("10000p")),
+                          MakeQueueSizeAccessor(&QueueDisc::SetMaxSize, &QueueDisc::GetMaxSize),
+                          MakeQueueSizeChecker())
+            .AddAttribute("NumSlots",
+                          "The number of slots of the timing wheel",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&CarouselQueueDisc::m_numSlots),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SlotDuration",
+                          "The duration covered by a slot of the timing wheel",
+                          TimeValue(MicroSeconds(100)),
+                          MakeTimeAccessor(&CarouselQueueDisc::m_slotDuration),
+                          MakeTimeChecker())
+            .AddAttribute("DefaultRate",
+                          "The rate of the flows whose rate is not set. "
+                          "A null rate does not shape the flows.",
+                          DataRateValue(DataRate("0bps")),
+                          MakeDataRateAccessor(&CarouselQueueDisc::m_defaultRate),
+                          MakeDataRateChecker())
+            .AddAttribute("Perturbation",
+                          "The salt used as an additional input to the hash function used to "
+                          "identify the flows, when no packet filter is installed",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CarouselQueueDisc::m_perturbation),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+CarouselQueueDisc::CarouselQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::MULTIPLE_QUEUES),
+      m_currentSlot(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CarouselQueueDisc::~CarouselQueueDisc()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CarouselQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_id.Cancel();
+    m_flows.clear();
+    QueueDisc::DoDispose();
+}
+
+void
+CarouselQueueDisc::SetFlowRate(uint32_t flow, DataRate rate)
+{
+    NS_LOG_FUNCTION(this << flow << rate);
+    m_flows[flow].rate = rate;
+}
+
+DataRate
+CarouselQueueDisc::GetFlowRate(uint32_t flow) const
+{
+    NS_LOG_FUNCTION(this << flow);
+    auto it = m_flows.find(flow);
+    return (it != m_flows.end() ? it->second.rate : m_defaultRate);
+}
+
+std::size_t
+CarouselQueueDisc::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+CarouselQueueDisc::Flow*
+CarouselQueueDisc::GetFlow(Ptr<QueueDiscItem> item)
+{
+    uint32_t flow;
+    if (GetNPacketFilters() == 0)
+    {
+        flow = item->Hash(m_perturbation);
+    }
+    else
+    {
+        int32_t ret = Classify(item);
+        if (ret == PacketFilter::PF_NO_MATCH)
+        {
+            return nullptr;
+        }
+        flow = static_cast<uint32_t>(ret);
+    }
+    return &m_flows.try_emplace(flow, Flow{m_defaultRate, Time()}).first->second;
+}
+
+bool
+CarouselQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    Flow* flow = GetFlow(item);
+    if (!flow)
+    {
+        NS_LOG_ERROR("No filter has been able to classify this packet, drop it.");
+        DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+        return false;
+    }
+
+    if (GetCurrentSize() + item > GetMaxSize())
+    {
+        NS_LOG_LOGIC("Queue disc limit exceeded -- dropping packet");
+        DropBeforeEnqueue(item, LIMIT_EXCEEDED_DROP);
+        return false;
+    }
+
+    Time now = Simulator::Now();
+    if (GetNPackets() == 0)
+    {
+        // the wheel is empty, let the current slot start now
+        m_wheelTime = now;
+    }
+
+    Time timestamp = std::max(now, flow->nextTimestamp);
+    uint64_t offset = 0;
+    if (timestamp > m_wheelTime)
+    {
+        offset = (timestamp - m_wheelTime).GetTimeStep() / m_slotDuration.GetTimeStep();
+    }
+    if (offset >= m_numSlots)
+    {
+        NS_LOG_LOGIC("Timestamp " << timestamp.As(Time::S) << " beyond the horizon");
+        DropBeforeEnqueue(item, HORIZON_DROP);
+        return false;
+    }
+
+    if (flow->rate.GetBitRate() > 0)
+    {
+        flow->nextTimestamp = timestamp + flow->rate.CalculateBytesTxTime(item->GetSize());
+    }
+
+    uint32_t slot = (m_currentSlot + offset) % m_numSlots;
+    NS_LOG_LOGIC("Timestamp " << timestamp.As(Time::S) << ", slot " << slot);
+
+    bool retval = GetInternalQueue(slot)->Enqueue(item);
+
+    // If Queue::Enqueue fails, QueueDisc::DropBeforeEnqueue is called by the
+    // internal queue because QueueDisc::AddInternalQueue sets the trace callback
+
+    if (!retval)
+    {
+        NS_LOG_WARN("Packet enqueue failed. Check the size of the internal queues");
+    }
+
+    return retval;
+}
+
+Ptr<QueueDiscItem>
+CarouselQueueDisc::DoDequeue()
+{
+    NS_LOG_FUNCTION(this);
+
+    Time now = Simulator::Now();
+    while (GetNPackets() > 0)
+    {
+        Ptr<QueueDiscItem> item = GetInternalQueue(m_currentSlot)->Dequeue();
+        if (item)
+        {
+            return item;
+        }
+        if (m_wheelTime + m_slotDuration > now)
+        {
+            // the next packets are not due yet
+            ScheduleWakeUp();
+            return nullptr;
+        }
+        m_currentSlot = (m_currentSlot + 1) % m_numSlots;
+        m_wheelTime += m_slotDuration;
+    }
+    return nullptr;
+}
+
+void
+CarouselQueueDisc::ScheduleWakeUp()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (uint32_t offset = 1; offset < m_numSlots; offset++)
+    {
+        if (GetInternalQueue((m_currentSlot + offset) % m_numSlots)->IsEmpty())
+        {
+            continue;
+        }
+        Time wakeUp = m_wheelTime + m_slotDuration * offset;
+        if (m_id.IsPending() && Time(m_id.GetTs()) <= wakeUp)
+        {
+            return;
+        }
+        m_id.Cancel();
+        m_id = Simulator::Schedule(wakeUp - Simulator::Now(), &QueueDisc::Run, this);
+        NS_LOG_LOGIC("Waking Event Scheduled at " << wakeUp.As(Time::S));
+        return;
+    }
+}
+
+bool
+CarouselQueueDisc::CheckConfig()
+{
+    NS_LOG_FUNCTION(this);
+    if (GetNQueueDiscClasses() > 0)
+    {
+        NS_LOG_ERROR("CarouselQueueDisc cannot have classes");
+        return false;
+    }
+
+    if (!m_slotDuration.IsStrictlyPositive())
+    {
+        NS_LOG_ERROR("The slot duration of CarouselQueueDisc must be positive");
+        return false;
+    }
+
+    if (GetNInternalQueues() == 0)
+    {
+        // create a DropTail queue per slot, each able to hold all the packets
+        ObjectFactory factory;
+        factory.SetTypeId("ns3::DropTailQueue<QueueDiscItem>");
+        factory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
+        for (uint32_t i = 0; i < m_numSlots; i++)
+        {
+            AddInternalQueue(factory.Create<InternalQueue>());
+        }
+    }
+
+    if (GetNInternalQueues() != m_numSlots)
+    {
+        NS_LOG_ERROR("CarouselQueueDisc needs an internal queue per slot");
+        return false;
+    }
+
+    return true;
+}
+
+void
+CarouselQueueDisc::InitializeParams()
+{
+    NS_LOG_FUNCTION(this);
+    m_currentSlot = 0;
+    m_wheelTime = Simulator::Now();
+    m_id = EventId();
+}
+
+} // namespace ns3
@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CAROUSEL_QUEUE_DISC_H
+#define CAROUSEL_QUEUE_DISC_H
+
+#include "queue-disc.h"
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * Carousel is a rate limiter shaping many flows with a single timing wheel,
+ * as described in "Carousel: Scalable Traffic Shaping at End Hosts" (Saeed
+ * et al., SIGCOMM 2017).
+ *
+ * When a packet is enqueued, it is given a timestamp according to the rate of
+ * its flow, i.e., the time at which the previous packet of the flow has been
+ * entirely sent at that rate, and is stored in the slot of the timing wheel
+ * covering its timestamp. The slots of the wheel are internal queues, and
+ * each slot covers a duration of SlotDuration. The packets of a slot are
+ * released when the start time of the slot is reached. Packets whose
+ * timestamp is beyond the horizon of the wheel (NumSlots * SlotDuration)
+ * are dropped.
+ *
+ * The flows are identified by the packet filters, if any, or by the hash of
+ * the packet otherwise. The rate of a flow is set by SetFlowRate, and is
+ * DefaultRate if not set. A null rate does not shape the flow.
+ *
+ * A single wake-up event is scheduled, at the start of the next non-empty
+ * slot, whatever the number of flows and packets.
+ */
+class CarouselQueueDisc : public QueueDisc
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief CarouselQueueDisc constructor
+     */
+    CarouselQueueDisc();
+
+    ~CarouselQueueDisc() override;
+
+    /**
+     * @brief Set the rate of a flow.
+     * @param flow the flow, i.e., the value returned by the packet filters
+     * @param rate the rate (a null rate does not shape the flow)
+     */
+    void SetFlowRate(uint32_t flow, DataRate rate);
+
+    /**
+     * @brief Get the rate of a flow.
+     * @param flow the flow
+     * @return the rate of the flow
+     */
+    DataRate GetFlowRate(uint32_t flow) const;
+
+    /**
+     * @return the number of flows
+     */
+    std::size_t GetNFlows() const;
+
+    // Reasons for dropping packets
+    static constexpr const char* UNCLASSIFIED_DROP =
+        "Unclassified drop"; //!< No packet filter able to classify packet
+    static constexpr const char* LIMIT_EXCEEDED_DROP =
+        "Queue disc limit exceeded"; //!< Packet dropped due to queue disc limit exceeded
+    static constexpr const char* HORIZON_DROP =
+        "Beyond the horizon"; //!< Packet timestamp beyond the horizon of the timing wheel
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// State of a flow
+    struct Flow
+    {
+        DataRate rate;      //!< The rate of the flow
+        Time nextTimestamp; //!< The earliest timestamp of the next packet of the flow
+    };
+
+    bool DoEnqueue(Ptr<QueueDiscItem> item) override;
+    Ptr<QueueDiscItem> DoDequeue() override;
+    bool CheckConfig() override;
+    void InitializeParams() override;
+
+    /**
+     * @brief Get the flow of the given item, creating it if needed.
+     * @param item the item
+     * @return the flow, or nullptr if the item cannot be classified
+     */
+    Flow* GetFlow(Ptr<QueueDiscItem> item);
+
+    /**
+     * @brief Schedule the wake-up of the queue disc at the start of the next
+     *        non-empty slot, unless an earlier wake-up is already scheduled.
+     */
+    void ScheduleWakeUp();
+
+    uint32_t m_numSlots;     //!< Number of slots of the timing wheel
+    Time m_slotDuration;     //!< Duration covered by a slot
+    DataRate m_defaultRate;  //!< Rate of the flows whose rate is not set
+    uint32_t m_perturbation; //!< Hash perturbation value
+
+    std::unordered_map<uint32_t, Flow> m_flows; //!< The flows
+    uint32_t m_currentSlot; //!< The current slot of the timing wheel
+    Time m_wheelTime;       //!< The start time of the current slot
+    EventId m_id;           //!< Wake-up event
+};
+
+} // namespace ns3
+
+#endif /* CAROUSEL_QUEUE_DISC_H */
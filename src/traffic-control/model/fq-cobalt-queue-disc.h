@@ -16,13 +16,12 @@
 #ifndef FQ_COBALT_QUEUE_DISC
 #define FQ_COBALT_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
+#include "ns3/deprecated.h"
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -61,7 +60,9 @@ class FqCobaltFlow : public QueueDiscClass
     /**
      * @brief Set the deficit for this flow
      * @param deficit the deficit for this flow
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void SetDeficit(uint32_t deficit);
     /**
      * @brief Get the deficit for this flow
@@ -71,12 +72,16 @@ class FqCobaltFlow : public QueueDiscClass
     /**
      * @brief Increase the deficit for this flow
      * @param deficit the amount by which the deficit is to be increased
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void IncreaseDeficit(int32_t deficit);
     /**
      * @brief Set the status for this flow
      * @param status the status for this flow
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void SetStatus(FlowStatus status);
     /**
      * @brief Get the status of this flow
@@ -93,11 +98,18 @@ class FqCobaltFlow : public QueueDiscClass
      * @return the index of this flow
      */
     uint32_t GetIndex() const;
+    /**
+     * @brief Attach this flow to the flow table of the queue disc, which keeps
+     *        the deficit and the status of this flow from then on
+     * @param table the flow table
+     */
+    void SetFlowTable(const FqFlowTable* table);
 
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    int32_t m_deficit;              //!< the deficit for this flow
+    FlowStatus m_status;            //!< the status of this flow
+    uint32_t m_index;               //!< the index for this flow
+    const FqFlowTable* m_flowTable; //!< the flow table of the queue disc, if attached
 };
 
 /**
@@ -154,14 +166,6 @@ class FqCobaltQueueDisc : public QueueDisc
      */
     uint32_t FqCobaltDrop();
 
-    /**
-     * Compute the index of the queue for the flow having the given flowHash,
-     * according to the set associative hash approach.
-     *
-     * @param flowHash the hash of the flow 5-tuple
-     * @return the index of the queue for the given flow
-     */
-    uint32_t SetAssociativeHash(uint32_t flowHash);
 
     std::string m_interval;   //!< CoDel interval attribute
     std::string m_target;     //!< CoDel target attribute
@@ -179,11 +183,7 @@ class FqCobaltQueueDisc : public QueueDisc
     double m_Pdrop;       //!< Drop Probability
     Time m_blueThreshold; //!< Threshold to enable blue enhancement
 
-    std::list<Ptr<FqCobaltFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCobaltFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    FqFlowTable m_flowTable; //!< The flow queues and their DRR state
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
@@ -36,7 +36,8 @@ FqCoDelFlow::GetTypeId()
 FqCoDelFlow::FqCoDelFlow()
     : m_deficit(0),
       m_status(INACTIVE),
-      m_index(0)
+      m_index(0),
+      m_flowTable(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -57,7 +58,7 @@ int32_t
 FqCoDelFlow::GetDeficit() const
 {
     NS_LOG_FUNCTION(this);
-    return m_deficit;
+    return m_flowTable ? m_flowTable->GetDeficit(m_index) : m_deficit;
 }
 
 void
@@ -78,7 +79,7 @@ FqCoDelFlow::FlowStatus
 FqCoDelFlow::GetStatus() const
 {
     NS_LOG_FUNCTION(this);
-    return m_status;
+    return m_flowTable ? static_cast<FlowStatus>(m_flowTable->GetStatus(m_index)) : m_status;
 }
 
 void
@@ -94,6 +95,13 @@ FqCoDelFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqCoDelFlow::SetFlowTable(const FqFlowTable* table)
+{
+    NS_LOG_FUNCTION(this << table);
+    m_flowTable = table;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqCoDelQueueDisc);
 
 TypeId
@@ -188,36 +196,6 @@ FqCoDelQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
-{
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
-}
-
 bool
 FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 {
@@ -246,17 +224,10 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         }
     }
 
-    if (m_enableSetAssociativeHash)
-    {
-        h = SetAssociativeHash(flowHash);
-    }
-    else
-    {
-        h = flowHash % m_flows;
-    }
+    h = m_flowTable.GetFlow(flowHash);
 
     Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowTable.GetClassIndex(h) == FqFlowTable::NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCoDelFlow>();
@@ -272,25 +243,22 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         qd->Initialize();
         flow->SetQueueDisc(qd);
         flow->SetIndex(h);
+        flow->SetFlowTable(&m_flowTable);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowTable.SetClassIndex(h, GetNQueueDiscClasses() - 1);
     }
     else
     {
-        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowTable.GetClassIndex(h)));
     }
 
-    if (flow->GetStatus() == FqCoDelFlow::INACTIVE)
-    {
-        flow->SetStatus(FqCoDelFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
-    }
+    m_flowTable.Activate(h, m_quantum);
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index "
+                                              << m_flowTable.GetClassIndex(h));
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -306,70 +274,24 @@ FqCoDelQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCoDelFlow> flow;
     Ptr<QueueDiscItem> item;
+    uint32_t flow;
 
     do
     {
-        bool found = false;
+        flow = m_flowTable.Select(m_quantum);
 
-        while (!found && !m_newFlows.empty())
+        if (flow == FqFlowTable::NO_FLOW)
         {
-            flow = m_newFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        while (!found && !m_oldFlows.empty())
-        {
-            flow = m_oldFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        if (!found)
-        {
-            NS_LOG_DEBUG("No flow found to dequeue a packet");
             return nullptr;
         }
 
-        item = flow->GetQueueDisc()->Dequeue();
+        item = GetQueueDiscClass(m_flowTable.GetClassIndex(flow))->GetQueueDisc()->Dequeue();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
-            {
-                flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                flow->SetStatus(FqCoDelFlow::INACTIVE);
-                m_oldFlows.pop_front();
-            }
+            m_flowTable.Deactivate(flow);
         }
         else
         {
@@ -377,7 +299,7 @@ FqCoDelQueueDisc::DoDequeue()
         }
     } while (!item);
 
-    flow->IncreaseDeficit(item->GetSize() * -1);
+    m_flowTable.Consume(flow, item->GetSize());
 
     return item;
 }
@@ -448,6 +370,8 @@ FqCoDelQueueDisc::InitializeParams()
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("Interval", StringValue(m_interval));
     m_queueDiscFactory.Set("Target", StringValue(m_target));
+
+    m_flowTable.Reset(m_flows, m_enableSetAssociativeHash ? m_setWays : 0);
 }
 
 uint32_t
@@ -10,13 +10,12 @@
 #ifndef FQ_CODEL_QUEUE_DISC
 #define FQ_CODEL_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
+#include "ns3/deprecated.h"
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -55,7 +54,9 @@ class FqCoDelFlow : public QueueDiscClass
     /**
      * @brief Set the deficit for this flow
      * @param deficit the deficit for this flow
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void SetDeficit(uint32_t deficit);
     /**
      * @brief Get the deficit for this flow
@@ -65,12 +66,16 @@ class FqCoDelFlow : public QueueDiscClass
     /**
      * @brief Increase the deficit for this flow
      * @param deficit the amount by which the deficit is to be increased
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void IncreaseDeficit(int32_t deficit);
     /**
      * @brief Set the status for this flow
      * @param status the status for this flow
+     * @deprecated The flow table of the queue disc keeps the DRR state of the flow
      */
+    NS_DEPRECATED_3_47("The DRR state of the flows is kept by the flow table of the queue disc")
     void SetStatus(FlowStatus status);
     /**
      * @brief Get the status of this flow
@@ -87,11 +92,18 @@ class FqCoDelFlow : public QueueDiscClass
      * @return the index of this flow
      */
     uint32_t GetIndex() const;
+    /**
+     * @brief Attach this flow to the flow table of the queue disc, which keeps
+     *        the deficit and the status of this flow from then on
+     * @param table the flow table
+     */
+    void SetFlowTable(const FqFlowTable* table);
 
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    int32_t m_deficit;              //!< the deficit for this flow
+    FlowStatus m_status;            //!< the status of this flow
+    uint32_t m_index;               //!< the index for this flow
+    const FqFlowTable* m_flowTable; //!< the flow table of the queue disc, if attached
 };
 
 /**
@@ -149,14 +161,6 @@ class FqCoDelQueueDisc : public QueueDisc
     uint32_t FqCoDelDrop();
 
     bool m_useEcn; //!< True if ECN is used (packets are marked instead of being dropped)
-    /**
-     * Compute the index of the queue for the flow having the given flowHash,
-     * according to the set associative hash approach.
-     *
-     * @param flowHash the hash of the flow 5-tuple
-     * @return the index of the queue for the given flow
-     */
-    uint32_t SetAssociativeHash(uint32_t flowHash);
 
     std::string m_interval;          //!< CoDel interval attribute
     std::string m_target;            //!< CoDel target attribute
@@ -169,11 +173,7 @@ class FqCoDelQueueDisc : public QueueDisc
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
     bool m_useL4s; //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-    std::list<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    FqFlowTable m_flowTable; //!< The flow queues and their DRR state
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
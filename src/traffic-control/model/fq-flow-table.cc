@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fq-flow-table.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FqFlowTable");
+
+FqFlowTable::FqFlowTable()
+    : m_setWays(0)
+{
+}
+
+void
+FqFlowTable::Reset(uint32_t nFlows, uint32_t setWays)
+{
+    NS_LOG_FUNCTION(this << nFlows << setWays);
+    NS_ASSERT_MSG(setWays == 0 || nFlows % setWays == 0,
+                  "The number of flow queues must be a multiple of the size of the sets");
+    m_flows.assign(nFlows, Flow());
+    m_setWays = setWays;
+    m_newFlows = List();
+    m_oldFlows = List();
+}
+
+uint32_t
+FqFlowTable::GetFlow(uint32_t flowHash)
+{
+    uint32_t h = flowHash % m_flows.size();
+    if (m_setWays == 0)
+    {
+        return h;
+    }
+
+    uint32_t outerHash = h - h % m_setWays;
+    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
+    {
+        Flow& flow = m_flows[i];
+        if (flow.classIndex == NO_FLOW || (flow.tagged && flow.tag == flowHash) ||
+            flow.status == INACTIVE)
+        {
+            // this queue has not been created yet or is associated with this flow
+            // or is inactive, hence we can use it
+            flow.tagged = true;
+            flow.tag = flowHash;
+            return i;
+        }
+    }
+
+    // all the queues of the set are used. Use the first queue of the set
+    m_flows[outerHash].tagged = true;
+    m_flows[outerHash].tag = flowHash;
+    return outerHash;
+}
+
+uint32_t
+FqFlowTable::GetClassIndex(uint32_t flow) const
+{
+    return m_flows[flow].classIndex;
+}
+
+void
+FqFlowTable::SetClassIndex(uint32_t flow, uint32_t classIndex)
+{
+    m_flows[flow].classIndex = classIndex;
+}
+
+FqFlowTable::FlowStatus
+FqFlowTable::GetStatus(uint32_t flow) const
+{
+    return m_flows[flow].status;
+}
+
+int32_t
+FqFlowTable::GetDeficit(uint32_t flow) const
+{
+    return m_flows[flow].deficit;
+}
+
+void
+FqFlowTable::Activate(uint32_t flow, uint32_t quantum)
+{
+    if (m_flows[flow].status == INACTIVE)
+    {
+        m_flows[flow].status = NEW_FLOW;
+        m_flows[flow].deficit = quantum;
+        PushBack(m_newFlows, flow);
+    }
+}
+
+uint32_t
+FqFlowTable::Select(uint32_t quantum)
+{
+    while (m_newFlows.head != NO_FLOW)
+    {
+        uint32_t flow = m_newFlows.head;
+        if (m_flows[flow].deficit <= 0)
+        {
+            NS_LOG_DEBUG("Increase deficit for new flow index " << flow);
+            m_flows[flow].deficit += quantum;
+            m_flows[flow].status = OLD_FLOW;
+            PushBack(m_oldFlows, PopFront(m_newFlows));
+        }
+        else
+        {
+            NS_LOG_DEBUG("Found a new flow " << flow << " with positive deficit");
+            return flow;
+        }
+    }
+
+    while (m_oldFlows.head != NO_FLOW)
+    {
+        uint32_t flow = m_oldFlows.head;
+        if (m_flows[flow].deficit <= 0)
+        {
+            NS_LOG_DEBUG("Increase deficit for old flow index " << flow);
+            m_flows[flow].deficit += quantum;
+            PushBack(m_oldFlows, PopFront(m_oldFlows));
+        }
+        else
+        {
+            NS_LOG_DEBUG("Found an old flow " << flow << " with positive deficit");
+            return flow;
+        }
+    }
+
+    NS_LOG_DEBUG("No flow found to dequeue a packet");
+    return NO_FLOW;
+}
+
+void
+FqFlowTable::Deactivate(uint32_t flow)
+{
+    if (m_newFlows.head != NO_FLOW)
+    {
+        NS_ASSERT(m_newFlows.head == flow);
+        m_flows[flow].status = OLD_FLOW;
+        PushBack(m_oldFlows, PopFront(m_newFlows));
+    }
+    else
+    {
+        NS_ASSERT(m_oldFlows.head == flow);
+        m_flows[flow].status = INACTIVE;
+        PopFront(m_oldFlows);
+    }
+}
+
+void
+FqFlowTable::Consume(uint32_t flow, uint32_t bytes)
+{
+    m_flows[flow].deficit -= static_cast<int32_t>(bytes);
+}
+
+void
+FqFlowTable::PushBack(List& list, uint32_t flow)
+{
+    m_flows[flow].next = NO_FLOW;
+    if (list.tail == NO_FLOW)
+    {
+        list.head = flow;
+    }
+    else
+    {
+        m_flows[list.tail].next = flow;
+    }
+    list.tail = flow;
+}
+
+uint32_t
+FqFlowTable::PopFront(List& list)
+{
+    uint32_t flow = list.head;
+    NS_ASSERT(flow != NO_FLOW);
+    list.head = m_flows[flow].next;
+    if (list.head == NO_FLOW)
+    {
+        list.tail = NO_FLOW;
+    }
+    m_flows[flow].next = NO_FLOW;
+    return flow;
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief The flow table shared by the flow queueing (FQ) queue discs.
+ *
+ * The table maps the flow hashes to flow queues (buckets), according to the
+ * set associative hash approach if enabled, and keeps the Deficit Round Robin
+ * state of the flow queues: deficit, status, and the lists of new and old
+ * flows. The state of all the flow queues is stored in a single vector
+ * indexed by bucket, and the lists of new and old flows are linked through
+ * the bucket indices, so that neither maps nor per-flow allocations are
+ * involved in enqueue and dequeue operations.
+ *
+ * The queue discs keep a QueueDiscClass per flow queue, created upon the
+ * arrival of the first packet of the flow queue, whose index is stored in
+ * the table.
+ */
+class FqFlowTable
+{
+  public:
+    /// Status of a flow queue
+    enum FlowStatus : uint8_t
+    {
+        INACTIVE,
+        NEW_FLOW,
+        OLD_FLOW
+    };
+
+    /// Value returned when no flow queue is found
+    static constexpr uint32_t NO_FLOW = std::numeric_limits<uint32_t>::max();
+
+    FqFlowTable();
+
+    /**
+     * @brief Reset the table, with all the flow queues inactive and without class.
+     * @param nFlows the number of flow queues
+     * @param setWays the size of a set of flow queues for the set associative
+     *        hash, or 0 to map the flow hashes modulo the number of flow queues
+     */
+    void Reset(uint32_t nFlows, uint32_t setWays);
+
+    /**
+     * @brief Get the flow queue of the flow having the given hash.
+     * @param flowHash the hash of the flow
+     * @return the flow queue
+     */
+    uint32_t GetFlow(uint32_t flowHash);
+
+    /**
+     * @param flow the flow queue
+     * @return the index of the class of the flow queue, or NO_FLOW if none
+     */
+    uint32_t GetClassIndex(uint32_t flow) const;
+
+    /**
+     * @brief Set the index of the class of a flow queue.
+     * @param flow the flow queue
+     * @param classIndex the index of the class
+     */
+    void SetClassIndex(uint32_t flow, uint32_t classIndex);
+
+    /**
+     * @param flow the flow queue
+     * @return the status of the flow queue
+     */
+    FlowStatus GetStatus(uint32_t flow) const;
+
+    /**
+     * @param flow the flow queue
+     * @return the deficit of the flow queue
+     */
+    int32_t GetDeficit(uint32_t flow) const;
+
+    /**
+     * @brief Add an inactive flow queue to the list of new flows, with the given deficit.
+     * @param flow the flow queue
+     * @param quantum the deficit
+     */
+    void Activate(uint32_t flow, uint32_t quantum);
+
+    /**
+     * @brief Select the flow queue to dequeue a packet from, according to DRR.
+     *
+     * The flow queues with no deficit left get the quantum and are moved to the
+     * end of the list of old flows, until a flow queue with a positive deficit
+     * is found at the head of the list of new flows or, if that list is empty,
+     * at the head of the list of old flows.
+     *
+     * @param quantum the deficit assigned to the flow queues at each round
+     * @return the selected flow queue, or NO_FLOW if there is no active flow queue
+     */
+    uint32_t Select(uint32_t quantum);
+
+    /**
+     * @brief Handle the selected flow queue being empty: a new flow becomes an
+     *        old flow, while an old flow becomes inactive.
+     * @param flow the flow queue returned by Select
+     */
+    void Deactivate(uint32_t flow);
+
+    /**
+     * @brief Decrease the deficit of a flow queue.
+     * @param flow the flow queue
+     * @param bytes the size of the dequeued packet
+     */
+    void Consume(uint32_t flow, uint32_t bytes);
+
+  private:
+    /// State of a flow queue
+    struct Flow
+    {
+        int32_t deficit{0};           //!< the deficit
+        FlowStatus status{INACTIVE};  //!< the status
+        bool tagged{false};           //!< whether a tag is set (set associative hash)
+        uint32_t tag{0};              //!< the hash of the flow using this flow queue
+        uint32_t classIndex{NO_FLOW}; //!< the index of the class
+        uint32_t next{NO_FLOW};       //!< the next flow queue in the list
+    };
+
+    /// A list of flow queues, linked through Flow::next
+    struct List
+    {
+        uint32_t head{NO_FLOW}; //!< the first flow queue
+        uint32_t tail{NO_FLOW}; //!< the last flow queue
+    };
+
+    /**
+     * @brief Append a flow queue to a list.
+     * @param list the list
+     * @param flow the flow queue
+     */
+    void PushBack(List& list, uint32_t flow);
+
+    /**
+     * @brief Remove the first flow queue of a list.
+     * @param list the list
+     * @return the removed flow queue
+     */
+    uint32_t PopFront(List& list);
+
+    std::vector<Flow> m_flows; //!< the flow queues
+    uint32_t m_setWays;        //!< size of a set of flow queues (0 if no set associative hash)
+    List m_newFlows;           //!< the list of new flows
+    List m_oldFlows;           //!< the list of old flows
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
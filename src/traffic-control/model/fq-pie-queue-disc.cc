@@ -41,7 +41,8 @@ FqPieFlow::GetTypeId()
 FqPieFlow::FqPieFlow()
     : m_deficit(0),
       m_status(INACTIVE),
-      m_index(0)
+      m_index(0),
+      m_flowTable(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -62,7 +63,7 @@ int32_t
 FqPieFlow::GetDeficit() const
 {
     NS_LOG_FUNCTION(this);
-    return m_deficit;
+    return m_flowTable ? m_flowTable->GetDeficit(m_index) : m_deficit;
 }
 
 void
@@ -83,7 +84,7 @@ FqPieFlow::FlowStatus
 FqPieFlow::GetStatus() const
 {
     NS_LOG_FUNCTION(this);
-    return m_status;
+    return m_flowTable ? static_cast<FlowStatus>(m_flowTable->GetStatus(m_index)) : m_status;
 }
 
 void
@@ -99,6 +100,13 @@ FqPieFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqPieFlow::SetFlowTable(const FqFlowTable* table)
+{
+    NS_LOG_FUNCTION(this << table);
+    m_flowTable = table;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqPieQueueDisc);
 
 TypeId
@@ -243,36 +251,6 @@ FqPieQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
-{
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
-}
-
 bool
 FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 {
@@ -301,17 +279,10 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         }
     }
 
-    if (m_enableSetAssociativeHash)
-    {
-        h = SetAssociativeHash(flowHash);
-    }
-    else
-    {
-        h = flowHash % m_flows;
-    }
+    h = m_flowTable.GetFlow(flowHash);
 
     Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowTable.GetClassIndex(h) == FqFlowTable::NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -327,25 +298,22 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         qd->Initialize();
         flow->SetQueueDisc(qd);
         flow->SetIndex(h);
+        flow->SetFlowTable(&m_flowTable);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowTable.SetClassIndex(h, GetNQueueDiscClasses() - 1);
     }
     else
     {
-        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowTable.GetClassIndex(h)));
     }
 
-    if (flow->GetStatus() == FqPieFlow::INACTIVE)
-    {
-        flow->SetStatus(FqPieFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
-    }
+    m_flowTable.Activate(h, m_quantum);
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index "
+                                              << m_flowTable.GetClassIndex(h));
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -361,72 +329,24 @@ FqPieQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqPieFlow> flow;
     Ptr<QueueDiscItem> item;
+    uint32_t flow;
 
     do
     {
-        bool found = false;
+        flow = m_flowTable.Select(m_quantum);
 
-        while (!found && !m_newFlows.empty())
+        if (flow == FqFlowTable::NO_FLOW)
         {
-            flow = m_newFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        while (!found && !m_oldFlows.empty())
-        {
-            flow = m_oldFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        if (!found)
-        {
-            NS_LOG_DEBUG("No flow found to dequeue a packet");
             return nullptr;
         }
 
-        item = flow->GetQueueDisc()->Dequeue();
+        item = GetQueueDiscClass(m_flowTable.GetClassIndex(flow))->GetQueueDisc()->Dequeue();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
-            {
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
-            }
+            m_flowTable.Deactivate(flow);
         }
         else
         {
@@ -434,7 +354,7 @@ FqPieQueueDisc::DoDequeue()
         }
     } while (!item);
 
-    flow->IncreaseDeficit(item->GetSize() * -1);
+    m_flowTable.Consume(flow, item->GetSize());
 
     return item;
 }
@@ -514,6 +434,8 @@ FqPieQueueDisc::InitializeParams()
     m_queueDiscFactory.Set("UseDequeueRateEstimator", BooleanValue(m_useDqRateEstimator));
     m_queueDiscFactory.Set("UseCapDropAdjustment", BooleanValue(m_isCapDropAdjustment));
     m_queueDiscFactory.Set("UseDerandomization", BooleanValue(m_useDerandomization));
+
+    m_flowTable.Reset(m_flows, m_enableSetAssociativeHash ? m_setWays : 0);
 }
 
 uint32_t
@@ -0,0 +1,550 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * HTB, the Hierarchical Token Bucket queueing discipline
+ *
+ * This implementation is based on the design of the linux kernel code by
+ * Martin Devera, <devik@cdi.cz>
+ */
+
+#include "htb-queue-disc.h"
+
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HtbQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED(HtbClass);
+
+TypeId
+HtbClass::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbClass")
+            .SetParent<QueueDiscClass>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbClass>()
+            .AddAttribute("Parent",
+                          "The index of the parent class, or -1 for a top level class",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&HtbClass::m_parent),
+                          MakeIntegerChecker<int32_t>(-1))
+            .AddAttribute("Rate",
+                          "The assured rate of the class",
+                          DataRateValue(DataRate("1Mbps")),
+                          MakeDataRateAccessor(&HtbClass::m_rate),
+                          MakeDataRateChecker())
+            .AddAttribute("Ceil",
+                          "The maximum rate of the class when borrowing from its parent "
+                          "(zero for the assured rate)",
+                          DataRateValue(DataRate("0bps")),
+                          MakeDataRateAccessor(&HtbClass::m_ceil),
+                          MakeDataRateChecker())
+            .AddAttribute("Burst",
+                          "The number of bytes that can be burst at the assured rate",
+                          UintegerValue(1600),
+                          MakeUintegerAccessor(&HtbClass::m_burst),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Cburst",
+                          "The number of bytes that can be burst at the maximum rate",
+                          UintegerValue(1600),
+                          MakeUintegerAccessor(&HtbClass::m_cburst),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Quantum",
+                          "The number of bytes dequeued from a leaf class at each round "
+                          "(zero to use a tenth of the bytes sent in a second at the "
+                          "assured rate, between 1000 and 200000)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_quantum),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Priority",
+                          "The priority of a leaf class (lower values are served first)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbClass::m_priority),
+                          MakeUintegerChecker<uint32_t>(0, HtbQueueDisc::N_PRIOS - 1));
+    return tid;
+}
+
+HtbClass::HtbClass()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbClass::~HtbClass()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+int32_t
+HtbClass::GetParent() const
+{
+    return m_parent;
+}
+
+DataRate
+HtbClass::GetRate() const
+{
+    return m_rate;
+}
+
+DataRate
+HtbClass::GetCeil() const
+{
+    return m_ceil;
+}
+
+uint32_t
+HtbClass::GetBurst() const
+{
+    return m_burst;
+}
+
+uint32_t
+HtbClass::GetCburst() const
+{
+    return m_cburst;
+}
+
+uint32_t
+HtbClass::GetQuantum() const
+{
+    return m_quantum;
+}
+
+uint32_t
+HtbClass::GetPriority() const
+{
+    return m_priority;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(HtbQueueDisc);
+
+TypeId
+HtbQueueDisc::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbQueueDisc>()
+            .AddAttribute("DefaultClass",
+                          "The index of the leaf class of the packets not classified by the "
+                          "packet filters (-1 to drop such packets)",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&HtbQueueDisc::m_defaultClass),
+                          MakeIntegerChecker<int32_t>(-1));
+    return tid;
+}
+
+HtbQueueDisc::HtbQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbQueueDisc::~HtbQueueDisc()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+HtbQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_id.Cancel();
+    m_classes.clear();
+    m_rows.clear();
+    m_waitQueue.clear();
+    QueueDisc::DoDispose();
+}
+
+uint32_t
+HtbQueueDisc::Pick(const RoundRobinSet& set)
+{
+    NS_ASSERT(!set.members.empty());
+    auto it = set.members.lower_bound(set.next);
+    return (it != set.members.end() ? *it : *set.members.begin());
+}
+
+void
+HtbQueueDisc::Advance(RoundRobinSet& set, uint32_t id)
+{
+    set.next = id + 1;
+}
+
+void
+HtbQueueDisc::UpdateTokens(ClassState& c) const
+{
+    Time now = Simulator::Now();
+    Time diff = now - c.checkpoint;
+    c.tokens = std::min(c.tokens + diff, c.buffer);
+    c.ctokens = std::min(c.ctokens + diff, c.cbuffer);
+    c.checkpoint = now;
+}
+
+void
+HtbQueueDisc::UpdateMode(uint32_t id)
+{
+    ClassState& c = m_classes[id];
+    ClassMode mode = CAN_SEND;
+    Time wait;
+    if (c.ctokens.IsStrictlyNegative())
+    {
+        mode = CANT_SEND;
+        wait = Time(0) - c.ctokens;
+    }
+    else if (c.tokens.IsStrictlyNegative())
+    {
+        mode = MAY_BORROW;
+        wait = Time(0) - c.tokens;
+    }
+
+    if (c.waitTime != Time::Max())
+    {
+        m_waitQueue.erase({c.waitTime, id});
+        c.waitTime = Time::Max();
+    }
+    if (mode != CAN_SEND)
+    {
+        c.waitTime = Simulator::Now() + wait;
+        m_waitQueue.insert({c.waitTime, id});
+    }
+
+    if (mode != c.mode)
+    {
+        NS_LOG_LOGIC("Class " << id << " changes mode from " << +c.mode << " to " << +mode);
+        c.mode = mode;
+        UpdateMembership(id);
+    }
+}
+
+void
+HtbQueueDisc::UpdateMembership(uint32_t id)
+{
+    ClassState& c = m_classes[id];
+    for (uint32_t p = 0; p < N_PRIOS; p++)
+    {
+        uint8_t bit = (1 << p);
+        bool active = (c.activePrios & bit);
+        bool inRow = (active && c.mode == CAN_SEND);
+        bool inFeed = (active && c.mode == MAY_BORROW && c.parent != NO_CLASS);
+
+        if (inRow != static_cast<bool>(c.inRow & bit))
+        {
+            if (inRow)
+            {
+                m_rows[c.level][p].members.insert(id);
+            }
+            else
+            {
+                m_rows[c.level][p].members.erase(id);
+            }
+            c.inRow ^= bit;
+        }
+
+        if (inFeed != static_cast<bool>(c.inFeed & bit))
+        {
+            ClassState& parent = m_classes[c.parent];
+            if (inFeed)
+            {
+                parent.feeds[p].members.insert(id);
+            }
+            else
+            {
+                parent.feeds[p].members.erase(id);
+            }
+            c.inFeed ^= bit;
+
+            // the parent has a backlog at this priority as long as some of its
+            // children may borrow from it
+            if (parent.feeds[p].members.empty() == static_cast<bool>(parent.activePrios & bit))
+            {
+                parent.activePrios ^= bit;
+                UpdateMembership(c.parent);
+            }
+        }
+    }
+}
+
+void
+HtbQueueDisc::ProcessWaitQueue()
+{
+    Time now = Simulator::Now();
+    while (!m_waitQueue.empty() && m_waitQueue.begin()->first <= now)
+    {
+        uint32_t id = m_waitQueue.begin()->second;
+        UpdateTokens(m_classes[id]);
+        UpdateMode(id);
+    }
+}
+
+void
+HtbQueueDisc::SetLeafActive(uint32_t id, bool active)
+{
+    ClassState& c = m_classes[id];
+    uint8_t activePrios = (active ? (1 << c.prio) : 0);
+    if (activePrios != c.activePrios)
+    {
+        c.activePrios = activePrios;
+        UpdateMembership(id);
+    }
+}
+
+bool
+HtbQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    int32_t ret = Classify(item);
+    uint32_t id = NO_CLASS;
+
+    if (ret != PacketFilter::PF_NO_MATCH && ret >= 0 &&
+        static_cast<uint32_t>(ret) < m_classes.size() && m_classes[ret].isLeaf)
+    {
+        id = ret;
+    }
+    else if (m_defaultClass >= 0)
+    {
+        NS_LOG_DEBUG("Packet not classified into a leaf class, using the default class");
+        id = m_defaultClass;
+    }
+    else
+    {
+        NS_LOG_DEBUG("No filter has been able to classify this packet, drop it.");
+        DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+        return false;
+    }
+
+    bool retval = m_classes[id].queueDisc->Enqueue(item);
+
+    // If Queue::Enqueue fails, QueueDisc::Drop is called by the child queue disc
+    // because QueueDisc::AddQueueDiscClass sets the drop callback
+
+    if (retval)
+    {
+        SetLeafActive(id, true);
+    }
+
+    NS_LOG_LOGIC("Number packets class " << id << ": "
+                                         << m_classes[id].queueDisc->GetNPackets());
+
+    return retval;
+}
+
+uint32_t
+HtbQueueDisc::FindLeaf(uint32_t& lender, uint32_t& prio)
+{
+    for (prio = 0; prio < N_PRIOS; prio++)
+    {
+        for (const auto& rows : m_rows)
+        {
+            const RoundRobinSet& row = rows[prio];
+            if (row.members.empty())
+            {
+                continue;
+            }
+            // walk down the tree through the classes that may borrow
+            lender = Pick(row);
+            uint32_t id = lender;
+            while (!m_classes[id].isLeaf)
+            {
+                id = Pick(m_classes[id].feeds[prio]);
+            }
+            return id;
+        }
+    }
+    return NO_CLASS;
+}
+
+void
+HtbQueueDisc::Charge(uint32_t id, uint32_t level, uint32_t bytes)
+{
+    for (; id != NO_CLASS; id = m_classes[id].parent)
+    {
+        ClassState& c = m_classes[id];
+        UpdateTokens(c);
+        // the classes below the level of the lender borrow, hence they do not
+        // consume their assured rate
+        if (c.level >= level)
+        {
+            c.tokens -= c.rate.CalculateBytesTxTime(bytes);
+        }
+        c.ctokens -= c.ceil.CalculateBytesTxTime(bytes);
+        UpdateMode(id);
+    }
+}
+
+Ptr<QueueDiscItem>
+HtbQueueDisc::DoDequeue()
+{
+    NS_LOG_FUNCTION(this);
+
+    ProcessWaitQueue();
+
+    uint32_t lender;
+    uint32_t prio;
+    uint32_t leaf;
+    Ptr<QueueDiscItem> item;
+
+    while ((leaf = FindLeaf(lender, prio)) != NO_CLASS)
+    {
+        ClassState& c = m_classes[leaf];
+        item = c.queueDisc->Dequeue();
+
+        if (c.queueDisc->GetNPackets() == 0)
+        {
+            SetLeafActive(leaf, false);
+        }
+
+        if (!item)
+        {
+            NS_LOG_DEBUG("Could not get a packet from the selected class");
+            continue;
+        }
+
+        NS_LOG_LOGIC("Popped from class " << leaf << ": " << item);
+
+        c.deficit -= item->GetSize();
+        if (c.deficit < 0)
+        {
+            c.deficit += c.quantum;
+            // move to the next class in all the sets on the path from the leaf
+            // to the lender
+            for (uint32_t id = leaf; id != lender; id = m_classes[id].parent)
+            {
+                Advance(m_classes[m_classes[id].parent].feeds[prio], id);
+            }
+            Advance(m_rows[m_classes[lender].level][prio], lender);
+        }
+
+        Charge(leaf, m_classes[lender].level, item->GetSize());
+        return item;
+    }
+
+    if (GetNPackets() > 0 && !m_waitQueue.empty())
+    {
+        // wake up when the first class changes mode
+        Time delay = m_waitQueue.begin()->first - Simulator::Now();
+        if (m_id.IsExpired() || Simulator::GetDelayLeft(m_id) > delay)
+        {
+            m_id.Cancel();
+            m_id = Simulator::Schedule(delay, &QueueDisc::Run, this);
+            NS_LOG_LOGIC("Waking event scheduled in " << delay.As(Time::S));
+        }
+    }
+
+    return nullptr;
+}
+
+bool
+HtbQueueDisc::CheckConfig()
+{
+    NS_LOG_FUNCTION(this);
+    if (GetNInternalQueues() > 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc cannot have internal queues");
+        return false;
+    }
+
+    if (GetNQueueDiscClasses() == 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc needs at least one class");
+        return false;
+    }
+
+    std::vector<bool> isLeaf(GetNQueueDiscClasses(), true);
+    for (std::size_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<HtbClass> c = DynamicCast<HtbClass>(GetQueueDiscClass(i));
+        if (!c)
+        {
+            NS_LOG_ERROR("The classes of HtbQueueDisc must be HtbClass objects");
+            return false;
+        }
+
+        if (c->GetParent() >= static_cast<int32_t>(i))
+        {
+            NS_LOG_ERROR("The parent of class " << i << " must precede it");
+            return false;
+        }
+        if (c->GetParent() >= 0)
+        {
+            isLeaf[c->GetParent()] = false;
+        }
+
+        if (c->GetRate().GetBitRate() == 0)
+        {
+            NS_LOG_ERROR("The rate of class " << i << " cannot be null");
+            return false;
+        }
+
+        if (c->GetCeil().GetBitRate() > 0 && c->GetCeil() < c->GetRate())
+        {
+            NS_LOG_ERROR("The ceil of class " << i << " cannot be less than its rate");
+            return false;
+        }
+    }
+
+    if (m_defaultClass >= static_cast<int32_t>(GetNQueueDiscClasses()) ||
+        (m_defaultClass >= 0 && !isLeaf[m_defaultClass]))
+    {
+        NS_LOG_ERROR("The default class must be a leaf class");
+        return false;
+    }
+
+    return true;
+}
+
+void
+HtbQueueDisc::InitializeParams()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_classes.clear();
+    m_classes.resize(GetNQueueDiscClasses());
+    for (std::size_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<HtbClass> htbClass = StaticCast<HtbClass>(GetQueueDiscClass(i));
+        ClassState& c = m_classes[i];
+        c.queueDisc = htbClass->GetQueueDisc();
+        c.parent = (htbClass->GetParent() >= 0 ? htbClass->GetParent() : NO_CLASS);
+        c.prio = htbClass->GetPriority();
+        c.rate = htbClass->GetRate();
+        c.ceil = (htbClass->GetCeil().GetBitRate() > 0 ? htbClass->GetCeil() : c.rate);
+        c.buffer = c.rate.CalculateBytesTxTime(htbClass->GetBurst());
+        c.cbuffer = c.ceil.CalculateBytesTxTime(htbClass->GetCburst());
+        c.tokens = c.buffer;
+        c.ctokens = c.cbuffer;
+        c.quantum = htbClass->GetQuantum();
+        if (c.quantum == 0)
+        {
+            c.quantum = std::clamp<uint64_t>(c.rate.GetBitRate() / 80, 1000, 200000);
+        }
+    }
+
+    // the parents precede their children
+    uint32_t maxLevel = 0;
+    for (std::size_t i = m_classes.size(); i-- > 0;)
+    {
+        if (m_classes[i].parent != NO_CLASS)
+        {
+            ClassState& parent = m_classes[m_classes[i].parent];
+            parent.isLeaf = false;
+            parent.level = std::max(parent.level, m_classes[i].level + 1);
+            maxLevel = std::max(maxLevel, parent.level);
+        }
+    }
+
+    m_rows.assign(maxLevel + 1, {});
+    m_waitQueue.clear();
+    m_id = EventId();
+}
+
+} // namespace ns3
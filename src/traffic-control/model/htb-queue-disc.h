@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * HTB, the Hierarchical Token Bucket queueing discipline
+ *
+ * This implementation is based on the design of the linux kernel code by
+ * Martin Devera, <devik@cdi.cz>
+ */
+
+#ifndef HTB_QUEUE_DISC_H
+#define HTB_QUEUE_DISC_H
+
+#include "queue-disc.h"
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <array>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief A class of the HTB queue disc.
+ *
+ * The class is guaranteed the Rate and can borrow from its parent class up to
+ * the Ceil. The Parent attribute is the index of the parent class within the
+ * classes of the queue disc, which must precede its children, or -1 for a top
+ * level class. Only the queue discs of the leaf classes store packets.
+ */
+class HtbClass : public QueueDiscClass
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    HtbClass();
+    ~HtbClass() override;
+
+    /**
+     * @return the index of the parent class, or -1 for a top level class
+     */
+    int32_t GetParent() const;
+
+    /**
+     * @return the assured rate of the class
+     */
+    DataRate GetRate() const;
+
+    /**
+     * @return the maximum rate of the class (when borrowing), or zero if it
+     *         equals the assured rate
+     */
+    DataRate GetCeil() const;
+
+    /**
+     * @return the number of bytes that can be burst at the assured rate
+     */
+    uint32_t GetBurst() const;
+
+    /**
+     * @return the number of bytes that can be burst at the ceil rate
+     */
+    uint32_t GetCburst() const;
+
+    /**
+     * @return the number of bytes dequeued from a leaf class at each DRR round,
+     *         or zero if derived from the assured rate
+     */
+    uint32_t GetQuantum() const;
+
+    /**
+     * @return the priority of a leaf class (lower values are served first)
+     */
+    uint32_t GetPriority() const;
+
+  private:
+    int32_t m_parent;    //!< Index of the parent class
+    DataRate m_rate;     //!< Assured rate
+    DataRate m_ceil;     //!< Maximum rate
+    uint32_t m_burst;    //!< Burst at the assured rate in bytes
+    uint32_t m_cburst;   //!< Burst at the maximum rate in bytes
+    uint32_t m_quantum;  //!< DRR quantum in bytes
+    uint32_t m_priority; //!< Priority of the class
+};
+
+/**
+ * @ingroup traffic-control
+ *
+ * The HTB (Hierarchical Token Bucket) queue disc shares the link among a tree
+ * of classes (HtbClass objects). Each class has an assured rate and a maximum
+ * rate (ceil), enforced by two token buckets. A class whose assured rate is
+ * exceeded may borrow the unused rate of its ancestors, up to its ceil. The
+ * packets are classified into leaf classes by the packet filters (which
+ * return the index of the class) or, failing that, go to the DefaultClass.
+ *
+ * As in Linux, each class is, at any time, in one of three modes: it can send
+ * within its assured rate, it may borrow from its parent, or it cannot send
+ * because its ceil is exceeded. The classes that can send and have a backlog
+ * are kept, for each level of the tree and each priority, in an ordered set
+ * served in round robin, and the classes that may borrow are kept in similar
+ * sets of their parent. Thus, the leaf to dequeue from is found by walking
+ * down the tree from the lowest non-empty level, in O(log n) for n classes.
+ * Leaves of the same priority share the excess rate according to their
+ * quantum (Deficit Round Robin). The classes that cannot send are kept in a
+ * wait queue ordered by the time their mode changes, and a single wake-up
+ * event is scheduled, at the earliest of such times, when no packet can be
+ * dequeued.
+ */
+class HtbQueueDisc : public QueueDisc
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief HtbQueueDisc constructor
+     */
+    HtbQueueDisc();
+
+    ~HtbQueueDisc() override;
+
+    /// Number of priorities of the leaf classes
+    static constexpr uint32_t N_PRIOS = 8;
+
+    /// Mode of a class
+    enum ClassMode : uint8_t
+    {
+        CAN_SEND,   //!< within the assured rate
+        MAY_BORROW, //!< above the assured rate, within the ceil
+        CANT_SEND   //!< above the ceil
+    };
+
+    // Reasons for dropping packets
+    static constexpr const char* UNCLASSIFIED_DROP =
+        "Unclassified drop"; //!< No packet filter able to classify packet and no default class
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Classes served in round robin, ordered by index
+    struct RoundRobinSet
+    {
+        std::set<uint32_t> members; //!< the indices of the classes
+        uint32_t next{0};           //!< the index from which to look for the next class
+    };
+
+    /// State of a class
+    struct ClassState
+    {
+        Ptr<QueueDisc> queueDisc;                 //!< the queue disc of the class
+        uint32_t parent;                          //!< the parent class
+        bool isLeaf{true};                        //!< whether the class is a leaf
+        uint32_t level{0};                        //!< the level (0 for the leaves)
+        uint32_t prio{0};                         //!< the priority of a leaf
+        DataRate rate;                            //!< the assured rate
+        DataRate ceil;                            //!< the maximum rate
+        Time buffer;                              //!< the size of the rate bucket
+        Time cbuffer;                             //!< the size of the ceil bucket
+        Time tokens;                              //!< the tokens of the rate bucket
+        Time ctokens;                             //!< the tokens of the ceil bucket
+        Time checkpoint;                          //!< the last update of the tokens
+        uint32_t quantum{0};                      //!< the DRR quantum
+        int32_t deficit{0};                       //!< the DRR deficit
+        ClassMode mode{CAN_SEND};                 //!< the mode
+        Time waitTime{Time::Max()};               //!< the end of the wait (if not CAN_SEND)
+        uint8_t activePrios{0};                   //!< priorities with a backlog (bitmask)
+        uint8_t inRow{0};                         //!< priorities of the rows with the class
+        uint8_t inFeed{0};                        //!< priorities of the parent feeds with it
+        std::array<RoundRobinSet, N_PRIOS> feeds; //!< the children that may borrow
+    };
+
+    bool DoEnqueue(Ptr<QueueDiscItem> item) override;
+    Ptr<QueueDiscItem> DoDequeue() override;
+    bool CheckConfig() override;
+    void InitializeParams() override;
+
+    /**
+     * @brief Get the class to serve from a set, according to round robin.
+     * @param set the set
+     * @return the class
+     */
+    static uint32_t Pick(const RoundRobinSet& set);
+
+    /**
+     * @brief Move the round robin pointer of a set past the given class.
+     * @param set the set
+     * @param id the class
+     */
+    static void Advance(RoundRobinSet& set, uint32_t id);
+
+    /**
+     * @brief Add the tokens accumulated since the last update to a class.
+     * @param c the class
+     */
+    void UpdateTokens(ClassState& c) const;
+
+    /**
+     * @brief Set the mode of a class according to its tokens, and update the
+     *        wait queue and the sets containing the class.
+     * @param id the class
+     */
+    void UpdateMode(uint32_t id);
+
+    /**
+     * @brief Update the rows and the feeds containing a class after a change
+     *        of its mode or of its backlogged priorities.
+     * @param id the class
+     */
+    void UpdateMembership(uint32_t id);
+
+    /**
+     * @brief Update the mode of the classes whose wait time has elapsed.
+     */
+    void ProcessWaitQueue();
+
+    /**
+     * @brief Find the leaf class to dequeue a packet from.
+     * @param [out] lender the class (the leaf or an ancestor) sending within
+     *        its assured rate
+     * @param [out] prio the priority of the leaf
+     * @return the leaf, or NO_CLASS if no class can send
+     */
+    uint32_t FindLeaf(uint32_t& lender, uint32_t& prio);
+
+    /**
+     * @brief Set whether a leaf class has a backlog.
+     * @param id the leaf
+     * @param active whether the leaf has a backlog
+     */
+    void SetLeafActive(uint32_t id, bool active);
+
+    /**
+     * @brief Charge the classes from a leaf to the root for a dequeued packet.
+     * @param id the leaf
+     * @param level the level at which the packet is sent within the assured rate
+     * @param bytes the size of the packet
+     */
+    void Charge(uint32_t id, uint32_t level, uint32_t bytes);
+
+    /// Index denoting no class
+    static constexpr uint32_t NO_CLASS = std::numeric_limits<uint32_t>::max();
+
+    int32_t m_defaultClass; //!< Index of the class of the unclassified packets
+
+    std::vector<ClassState> m_classes;                      //!< The classes
+    std::vector<std::array<RoundRobinSet, N_PRIOS>> m_rows; //!< The classes that can send
+    std::set<std::pair<Time, uint32_t>> m_waitQueue;        //!< The classes that cannot send
+    EventId m_id;                                           //!< Wake-up event
+};
+
+} // namespace ns3
+
+#endif /* HTB_QUEUE_DISC_H */
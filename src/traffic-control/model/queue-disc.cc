@@ -18,6 +18,8 @@
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <cstring>
+
 namespace ns3
 {
 
@@ -414,6 +416,30 @@ QueueDisc::GetStats()
                               (m_requeued ? m_requeued->GetSize() : 0) -
                               m_stats.nTotalDroppedBytesAfterDequeue;
 
+    // the per-reason maps are only built here, the hot path updates the counters
+    // of the reason ids
+    std::array<std::map<std::string, uint32_t, std::less<>>*, N_REASON_EVENTS> packets{
+        &m_stats.nDroppedPacketsBeforeEnqueue,
+        &m_stats.nDroppedPacketsAfterDequeue,
+        &m_stats.nMarkedPackets};
+    std::array<std::map<std::string, uint64_t, std::less<>>*, N_REASON_EVENTS> bytes{
+        &m_stats.nDroppedBytesBeforeEnqueue,
+        &m_stats.nDroppedBytesAfterDequeue,
+        &m_stats.nMarkedBytes};
+    for (uint8_t event = 0; event < N_REASON_EVENTS; event++)
+    {
+        packets[event]->clear();
+        bytes[event]->clear();
+        for (const auto& counters : m_reasons)
+        {
+            if (counters.nPackets[event] > 0)
+            {
+                packets[event]->emplace(counters.reason, counters.nPackets[event]);
+                bytes[event]->emplace(counters.reason, counters.nBytes[event]);
+            }
+        }
+    }
+
     return m_stats;
 }
 
@@ -715,26 +741,7 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
     m_stats.nTotalDroppedPacketsBeforeEnqueue++;
     m_stats.nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    auto itp = m_stats.nDroppedPacketsBeforeEnqueue.find(reason);
-    if (itp != m_stats.nDroppedPacketsBeforeEnqueue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsBeforeEnqueue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    auto itb = m_stats.nDroppedBytesBeforeEnqueue.find(reason);
-    if (itb != m_stats.nDroppedBytesBeforeEnqueue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesBeforeEnqueue[reason] = item->GetSize();
-    }
+    CountReason(DROP_BEFORE_ENQUEUE, reason, item->GetSize());
 
     NS_LOG_DEBUG("Total packets/bytes dropped before enqueue: "
                  << m_stats.nTotalDroppedPacketsBeforeEnqueue << " / "
@@ -754,26 +761,7 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
     m_stats.nTotalDroppedPacketsAfterDequeue++;
     m_stats.nTotalDroppedBytesAfterDequeue += item->GetSize();
 
-    // update the number of packets dropped for the given reason
-    auto itp = m_stats.nDroppedPacketsAfterDequeue.find(reason);
-    if (itp != m_stats.nDroppedPacketsAfterDequeue.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nDroppedPacketsAfterDequeue[reason] = 1;
-    }
-    // update the amount of bytes dropped for the given reason
-    auto itb = m_stats.nDroppedBytesAfterDequeue.find(reason);
-    if (itb != m_stats.nDroppedBytesAfterDequeue.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nDroppedBytesAfterDequeue[reason] = item->GetSize();
-    }
+    CountReason(DROP_AFTER_DEQUEUE, reason, item->GetSize());
 
     // if in the context of a peek request a dequeued packet is dropped, we need
     // to update the statistics and fire the dequeue trace before firing the drop
@@ -794,6 +782,40 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
     m_traceDropAfterDequeue(item, reason);
 }
 
+std::size_t
+QueueDisc::GetReasonId(const char* reason)
+{
+    for (std::size_t id = 0; id < m_reasons.size(); id++)
+    {
+        if (m_reasons[id].lastString == reason &&
+            std::strcmp(m_reasons[id].reason.c_str(), reason) == 0)
+        {
+            return id;
+        }
+    }
+    // the reason may have been reported with another string, or the string
+    // (e.g., a buffer) may now hold another reason
+    for (std::size_t id = 0; id < m_reasons.size(); id++)
+    {
+        if (m_reasons[id].reason == reason)
+        {
+            m_reasons[id].lastString = reason;
+            return id;
+        }
+    }
+    NS_LOG_DEBUG("Registering reason \"" << reason << "\" with id " << m_reasons.size());
+    m_reasons.push_back({reason, reason, {}, {}});
+    return m_reasons.size() - 1;
+}
+
+void
+QueueDisc::CountReason(ReasonEvent event, const char* reason, uint32_t size)
+{
+    ReasonCounters& counters = m_reasons[GetReasonId(reason)];
+    counters.nPackets[event]++;
+    counters.nBytes[event] += size;
+}
+
 bool
 QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
 {
@@ -809,26 +831,7 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
     m_stats.nTotalMarkedPackets++;
     m_stats.nTotalMarkedBytes += item->GetSize();
 
-    // update the number of packets marked for the given reason
-    auto itp = m_stats.nMarkedPackets.find(reason);
-    if (itp != m_stats.nMarkedPackets.end())
-    {
-        itp->second++;
-    }
-    else
-    {
-        m_stats.nMarkedPackets[reason] = 1;
-    }
-    // update the amount of bytes marked for the given reason
-    auto itb = m_stats.nMarkedBytes.find(reason);
-    if (itb != m_stats.nMarkedBytes.end())
-    {
-        itb->second += item->GetSize();
-    }
-    else
-    {
-        m_stats.nMarkedBytes[reason] = item->GetSize();
-    }
+    CountReason(MARK, reason, item->GetSize());
 
     NS_LOG_DEBUG("Total packets/bytes marked: " << m_stats.nTotalMarkedPackets << " / "
                                                 << m_stats.nTotalMarkedBytes);
@@ -17,6 +17,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
+#include <array>
 #include <functional>
 #include <map>
 #include <string>
@@ -172,7 +173,13 @@ enum QueueDiscSizePolicy
 class QueueDisc : public Object
 {
   public:
-    /// @brief Structure that keeps the queue disc statistics
+    /**
+     * @brief Structure that keeps the queue disc statistics
+     *
+     * The per-reason maps are filled by QueueDisc::GetStats from the counters
+     * the queue disc keeps for each reason, hence they are only up to date in
+     * the structure returned by QueueDisc::GetStats.
+     */
     struct Stats
     {
         /// Total received packets
@@ -677,6 +684,43 @@ class QueueDisc : public Object
     static const uint32_t DEFAULT_QUOTA = 64;
 
     std::vector<Ptr<InternalQueue>> m_queues;   //!< Internal queues
+    /// Events counted for each reason
+    enum ReasonEvent : uint8_t
+    {
+        DROP_BEFORE_ENQUEUE = 0, //!< Packet dropped before enqueue
+        DROP_AFTER_DEQUEUE,      //!< Packet dropped after dequeue
+        MARK,                    //!< Packet marked
+        N_REASON_EVENTS          //!< Number of events
+    };
+
+    /// Counters of the packets dropped or marked for a given reason
+    struct ReasonCounters
+    {
+        std::string reason;                             //!< The reason
+        const char* lastString;                         //!< The string last used for the reason
+        std::array<uint32_t, N_REASON_EVENTS> nPackets; //!< Packets, for each event
+        std::array<uint64_t, N_REASON_EVENTS> nBytes;   //!< Bytes, for each event
+    };
+
+    /**
+     * @brief Get the id of the given reason, registering the reason if needed.
+     *
+     * Reasons are usually string constants, hence the reason last reported
+     * with the same string is checked first.
+     *
+     * @param reason the reason
+     * @return the index of the counters of the reason in m_reasons
+     */
+    std::size_t GetReasonId(const char* reason);
+
+    /**
+     * @brief Update the counters of the given reason.
+     * @param event the event
+     * @param reason the reason
+     * @param size the size of the packet
+     */
+    void CountReason(ReasonEvent event, const char* reason, uint32_t size);
+
     std::vector<Ptr<PacketFilter>> m_filters;   //!< Packet filters
     std::vector<Ptr<QueueDiscClass>> m_classes; //!< Classes
 
@@ -686,6 +730,7 @@ class QueueDisc : public Object
     QueueSize m_maxSize;              //!< max queue size
 
     Stats m_stats;    //!< The collected statistics
+    std::vector<ReasonCounters> m_reasons; //!< Counters, for each reason id
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
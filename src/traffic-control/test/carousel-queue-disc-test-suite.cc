@@ -0,0 +1,272 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/carousel-queue-disc.h"
+#include "ns3/data-rate.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Carousel Queue Disc Test Item
+ */
+class CarouselQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param p the packet
+     * @param flow the flow of the packet
+     */
+    CarouselQueueDiscTestItem(Ptr<Packet> p, uint32_t flow);
+    void AddHeader() override;
+    bool Mark() override;
+    uint32_t Hash(uint32_t perturbation) const override;
+
+    /**
+     * @return the flow of the packet
+     */
+    uint32_t GetFlow() const;
+
+  private:
+    uint32_t m_flow; //!< the flow of the packet
+};
+
+CarouselQueueDiscTestItem::CarouselQueueDiscTestItem(Ptr<Packet> p, uint32_t flow)
+    : QueueDiscItem(p, Address(), 0),
+      m_flow(flow)
+{
+}
+
+void
+CarouselQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+CarouselQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+uint32_t
+CarouselQueueDiscTestItem::Hash(uint32_t perturbation) const
+{
+    return m_flow;
+}
+
+uint32_t
+CarouselQueueDiscTestItem::GetFlow() const
+{
+    return m_flow;
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Carousel Queue Disc Test Packet Filter, returning the flow of the test items
+ */
+class CarouselQueueDiscTestFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override;
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+};
+
+bool
+CarouselQueueDiscTestFilter::CheckProtocol(Ptr<QueueDiscItem> item) const
+{
+    return true;
+}
+
+int32_t
+CarouselQueueDiscTestFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    return DynamicCast<CarouselQueueDiscTestItem>(item)->GetFlow();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Carousel Queue Disc Test Case
+ */
+class CarouselQueueDiscTestCase : public TestCase
+{
+  public:
+    CarouselQueueDiscTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Enqueue packets and run the queue disc, as the traffic control layer does.
+     * @param queue the queue disc
+     * @param flow the flow of the packets
+     * @param n the number of packets
+     */
+    void Enqueue(Ptr<CarouselQueueDisc> queue, uint32_t flow, uint32_t n);
+    /// Test the pacing of a single flow
+    void RunPacingTest();
+    /// Test the rates of two flows classified by a packet filter
+    void RunPerFlowRateTest();
+    /// Test the drop of the packets beyond the horizon
+    void RunHorizonTest();
+
+    std::vector<std::pair<Time, uint32_t>> m_sent; //!< the send time and flow of the packets
+};
+
+CarouselQueueDiscTestCase::CarouselQueueDiscTestCase()
+    : TestCase("Sanity check on the carousel queue disc implementation")
+{
+}
+
+void
+CarouselQueueDiscTestCase::Enqueue(Ptr<CarouselQueueDisc> queue, uint32_t flow, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(Create<CarouselQueueDiscTestItem>(Create<Packet>(1000), flow));
+    }
+    queue->Run();
+}
+
+void
+CarouselQueueDiscTestCase::RunPacingTest()
+{
+    Ptr<CarouselQueueDisc> queue =
+        CreateObjectWithAttributes<CarouselQueueDisc>("DefaultRate",
+                                                      DataRateValue(DataRate("8Mbps")),
+                                                      "SlotDuration",
+                                                      TimeValue(MicroSeconds(100)));
+    m_sent.clear();
+    queue->SetSendCallback([this](Ptr<QueueDiscItem> item) {
+        m_sent.emplace_back(Simulator::Now(), item->Hash(0));
+    });
+    queue->Initialize();
+
+    // 1000 bytes at 8 Mbps take 1 ms
+    Simulator::Schedule(MilliSeconds(10),
+                        &CarouselQueueDiscTestCase::Enqueue,
+                        this,
+                        queue,
+                        1,
+                        5);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 5, "All the packets should have been sent");
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sent[i].first,
+                              MilliSeconds(10 + i),
+                              "Packet " << i << " sent at an unexpected time");
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNFlows(), 1, "There should be a single flow");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 0, "The queue disc should be empty");
+    Simulator::Destroy();
+}
+
+void
+CarouselQueueDiscTestCase::RunPerFlowRateTest()
+{
+    Ptr<CarouselQueueDisc> queue = CreateObject<CarouselQueueDisc>();
+    queue->AddPacketFilter(CreateObject<CarouselQueueDiscTestFilter>());
+    queue->SetFlowRate(1, DataRate("8Mbps"));
+    queue->SetFlowRate(2, DataRate("16Mbps"));
+    NS_TEST_EXPECT_MSG_EQ(queue->GetFlowRate(2), DataRate("16Mbps"), "Unexpected flow rate");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetFlowRate(3), DataRate("0bps"), "Unexpected default rate");
+    m_sent.clear();
+    queue->SetSendCallback([this](Ptr<QueueDiscItem> item) {
+        m_sent.emplace_back(Simulator::Now(), item->Hash(0));
+    });
+    queue->Initialize();
+
+    Simulator::Schedule(Seconds(0), &CarouselQueueDiscTestCase::Enqueue, this, queue, 1, 4);
+    Simulator::Schedule(Seconds(0), &CarouselQueueDiscTestCase::Enqueue, this, queue, 2, 4);
+    // the third flow is not shaped
+    Simulator::Schedule(MicroSeconds(200),
+                        &CarouselQueueDiscTestCase::Enqueue,
+                        this,
+                        queue,
+                        3,
+                        4);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 12, "All the packets should have been sent");
+    std::vector<Time> expected[4] = {{},
+                                     {MilliSeconds(0), MilliSeconds(1), MilliSeconds(2),
+                                      MilliSeconds(3)},
+                                     {MicroSeconds(0), MicroSeconds(500), MicroSeconds(1000),
+                                      MicroSeconds(1500)},
+                                     {MicroSeconds(200), MicroSeconds(200), MicroSeconds(200),
+                                      MicroSeconds(200)}};
+    uint32_t count[4] = {0, 0, 0, 0};
+    for (const auto& [time, flow] : m_sent)
+    {
+        NS_TEST_ASSERT_MSG_LT(flow, 4, "Unexpected flow");
+        NS_TEST_ASSERT_MSG_LT(count[flow], 4, "Too many packets of flow " << flow);
+        NS_TEST_EXPECT_MSG_EQ(time,
+                              expected[flow][count[flow]],
+                              "Packet " << count[flow] << " of flow " << flow
+                                        << " sent at an unexpected time");
+        count[flow]++;
+    }
+    Simulator::Destroy();
+}
+
+void
+CarouselQueueDiscTestCase::RunHorizonTest()
+{
+    // the horizon is 1 ms, the transmission time of a packet
+    Ptr<CarouselQueueDisc> queue =
+        CreateObjectWithAttributes<CarouselQueueDisc>("DefaultRate",
+                                                      DataRateValue(DataRate("8Mbps")),
+                                                      "NumSlots",
+                                                      UintegerValue(10),
+                                                      "SlotDuration",
+                                                      TimeValue(MicroSeconds(100)));
+    queue->Initialize();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        queue->Enqueue(Create<CarouselQueueDiscTestItem>(Create<Packet>(1000), 1));
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 1, "A single packet should have been enqueued");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetStats().GetNDroppedPackets(CarouselQueueDisc::HORIZON_DROP),
+                          2,
+                          "The packets beyond the horizon should have been dropped");
+    NS_TEST_EXPECT_MSG_NE(queue->Dequeue(), nullptr, "The first packet should be due");
+    Simulator::Destroy();
+}
+
+void
+CarouselQueueDiscTestCase::DoRun()
+{
+    RunPacingTest();
+    RunPerFlowRateTest();
+    RunHorizonTest();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Carousel Queue Disc Test Suite
+ */
+static class CarouselQueueDiscTestSuite : public TestSuite
+{
+  public:
+    CarouselQueueDiscTestSuite()
+        : TestSuite("carousel-queue-disc", Type::UNIT)
+    {
+        AddTestCase(new CarouselQueueDiscTestCase(), TestCase::Duration::QUICK);
+    }
+} g_carouselQueueDiscTestSuite; ///< the test suite
@@ -0,0 +1,288 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/htb-queue-disc.h"
+#include "ns3/integer.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Htb Queue Disc Test Item
+ */
+class HtbQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param p the packet
+     * @param cls the class of the packet
+     */
+    HtbQueueDiscTestItem(Ptr<Packet> p, uint32_t cls);
+    void AddHeader() override;
+    bool Mark() override;
+
+    /**
+     * @return the class of the packet
+     */
+    uint32_t GetClass() const;
+
+  private:
+    uint32_t m_class; //!< the class of the packet
+};
+
+HtbQueueDiscTestItem::HtbQueueDiscTestItem(Ptr<Packet> p, uint32_t cls)
+    : QueueDiscItem(p, Address(), 0),
+      m_class(cls)
+{
+}
+
+void
+HtbQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+HtbQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+uint32_t
+HtbQueueDiscTestItem::GetClass() const
+{
+    return m_class;
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Htb Queue Disc Test Packet Filter, returning the class of the test items
+ */
+class HtbQueueDiscTestFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override;
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+};
+
+bool
+HtbQueueDiscTestFilter::CheckProtocol(Ptr<QueueDiscItem> item) const
+{
+    return true;
+}
+
+int32_t
+HtbQueueDiscTestFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    return DynamicCast<HtbQueueDiscTestItem>(item)->GetClass();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Htb Queue Disc Test Case
+ */
+class HtbQueueDiscTestCase : public TestCase
+{
+  public:
+    HtbQueueDiscTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Create a queue disc with the given classes, each with a FIFO child queue disc.
+     * @param classes the attributes (parent, rate, ceil) of the classes
+     * @return the queue disc
+     */
+    Ptr<HtbQueueDisc> CreateQueueDisc(
+        const std::vector<std::tuple<int32_t, DataRate, DataRate>>& classes);
+    /**
+     * Enqueue packets and run the queue disc, as the traffic control layer does.
+     * @param queue the queue disc
+     * @param cls the class of the packets
+     * @param n the number of packets
+     */
+    void Enqueue(Ptr<HtbQueueDisc> queue, uint32_t cls, uint32_t n);
+    /// Test the shaping of a single class
+    void RunRateTest();
+    /// Test the borrowing of a class from its parent
+    void RunBorrowTest();
+    /// Test the sharing of the rate of the parent among two classes
+    void RunShareTest();
+    /// Test the drop of the unclassified packets
+    void RunUnclassifiedTest();
+
+    std::vector<std::pair<Time, uint32_t>> m_sent; //!< the send time and class of the packets
+};
+
+HtbQueueDiscTestCase::HtbQueueDiscTestCase()
+    : TestCase("Sanity check on the htb queue disc implementation")
+{
+}
+
+Ptr<HtbQueueDisc>
+HtbQueueDiscTestCase::CreateQueueDisc(
+    const std::vector<std::tuple<int32_t, DataRate, DataRate>>& classes)
+{
+    Ptr<HtbQueueDisc> queue = CreateObject<HtbQueueDisc>();
+    queue->AddPacketFilter(CreateObject<HtbQueueDiscTestFilter>());
+    for (const auto& [parent, rate, ceil] : classes)
+    {
+        Ptr<QueueDisc> qd = CreateObject<FifoQueueDisc>();
+        qd->Initialize();
+        Ptr<HtbClass> c = CreateObjectWithAttributes<HtbClass>("Parent",
+                                                               IntegerValue(parent),
+                                                               "Rate",
+                                                               DataRateValue(rate),
+                                                               "Ceil",
+                                                               DataRateValue(ceil),
+                                                               "Burst",
+                                                               UintegerValue(1000),
+                                                               "Cburst",
+                                                               UintegerValue(1000));
+        c->SetQueueDisc(qd);
+        queue->AddQueueDiscClass(c);
+    }
+    m_sent.clear();
+    queue->SetSendCallback([this](Ptr<QueueDiscItem> item) {
+        m_sent.emplace_back(Simulator::Now(),
+                            DynamicCast<HtbQueueDiscTestItem>(item)->GetClass());
+    });
+    queue->Initialize();
+    return queue;
+}
+
+void
+HtbQueueDiscTestCase::Enqueue(Ptr<HtbQueueDisc> queue, uint32_t cls, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1000), cls));
+    }
+    queue->Run();
+}
+
+void
+HtbQueueDiscTestCase::RunRateTest()
+{
+    // a top level class; 1000 bytes at 8 Mbps take 1 ms
+    Ptr<HtbQueueDisc> queue = CreateQueueDisc({{-1, DataRate("8Mbps"), DataRate("0bps")}});
+    Simulator::Schedule(MilliSeconds(10), &HtbQueueDiscTestCase::Enqueue, this, queue, 0, 5);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 5, "All the packets should have been sent");
+    // the bucket holds a packet, hence the first two packets are sent at once
+    std::vector<Time> expected{MilliSeconds(10),
+                               MilliSeconds(10),
+                               MilliSeconds(11),
+                               MilliSeconds(12),
+                               MilliSeconds(13)};
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sent[i].first,
+                              expected[i],
+                              "Packet " << i << " sent at an unexpected time");
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 0, "The queue disc should be empty");
+    Simulator::Destroy();
+}
+
+void
+HtbQueueDiscTestCase::RunBorrowTest()
+{
+    // the first leaf borrows the rate of its parent unused by the second leaf
+    Ptr<HtbQueueDisc> queue = CreateQueueDisc({{-1, DataRate("8Mbps"), DataRate("0bps")},
+                                               {0, DataRate("2Mbps"), DataRate("8Mbps")},
+                                               {0, DataRate("6Mbps"), DataRate("8Mbps")}});
+    Simulator::Schedule(Seconds(0), &HtbQueueDiscTestCase::Enqueue, this, queue, 1, 20);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 20, "All the packets should have been sent");
+    // at the assured rate, the last packet would be sent after 76 ms
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_sent.back().first,
+                                MilliSeconds(20),
+                                "The first leaf should have borrowed from its parent");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_sent.back().first,
+                                MilliSeconds(17),
+                                "The first leaf should not exceed its ceil");
+    Simulator::Destroy();
+}
+
+void
+HtbQueueDiscTestCase::RunShareTest()
+{
+    // both leaves are backlogged, hence they get their assured rates
+    Ptr<HtbQueueDisc> queue = CreateQueueDisc({{-1, DataRate("8Mbps"), DataRate("0bps")},
+                                               {0, DataRate("2Mbps"), DataRate("8Mbps")},
+                                               {0, DataRate("6Mbps"), DataRate("8Mbps")}});
+    Simulator::Schedule(Seconds(0), &HtbQueueDiscTestCase::Enqueue, this, queue, 1, 50);
+    Simulator::Schedule(Seconds(0), &HtbQueueDiscTestCase::Enqueue, this, queue, 2, 50);
+    Simulator::Stop(MilliSeconds(40));
+    Simulator::Run();
+
+    uint32_t count[3] = {0, 0, 0};
+    for (const auto& [time, cls] : m_sent)
+    {
+        NS_TEST_ASSERT_MSG_LT(cls, 3, "Unexpected class");
+        count[cls]++;
+    }
+    // 40 ms at 2 Mbps and 6 Mbps are 10 and 30 packets
+    NS_TEST_EXPECT_MSG_EQ_TOL(count[1], 10, 2, "Unexpected number of packets of the first leaf");
+    NS_TEST_EXPECT_MSG_EQ_TOL(count[2], 30, 2, "Unexpected number of packets of the second leaf");
+    Simulator::Destroy();
+}
+
+void
+HtbQueueDiscTestCase::RunUnclassifiedTest()
+{
+    // packets of an inner class are not classified, and there is no default class
+    Ptr<HtbQueueDisc> queue = CreateQueueDisc({{-1, DataRate("8Mbps"), DataRate("0bps")},
+                                               {0, DataRate("8Mbps"), DataRate("0bps")}});
+    queue->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1000), 0));
+    queue->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1000), 1));
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 1, "A single packet should have been enqueued");
+    NS_TEST_EXPECT_MSG_EQ(
+        queue->GetStats().GetNDroppedPackets(HtbQueueDisc::UNCLASSIFIED_DROP),
+        1,
+        "The packet of the inner class should have been dropped");
+    Simulator::Destroy();
+}
+
+void
+HtbQueueDiscTestCase::DoRun()
+{
+    RunRateTest();
+    RunBorrowTest();
+    RunShareTest();
+    RunUnclassifiedTest();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Htb Queue Disc Test Suite
+ */
+static class HtbQueueDiscTestSuite : public TestSuite
+{
+  public:
+    HtbQueueDiscTestSuite()
+        : TestSuite("htb-queue-disc", Type::UNIT)
+    {
+        AddTestCase(new HtbQueueDiscTestCase(), TestCase::Duration::QUICK);
+    }
+} g_htbQueueDiscTestSuite; ///< the test suite
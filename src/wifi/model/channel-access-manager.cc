@@ -592,9 +592,10 @@ ChannelAccessManager::RequestAccess(Ptr<Txop> txop)
     {
         // The backoff start time reported by the EDCAF is more recent than the last time the medium
         // was busy plus an AIFS, hence we need to align it to the next slot boundary.
-        const auto div = diff / GetSlot();
-        const uint32_t nIntSlots = div.GetHigh() + (div.GetLow() > 0 ? 1 : 0);
-        txop->UpdateBackoffSlotsNow(0, accessGrantStart + (nIntSlots * GetSlot()), m_linkId);
+        const auto slot = GetSlot();
+        const auto nIntSlots =
+            static_cast<uint32_t>(Div(diff, slot) + (Rem(diff, slot).IsStrictlyPositive() ? 1 : 0));
+        txop->UpdateBackoffSlotsNow(0, accessGrantStart + (nIntSlots * slot), m_linkId);
     }
 
     UpdateBackoff();
@@ -717,43 +718,37 @@ ChannelAccessManager::AccessTimeout()
     DoRestartAccessTimeoutIfNeeded();
 }
 
-std::multimap<Time, WifiExpectedAccessReason>
+ChannelAccessManager::AccessGrantStartEvents
 ChannelAccessManager::DoGetAccessGrantStart(bool ignoreNav) const
 {
     NS_LOG_FUNCTION(this << ignoreNav);
     const auto now = Simulator::Now();
 
-    std::multimap<Time, WifiExpectedAccessReason> ret;
-
     // an EDCA TXOP is obtained based solely on activity of the primary channel
     // (Sec. 10.23.2.5 of IEEE 802.11-2020)
     const auto busyAccessStart = m_lastBusyEnd.at(WIFI_CHANLIST_PRIMARY);
-    ret.emplace(busyAccessStart, WifiExpectedAccessReason::BUSY_END);
 
     auto rxAccessStart = m_lastRx.end;
     if ((m_lastRx.end <= now) && !m_lastRxReceivedOk)
     {
         rxAccessStart += GetEifsNoDifs();
     }
-    ret.emplace(rxAccessStart, WifiExpectedAccessReason::RX_END);
-
-    ret.emplace(m_lastTxEnd, WifiExpectedAccessReason::TX_END);
 
     const auto navAccessStart = ignoreNav ? Time{0} : m_lastNavEnd;
-    ret.emplace(navAccessStart, WifiExpectedAccessReason::NAV_END);
-
-    ret.emplace(m_lastAckTimeoutEnd, WifiExpectedAccessReason::ACK_TIMER_END);
-    ret.emplace(m_lastCtsTimeoutEnd, WifiExpectedAccessReason::CTS_TIMER_END);
-    ret.emplace(m_lastSwitchingEnd, WifiExpectedAccessReason::SWITCHING_END);
-
     const auto noPhyStart = m_phy ? m_lastNoPhy.end : now;
-    ret.emplace(noPhyStart, WifiExpectedAccessReason::NO_PHY_END);
-
     const auto lastSleepEnd = (m_lastSleep.start > m_lastSleep.end ? now : m_lastSleep.end);
-    ret.emplace(lastSleepEnd, WifiExpectedAccessReason::SLEEP_END);
-
     const auto lastOffEnd = (m_lastOff.start > m_lastOff.end ? now : m_lastOff.end);
-    ret.emplace(lastOffEnd, WifiExpectedAccessReason::OFF_END);
+
+    AccessGrantStartEvents ret{{{busyAccessStart, WifiExpectedAccessReason::BUSY_END},
+                                {rxAccessStart, WifiExpectedAccessReason::RX_END},
+                                {m_lastTxEnd, WifiExpectedAccessReason::TX_END},
+                                {navAccessStart, WifiExpectedAccessReason::NAV_END},
+                                {m_lastAckTimeoutEnd, WifiExpectedAccessReason::ACK_TIMER_END},
+                                {m_lastCtsTimeoutEnd, WifiExpectedAccessReason::CTS_TIMER_END},
+                                {m_lastSwitchingEnd, WifiExpectedAccessReason::SWITCHING_END},
+                                {noPhyStart, WifiExpectedAccessReason::NO_PHY_END},
+                                {lastSleepEnd, WifiExpectedAccessReason::SLEEP_END},
+                                {lastOffEnd, WifiExpectedAccessReason::OFF_END}}};
 
     NS_LOG_INFO("rx access start=" << rxAccessStart.As(Time::US)
                                    << ", busy access start=" << busyAccessStart.As(Time::US)
@@ -771,9 +766,11 @@ ChannelAccessManager::GetAccessGrantStart(bool ignoreNav) const
 {
     NS_LOG_FUNCTION(this << ignoreNav);
 
-    auto timeReasonMap = DoGetAccessGrantStart(ignoreNav);
-    NS_ASSERT(!timeReasonMap.empty());
-    const auto accessGrantedStart = timeReasonMap.crbegin()->first;
+    Time accessGrantedStart{0};
+    for (const auto& [time, reason] : DoGetAccessGrantStart(ignoreNav))
+    {
+        accessGrantedStart = std::max(accessGrantedStart, time);
+    }
     NS_LOG_INFO("access grant start=" << accessGrantedStart.As(Time::US));
 
     return accessGrantedStart + GetSifs();
@@ -823,27 +820,32 @@ ChannelAccessManager::GetExpectedAccessWithin(const Time& delay) const
 
     const auto now = Simulator::Now();
     const auto deadline = now + delay;
-    const auto timeReasonMap = DoGetAccessGrantStart(false);
-    NS_ASSERT(!timeReasonMap.empty());
-    auto accessGrantStart = timeReasonMap.crbegin()->first;
+    const auto timeReasonArray = DoGetAccessGrantStart(false);
+    // the earliest event for which access cannot be granted in time, if any (in case of ties,
+    // the event that comes first in the array is selected)
+    const std::pair<Time, WifiExpectedAccessReason>* earliestLate = nullptr;
+    Time accessGrantStart{0};
+    for (const auto& event : timeReasonArray)
+    {
+        accessGrantStart = std::max(accessGrantStart, event.first);
+        if (event.first >= deadline && (!earliestLate || event.first < earliestLate->first))
+        {
+            earliestLate = &event;
+        }
+    }
 
     if (accessGrantStart >= deadline)
     {
         // return the earliest reason for which access cannot be granted in time
-        for (const auto& [time, reason] : timeReasonMap)
-        {
-            if (time >= deadline)
-            {
-                NS_ASSERT(reason != WifiExpectedAccessReason::ACCESS_EXPECTED);
-                NS_ASSERT(reason != WifiExpectedAccessReason::NOTHING_TO_TX);
-                NS_ASSERT(reason != WifiExpectedAccessReason::NOT_REQUESTED);
-                NS_ASSERT(reason != WifiExpectedAccessReason::BACKOFF_END);
-                NS_LOG_DEBUG("Access grant start (" << accessGrantStart.As(Time::US)
-                                                    << ") too late for reason " << reason);
-                return reason;
-            }
-        }
-        NS_ABORT_MSG("No reason found that exceeds the deadline!");
+        NS_ABORT_MSG_IF(!earliestLate, "No reason found that exceeds the deadline!");
+        const auto reason = earliestLate->second;
+        NS_ASSERT(reason != WifiExpectedAccessReason::ACCESS_EXPECTED);
+        NS_ASSERT(reason != WifiExpectedAccessReason::NOTHING_TO_TX);
+        NS_ASSERT(reason != WifiExpectedAccessReason::NOT_REQUESTED);
+        NS_ASSERT(reason != WifiExpectedAccessReason::BACKOFF_END);
+        NS_LOG_DEBUG("Access grant start (" << accessGrantStart.As(Time::US)
+                                            << ") too late for reason " << reason);
+        return reason;
     }
 
     accessGrantStart += GetSifs();
@@ -890,14 +892,27 @@ void
 ChannelAccessManager::UpdateBackoff()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t k = 0;
+    const auto now = Simulator::Now();
     const auto accessGrantStart = GetAccessGrantStart();
+    if (accessGrantStart > now)
+    {
+        // the backoff start of every Txop is not earlier than the access grant start, hence
+        // no slot has elapsed and there is nothing to update. This is the common case, given
+        // that this method is called at every PHY notification, including those received
+        // while the medium is busy
+        NS_LOG_DEBUG("access cannot be granted yet, no backoff slot to count");
+        return;
+    }
+
+    uint32_t k = 0;
+    const auto slot = GetSlot();
     for (auto txop : m_txops)
     {
         Time backoffStart = GetBackoffStartFor(txop, accessGrantStart);
-        if (backoffStart <= Simulator::Now())
+        if (backoffStart <= now)
         {
-            uint32_t nIntSlots = ((Simulator::Now() - backoffStart) / GetSlot()).GetHigh();
+            // integer number of slots elapsed since the backoff start
+            auto nIntSlots = static_cast<uint32_t>(Div(now - backoffStart, slot));
             /*
              * EDCA behaves slightly different to DCA. For EDCA we
              * decrement once at the slot boundary at the end of AIFS as
@@ -915,7 +930,7 @@ ChannelAccessManager::UpdateBackoff()
             }
             uint32_t n = std::min(nIntSlots, txop->GetBackoffSlots(m_linkId));
             NS_LOG_DEBUG("dcf " << k << " dec backoff slots=" << n);
-            Time backoffUpdateBound = backoffStart + (n * GetSlot());
+            Time backoffUpdateBound = backoffStart + (n * slot);
             txop->UpdateBackoffSlotsNow(n, backoffUpdateBound, m_linkId);
         }
         ++k;
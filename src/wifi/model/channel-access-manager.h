@@ -18,6 +18,7 @@
 #include "ns3/traced-callback.h"
 
 #include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -423,7 +424,9 @@ class ChannelAccessManager : public Object
      */
     void ResizeLastBusyStructs();
     /**
-     * Update backoff slots for all Txops.
+     * Update backoff slots for all Txops. Backoff counters are only decremented when the
+     * slots elapsed since the backoff start need to be accounted for, i.e., when access may
+     * have been granted at the current time; otherwise, this method returns immediately.
      */
     void UpdateBackoff();
 
@@ -449,19 +452,22 @@ class ChannelAccessManager : public Object
      */
     Time GetBackoffEndFor(Ptr<Txop> txop, Time accessGrantStart) const;
 
+    /// (Time, WifiExpectedAccessReason) pairs for all the events preventing channel access
+    using AccessGrantStartEvents = std::array<std::pair<Time, WifiExpectedAccessReason>, 10>;
+
     /**
-     * Return a map containing (Time, WifiExpectedAccessReason) pairs sorted in increasing order
-     * of times. For each of the events preventing channel access (e.g., medium busy, RX state,
-     * TX state, etc), a pair is present in the map indicating the latest known time for which
-     * channel access cannot be granted due to that event. Therefore, the returned map does not
-     * contain a pair for some WifiExpectedAccessReason enum values (ACCESS_EXPECTED, NOTHING_TO_TX,
-     * NOT_REQUESTED and BACKOFF_END).
+     * Return an array containing (Time, WifiExpectedAccessReason) pairs. For each of the events
+     * preventing channel access (e.g., medium busy, RX state, TX state, etc), a pair is present
+     * in the array indicating the latest known time for which channel access cannot be granted
+     * due to that event. Therefore, the returned array does not contain a pair for some
+     * WifiExpectedAccessReason enum values (ACCESS_EXPECTED, NOTHING_TO_TX, NOT_REQUESTED and
+     * BACKOFF_END). The array is not sorted and is returned by value, so that the access grant
+     * start can be computed at every PHY notification without allocating memory.
      *
      * @param ignoreNav whether NAV should be ignored
-     * @return a map containing (Time, WifiExpectedAccessReason) pairs sorted in increasing order
-     *         of times
+     * @return an array containing (Time, WifiExpectedAccessReason) pairs
      */
-    std::multimap<Time, WifiExpectedAccessReason> DoGetAccessGrantStart(bool ignoreNav) const;
+    AccessGrantStartEvents DoGetAccessGrantStart(bool ignoreNav) const;
 
     /**
      * This method determines whether the medium has been idle during a period (of
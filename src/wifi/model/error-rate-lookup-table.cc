@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "error-rate-lookup-table.h"
+
+#include "wifi-utils.h"
+
+#include "ns3/log.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ErrorRateLookupTable");
+
+ErrorRateLookupTable::ErrorRateLookupTable(const BitSuccessRateFunction& bitSuccessRate)
+{
+    NS_LOG_FUNCTION(this);
+    const auto nPoints = static_cast<std::size_t>((MAX_SNR - MIN_SNR) * POINTS_PER_DB) + 1;
+    m_logErrorExponents.reserve(nPoints);
+    for (std::size_t i = 0; i < nPoints; i++)
+    {
+        const dB_u snr = MIN_SNR + static_cast<double>(i) / POINTS_PER_DB;
+        // log(0) is -infinity (bit always successful) and log(infinity) is
+        // infinity (bit never successful), both are handled by the lookups
+        m_logErrorExponents.push_back(std::log(-std::log(bitSuccessRate(DbToRatio(snr)))));
+    }
+}
+
+std::optional<double>
+ErrorRateLookupTable::GetChunkSuccessRate(double snr, uint64_t nbits) const
+{
+    if (!(snr > 0))
+    {
+        return std::nullopt;
+    }
+    const auto pos = (RatioToDb(snr) - MIN_SNR) * POINTS_PER_DB;
+    if (pos < 0 || pos >= m_logErrorExponents.size() - 1)
+    {
+        return std::nullopt;
+    }
+    if (nbits == 0)
+    {
+        return 1.0;
+    }
+    const auto i = static_cast<std::size_t>(pos);
+    const auto lower = m_logErrorExponents[i];
+    const auto upper = m_logErrorExponents[i + 1];
+    // if one of the samples is infinite, use the one at the lower SNR, which
+    // yields the lower success rate
+    const auto logErrorExponent = (std::isfinite(lower) && std::isfinite(upper))
+                                      ? lower + (pos - i) * (upper - lower)
+                                      : lower;
+    return std::exp(-std::exp(logErrorExponent) * nbits);
+}
+
+} // namespace ns3
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef ERROR_RATE_LOOKUP_TABLE_H
+#define ERROR_RATE_LOOKUP_TABLE_H
+
+#include "wifi-units.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ *
+ * @brief Dense table of the bit error exponent of an analytical error rate
+ * model, used to compute chunk success rates without evaluating the model.
+ *
+ * The success rate of a chunk of n bits of the analytical error rate models
+ * is of the form (1 - pe)^n, where the probability pe only depends on the SNR
+ * (for a given constellation and code rate). The table stores -log(1 - pe),
+ * the bit error exponent, for SNR values sampled every 1/POINTS_PER_DB dB
+ * between MIN_SNR and MAX_SNR, in a single contiguous array. The chunk success
+ * rate is then obtained for any number of bits by linearly interpolating the
+ * logarithm of the bit error exponent between the two closest samples, which
+ * is accurate since pe decreases exponentially with the SNR.
+ */
+class ErrorRateLookupTable
+{
+  public:
+    /// Function returning the success rate of a single bit for a given SNR (linear scale)
+    using BitSuccessRateFunction = std::function<double(double)>;
+
+    static constexpr dB_u MIN_SNR{-10}; //!< the lowest SNR of the table
+    static constexpr dB_u MAX_SNR{70};  //!< the highest SNR of the table
+    static constexpr uint32_t POINTS_PER_DB{100}; //!< the number of samples per dB
+
+    /**
+     * Build the table by sampling the given function.
+     * @param bitSuccessRate the function returning the success rate of a single bit
+     */
+    explicit ErrorRateLookupTable(const BitSuccessRateFunction& bitSuccessRate);
+
+    /**
+     * @param snr the SNR (linear scale)
+     * @param nbits the number of bits of the chunk
+     * @return the success rate of the chunk, or std::nullopt if the SNR is
+     *         outside the range of the table
+     */
+    std::optional<double> GetChunkSuccessRate(double snr, uint64_t nbits) const;
+
+  private:
+    std::vector<double> m_logErrorExponents; //!< the logarithm of the bit error exponents
+};
+
+} // namespace ns3
+
+#endif /* ERROR_RATE_LOOKUP_TABLE_H */
@@ -22,6 +22,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
 namespace ns3
@@ -124,35 +125,6 @@ operator<<(std::ostream& os, const Event& event)
     return os;
 }
 
-/****************************************************************
- *       Class which records SNIR change events for a
- *       short period of time.
- ****************************************************************/
-
-InterferenceHelper::NiChange::NiChange(Watt_u power, Ptr<Event> event)
-    : m_power(power),
-      m_event(event)
-{
-}
-
-Watt_u
-InterferenceHelper::NiChange::GetPower() const
-{
-    return m_power;
-}
-
-void
-InterferenceHelper::NiChange::AddPower(Watt_u power)
-{
-    m_power += power;
-}
-
-Ptr<Event>
-InterferenceHelper::NiChange::GetEvent() const
-{
-    return m_event;
-}
-
 /****************************************************************
  *       The actual InterferenceHelper
  ****************************************************************/
@@ -183,12 +155,8 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
-    {
-        it.second.clear();
-    }
-    m_niChanges.clear();
-    m_firstPowers.clear();
+    m_timelines.clear();
+    m_bandIds.clear();
     m_errorRateModel = nullptr;
 }
 
@@ -223,39 +191,48 @@ InterferenceHelper::AddForeignSignal(Time duration,
 bool
 InterferenceHelper::HasBands() const
 {
-    return !m_niChanges.empty();
+    return !m_timelines.empty();
 }
 
 bool
 InterferenceHelper::HasBand(const WifiSpectrumBandInfo& band) const
 {
-    return m_niChanges.contains(band);
+    return m_bandIds.contains(band);
+}
+
+std::size_t
+InterferenceHelper::GetBandId(const WifiSpectrumBandInfo& band) const
+{
+    auto it = m_bandIds.find(band);
+    NS_ABORT_IF(it == m_bandIds.end());
+    return it->second;
 }
 
 void
 InterferenceHelper::AddBand(const WifiSpectrumBandInfo& band)
 {
     NS_LOG_FUNCTION(this << band);
-    NS_ASSERT(!m_niChanges.contains(band));
-    NS_ASSERT(!m_firstPowers.contains(band));
-    NiChanges niChanges;
-    auto result = m_niChanges.insert({band, niChanges});
-    NS_ASSERT(result.second);
+    NS_ASSERT(!m_bandIds.contains(band));
+    m_bandIds.emplace(band, m_timelines.size());
     // Always have a zero power noise event in the list
-    AddNiChangeEvent(Time(0), NiChange(Watt_u{0}, nullptr), result.first);
-    m_firstPowers.insert({band, Watt_u{0}});
+    m_timelines.push_back({band, {{Time(0), Watt_u{0}, nullptr}}, Watt_u{0}});
 }
 
 void
 InterferenceHelper::RemoveBand(const WifiSpectrumBandInfo& band)
 {
     NS_LOG_FUNCTION(this << band);
-    NS_ASSERT(m_firstPowers.count(band) != 0);
-    m_firstPowers.erase(band);
-    auto it = m_niChanges.find(band);
-    NS_ASSERT(it != std::end(m_niChanges));
-    it->second.clear();
-    m_niChanges.erase(it);
+    auto it = m_bandIds.find(band);
+    NS_ASSERT(it != m_bandIds.end());
+    const auto bandId = it->second;
+    m_bandIds.erase(it);
+    if (bandId + 1 != m_timelines.size())
+    {
+        // move the last timeline in place of the removed one
+        m_timelines[bandId] = std::move(m_timelines.back());
+        m_bandIds.at(m_timelines[bandId].band) = bandId;
+    }
+    m_timelines.pop_back();
 }
 
 void
@@ -264,21 +241,21 @@ InterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
 {
     NS_LOG_FUNCTION(this << freqRange);
     std::vector<WifiSpectrumBandInfo> bandsToRemove{};
-    for (auto it = m_niChanges.begin(); it != m_niChanges.end(); ++it)
+    for (const auto& timeline : m_timelines)
     {
-        if (!IsBandInFrequencyRange(it->first, freqRange))
+        if (!IsBandInFrequencyRange(timeline.band, freqRange))
         {
             continue;
         }
-        const auto frequencies = it->first.frequencies;
+        const auto& frequencies = timeline.band.frequencies;
         const auto found =
-            std::find_if(bands.cbegin(), bands.cend(), [frequencies](const auto& item) {
+            std::find_if(bands.cbegin(), bands.cend(), [&frequencies](const auto& item) {
                 return frequencies == item.frequencies;
             }) != std::end(bands);
         if (!found)
         {
             // band does not belong to the new bands, erase it
-            bandsToRemove.emplace_back(it->first);
+            bandsToRemove.emplace_back(timeline.band);
         }
     }
     for (const auto& band : bandsToRemove)
@@ -324,14 +301,13 @@ InterferenceHelper::GetEnergyDuration(Watt_u energy, const WifiSpectrumBandInfo&
 {
     NS_LOG_FUNCTION(this << energy << band);
     Time now = Simulator::Now();
-    auto niIt = m_niChanges.find(band);
-    NS_ABORT_IF(niIt == m_niChanges.end());
-    auto i = GetPreviousPosition(now, niIt);
-    Time end = i->first;
-    for (; i != niIt->second.end(); ++i)
+    const auto& changes = m_timelines[GetBandId(band)].changes;
+    auto i = GetPreviousPosition(now, changes);
+    Time end = changes[i].time;
+    for (; i < changes.size(); ++i)
     {
-        const auto noiseInterference = i->second.GetPower();
-        end = i->first;
+        const auto noiseInterference = changes[i].power;
+        end = changes[i].time;
         if (noiseInterference < energy)
         {
             break;
@@ -346,34 +322,36 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
                                 bool isStartHePortionRxing)
 {
     NS_LOG_FUNCTION(this << event << freqRange << isStartHePortionRxing);
+    const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange));
     for (const auto& [band, power] : event->GetRxPowerPerBand())
     {
-        auto niIt = m_niChanges.find(band);
-        NS_ABORT_IF(niIt == m_niChanges.end());
-        Watt_u previousPowerStart{0.0};
-        Watt_u previousPowerEnd{0.0};
-        auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), niIt);
-        previousPowerStart = previousPowerPosition->second.GetPower();
-        previousPowerEnd = GetPreviousPosition(event->GetEndTime(), niIt)->second.GetPower();
-        if (const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange)); !rxing)
+        auto& timeline = m_timelines[GetBandId(band)];
+        auto& changes = timeline.changes;
+        const auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), changes);
+        const auto previousPowerStart = changes[previousPowerPosition].power;
+        const auto previousPowerEnd =
+            changes[GetPreviousPosition(event->GetEndTime(), changes)].power;
+        if (!rxing)
         {
-            m_firstPowers.find(band)->second = previousPowerStart;
-            // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            timeline.firstPower = previousPowerStart;
+            // Always leave the first zero power noise event in the list. The changes
+            // erased here precede the new event, hence only the few changes that follow
+            // them (the ends of the ongoing events) are moved.
+            changes.erase(changes.begin() + 1, changes.begin() + previousPowerPosition + 1);
         }
         else if (isStartHePortionRxing)
         {
             // When the first HE portion is received, we need to set m_firstPowerPerBand
             // so that it takes into account interferences that arrived between the start of the
             // HE TB PPDU transmission and the start of HE TB payload.
-            m_firstPowers.find(band)->second = previousPowerStart;
+            timeline.firstPower = previousPowerStart;
         }
-        auto first =
-            AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
-        auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        const auto first =
+            AddNiChangeEvent({event->GetStartTime(), previousPowerStart, event}, changes);
+        const auto last = AddNiChangeEvent({event->GetEndTime(), previousPowerEnd, event}, changes);
+        for (auto i = first; i < last; ++i)
         {
-            i->second.AddPower(power);
+            changes[i].power += power;
         }
     }
 }
@@ -385,13 +363,12 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
     // This is called for UL MU events, in order to scale power as long as UL MU PPDUs arrive
     for (const auto& [band, power] : rxPower)
     {
-        auto niIt = m_niChanges.find(band);
-        NS_ABORT_IF(niIt == m_niChanges.end());
-        auto first = GetPreviousPosition(event->GetStartTime(), niIt);
-        auto last = GetPreviousPosition(event->GetEndTime(), niIt);
-        for (auto i = first; i != last; ++i)
+        auto& changes = m_timelines[GetBandId(band)].changes;
+        const auto first = GetPreviousPosition(event->GetStartTime(), changes);
+        const auto last = GetPreviousPosition(event->GetEndTime(), changes);
+        for (auto i = first; i < last; ++i)
         {
-            i->second.AddPower(power);
+            changes[i].power += power;
         }
     }
     event->UpdateRxPowerW(rxPower);
@@ -430,86 +407,85 @@ InterferenceHelper::CalculateSnr(Watt_u signal,
 }
 
 Watt_u
-InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
-                                                const WifiSpectrumBandInfo& band) const
-{
-    NS_LOG_FUNCTION(this << band);
-    auto firstPower_it = m_firstPowers.find(band);
-    NS_ABORT_IF(firstPower_it == m_firstPowers.end());
-    auto noiseInterference = firstPower_it->second;
-    auto niIt = m_niChanges.find(band);
-    NS_ABORT_IF(niIt == m_niChanges.end());
+InterferenceHelper::CalculateNoiseInterferenceW(const Event& event,
+                                                std::size_t bandId,
+                                                NiSpan& span) const
+{
+    NS_LOG_FUNCTION(this << bandId);
+    const auto& timeline = m_timelines[bandId];
+    const auto& changes = timeline.changes;
+    auto noiseInterference = timeline.firstPower;
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
-    const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
-                                 ? CalculateMuMimoPowerW(event, band)
+    const auto start = static_cast<std::size_t>(
+        std::lower_bound(changes.cbegin(),
+                         changes.cend(),
+                         event.GetStartTime(),
+                         [](const NiChange& change, Time time) { return change.time < time; }) -
+        changes.cbegin());
+    NS_ABORT_IF(start == changes.size() || changes[start].time != event.GetStartTime());
+    const auto power = event.GetRxPower(timeline.band);
+    const auto muMimoPower = (event.GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
+                                 ? CalculateMuMimoPowerW(event, bandId)
                                  : Watt_u{0.0};
-    for (; it != niIt->second.end() && it->first < now; ++it)
+    for (auto i = start; i < changes.size() && changes[i].time < now; ++i)
     {
-        if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
-            (event != it->second.GetEvent()))
+        const auto other = PeekPointer(changes[i].event);
+        if (IsSameMuMimoTransmission(event, other) && (other != &event))
         {
             // Do not calculate noiseInterferenceW if events belong to the same MU-MIMO transmission
             // unless this is the same event
             continue;
         }
-        noiseInterference = it->second.GetPower() - event->GetRxPower(band) - muMimoPower;
+        noiseInterference = changes[i].power - power - muMimoPower;
         if (std::abs(noiseInterference) < std::numeric_limits<double>::epsilon())
         {
             // fix some possible rounding issues with double values
             noiseInterference = Watt_u{0.0};
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    span.bandId = bandId;
+    span.first = start;
+    while (PeekPointer(changes[span.first].event) != &event)
     {
-        ;
+        ++span.first;
+        NS_ASSERT(span.first < changes.size());
     }
-    auto& ni = nis[band];
-    ni.emplace(event->GetStartTime(), NiChange(Watt_u{0}, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    span.last = span.first + 1;
+    while (span.last < changes.size() && PeekPointer(changes[span.last].event) != &event)
     {
-        ni.insert(*it);
+        ++span.last;
     }
-    ni.emplace(event->GetEndTime(), NiChange(Watt_u{0}, event));
     NS_ASSERT_MSG(noiseInterference >= Watt_u{0.0},
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
 }
 
 Watt_u
-InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
-                                          const WifiSpectrumBandInfo& band) const
+InterferenceHelper::CalculateMuMimoPowerW(const Event& event, std::size_t bandId) const
 {
-    auto niIt = m_niChanges.find(band);
-    NS_ASSERT(niIt != m_niChanges.end());
-    auto it = niIt->second.begin();
-    ++it;
+    const auto& timeline = m_timelines[bandId];
+    const auto& changes = timeline.changes;
+    const auto now = Simulator::Now();
     Watt_u muMimoPower{0.0};
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    for (std::size_t i = 1; i < changes.size() && changes[i].time < now; ++i)
     {
-        if (IsSameMuMimoTransmission(event, it->second.GetEvent()))
+        const auto other = PeekPointer(changes[i].event);
+        if (IsSameMuMimoTransmission(event, other))
         {
-            auto hePpdu = DynamicCast<HePpdu>(it->second.GetEvent()->GetPpdu()->Copy());
+            auto hePpdu = DynamicCast<const HePpdu>(other->GetPpdu());
             NS_ASSERT(hePpdu);
             HePpdu::TxPsdFlag psdFlag = hePpdu->GetTxPsdFlag();
             if (psdFlag == HePpdu::PSD_HE_PORTION)
             {
                 const auto staId =
-                    event->GetPpdu()->GetTxVector().GetHeMuUserInfoMap().cbegin()->first;
-                const auto otherStaId = it->second.GetEvent()
-                                            ->GetPpdu()
-                                            ->GetTxVector()
-                                            .GetHeMuUserInfoMap()
-                                            .cbegin()
-                                            ->first;
+                    event.GetPpdu()->GetTxVector().GetHeMuUserInfoMap().cbegin()->first;
+                const auto otherStaId =
+                    other->GetPpdu()->GetTxVector().GetHeMuUserInfoMap().cbegin()->first;
                 if (staId == otherStaId)
                 {
                     break;
                 }
-                muMimoPower += it->second.GetEvent()->GetRxPower(band);
+                muMimoPower += other->GetRxPower(timeline.band);
             }
         }
     }
@@ -560,52 +536,51 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 }
 
 double
-InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
+InterferenceHelper::CalculatePayloadPer(const Event& event,
                                         MHz_u channelWidth,
-                                        NiChangesPerBand* nis,
-                                        const WifiSpectrumBandInfo& band,
+                                        const NiSpan& span,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
-    NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
+    NS_LOG_FUNCTION(this << channelWidth << span.bandId << staId << window.first
+                         << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
-    auto previous = j->first;
+    const auto& timeline = m_timelines[span.bandId];
+    const auto& changes = timeline.changes;
+    const auto& txVector = event.GetPpdu()->GetTxVector();
+    auto previous = event.GetStartTime();
     Watt_u muMimoPower{0.0};
-    const auto payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
-    auto phyPayloadStart = j->first;
-    if (event->GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
-        event->GetPpdu()->GetType() !=
-            WIFI_PPDU_TYPE_DL_MU) // j->first corresponds to the start of the MU payload
+    const auto payloadMode = txVector.GetMode(staId);
+    auto phyPayloadStart = previous;
+    if (event.GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
+        event.GetPpdu()->GetType() !=
+            WIFI_PPDU_TYPE_DL_MU) // the start of the event corresponds to the start of the MU
+                                  // payload
     {
-        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(
-                                         event->GetPpdu()->GetTxVector());
+        phyPayloadStart = previous + WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
     }
     else
     {
-        muMimoPower = CalculateMuMimoPowerW(event, band);
+        muMimoPower = CalculateMuMimoPowerW(event, span.bandId);
     }
     const auto windowStart = phyPayloadStart + window.first;
     const auto windowEnd = phyPayloadStart + window.second;
-    NS_ABORT_IF(!m_firstPowers.contains(band));
-    auto noiseInterference = m_firstPowers.at(band);
-    auto power = event->GetRxPower(band);
-    while (++j != niIt.cend())
+    auto noiseInterference = timeline.firstPower;
+    const auto power = event.GetRxPower(timeline.band);
+    const auto nss = txVector.GetNss(staId);
+    for (auto j = span.first + 1; j <= span.last; ++j)
     {
-        Time current = j->first;
+        // the change at the end of the event may have been erased already
+        const auto current = (j < span.last) ? changes[j].time : event.GetEndTime();
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
-        const auto snr = CalculateSnr(power,
-                                      noiseInterference,
-                                      channelWidth,
-                                      event->GetPpdu()->GetTxVector().GetNss(staId));
+        const auto snr = CalculateSnr(power, noiseInterference, channelWidth, nss);
         // Case 1: Both previous and current point to the windowed payload
         if (previous >= windowStart)
         {
             psr *= CalculatePayloadChunkSuccessRate(snr,
                                                     Min(windowEnd, current) - previous,
-                                                    event->GetPpdu()->GetTxVector(),
+                                                    txVector,
                                                     staId);
             NS_LOG_DEBUG("Both previous and current point to the windowed payload: mode="
                          << payloadMode << ", psr=" << psr);
@@ -615,20 +590,25 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
         {
             psr *= CalculatePayloadChunkSuccessRate(snr,
                                                     Min(windowEnd, current) - windowStart,
-                                                    event->GetPpdu()->GetTxVector(),
+                                                    txVector,
                                                     staId);
             NS_LOG_DEBUG(
                 "previous is before windowed payload and current is in the windowed payload: mode="
                 << payloadMode << ", psr=" << psr);
         }
-        noiseInterference = j->second.GetPower() - power;
-        if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
+        if (j == span.last)
+        {
+            break;
+        }
+        noiseInterference = changes[j].power - power;
+        const auto other = PeekPointer(changes[j].event);
+        if (IsSameMuMimoTransmission(event, other))
         {
-            muMimoPower += j->second.GetEvent()->GetRxPower(band);
+            muMimoPower += other->GetRxPower(timeline.band);
             NS_LOG_DEBUG("PPDU belongs to same MU-MIMO transmission: muMimoPowerW=" << muMimoPower);
         }
         noiseInterference -= muMimoPower;
-        previous = j->first;
+        previous = current;
         if (previous > windowEnd)
         {
             NS_LOG_DEBUG("Stop: new previous=" << previous
@@ -641,16 +621,78 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 }
 
 double
-InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                                 NiChangesPerBand* nis,
+InterferenceHelper::CalculatePayloadEffectiveSnr(const Event& event,
                                                  MHz_u channelWidth,
-                                                 const WifiSpectrumBandInfo& band,
-                                                 PhyHeaderSections phyHeaderSections) const
+                                                 const NiSpan& span,
+                                                 uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << channelWidth << span.bandId << staId);
+    const auto& timeline = m_timelines[span.bandId];
+    const auto& changes = timeline.changes;
+    const auto& txVector = event.GetPpdu()->GetTxVector();
+    auto previous = event.GetStartTime();
+    Watt_u muMimoPower{0.0};
+    auto phyPayloadStart = previous;
+    if (event.GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
+        event.GetPpdu()->GetType() !=
+            WIFI_PPDU_TYPE_DL_MU) // the start of the event corresponds to the start of the MU
+                                  // payload
+    {
+        phyPayloadStart = previous + WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
+    }
+    else
+    {
+        muMimoPower = CalculateMuMimoPowerW(event, span.bandId);
+    }
+    auto noiseInterference = timeline.firstPower;
+    const auto power = event.GetRxPower(timeline.band);
+    const auto nss = txVector.GetNss(staId);
+    double capacity = 0; // integral of log2(1 + snr) over the payload, in seconds
+    Time duration;
+    for (auto j = span.first + 1; j <= span.last; ++j)
+    {
+        // the change at the end of the event may have been erased already
+        const auto current = (j < span.last) ? changes[j].time : event.GetEndTime();
+        NS_ASSERT(current >= previous);
+        if (current > phyPayloadStart)
+        {
+            const auto snr = CalculateSnr(power, noiseInterference, channelWidth, nss);
+            const auto chunk = current - Max(previous, phyPayloadStart);
+            capacity += std::log2(1 + snr) * chunk.GetSeconds();
+            duration += chunk;
+        }
+        if (j == span.last)
+        {
+            break;
+        }
+        noiseInterference = changes[j].power - power;
+        const auto other = PeekPointer(changes[j].event);
+        if (IsSameMuMimoTransmission(event, other))
+        {
+            muMimoPower += other->GetRxPower(timeline.band);
+        }
+        noiseInterference -= muMimoPower;
+        previous = current;
+    }
+    if (!duration.IsStrictlyPositive())
+    {
+        return CalculateSnr(power, noiseInterference, channelWidth, nss);
+    }
+    const auto snr = std::exp2(capacity / duration.GetSeconds()) - 1;
+    NS_LOG_DEBUG("effective SNR=" << RatioToDb(snr) << " dB over " << duration.As(Time::US));
+    return snr;
+}
+
+double
+InterferenceHelper::CalculatePhyHeaderSectionPsr(const Event& event,
+                                                 const NiSpan& span,
+                                                 MHz_u channelWidth,
+                                                 const PhyHeaderSections& phyHeaderSections) const
 {
-    NS_LOG_FUNCTION(this << band);
+    NS_LOG_FUNCTION(this << span.bandId);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    const auto& timeline = m_timelines[span.bandId];
+    const auto& changes = timeline.changes;
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection;
@@ -659,13 +701,13 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
         stopLastSection = Max(stopLastSection, section.second.first.second);
     }
 
-    auto previous = j->first;
-    NS_ABORT_IF(!m_firstPowers.contains(band));
-    auto noiseInterference = m_firstPowers.at(band);
-    const auto power = event->GetRxPower(band);
-    while (++j != niIt.end())
+    auto previous = event.GetStartTime();
+    auto noiseInterference = timeline.firstPower;
+    const auto power = event.GetRxPower(timeline.band);
+    for (auto j = span.first + 1; j <= span.last; ++j)
     {
-        auto current = j->first;
+        // the change at the end of the event may have been erased already
+        const auto current = (j < span.last) ? changes[j].time : event.GetEndTime();
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
         const auto snr = CalculateSnr(power, noiseInterference, channelWidth, 1);
@@ -682,7 +724,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
                     psr *= CalculateChunkSuccessRate(snr,
                                                      duration,
                                                      section.second.second,
-                                                     event->GetPpdu()->GetTxVector(),
+                                                     event.GetPpdu()->GetTxVector(),
                                                      section.first);
                     NS_LOG_DEBUG("Current NI change in "
                                  << section.first << " [" << start << ", " << stop << "] for "
@@ -691,8 +733,12 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
                 }
             }
         }
-        noiseInterference = j->second.GetPower() - power;
-        previous = j->first;
+        if (j == span.last)
+        {
+            break;
+        }
+        noiseInterference = changes[j].power - power;
+        previous = current;
         if (previous > stopLastSection)
         {
             NS_LOG_DEBUG("Stop: new previous=" << previous << " after stop of last section="
@@ -704,20 +750,17 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
 }
 
 double
-InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+InterferenceHelper::CalculatePhyHeaderPer(const Event& event,
+                                          const NiSpan& span,
                                           MHz_u channelWidth,
-                                          const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
-    NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
-    auto phyEntity =
-        WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
+    NS_LOG_FUNCTION(this << span.bandId << header);
+    const auto& txVector = event.GetPpdu()->GetTxVector();
+    auto phyEntity = WifiPhy::GetStaticPhyEntity(txVector.GetModulationClass());
 
     PhyHeaderSections sections;
-    for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+    for (const auto& section : phyEntity->GetPhyHeaderSections(txVector, event.GetStartTime()))
     {
         if (section.first == header)
         {
@@ -728,7 +771,7 @@ InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
     double psr = 1.0;
     if (!sections.empty())
     {
-        psr = CalculatePhyHeaderSectionPsr(event, nis, channelWidth, band, sections);
+        psr = CalculatePhyHeaderSectionPsr(event, span, channelWidth, sections);
     }
     return 1 - psr;
 }
@@ -742,8 +785,8 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
-    const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
+    NiSpan span;
+    const auto noiseInterference = CalculateNoiseInterferenceW(*event, GetBandId(band), span);
     const auto snr = CalculateSnr(event->GetRxPower(band),
                                   noiseInterference,
                                   channelWidth,
@@ -752,20 +795,40 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    const auto per =
-        CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    const auto per = CalculatePayloadPer(*event, channelWidth, span, staId, relativeMpduStartStop);
 
     return SnrPer(snr, per);
 }
 
+double
+InterferenceHelper::CalculatePayloadEffectiveSnr(Ptr<Event> event,
+                                                 MHz_u channelWidth,
+                                                 const WifiSpectrumBandInfo& band,
+                                                 uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << channelWidth << band << staId);
+    NiSpan span;
+    CalculateNoiseInterferenceW(*event, GetBandId(band), span);
+    return CalculatePayloadEffectiveSnr(*event, channelWidth, span, staId);
+}
+
+double
+InterferenceHelper::CalculatePayloadPer(double snir,
+                                        Time duration,
+                                        const WifiTxVector& txVector,
+                                        uint16_t staId) const
+{
+    return 1.0 - CalculatePayloadChunkSuccessRate(snir, duration, txVector, staId);
+}
+
 double
 InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  MHz_u channelWidth,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
-    const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
+    NiSpan span;
+    const auto noiseInterference = CalculateNoiseInterferenceW(*event, GetBandId(band), span);
     return CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, nss);
 }
 
@@ -776,35 +839,42 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
-    const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
+    NiSpan span;
+    const auto noiseInterference = CalculateNoiseInterferenceW(*event, GetBandId(band), span);
     const auto snr = CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    const auto per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    const auto per = CalculatePhyHeaderPer(*event, span, channelWidth, header);
 
     return SnrPer(snr, per);
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt) const
+std::size_t
+InterferenceHelper::GetNextPosition(Time moment, const NiChanges& changes)
 {
-    return niIt->second.upper_bound(moment);
+    return static_cast<std::size_t>(
+        std::upper_bound(changes.cbegin(),
+                         changes.cend(),
+                         moment,
+                         [](Time time, const NiChange& change) { return time < change.time; }) -
+        changes.cbegin());
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt) const
+std::size_t
+InterferenceHelper::GetPreviousPosition(Time moment, const NiChanges& changes)
 {
     // This is safe since there is always an NiChange at time 0, before moment.
-    return std::prev(GetNextPosition(moment, niIt));
+    return GetNextPosition(moment, changes) - 1;
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
+std::size_t
+InterferenceHelper::AddNiChangeEvent(NiChange change, NiChanges& changes)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
+    const auto position = GetNextPosition(change.time, changes);
+    changes.insert(changes.begin() + position, std::move(change));
+    return position;
 }
 
 void
@@ -819,16 +889,17 @@ InterferenceHelper::NotifyRxEnd(Time endTime, const FrequencyRange& freqRange)
 {
     NS_LOG_FUNCTION(this << endTime << freqRange);
     m_rxing.at(freqRange) = false;
-    // Update m_firstPowers for frame capture
-    for (auto niIt = m_niChanges.begin(); niIt != m_niChanges.end(); ++niIt)
+    // Update the first powers for frame capture
+    for (auto& timeline : m_timelines)
     {
-        if (!IsBandInFrequencyRange(niIt->first, freqRange))
+        if (!IsBandInFrequencyRange(timeline.band, freqRange))
         {
             continue;
         }
-        NS_ASSERT(niIt->second.size() > 1);
-        auto it = std::prev(GetPreviousPosition(endTime, niIt));
-        m_firstPowers.find(niIt->first)->second = it->second.GetPower();
+        NS_ASSERT(timeline.changes.size() > 1);
+        const auto position = GetPreviousPosition(endTime, timeline.changes);
+        NS_ASSERT(position > 0);
+        timeline.firstPower = timeline.changes[position - 1].power;
     }
 }
 
@@ -845,15 +916,15 @@ InterferenceHelper::IsBandInFrequencyRange(const WifiSpectrumBandInfo& band,
 }
 
 bool
-InterferenceHelper::IsSameMuMimoTransmission(Ptr<const Event> currentEvent,
-                                             Ptr<const Event> otherEvent) const
+InterferenceHelper::IsSameMuMimoTransmission(const Event& currentEvent,
+                                             const Event* otherEvent) const
 {
-    if ((currentEvent->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU) &&
+    if (otherEvent && (currentEvent.GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU) &&
         (otherEvent->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU) &&
-        (currentEvent->GetPpdu()->GetUid() == otherEvent->GetPpdu()->GetUid()))
+        (currentEvent.GetPpdu()->GetUid() == otherEvent->GetPpdu()->GetUid()))
     {
-        const auto currentTxVector = currentEvent->GetPpdu()->GetTxVector();
-        const auto otherTxVector = otherEvent->GetPpdu()->GetTxVector();
+        const auto& currentTxVector = currentEvent.GetPpdu()->GetTxVector();
+        const auto& otherTxVector = otherEvent->GetPpdu()->GetTxVector();
         NS_ASSERT(currentTxVector.GetHeMuUserInfoMap().size() == 1);
         NS_ASSERT(otherTxVector.GetHeMuUserInfoMap().size() == 1);
         const auto currentUserInfo = currentTxVector.GetHeMuUserInfoMap().cbegin();
@@ -16,6 +16,7 @@
 #include "ns3/object.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -126,6 +127,11 @@ std::ostream& operator<<(std::ostream& os, const Event& event);
 /**
  * @ingroup wifi
  * @brief handles interference calculations
+ *
+ * The noise and interference (NI) changes of each band are kept in a vector
+ * sorted by time, each change holding the total power received on the band
+ * from its time on. Bands are identified by the index of their vector, and the
+ * changes preceding a new event are discarded when no reception is ongoing.
  */
 class InterferenceHelper : public Object
 {
@@ -255,6 +261,38 @@ class InterferenceHelper : public Object
                                   const WifiSpectrumBandInfo& band,
                                   uint16_t staId,
                                   std::pair<Time, Time> relativeMpduStartStop) const;
+    /**
+     * Calculate the effective SNIR of the PHY payload, that is the SNIR that yields the same
+     * capacity as the SNIR changes over the PHY payload: 2^(E[log2(1 + snir)]) - 1, where
+     * the mean is weighted by the duration of each SNIR value. This is used to evaluate the
+     * reception of all the MPDUs of the PSDU at once (see WifiPhy::RxAbstraction).
+     *
+     * @param event the event corresponding to the first time the corresponding PPDU arrives
+     * @param channelWidth the channel width used to transmit the PSDU
+     * @param band identify the band used by the PSDU
+     * @param staId the station ID of the PSDU (only used for MU)
+     *
+     * @return the effective SNIR of the PHY payload in linear scale
+     */
+    double CalculatePayloadEffectiveSnr(Ptr<Event> event,
+                                        MHz_u channelWidth,
+                                        const WifiSpectrumBandInfo& band,
+                                        uint16_t staId) const;
+    /**
+     * Calculate the error rate of a part of the PHY payload received with a constant SNIR
+     * (e.g., the effective SNIR of the PHY payload).
+     *
+     * @param snir the SINR
+     * @param duration the duration of the part of the PHY payload
+     * @param txVector the TXVECTOR
+     * @param staId the station ID of the PSDU (only used for MU)
+     *
+     * @return the error rate of the part of the PHY payload
+     */
+    double CalculatePayloadPer(double snir,
+                               Time duration,
+                               const WifiTxVector& txVector,
+                               uint16_t staId = SU_STA_ID) const;
     /**
      * Calculate the SNIR for the event (starting from now until the event end).
      *
@@ -362,61 +400,47 @@ class InterferenceHelper : public Object
         m_rxing; //!< flag whether it is in receiving state for a given FrequencyRange
 
     /**
-     * Noise and Interference (thus Ni) event.
+     * Noise and Interference (thus Ni) change: from the given time on, the total
+     * received power on a band is the given power, until the next change.
      */
-    class NiChange
+    struct NiChange
     {
-      public:
-        /**
-         * Create a NiChange at the given time and the amount of NI change.
-         *
-         * @param power the power
-         * @param event causes this NI change
-         */
-        NiChange(Watt_u power, Ptr<Event> event);
-
-        /**
-         * Return the power
-         *
-         * @return the power
-         */
-        Watt_u GetPower() const;
-        /**
-         * Add a given amount of power.
-         *
-         * @param power the power to be added to the existing value
-         */
-        void AddPower(Watt_u power);
-        /**
-         * Return the event causes the corresponding NI change
-         *
-         * @return the event
-         */
-        Ptr<Event> GetEvent() const;
-
-      private:
-        Watt_u m_power;     ///< power
-        Ptr<Event> m_event; ///< event
+        Time time;        //!< the time of the change
+        Watt_u power;     //!< the total received power from the time of the change
+        Ptr<Event> event; //!< the event causing the change (null for the initial change)
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * The NI changes of a band, in increasing order of time
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<NiChange>;
 
     /**
-     * Map of NiChanges per band
+     * The NI changes of a band, along with the power that was received on the band
+     * when the reception of the current event started
      */
-    using NiChangesPerBand = std::map<WifiSpectrumBandInfo, NiChanges>;
+    struct NiTimeline
+    {
+        WifiSpectrumBandInfo band; //!< the band
+        NiChanges changes;         //!< the NI changes, starting with a zero power change at 0
+        Watt_u firstPower;         //!< first power of the band
+    };
+
+    std::vector<NiTimeline> m_timelines;                     //!< NI timeline of each band
+    std::map<WifiSpectrumBandInfo, std::size_t> m_bandIds; //!< index of each band's timeline
 
+  private:
     /**
-     * Map of first power per band
+     * The NI changes of a band overlapping an event: the change at the start of
+     * the event, those in between and the change at the end of the event
      */
-    using FirstPowerPerBand = std::map<WifiSpectrumBandInfo, Watt_u>;
-
-    NiChangesPerBand m_niChanges; //!< NI Changes for each band
+    struct NiSpan
+    {
+        std::size_t bandId; //!< the index of the timeline of the band
+        std::size_t first;  //!< the index of the change at the start of the event
+        std::size_t last;   //!< the index of the change at the end of the event, if any
+    };
 
-  private:
     /**
      * Check whether a given band is tracked by this interference helper.
      *
@@ -425,6 +449,15 @@ class InterferenceHelper : public Object
      */
     bool HasBand(const WifiSpectrumBandInfo& band) const;
 
+    /**
+     * Return the index of the timeline of a given band, which must be tracked by
+     * this interference helper.
+     *
+     * @param band the band
+     * @return the index of the timeline of the band
+     */
+    std::size_t GetBandId(const WifiSpectrumBandInfo& band) const;
+
     /**
      * Check whether a given band belongs to a given frequency range.
      *
@@ -449,26 +482,24 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power.
      *
      * @param event the event
-     * @param nis the NiChanges
-     * @param band the band
+     * @param bandId the index of the timeline of the band
+     * @param span the NI changes overlapping the event
      *
      * @return noise and interference power
      */
-    Watt_u CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
-                                       const WifiSpectrumBandInfo& band) const;
+    Watt_u CalculateNoiseInterferenceW(const Event& event, std::size_t bandId, NiSpan& span) const;
 
     /**
      * Calculate power of all other events preceding a given event that belong to the same MU-MIMO
      * transmission.
      *
      * @param event the event
-     * @param band the band
+     * @param bandId the index of the timeline of the band
      *
      * @return the power of all other events preceding the event that belong to the same MU-MIMO
      * transmission
      */
-    Watt_u CalculateMuMimoPowerW(Ptr<const Event> event, const WifiSpectrumBandInfo& band) const;
+    Watt_u CalculateMuMimoPowerW(const Event& event, std::size_t bandId) const;
 
     /**
      * Calculate the error rate of the given PHY payload only in the provided time
@@ -477,98 +508,102 @@ class InterferenceHelper : public Object
      *
      * @param event the event
      * @param channelWidth the channel width used to transmit the PSDU
-     * @param nis the NiChanges
-     * @param band identify the band used by the PSDU
+     * @param span the NI changes overlapping the event
      * @param staId the station ID of the PSDU (only used for MU)
      * @param window time window (pair of start and end times) of PHY payload to focus on
      *
      * @return the error rate of the payload
      */
-    double CalculatePayloadPer(Ptr<const Event> event,
+    double CalculatePayloadPer(const Event& event,
                                MHz_u channelWidth,
-                               NiChangesPerBand* nis,
-                               const WifiSpectrumBandInfo& band,
+                               const NiSpan& span,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
+    /**
+     * Calculate the effective SNIR of the PHY payload (see the public overload).
+     *
+     * @param event the event
+     * @param channelWidth the channel width used to transmit the PSDU
+     * @param span the NI changes overlapping the event
+     * @param staId the station ID of the PSDU (only used for MU)
+     *
+     * @return the effective SNIR of the PHY payload in linear scale
+     */
+    double CalculatePayloadEffectiveSnr(const Event& event,
+                                        MHz_u channelWidth,
+                                        const NiSpan& span,
+                                        uint16_t staId) const;
     /**
      * Calculate the error rate of the PHY header. The PHY header
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param span the NI changes overlapping the event
      * @param channelWidth the channel width for header measurement
-     * @param band the band
      * @param header the PHY header to consider
      *
      * @return the error rate of the HT PHY header
      */
-    double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+    double CalculatePhyHeaderPer(const Event& event,
+                                 const NiSpan& span,
                                  MHz_u channelWidth,
-                                 const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
     /**
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param span the NI changes overlapping the event
      * @param channelWidth the channel width for header measurement
-     * @param band the band
      * @param phyHeaderSections the map of PHY header sections (\see PhyHeaderSections)
      *
      * @return the success rate of the PHY header sections
      */
-    double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+    double CalculatePhyHeaderSectionPsr(const Event& event,
+                                        const NiSpan& span,
                                         MHz_u channelWidth,
-                                        const WifiSpectrumBandInfo& band,
-                                        PhyHeaderSections phyHeaderSections) const;
+                                        const PhyHeaderSections& phyHeaderSections) const;
 
     double m_noiseFigure;                 //!< noise figure (linear)
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
-    uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
-    FirstPowerPerBand m_firstPowers; //!< first power of each band
+    uint8_t m_numRxAntennas; //!< the number of RX antennas in the corresponding receiver
 
     /**
-     * Returns an iterator to the first NiChange that is later than moment
+     * Returns the index of the first NiChange that is later than moment
      *
      * @param moment time to check from
-     * @param niIt iterator of the band to check
-     * @returns an iterator to the list of NiChanges
+     * @param changes the NI changes of the band to check
+     * @returns the index of the first NiChange later than moment, or the number of NiChanges
      */
-    NiChanges::iterator GetNextPosition(Time moment, NiChangesPerBand::iterator niIt) const;
+    static std::size_t GetNextPosition(Time moment, const NiChanges& changes);
     /**
-     * Returns an iterator to the last NiChange that is before than moment
+     * Returns the index of the last NiChange that is before than moment
      *
      * @param moment time to check from
-     * @param niIt iterator of the band to check
-     * @returns an iterator to the list of NiChanges
+     * @param changes the NI changes of the band to check
+     * @returns the index of the last NiChange not later than moment
      */
-    NiChanges::iterator GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt) const;
+    static std::size_t GetPreviousPosition(Time moment, const NiChanges& changes);
 
     /**
      * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * return the index of the new change.
      *
-     * @param moment time to check from
      * @param change the NiChange to add
-     * @param niIt iterator of the band to check
-     * @returns the iterator of the new event
+     * @param changes the NI changes of the band
+     * @returns the index of the new change
      */
-    NiChanges::iterator AddNiChangeEvent(Time moment,
-                                         NiChange change,
-                                         NiChangesPerBand::iterator niIt);
+    static std::size_t AddNiChangeEvent(NiChange change, NiChanges& changes);
 
     /**
      * Return whether another event is a MU-MIMO event that belongs to the same transmission and to
      * the same RU.
      *
      * @param currentEvent the current event that is being inspected
-     * @param otherEvent the other event to compare against
+     * @param otherEvent the other event to compare against, possibly null
      *
      * @return whether both events belong to the same transmission and to the same RU
      */
-    bool IsSameMuMimoTransmission(Ptr<const Event> currentEvent, Ptr<const Event> otherEvent) const;
+    bool IsSameMuMimoTransmission(const Event& currentEvent, const Event* otherEvent) const;
 };
 
 } // namespace ns3
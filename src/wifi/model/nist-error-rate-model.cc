@@ -9,12 +9,17 @@
 
 #include "nist-error-rate-model.h"
 
+#include "error-rate-lookup-table.h"
 #include "wifi-tx-vector.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <map>
 
 namespace ns3
 {
@@ -23,13 +28,31 @@ NS_LOG_COMPONENT_DEFINE("NistErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 
+/// The lookup tables shared by all the instances, indexed by constellation size and code rate
+static std::map<std::pair<uint16_t, WifiCodeRate>, ErrorRateLookupTable> g_nistLookupTables;
+
 TypeId
 NistErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NistErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::NistErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<NistErrorRateModel>()
+            .AddAttribute("UseLookupTables",
+                          "Whether the chunk success rates are interpolated from tables of the "
+                          "model sampled on a dense SNR grid, which are built on first use and "
+                          "shared by all the instances, rather than evaluated analytically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NistErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker())
+            .AddAttribute("LookupTableTolerance",
+                          "If strictly positive, every chunk success rate read from the lookup "
+                          "tables is also evaluated analytically and the simulation is aborted "
+                          "if both differ by more than this tolerance.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&NistErrorRateModel::m_lookupTableTolerance),
+                          MakeDoubleChecker<double>(0, 1));
     return tid;
 }
 
@@ -190,6 +213,20 @@ NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
     return 0;
 }
 
+double
+NistErrorRateModel::CalculateChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const
+{
+    if (mode.GetConstellationSize() == 2)
+    {
+        return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+    }
+    else if (mode.GetConstellationSize() == 4)
+    {
+        return GetFecQpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+    }
+    return GetFecQamBer(mode.GetConstellationSize(), snr, nbits, GetBValue(mode.GetCodeRate()));
+}
+
 double
 NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           const WifiTxVector& txVector,
@@ -200,25 +237,36 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           uint16_t staId) const
 {
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
-    if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM)
     {
-        if (mode.GetConstellationSize() == 2)
-        {
-            return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
-        }
-        else if (mode.GetConstellationSize() == 4)
+        return 0;
+    }
+    if (m_useLookupTables)
+    {
+        const auto key = std::make_pair(mode.GetConstellationSize(), mode.GetCodeRate());
+        auto it = g_nistLookupTables.find(key);
+        if (it == g_nistLookupTables.end())
         {
-            return GetFecQpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
+            it = g_nistLookupTables
+                     .emplace(key,
+                              ErrorRateLookupTable([this, mode](double bitSnr) {
+                                  return CalculateChunkSuccessRate(mode, bitSnr, 1);
+                              }))
+                     .first;
         }
-        else
+        if (const auto csr = it->second.GetChunkSuccessRate(snr, nbits))
         {
-            return GetFecQamBer(mode.GetConstellationSize(),
-                                snr,
-                                nbits,
-                                GetBValue(mode.GetCodeRate()));
+            NS_ABORT_MSG_IF(m_lookupTableTolerance > 0 &&
+                                std::abs(*csr - CalculateChunkSuccessRate(mode, snr, nbits)) >
+                                    m_lookupTableTolerance,
+                            "Chunk success rate of the lookup table for "
+                                << mode << " at SNR=" << snr << " and nbits=" << nbits
+                                << " differs from the analytical one by more than "
+                                << m_lookupTableTolerance);
+            return *csr;
         }
     }
-    return 0;
+    return CalculateChunkSuccessRate(mode, snr, nbits);
 }
 
 } // namespace ns3
@@ -42,6 +42,16 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Return the success rate of a chunk evaluated with the analytical model.
+     *
+     * @param mode the Wi-Fi mode applicable to this chunk
+     * @param snr SNR ratio (in linear scale)
+     * @param nbits the number of bits in the chunk
+     *
+     * @return the success rate of the chunk
+     */
+    double CalculateChunkSuccessRate(WifiMode mode, double snr, uint64_t nbits) const;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -117,6 +127,9 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+
+    bool m_useLookupTables;        //!< whether chunk success rates are read from lookup tables
+    double m_lookupTableTolerance; //!< tolerance of the validation of the lookup tables
 };
 
 } // namespace ns3
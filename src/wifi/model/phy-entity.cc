@@ -571,7 +571,12 @@ PhyEntity::DoStartReceivePayload(Ptr<Event> event)
     uint16_t staId = GetStaId(ppdu);
     m_signalNoiseMap.insert({{ppdu->GetUid(), staId}, SignalNoiseDbm()});
     m_statusPerMpduMap.insert({{ppdu->GetUid(), staId}, std::vector<bool>()});
-    ScheduleEndOfMpdus(event);
+    if (m_wifiPhy->m_rxAbstraction == WifiPhy::RX_ABSTRACTION_FULL ||
+        m_wifiPhy->m_notifyRxMacHeaderEnd)
+    {
+        ScheduleEndOfMpdus(event);
+    }
+    // otherwise, the MPDUs are all received by EndOfMpdus at the end of the payload
     const auto& txVector = event->GetPpdu()->GetTxVector();
     Time payloadDuration = ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
     m_wifiPhy->m_phyRxPayloadBeginTrace(
@@ -592,23 +597,19 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
     Ptr<const WifiPsdu> psdu = GetAddressedPsduInPpdu(ppdu);
     const auto& txVector = event->GetPpdu()->GetTxVector();
     uint16_t staId = GetStaId(ppdu);
-    Time endOfMpduDuration;
-    Time relativeStart;
     Time psduDuration = ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
-    Time remainingAmpduDuration = psduDuration;
-    size_t nMpdus = psdu->GetNMpdus();
-    MpduType mpduType =
-        (nMpdus > 1) ? FIRST_MPDU_IN_AGGREGATE : (psdu->IsSingle() ? SINGLE_MPDU : NORMAL_MPDU);
-    uint32_t totalAmpduSize = 0;
-    double totalAmpduNumSymbols = 0.0;
+    const auto mpduWindows = GetMpduWindows(ppdu);
     auto mpdu = psdu->begin();
-    for (size_t i = 0; i < nMpdus && mpdu != psdu->end(); ++mpdu)
+    for (size_t i = 0; i < mpduWindows.size() && mpdu != psdu->end(); ++i, ++mpdu)
     {
+        const auto [relativeStart, endOfMpduDuration] = mpduWindows[i];
+        const auto mpduDuration = endOfMpduDuration - relativeStart;
+        const auto remainingAmpduDuration = psduDuration - relativeStart;
         if (m_wifiPhy->m_notifyRxMacHeaderEnd)
         {
             // calculate MAC header size (including A-MPDU subframe header, if present)
             auto macHdrSize =
-                (*mpdu)->GetHeader().GetSerializedSize() + (mpduType == NORMAL_MPDU ? 0 : 4);
+                (*mpdu)->GetHeader().GetSerializedSize() + (psdu->IsAggregate() ? 4 : 0);
             // calculate the (approximate) duration of the MAC header TX
             auto macHdrDuration = DataRate(txVector.GetMode(staId).GetDataRate(txVector, staId))
                                       .CalculateBytesTxTime(macHdrSize);
@@ -623,7 +624,7 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
             {
                 // interference level should permit to correctly decode the MAC header
                 m_endOfMacHdrEvents[staId].push_back(
-                    Simulator::Schedule(endOfMpduDuration + macHdrDuration, [=, this]() {
+                    Simulator::Schedule(relativeStart + macHdrDuration, [=, this]() {
                         m_wifiPhy->m_phyRxMacHeaderEndTrace((*mpdu)->GetHeader(),
                                                             txVector,
                                                             remainingAmpduDuration -
@@ -632,6 +633,40 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
             }
         }
 
+        NS_LOG_INFO("Schedule end of MPDU #"
+                    << i << " in " << endOfMpduDuration.As(Time::NS) << " (relativeStart="
+                    << relativeStart.As(Time::NS) << ", mpduDuration=" << mpduDuration.As(Time::NS)
+                    << ", remainingAmdpuDuration=" << remainingAmpduDuration.As(Time::NS) << ")");
+        m_endOfMpduEvents.push_back(Simulator::Schedule(endOfMpduDuration,
+                                                        &PhyEntity::EndOfMpdu,
+                                                        this,
+                                                        event,
+                                                        *mpdu,
+                                                        i,
+                                                        relativeStart,
+                                                        mpduDuration));
+    }
+}
+
+std::vector<std::pair<Time, Time>>
+PhyEntity::GetMpduWindows(Ptr<const WifiPpdu> ppdu) const
+{
+    NS_LOG_FUNCTION(this << ppdu);
+    Ptr<const WifiPsdu> psdu = GetAddressedPsduInPpdu(ppdu);
+    const auto& txVector = ppdu->GetTxVector();
+    uint16_t staId = GetStaId(ppdu);
+    Time relativeStart;
+    Time psduDuration = ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
+    Time remainingAmpduDuration = psduDuration;
+    size_t nMpdus = psdu->GetNMpdus();
+    MpduType mpduType =
+        (nMpdus > 1) ? FIRST_MPDU_IN_AGGREGATE : (psdu->IsSingle() ? SINGLE_MPDU : NORMAL_MPDU);
+    uint32_t totalAmpduSize = 0;
+    double totalAmpduNumSymbols = 0.0;
+    std::vector<std::pair<Time, Time>> mpduWindows;
+    mpduWindows.reserve(nMpdus);
+    for (size_t i = 0; i < nMpdus; ++i)
+    {
         uint32_t size = (mpduType == NORMAL_MPDU) ? psdu->GetSize() : psdu->GetAmpduSubframeSize(i);
         Time mpduDuration = WifiPhy::GetPayloadDuration(size,
                                                         txVector,
@@ -651,26 +686,13 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
                                                         // had induced slight shift
             }
         }
-
-        endOfMpduDuration += mpduDuration;
-        NS_LOG_INFO("Schedule end of MPDU #"
-                    << i << " in " << endOfMpduDuration.As(Time::NS) << " (relativeStart="
-                    << relativeStart.As(Time::NS) << ", mpduDuration=" << mpduDuration.As(Time::NS)
-                    << ", remainingAmdpuDuration=" << remainingAmpduDuration.As(Time::NS) << ")");
-        m_endOfMpduEvents.push_back(Simulator::Schedule(endOfMpduDuration,
-                                                        &PhyEntity::EndOfMpdu,
-                                                        this,
-                                                        event,
-                                                        *mpdu,
-                                                        i,
-                                                        relativeStart,
-                                                        mpduDuration));
+        mpduWindows.emplace_back(relativeStart, relativeStart + mpduDuration);
 
         // Prepare next iteration
-        ++i;
         relativeStart += mpduDuration;
-        mpduType = (i == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
+        mpduType = (i + 1 == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
     }
+    return mpduWindows;
 }
 
 void
@@ -710,6 +732,60 @@ PhyEntity::EndOfMpdu(Ptr<Event> event,
     }
 }
 
+void
+PhyEntity::EndOfMpdus(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    const auto ppdu = event->GetPpdu();
+    const auto& txVector = ppdu->GetTxVector();
+    const auto staId = GetStaId(ppdu);
+    const auto psdu = GetAddressedPsduInPpdu(ppdu);
+    const auto channelWidthAndBand = GetChannelWidthAndBand(txVector, staId);
+    const auto snr = m_wifiPhy->m_interference->CalculatePayloadEffectiveSnr(
+        event,
+        channelWidthAndBand.first,
+        channelWidthAndBand.second,
+        staId);
+
+    SignalNoiseDbm signalNoise;
+    signalNoise.signal = WToDbm(event->GetRxPower(channelWidthAndBand.second));
+    signalNoise.noise = WToDbm(event->GetRxPower(channelWidthAndBand.second) / snr);
+    auto signalNoiseIt = m_signalNoiseMap.find({ppdu->GetUid(), staId});
+    NS_ASSERT(signalNoiseIt != m_signalNoiseMap.end());
+    signalNoiseIt->second = signalNoise;
+
+    RxSignalInfo rxSignalInfo;
+    rxSignalInfo.snr = snr;
+    rxSignalInfo.rssi = signalNoise.signal;
+
+    auto statusPerMpduIt = m_statusPerMpduMap.find({ppdu->GetUid(), staId});
+    NS_ASSERT(statusPerMpduIt != m_statusPerMpduMap.end());
+    auto mpdu = psdu->begin();
+    for (const auto& [relativeStart, relativeEnd] : GetMpduWindows(ppdu))
+    {
+        const auto per = m_wifiPhy->m_interference->CalculatePayloadPer(snr,
+                                                                        relativeEnd -
+                                                                            relativeStart,
+                                                                        txVector,
+                                                                        staId);
+        // same error checks as GetReceptionStatus
+        const auto success =
+            GetRandomValue() > per &&
+            !(m_wifiPhy->m_postReceptionErrorModel &&
+              m_wifiPhy->m_postReceptionErrorModel->IsCorrupt((*mpdu)->GetPacket()->Copy()));
+        NS_LOG_DEBUG("MPDU " << **mpdu << ": effective SNR(dB)=" << RatioToDb(snr)
+                             << ", PER=" << per << ", correct reception: " << success);
+        statusPerMpduIt->second.push_back(success);
+
+        if (success && psdu->GetNMpdus() > 1)
+        {
+            // only done for correct MPDU that is part of an A-MPDU
+            m_state->NotifyRxMpdu(Create<const WifiPsdu>(*mpdu, false), rxSignalInfo, txVector);
+        }
+        ++mpdu;
+    }
+}
+
 void
 PhyEntity::EndReceivePayload(Ptr<Event> event)
 {
@@ -719,6 +795,11 @@ PhyEntity::EndReceivePayload(Ptr<Event> event)
         this << *event << ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector));
     NS_ASSERT(event->GetEndTime() == Simulator::Now());
     const auto staId = GetStaId(ppdu);
+    if (const auto it = m_statusPerMpduMap.find({ppdu->GetUid(), staId});
+        it != m_statusPerMpduMap.end() && it->second.empty())
+    {
+        EndOfMpdus(event);
+    }
     const auto channelWidthAndBand = GetChannelWidthAndBand(txVector, staId);
     const auto snr = m_wifiPhy->m_interference->CalculateSnr(event,
                                                              channelWidthAndBand.first,
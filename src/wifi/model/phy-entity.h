@@ -666,6 +666,24 @@ class WIFI_EXPORT PhyEntity
      */
     void ScheduleEndOfMpdus(Ptr<Event> event);
 
+    /**
+     * Determine the reception status of all the MPDUs of the PSDU at once, from the
+     * effective SNR of the PHY payload, when the end of the MPDUs has not been
+     * scheduled (see WifiPhy::RxAbstraction).
+     *
+     * @param event the event holding incoming PPDU's information
+     */
+    void EndOfMpdus(Ptr<Event> event);
+
+    /**
+     * Get the time window (pair of start and end times, relative to the start of the
+     * PHY payload) of every MPDU of the PSDU addressed to this PHY.
+     *
+     * @param ppdu the incoming PPDU
+     * @return the time window of every MPDU of the PSDU
+     */
+    std::vector<std::pair<Time, Time>> GetMpduWindows(Ptr<const WifiPpdu> ppdu) const;
+
     /**
      * Perform amendment-specific actions when the payload is successfully received.
      *
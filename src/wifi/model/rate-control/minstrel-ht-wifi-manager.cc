@@ -105,8 +105,9 @@ struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
     uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
     uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
 
-    McsGroupData m_groupsTable; //!< Table of groups with stats.
-    bool m_isHt;                //!< If the station is HT capable.
+    McsGroupData m_groupsTable;       //!< Table of groups with stats.
+    MinstrelHtRateStats m_ratesStats; //!< Statistics of the supported rates.
+    bool m_isHt;                      //!< If the station is HT capable.
 
     std::ofstream m_statsFile; //!< File where statistics table is written.
 };
@@ -945,7 +946,7 @@ MinstrelHtWifiManager::UpdateRateAfterAllowedWidth(uint16_t txRate, MHz_u allowe
     NS_LOG_FUNCTION(this << txRate << allowedWidth);
 
     auto groupId = GetGroupId(txRate);
-    McsGroup group = m_minstrelGroups[groupId];
+    const auto& group = m_minstrelGroups[groupId];
 
     if (group.chWidth <= allowedWidth)
     {
@@ -968,8 +969,7 @@ MinstrelHtWifiManager::UpdateRateAfterAllowedWidth(uint16_t txRate, MHz_u allowe
             continue;
         }
         groupId = GetGroupIdForType(group.type, group.streams, group.gi, width);
-        group = m_minstrelGroups[groupId];
-        if (group.isSupported)
+        if (m_minstrelGroups[groupId].isSupported)
         {
             break;
         }
@@ -1014,7 +1014,7 @@ MinstrelHtWifiManager::DoGetDataTxVector(WifiRemoteStation* st, MHz_u allowedWid
     NS_LOG_DEBUG("DoGetDataMode rateId= " << rateId << " groupId= " << groupId
                                           << " mode= " << GetMcsSupported(station, mcsIndex));
 
-    McsGroup group = m_minstrelGroups[groupId];
+    const auto& group = m_minstrelGroups[groupId];
 
     // Check consistency of rate selected.
     if (((group.type >= WIFI_MINSTREL_GROUP_HE) && (group.gi < GetGuardInterval(station))) ||
@@ -1297,16 +1297,16 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
              * Also do not sample if the probability is already higher than 95%
              * to avoid wasting airtime.
              */
-            const auto sampleRateInfo =
+            const auto& sampleRateInfo =
                 station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+            const auto sampleProb = station->m_ratesStats.ewmaProb[sampleRateInfo.statsId];
 
             NS_LOG_DEBUG("Use sample rate? MaxTpRate= "
                          << station->m_maxTpRate << " CurrentRate= " << station->m_txrate
-                         << " SampleRate= " << sampleIdx
-                         << " SampleProb= " << sampleRateInfo.ewmaProb);
+                         << " SampleRate= " << sampleIdx << " SampleProb= " << sampleProb);
 
             if (sampleIdx != station->m_maxTpRate && sampleIdx != station->m_maxTpRate2 &&
-                sampleIdx != station->m_maxProbRate && sampleRateInfo.ewmaProb <= 95)
+                sampleIdx != station->m_maxProbRate && sampleProb <= 95)
             {
                 /**
                  * Make sure that lower rates get sampled only occasionally,
@@ -1397,103 +1397,75 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
         station->m_ampduPacketCount = 0;
     }
 
-    /* Initialize global rate indexes */
-    station->m_maxTpRate = GetLowestIndex(station);
-    station->m_maxTpRate2 = GetLowestIndex(station);
-    station->m_maxProbRate = GetLowestIndex(station);
+    auto& stats = station->m_ratesStats;
 
-    /// Update throughput and EWMA for each rate inside each group.
+    /// Update the EWMA probability of each rate inside each group. Only the rates that have
+    /// been attempted during the last interval need to be recomputed.
     for (std::size_t j = 0; j < m_numGroups; j++)
     {
         if (station->m_groupsTable[j].m_supported)
         {
             station->m_sampleCount++;
 
-            /* (re)Initialize group rate indexes */
-            station->m_groupsTable[j].m_maxTpRate = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxProbRate = GetLowestIndex(station, j);
-
             for (uint8_t i = 0; i < m_numRates; i++)
             {
-                if (station->m_groupsTable[j].m_ratesTable[i].supported)
+                auto& rate = station->m_groupsTable[j].m_ratesTable[i];
+                if (rate.supported)
                 {
-                    station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
+                    rate.retryUpdated = false;
 
-                    NS_LOG_DEBUG(
-                        +i << " "
-                           << GetMcsSupported(station,
-                                              station->m_groupsTable[j].m_ratesTable[i].mcsIndex)
-                           << "\t attempt="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt
-                           << "\t success="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
+                    NS_LOG_DEBUG(+i << " " << GetMcsSupported(station, rate.mcsIndex)
+                                    << "\t attempt=" << rate.numRateAttempt
+                                    << "\t success=" << rate.numRateSuccess);
 
                     /// If we've attempted something.
-                    if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
+                    if (rate.numRateAttempt > 0)
                     {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
+                        rate.numSamplesSkipped = 0;
                         /**
                          * Calculate the probability of success.
                          * Assume probability scales from 0 to 100.
                          */
-                        tempProb =
-                            (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) /
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
+                        tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
 
                         /// Bookkeeping.
-                        station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
+                        rate.prob = tempProb;
 
-                        if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
+                        auto& ewmaProb = stats.ewmaProb[rate.statsId];
+                        if (rate.successHist == 0)
                         {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
+                            ewmaProb = tempProb;
                         }
                         else
                         {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmsdProb =
-                                CalculateEwmsd(station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                               tempProb,
-                                               station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                               m_ewmaLevel);
+                            rate.ewmsdProb =
+                                CalculateEwmsd(rate.ewmsdProb, tempProb, ewmaProb, m_ewmaLevel);
                             /// EWMA probability
-                            tempProb =
-                                (tempProb * (100 - m_ewmaLevel) +
-                                 station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel) /
-                                100;
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
+                            ewmaProb =
+                                (tempProb * (100 - m_ewmaLevel) + ewmaProb * m_ewmaLevel) / 100;
                         }
 
-                        station->m_groupsTable[j].m_ratesTable[i].throughput =
-                            CalculateThroughput(station, j, i, tempProb);
-
-                        station->m_groupsTable[j].m_ratesTable[i].successHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                        station->m_groupsTable[j].m_ratesTable[i].attemptHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
+                        rate.successHist += rate.numRateSuccess;
+                        rate.attemptHist += rate.numRateAttempt;
                     }
                     else
                     {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
+                        rate.numSamplesSkipped++;
                     }
 
                     /// Bookkeeping.
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
-
-                    if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                        SetBestStationThRates(station, GetIndex(j, i));
-                        SetBestProbabilityRate(station, GetIndex(j, i));
-                    }
+                    rate.prevNumRateSuccess = rate.numRateSuccess;
+                    rate.prevNumRateAttempt = rate.numRateAttempt;
+                    rate.numRateSuccess = 0;
+                    rate.numRateAttempt = 0;
                 }
             }
         }
     }
 
+    UpdateThroughputs(station);
+    SetBestRates(station);
+
     // Try to sample all available rates during each interval.
     station->m_sampleCount *= 8;
 
@@ -1544,133 +1516,123 @@ MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
 }
 
 void
-MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* station, uint16_t index)
+MinstrelHtWifiManager::UpdateThroughputs(MinstrelHtWifiRemoteStation* station)
 {
-    GroupInfo* group;
-    MinstrelHtRateInfo rate;
-    std::size_t tmpGroupId;
-    uint8_t tmpRateId;
-    double tmpTh;
-    double tmpProb;
-    std::size_t groupId;
-    uint8_t rateId;
-    double currentTh;
-    // maximum group probability (GP) variables
-    std::size_t maxGPGroupId;
-    uint8_t maxGPRateId;
-    double maxGPTh;
-
-    groupId = GetGroupId(index);
-    rateId = GetRateId(index);
-    group = &station->m_groupsTable[groupId];
-    rate = group->m_ratesTable[rateId];
-
-    tmpGroupId = GetGroupId(station->m_maxProbRate);
-    tmpRateId = GetRateId(station->m_maxProbRate);
-    tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].ewmaProb;
-    tmpTh = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].throughput;
-
-    if (rate.ewmaProb > 75)
-    {
-        currentTh = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
-        if (currentTh > tmpTh)
-        {
-            station->m_maxProbRate = index;
-        }
+    auto& stats = station->m_ratesStats;
+    const auto n = stats.index.size();
+    const auto ewmaProb = stats.ewmaProb.data();
+    const auto txTime = stats.txTime.data();
+    auto throughput = stats.throughput.data();
 
-        maxGPGroupId = GetGroupId(group->m_maxProbRate);
-        maxGPRateId = GetRateId(group->m_maxProbRate);
-        maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable[maxGPRateId].throughput;
-
-        if (currentTh > maxGPTh)
-        {
-            group->m_maxProbRate = index;
-        }
-    }
-    else
+    // Same as CalculateThroughput(), written without branches so that the loop is vectorized
+    for (std::size_t k = 0; k < n; k++)
     {
-        if (rate.ewmaProb > tmpProb)
-        {
-            station->m_maxProbRate = index;
-        }
-        maxGPRateId = GetRateId(group->m_maxProbRate);
-        if (rate.ewmaProb > group->m_ratesTable[maxGPRateId].ewmaProb)
-        {
-            group->m_maxProbRate = index;
-        }
+        throughput[k] = (ewmaProb[k] < 10) ? 0 : std::min(ewmaProb[k], 90.0) / txTime[k];
     }
 }
 
 /*
- * Find & sort topmost throughput rates
+ * Find & sort topmost throughput rates and highest probability rates
  *
  * If multiple rates provide equal throughput the sorting is based on their
  * current success probability. Higher success probability is preferred among
  * MCS groups.
+ *
+ * The rates are visited in increasing order of global index and only those
+ * with non-zero throughput are considered. The best rates are initialized to
+ * the lowest rate supported by the station (or by the group), which is also the
+ * first rate visited.
  */
 void
-MinstrelHtWifiManager::SetBestStationThRates(MinstrelHtWifiRemoteStation* station, uint16_t index)
+MinstrelHtWifiManager::SetBestRates(MinstrelHtWifiRemoteStation* station)
 {
-    std::size_t groupId;
-    uint8_t rateId;
-    double th;
-    double prob;
-    std::size_t maxTpGroupId;
-    uint8_t maxTpRateId;
-    std::size_t maxTp2GroupId;
-    uint8_t maxTp2RateId;
-    double maxTpTh;
-    double maxTpProb;
-    double maxTp2Th;
-    double maxTp2Prob;
+    const auto& stats = station->m_ratesStats;
+    const auto th = stats.throughput.data();
+    const auto prob = stats.ewmaProb.data();
 
-    groupId = GetGroupId(index);
-    rateId = GetRateId(index);
-    prob = station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb;
-    th = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+    // positions of the best rates of the station in the statistics
+    std::size_t maxTp = 0;
+    std::size_t maxTp2 = 0;
+    std::size_t maxProb = 0;
 
-    maxTpGroupId = GetGroupId(station->m_maxTpRate);
-    maxTpRateId = GetRateId(station->m_maxTpRate);
-    maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+    for (std::size_t j = 0; j < m_numGroups; j++)
+    {
+        auto& group = station->m_groupsTable[j];
+        if (!group.m_supported)
+        {
+            continue;
+        }
+        NS_ASSERT(group.m_statsBegin < group.m_statsEnd);
 
-    maxTp2GroupId = GetGroupId(station->m_maxTpRate2);
-    maxTp2RateId = GetRateId(station->m_maxTpRate2);
-    maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+        // positions of the best rates of the group in the statistics
+        std::size_t groupMaxTp = group.m_statsBegin;
+        std::size_t groupMaxTp2 = group.m_statsBegin;
+        std::size_t groupMaxProb = group.m_statsBegin;
 
-    if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
-    {
-        station->m_maxTpRate2 = station->m_maxTpRate;
-        station->m_maxTpRate = index;
-    }
-    else if (th > maxTp2Th || (th == maxTp2Th && prob > maxTp2Prob))
-    {
-        station->m_maxTpRate2 = index;
-    }
+        for (std::size_t k = group.m_statsBegin; k < group.m_statsEnd; k++)
+        {
+            if (th[k] == 0)
+            {
+                continue;
+            }
 
-    // Find best rates per group
+            // best throughput rates of the station
+            if (th[k] > th[maxTp] || (th[k] == th[maxTp] && prob[k] > prob[maxTp]))
+            {
+                maxTp2 = maxTp;
+                maxTp = k;
+            }
+            else if (th[k] > th[maxTp2] || (th[k] == th[maxTp2] && prob[k] > prob[maxTp2]))
+            {
+                maxTp2 = k;
+            }
 
-    GroupInfo* group = &station->m_groupsTable[groupId];
-    maxTpGroupId = GetGroupId(group->m_maxTpRate);
-    maxTpRateId = GetRateId(group->m_maxTpRate);
-    maxTpProb = group->m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+            // best throughput rates of the group
+            if (th[k] > th[groupMaxTp] || (th[k] == th[groupMaxTp] && prob[k] > prob[groupMaxTp]))
+            {
+                groupMaxTp2 = groupMaxTp;
+                groupMaxTp = k;
+            }
+            else if (th[k] > th[groupMaxTp2] ||
+                     (th[k] == th[groupMaxTp2] && prob[k] > prob[groupMaxTp2]))
+            {
+                groupMaxTp2 = k;
+            }
 
-    maxTp2GroupId = GetGroupId(group->m_maxTpRate2);
-    maxTp2RateId = GetRateId(group->m_maxTpRate2);
-    maxTp2Prob = group->m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+            // highest probability rates: among the rates whose success probability is above
+            // 75%, the one with the highest throughput is preferred
+            if (prob[k] > 75)
+            {
+                if (th[k] > th[maxProb])
+                {
+                    maxProb = k;
+                }
+                if (th[k] > th[groupMaxProb])
+                {
+                    groupMaxProb = k;
+                }
+            }
+            else
+            {
+                if (prob[k] > prob[maxProb])
+                {
+                    maxProb = k;
+                }
+                if (prob[k] > prob[groupMaxProb])
+                {
+                    groupMaxProb = k;
+                }
+            }
+        }
 
-    if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
-    {
-        group->m_maxTpRate2 = group->m_maxTpRate;
-        group->m_maxTpRate = index;
-    }
-    else if (th > maxTp2Th || (th == maxTp2Th && prob > maxTp2Prob))
-    {
-        group->m_maxTpRate2 = index;
+        group.m_maxTpRate = stats.index[groupMaxTp];
+        group.m_maxTpRate2 = stats.index[groupMaxTp2];
+        group.m_maxProbRate = stats.index[groupMaxProb];
     }
+
+    station->m_maxTpRate = stats.index[maxTp];
+    station->m_maxTpRate2 = stats.index[maxTp2];
+    station->m_maxProbRate = stats.index[maxProb];
 }
 
 void
@@ -1679,6 +1641,7 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
     NS_LOG_FUNCTION(this << station);
 
     station->m_groupsTable = McsGroupData(m_numGroups);
+    station->m_ratesStats = MinstrelHtRateStats();
 
     /**
      * Initialize groups supported by the receiver.
@@ -1796,20 +1759,35 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                     station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].prob = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime =
                         GetFirstMpduTxTime(groupId, GetMcsSupported(station, i));
                     station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
-                    CalculateRetransmits(station, groupId, rateId);
                 }
             }
+
+            // Append the supported rates of the group to the rate statistics.
+            auto& stats = station->m_ratesStats;
+            station->m_groupsTable[groupId].m_statsBegin = stats.index.size();
+            for (uint8_t i = 0; i < m_numRates; i++)
+            {
+                auto& rate = station->m_groupsTable[groupId].m_ratesTable[i];
+                if (rate.supported)
+                {
+                    rate.statsId = stats.index.size();
+                    stats.index.push_back(GetIndex(groupId, i));
+                    stats.txTime.push_back(rate.perfectTxTime.GetSeconds());
+                    stats.ewmaProb.push_back(0);
+                    stats.throughput.push_back(0);
+                    CalculateRetransmits(station, groupId, i);
+                }
+            }
+            station->m_groupsTable[groupId].m_statsEnd = stats.index.size();
         }
     }
     /// make sure at least one group is supported, otherwise we end up with an infinite loop in
@@ -1848,7 +1826,8 @@ MinstrelHtWifiManager::CalculateRetransmits(MinstrelHtWifiRemoteStation* station
     Time txTime;
     const auto slotTime = GetPhy()->GetSlot();
 
-    if (station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb < 1)
+    const auto statsId = station->m_groupsTable[groupId].m_ratesTable[rateId].statsId;
+    if (station->m_ratesStats.ewmaProb[statsId] < 1)
     {
         station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 1;
     }
@@ -1976,7 +1955,7 @@ MinstrelHtWifiManager::StatsDump(MinstrelHtWifiRemoteStation* station,
                                  std::ofstream& of)
 {
     auto numRates = m_numRates;
-    McsGroup group = m_minstrelGroups[groupId];
+    const auto& group = m_minstrelGroups[groupId];
     Time txTime;
     for (uint8_t i = 0; i < numRates; i++)
     {
@@ -2036,10 +2015,11 @@ MinstrelHtWifiManager::StatsDump(MinstrelHtWifiRemoteStation* station,
                 GetMcsSupported(station, station->m_groupsTable[groupId].m_ratesTable[i].mcsIndex));
             of << std::setw(6) << txTime.GetMicroSeconds() << "  ";
 
+            const auto statsId = station->m_groupsTable[groupId].m_ratesTable[i].statsId;
             of << std::setw(7) << CalculateThroughput(station, groupId, i, 100) / 100 << "   "
-               << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].throughput / 100
-               << "   " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmaProb
-               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb
+               << std::setw(7) << station->m_ratesStats.throughput[statsId] / 100 << "   "
+               << std::setw(7) << station->m_ratesStats.ewmaProb[statsId] << "  " << std::setw(7)
+               << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb
                << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].prob
                << "  " << std::setw(2) << station->m_groupsTable[groupId].m_ratesTable[i].retryCount
                << "   " << std::setw(3)
@@ -2162,41 +2142,6 @@ MinstrelHtWifiManager::GetGroupIdForType(McsGroupType type,
     return 0;
 }
 
-uint16_t
-MinstrelHtWifiManager::GetLowestIndex(MinstrelHtWifiRemoteStation* station)
-{
-    NS_LOG_FUNCTION(this << station);
-
-    std::size_t groupId = 0;
-    uint8_t rateId = 0;
-    while (groupId < m_numGroups && !station->m_groupsTable[groupId].m_supported)
-    {
-        groupId++;
-    }
-    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
-    {
-        rateId++;
-    }
-    NS_ASSERT(station->m_groupsTable[groupId].m_supported &&
-              station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
-    return GetIndex(groupId, rateId);
-}
-
-uint16_t
-MinstrelHtWifiManager::GetLowestIndex(MinstrelHtWifiRemoteStation* station, std::size_t groupId)
-{
-    NS_LOG_FUNCTION(this << station << groupId);
-
-    uint8_t rateId = 0;
-    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
-    {
-        rateId++;
-    }
-    NS_ASSERT(station->m_groupsTable[groupId].m_supported &&
-              station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
-    return GetIndex(groupId, rateId);
-}
-
 WifiModeList
 MinstrelHtWifiManager::GetDeviceMcsList(WifiModulationClass mc) const
 {
@@ -112,13 +112,8 @@ struct MinstrelHtRateInfo
     uint32_t numRateSuccess;     //!< Number of successful frames transmitted so far.
     double prob; //!< Current probability within last time interval. (# frame success )/(# total
                  //!< frames)
-    bool retryUpdated; //!< If number of retries was updated already.
-    /**
-     * Exponential weighted moving average of probability.
-     * EWMA calculation:
-     * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
-     */
-    double ewmaProb;
+    bool retryUpdated;           //!< If number of retries was updated already.
+    uint16_t statsId;            //!< Position of this rate in the statistics of the station.
     double ewmsdProb;            //!< Exponential weighted moving standard deviation of probability.
     uint32_t prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
     uint32_t prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
@@ -126,7 +121,6 @@ struct MinstrelHtRateInfo
                                  //!< no attempts have been made.
     uint64_t successHist;        //!< Aggregate of all transmission successes.
     uint64_t attemptHist;        //!< Aggregate of all transmission attempts.
-    double throughput;           //!< Throughput of this rate (in packets per second).
 };
 
 /**
@@ -135,6 +129,26 @@ struct MinstrelHtRateInfo
  */
 typedef std::vector<MinstrelHtRateInfo> MinstrelHtRate;
 
+/**
+ * The statistics of the rates supported by a station that are needed to select the best
+ * rates at every update interval. They are stored as a structure of arrays, the n-th element
+ * of each array referring to the n-th supported rate in increasing order of global index
+ * (hence, the rates of a group are contiguous), so that the throughputs can be computed and
+ * the rates ranked by linear scans of contiguous memory.
+ */
+struct MinstrelHtRateStats
+{
+    std::vector<uint16_t> index; //!< Global index of the rate.
+    std::vector<double> txTime;  //!< Perfect transmission time of the rate (seconds).
+    /**
+     * Exponential weighted moving average of probability.
+     * EWMA calculation:
+     * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
+     */
+    std::vector<double> ewmaProb;
+    std::vector<double> throughput; //!< Throughput of the rate (in packets per second).
+};
+
 /**
  * A struct to contain information of a group.
  */
@@ -149,6 +163,8 @@ struct GroupInfo
     uint16_t m_maxTpRate;        //!< The max throughput rate of this group in bps.
     uint16_t m_maxTpRate2;       //!< The second max throughput rate of this group in bps.
     uint16_t m_maxProbRate;      //!< The highest success probability rate of this group in bps.
+    uint16_t m_statsBegin;       //!< Position of the first rate of this group in the statistics.
+    uint16_t m_statsEnd;         //!< Position past the last rate of this group in the statistics.
     MinstrelHtRate m_ratesTable; //!< Information about rates of this group.
 };
 
@@ -428,20 +444,21 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
                                double ewmaProb);
 
     /**
-     * Set index rate as maxTpRate or maxTp2Rate if is better than current values.
+     * Compute the throughput of all the rates supported by the station from their EWMA
+     * probability.
      *
      * @param station the Minstrel-HT wifi remote station
-     * @param index the index
      */
-    void SetBestStationThRates(MinstrelHtWifiRemoteStation* station, uint16_t index);
+    void UpdateThroughputs(MinstrelHtWifiRemoteStation* station);
 
     /**
-     * Set index rate as maxProbRate if it is better than current value.
+     * Set the maxTpRate, maxTp2Rate and maxProbRate of the station and of each of its
+     * supported groups. If multiple rates provide equal throughput, the one with the
+     * highest success probability is preferred.
      *
      * @param station the Minstrel-HT wifi remote station
-     * @param index the index
      */
-    void SetBestProbabilityRate(MinstrelHtWifiRemoteStation* station, uint16_t index);
+    void SetBestRates(MinstrelHtWifiRemoteStation* station);
 
     /**
      * Calculate the number of retransmissions to set for the index rate.
@@ -658,23 +675,6 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
                                   Time guardInterval,
                                   MHz_u chWidth);
 
-    /**
-     * Returns the lowest global index of the rates supported by the station.
-     *
-     * @param station the Minstrel-HT wifi remote station
-     * @returns the lowest global index
-     */
-    uint16_t GetLowestIndex(MinstrelHtWifiRemoteStation* station);
-
-    /**
-     * Returns the lowest global index of the rates supported by in the group.
-     *
-     * @param station the Minstrel-HT wifi remote station
-     * @param groupId the group ID
-     * @returns the lowest global index
-     */
-    uint16_t GetLowestIndex(MinstrelHtWifiRemoteStation* station, std::size_t groupId);
-
     /**
      * Returns a list of only the MCS supported by the device for a given modulation class.
      * @param mc the modulation class
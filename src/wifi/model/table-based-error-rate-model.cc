@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -32,6 +34,83 @@ NS_OBJECT_ENSURE_REGISTERED(TableBasedErrorRateModel);
 
 NS_LOG_COMPONENT_DEFINE("TableBasedErrorRateModel");
 
+/// The PERs of a table at every SNR multiple of the SNR precision between its lowest and
+/// highest SNR
+struct DensePerTable
+{
+    int64_t firstIndex;       //!< the lowest SNR of the table divided by the SNR precision
+    std::vector<double> pers; //!< the PERs, starting at the lowest SNR of the table
+};
+
+/// The dense PER tables shared by all the instances, indexed by table
+static std::map<const SnrPerTable*, DensePerTable> g_densePerTables;
+
+/**
+ * Get the PER of a table for a given SNR that is within the range of the table,
+ * interpolating linearly between the two closest entries if needed.
+ *
+ * @param table the table
+ * @param roundedSnr the SNR, rounded to the SNR precision
+ * @return the PER
+ */
+static double
+InterpolatePer(const SnrPerTable& table, dB_u roundedSnr)
+{
+    auto itTable = std::find_if(table.cbegin(), table.cend(), [&roundedSnr](const auto& element) {
+        return element.first == roundedSnr;
+    });
+    if (itTable != table.cend())
+    {
+        return itTable->second;
+    }
+    double a = 0.0;
+    double b = 0.0;
+    dB_u previousSnr{0.0};
+    dB_u nextSnr{0.0};
+    for (auto i = table.cbegin(); i != table.cend(); ++i)
+    {
+        if (i->first < roundedSnr)
+        {
+            previousSnr = i->first;
+            a = i->second;
+        }
+        else
+        {
+            nextSnr = i->first;
+            b = i->second;
+            break;
+        }
+    }
+    return a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
+}
+
+/**
+ * Get the dense version of a table, which holds the PER obtained by interpolating
+ * the table at every SNR multiple of the SNR precision, building it on first use.
+ *
+ * @param table the table
+ * @return the dense version of the table
+ */
+static const DensePerTable&
+GetDensePerTable(const SnrPerTable& table)
+{
+    auto it = g_densePerTables.find(&table);
+    if (it != g_densePerTables.end())
+    {
+        return it->second;
+    }
+    const auto multiplier = std::round(std::pow(10.0, SNR_PRECISION));
+    const auto first = std::llround(table.cbegin()->first * multiplier);
+    const auto last = std::llround((--table.cend())->first * multiplier);
+    DensePerTable dense{first, {}};
+    dense.pers.reserve(last - first + 1);
+    for (auto i = first; i <= last; i++)
+    {
+        dense.pers.push_back(InterpolatePer(table, dB_u{i / multiplier}));
+    }
+    return g_densePerTables.emplace(&table, std::move(dense)).first->second;
+}
+
 TypeId
 TableBasedErrorRateModel::GetTypeId()
 {
@@ -177,50 +256,21 @@ TableBasedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
 
     auto errorTable = (ldpc ? AwgnErrorTableLdpc1458
                             : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
-    const auto& itVector = errorTable[mcs];
-    auto itTable =
-        std::find_if(itVector.cbegin(), itVector.cend(), [&roundedSnr](const auto& element) {
-            return element.first == roundedSnr;
-        });
-    const auto minSnr = itVector.cbegin()->first;
-    const auto maxSnr = (--itVector.cend())->first;
+    const auto& dense = GetDensePerTable(errorTable[mcs]);
+    const auto index =
+        std::llround(roundedSnr * std::round(std::pow(10.0, SNR_PRECISION))) - dense.firstIndex;
     double per;
-    if (itTable == itVector.cend())
+    if (index < 0)
     {
-        if (roundedSnr < minSnr)
-        {
-            per = 1.0;
-        }
-        else if (roundedSnr > maxSnr)
-        {
-            per = 0.0;
-        }
-        else
-        {
-            double a = 0.0;
-            double b = 0.0;
-            dB_u previousSnr{0.0};
-            dB_u nextSnr{0.0};
-            for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
-            {
-                if (i->first < roundedSnr)
-                {
-                    previousSnr = i->first;
-                    a = i->second;
-                }
-                else
-                {
-                    nextSnr = i->first;
-                    b = i->second;
-                    break;
-                }
-            }
-            per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
-        }
+        per = 1.0;
+    }
+    else if (static_cast<std::size_t>(index) >= dense.pers.size())
+    {
+        per = 0.0;
     }
     else
     {
-        per = itTable->second;
+        per = dense.pers[index];
     }
 
     uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
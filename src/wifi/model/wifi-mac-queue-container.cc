@@ -14,7 +14,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
+#include <iterator>
 
 namespace ns3
 {
@@ -24,22 +24,21 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& info = m_queues[queueId];
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == info.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    info.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    return info.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -50,13 +49,18 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    auto& info = it->second;
+    NS_ASSERT(info.nBytes >= pos->mpdu->GetSize());
+    info.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    auto ret = info.queue.erase(pos);
+    if (info.queue.empty())
+    {
+        info.sortedByExpiryTime = true;
+    }
+    return ret;
 }
 
 Ptr<WifiMpdu>
@@ -65,6 +69,27 @@ WifiMacQueueContainer::GetItem(const const_iterator it) const
     return it->mpdu;
 }
 
+void
+WifiMacQueueContainer::SetExpiryTime(iterator it, Time expiryTime) const
+{
+    it->expiryTime = expiryTime;
+
+    if (it->expired)
+    {
+        return;
+    }
+
+    auto queueIt = m_queues.find(GetQueueId(it->mpdu));
+    NS_ASSERT(queueIt != m_queues.end());
+    auto& info = queueIt->second;
+    if (info.sortedByExpiryTime &&
+        ((it != info.queue.begin() && std::prev(it)->expiryTime > expiryTime) ||
+         (std::next(it) != info.queue.end() && std::next(it)->expiryTime < expiryTime)))
+    {
+        info.sortedByExpiryTime = false;
+    }
+}
+
 WifiContainerQueueId
 WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 {
@@ -106,17 +131,17 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return m_queues[queueId].queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (auto it = m_queues.find(queueId); it != m_queues.end())
     {
-        return 0;
+        return it->second.nBytes;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return 0;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
@@ -126,12 +151,20 @@ WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId)
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& info) const
 {
+    auto& queue = info.queue;
+    Time now = Simulator::Now();
+
+    if (info.sortedByExpiryTime && (queue.empty() || queue.front().expiryTime > now))
+    {
+        // no MPDU has expired (including the inflight MPDUs at the head of the queue)
+        return {queue.end(), queue.end()};
+    }
+
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
-    Time now = Simulator::Now();
 
     do
     {
@@ -157,11 +190,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(info.nBytes >= lastExpiredIt->mpdu->GetSize());
+            info.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -177,6 +207,10 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
 
     } while (true);
 
+    if (queue.empty())
+    {
+        info.sortedByExpiryTime = true;
+    }
     return *ret;
 }
 
@@ -215,16 +249,21 @@ std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
     auto [type, addrType, address, tid] = queueId;
-    const std::size_t size = tid.has_value() ? 8 : 7;
 
-    std::vector<uint8_t> buffer(size);
-    buffer[0] = type;
-    address.CopyTo(&buffer[1]);
+    // pack all the fields in a 64-bit integer, which is hashed without allocating memory
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (const auto byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    key |= static_cast<uint64_t>(type) << 48;
+    key |= static_cast<uint64_t>(addrType) << 52;
     if (tid.has_value())
     {
-        buffer[7] = *tid;
+        key |= (static_cast<uint64_t>(*tid) | 0x100) << 54;
     }
 
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(key);
 }
@@ -115,12 +115,15 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * The nodes of the container queues are recycled by a WifiMacQueueElemAllocator,
+ * so that inserting and erasing elements does not allocate memory in steady state.
  */
 class WifiMacQueueContainer
 {
   public:
     /// Type of a queue held by the container
-    using ContainerQueue = std::list<WifiMacQueueElem>;
+    using ContainerQueue =
+        std::list<WifiMacQueueElem, WifiMacQueueElemAllocator<WifiMacQueueElem>>;
     /// iterator over elements in a container queue
     using iterator = ContainerQueue::iterator;
     /// const iterator over elements in a container queue
@@ -156,6 +159,21 @@ class WifiMacQueueContainer
      */
     Ptr<WifiMpdu> GetItem(const const_iterator it) const;
 
+    /**
+     * Set the expiry time of the element pointed to by the given iterator.
+     *
+     * The container keeps track of whether the elements of each container queue are
+     * sorted by increasing expiry time, which is the case if MPDUs are enqueued at the
+     * tail of the container queues with the same lifetime. In such a case, looking for
+     * MPDUs with expired lifetime in a container queue whose first MPDU has not expired
+     * takes constant time. Setting the expiryTime field directly, instead of calling this
+     * method, does not update such information.
+     *
+     * @param it the given iterator
+     * @param expiryTime the expiry time
+     */
+    void SetExpiryTime(iterator it, Time expiryTime) const;
+
     /**
      * Return the QueueId identifying the container queue in which the given MPDU is
      * (or is to be) enqueued. Note that the given MPDU must not contain a control frame.
@@ -211,21 +229,27 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// Information stored for each container queue
+    struct QueueInfo
+    {
+        ContainerQueue queue;           //!< the container queue
+        uint32_t nBytes{0};             //!< size in bytes of the container queue
+        bool sortedByExpiryTime{true}; //!< whether the MPDUs are sorted by expiry time
+    };
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * @param queue the given container queue
+     * @param info the information about the given container queue
      * @return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& info) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
 };
 
 } // namespace ns3
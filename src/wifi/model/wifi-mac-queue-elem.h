@@ -14,7 +14,9 @@
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <cstddef>
 #include <map>
+#include <new>
 
 namespace ns3
 {
@@ -55,6 +57,118 @@ struct WifiMacQueueElem
     ~WifiMacQueueElem();
 };
 
+/**
+ * @ingroup wifi
+ * Allocator of the nodes of the container queues of WifiMacQueueContainer.
+ *
+ * The memory of the nodes released by a container queue is not returned to the
+ * heap but kept in a free list (threaded through the released nodes themselves),
+ * from which the nodes allocated afterwards are taken. Hence, once the queues
+ * have reached their steady-state size, enqueuing and dequeuing MPDUs does not
+ * allocate memory for the nodes. The allocator is stateless, thus all of its
+ * instances compare equal and nodes can be spliced from a container queue to
+ * another one.
+ */
+template <class T>
+class WifiMacQueueElemAllocator
+{
+  public:
+    using value_type = T; ///< type of the allocated objects
+
+    WifiMacQueueElemAllocator() = default;
+
+    /**
+     * Converting constructor.
+     */
+    template <class U>
+    WifiMacQueueElemAllocator(const WifiMacQueueElemAllocator<U>&) noexcept
+    {
+    }
+
+    /**
+     * @param n the number of objects to allocate storage for
+     * @return a pointer to the allocated storage
+     */
+    T* allocate(std::size_t n)
+    {
+        if (n == 1 && m_freeList.head)
+        {
+            auto node = m_freeList.head;
+            m_freeList.head = node->next;
+            return reinterpret_cast<T*>(node);
+        }
+        return static_cast<T*>(::operator new(n * sizeof(Storage)));
+    }
+
+    /**
+     * @param p a pointer to the storage to release
+     * @param n the number of objects the storage was allocated for
+     */
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (n == 1 && !m_freeListDestroyed)
+        {
+            auto node = reinterpret_cast<FreeNode*>(p);
+            node->next = m_freeList.head;
+            m_freeList.head = node;
+            return;
+        }
+        ::operator delete(p);
+    }
+
+  private:
+    /// Released node, which stores the pointer to the next released node
+    struct FreeNode
+    {
+        FreeNode* next; //!< next released node
+    };
+
+    /// Storage large enough and suitably aligned for an object or a released node
+    union Storage {
+        alignas(T) std::byte object[sizeof(T)]; //!< storage for an object
+        FreeNode node;                          //!< storage for a released node
+    };
+
+    /// List of released nodes, whose memory is returned to the heap at exit
+    struct FreeList
+    {
+        FreeNode* head{nullptr}; //!< first released node
+
+        ~FreeList()
+        {
+            while (head)
+            {
+                auto node = head;
+                head = head->next;
+                ::operator delete(node);
+            }
+            // nodes released afterwards (e.g., by static objects) go back to the heap
+            m_freeListDestroyed = true;
+        }
+    };
+
+    static inline FreeList m_freeList;              //!< released nodes
+    static inline bool m_freeListDestroyed{false}; //!< whether the free list has been destroyed
+};
+
+/// Two allocators compare equal, since they are stateless
+/// @return true
+template <class T, class U>
+bool
+operator==(const WifiMacQueueElemAllocator<T>&, const WifiMacQueueElemAllocator<U>&)
+{
+    return true;
+}
+
+/// Two allocators compare equal, since they are stateless
+/// @return false
+template <class T, class U>
+bool
+operator!=(const WifiMacQueueElemAllocator<T>&, const WifiMacQueueElemAllocator<U>&)
+{
+    return false;
+}
+
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_ELEM_H */
@@ -55,6 +55,10 @@ WifiMacQueue::WifiMacQueue(AcIndex ac)
     : m_ac(ac),
       NS_LOG_TEMPLATE_DEFINE("WifiMacQueue")
 {
+    // the deleter resets the iterator stored by the MPDU. It is the same for all the
+    // elements of the queue, hence it is created once here rather than at each enqueue
+    WmqIteratorTag tag;
+    m_deleter = [tag](Ptr<WifiMpdu> mpdu) { mpdu->SetQueueIt(std::nullopt, tag); };
 }
 
 WifiMacQueue::~WifiMacQueue()
@@ -274,7 +278,8 @@ WifiMacQueue::DequeueIfQueued(const std::list<Ptr<const WifiMpdu>>& mpdus)
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<ConstIterator> iterators;
+    std::vector<ConstIterator> iterators;
+    iterators.reserve(mpdus.size());
 
     for (const auto& mpdu : mpdus)
     {
@@ -433,7 +438,7 @@ WifiMacQueue::Replace(Ptr<const WifiMpdu> currentItem, Ptr<WifiMpdu> newItem)
     auto pos = std::next(currentIt);
     DoDequeue({currentIt});
     bool ret = Insert(pos, newItem);
-    GetIt(newItem)->expiryTime = expiryTime;
+    GetContainer().SetExpiryTime(GetIt(newItem), expiryTime);
     // The size of a WifiMacQueue is measured as number of packets. We dequeued
     // one packet, so there is certainly room for inserting one packet
     NS_ABORT_IF(!ret);
@@ -489,9 +494,10 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
         // set item's information about its position in the queue
         item->SetQueueIt(ret, {});
         ret->ac = m_ac;
-        ret->expiryTime = item->GetHeader().IsCtl() ? Time::Max() : Simulator::Now() + m_maxDelay;
-        WmqIteratorTag tag;
-        ret->deleter = [tag](auto mpdu) { mpdu->SetQueueIt(std::nullopt, tag); };
+        GetContainer().SetExpiryTime(ret,
+                                     item->GetHeader().IsCtl() ? Time::Max()
+                                                               : Simulator::Now() + m_maxDelay);
+        ret->deleter = m_deleter;
 
         m_scheduler->NotifyEnqueue(m_ac, item);
         return true;
@@ -501,7 +507,7 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
 }
 
 void
-WifiMacQueue::DoDequeue(const std::list<ConstIterator>& iterators)
+WifiMacQueue::DoDequeue(const std::vector<ConstIterator>& iterators)
 {
     NS_LOG_FUNCTION(this);
 
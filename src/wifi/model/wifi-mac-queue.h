@@ -21,6 +21,7 @@
 #include <functional>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -323,9 +324,9 @@ class WifiMacQueue : public Queue<WifiMpdu, ns3::WifiMacQueueContainer>
      * resets the iterator field of the dequeued items and notifies the scheduler, if
      * any item was dequeued.
      *
-     * @param iterators the list of iterators pointing to the items to dequeue
+     * @param iterators the iterators pointing to the items to dequeue
      */
-    void DoDequeue(const std::list<ConstIterator>& iterators);
+    void DoDequeue(const std::vector<ConstIterator>& iterators);
     /**
      * Wrapper for the DoRemove method provided by the base class that additionally
      * resets the iterator field of the item and notifies the scheduleer, if an
@@ -339,6 +340,7 @@ class WifiMacQueue : public Queue<WifiMpdu, ns3::WifiMacQueueContainer>
     Time m_maxDelay;                        //!< Time to live for packets in the queue
     AcIndex m_ac;                           //!< the access category
     Ptr<WifiMacQueueScheduler> m_scheduler; //!< the MAC queue scheduler
+    Callback<void, Ptr<WifiMpdu>> m_deleter; //!< shared by all the elements of this queue
 
     /// Traced callback: fired when a packet is dropped due to lifetime expiration
     TracedCallback<Ptr<const WifiMpdu>> m_traceExpired;
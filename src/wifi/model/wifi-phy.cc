@@ -23,6 +23,7 @@
 #include "ns3/channel.h"
 #include "ns3/dsss-phy.h"
 #include "ns3/eht-phy.h" //also includes OFDM, HT, VHT and HE
+#include "ns3/enum.h"
 #include "ns3/erp-ofdm-phy.h"
 #include "ns3/error-model.h"
 #include "ns3/ht-configuration.h"
@@ -36,6 +37,9 @@
 
 #include <algorithm>
 #include <numeric>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                      \
@@ -49,6 +53,175 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("WifiPhy");
 
+/// The parameters determining the duration of a non-MU PPDU
+struct TxDurationId
+{
+    bool payload;          ///< whether the duration includes the payload
+    uint32_t size;         ///< the PSDU size in bytes
+    uint16_t staId;        ///< the STA-ID
+    WifiPhyBand band;      ///< the band
+    WifiPreamble preamble; ///< the preamble type
+    uint32_t mode;         ///< the UID of the mode
+    MHz_u channelWidth;    ///< the channel width
+    int64_t guardInterval; ///< the guard interval, in time steps
+    uint8_t nTx;           ///< the number of TX antennas
+    uint8_t nss;           ///< the number of spatial streams
+    uint8_t ness;          ///< the number of extension spatial streams
+    bool aggregation;      ///< whether the PSDU is an A-MPDU
+    bool stbc;             ///< whether STBC is used
+    bool ldpc;             ///< whether LDPC is used
+};
+
+/**
+ * Equality operator
+ * @param lhs the left hand side PPDU parameters to compare
+ * @param rhs the right hand side PPDU parameters to compare
+ * @returns true if the PPDU parameters are equal
+ */
+bool
+operator==(const TxDurationId& lhs, const TxDurationId& rhs)
+{
+    return std::tie(lhs.payload,
+                    lhs.size,
+                    lhs.staId,
+                    lhs.band,
+                    lhs.preamble,
+                    lhs.mode,
+                    lhs.channelWidth,
+                    lhs.guardInterval,
+                    lhs.nTx,
+                    lhs.nss,
+                    lhs.ness,
+                    lhs.aggregation,
+                    lhs.stbc,
+                    lhs.ldpc) == std::tie(rhs.payload,
+                                          rhs.size,
+                                          rhs.staId,
+                                          rhs.band,
+                                          rhs.preamble,
+                                          rhs.mode,
+                                          rhs.channelWidth,
+                                          rhs.guardInterval,
+                                          rhs.nTx,
+                                          rhs.nss,
+                                          rhs.ness,
+                                          rhs.aggregation,
+                                          rhs.stbc,
+                                          rhs.ldpc);
+}
+
+/// Hash function for the PPDU parameters
+struct TxDurationIdHash
+{
+    /**
+     * @param id the PPDU parameters
+     * @return the hash of the PPDU parameters
+     */
+    std::size_t operator()(const TxDurationId& id) const
+    {
+        std::size_t seed = std::hash<double>{}(id.channelWidth);
+        for (uint64_t value : {(static_cast<uint64_t>(id.size) << 16) | id.staId,
+                               static_cast<uint64_t>(id.guardInterval),
+                               (static_cast<uint64_t>(id.mode) << 32) |
+                                   (static_cast<uint64_t>(id.preamble) << 16) |
+                                   (static_cast<uint64_t>(id.band) << 8) | id.nTx,
+                               (static_cast<uint64_t>(id.nss) << 32) |
+                                   (static_cast<uint64_t>(id.ness) << 24) | (id.payload << 3) |
+                                   (id.aggregation << 2) | (id.stbc << 1) |
+                                   static_cast<uint64_t>(id.ldpc)})
+        {
+            seed ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+/// The cache of the PPDU durations
+struct TxDurationCache
+{
+    std::unordered_map<TxDurationId, Time, TxDurationIdHash>
+        durations;                       ///< the PPDU durations, by PPDU parameters
+    std::size_t capacity{4096};          ///< the maximum number of PPDU durations
+    WifiPhy::TxDurationCacheStats stats; ///< the statistics of the cache
+};
+
+static TxDurationCache g_txDurationCache; ///< the cache of the PPDU durations
+
+/**
+ * Get the parameters determining the duration of a PPDU, if it can be cached.
+ * The duration of MU PPDUs (and of EHT SU PPDUs, which use the EHT MU format)
+ * also depends on the RU allocation and on the per-user information, hence
+ * they are not cached.
+ *
+ * @param payload whether the duration includes the payload
+ * @param size the PSDU size in bytes
+ * @param txVector the TXVECTOR of the PPDU
+ * @param band the band
+ * @param staId the STA-ID
+ * @return the parameters of the PPDU, if its duration can be cached
+ */
+static std::optional<TxDurationId>
+GetTxDurationId(bool payload,
+                uint32_t size,
+                const WifiTxVector& txVector,
+                WifiPhyBand band,
+                uint16_t staId)
+{
+    const auto preamble = txVector.GetPreambleType();
+    if (g_txDurationCache.capacity == 0 || IsDlMu(preamble) || IsUlMu(preamble))
+    {
+        return std::nullopt;
+    }
+    return TxDurationId{payload,
+                        size,
+                        staId,
+                        band,
+                        preamble,
+                        txVector.GetMode().GetUid(),
+                        txVector.GetChannelWidth(),
+                        txVector.GetGuardInterval().GetTimeStep(),
+                        txVector.GetNTx(),
+                        txVector.GetNss(),
+                        txVector.GetNess(),
+                        txVector.IsAggregation(),
+                        txVector.IsStbc(),
+                        txVector.IsLdpc()};
+}
+
+/**
+ * Get the duration of a PPDU from the cache, or compute it and store it in the
+ * cache if it is not found.
+ *
+ * @tparam F the type of the function computing the duration
+ * @param id the parameters of the PPDU, if its duration can be cached
+ * @param compute the function computing the duration
+ * @return the duration of the PPDU
+ */
+template <typename F>
+static Time
+GetCachedTxDuration(const std::optional<TxDurationId>& id, F&& compute)
+{
+    if (!id)
+    {
+        return compute();
+    }
+    if (const auto it = g_txDurationCache.durations.find(*id);
+        it != g_txDurationCache.durations.cend())
+    {
+        ++g_txDurationCache.stats.hits;
+        return it->second;
+    }
+    ++g_txDurationCache.stats.misses;
+    if (g_txDurationCache.durations.size() >= g_txDurationCache.capacity)
+    {
+        // the cache is full, start over
+        g_txDurationCache.durations.clear();
+    }
+    const auto duration = compute();
+    g_txDurationCache.durations.emplace(*id, duration);
+    return duration;
+}
+
 /****************************************************************
  *       The actual WifiPhy class
  ****************************************************************/
@@ -292,6 +465,21 @@ WifiPhy::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&WifiPhy::m_notifyRxMacHeaderEnd),
                           MakeBooleanChecker())
+            .AddAttribute(
+                "RxAbstraction",
+                "The level of abstraction of the reception of the PHY payload. With Full, the "
+                "reception status of every MPDU is determined at its own end from the SNR "
+                "changes during the MPDU. With Ppdu, the reception status of all the MPDUs is "
+                "determined at the end of the PPDU from the effective SNR of the payload, which "
+                "saves one event and one SNR computation per MPDU. Full is used anyway for HE "
+                "TB PPDUs and if NotifyMacHdrRxEnd is true.",
+                EnumValue(WifiPhy::RX_ABSTRACTION_FULL),
+                MakeEnumAccessor<RxAbstraction>(&WifiPhy::SetRxAbstraction,
+                                                &WifiPhy::GetRxAbstraction),
+                MakeEnumChecker(WifiPhy::RX_ABSTRACTION_FULL,
+                                "Full",
+                                WifiPhy::RX_ABSTRACTION_PPDU,
+                                "Ppdu"))
             .AddTraceSource(
                 "PhyTxBegin",
                 "Trace source indicating a packet has begun transmitting over the medium; "
@@ -404,7 +592,8 @@ WifiPhy::WifiPhy()
       m_txSpatialStreams(1),
       m_rxSpatialStreams(1),
       m_wifiRadioEnergyModel(nullptr),
-      m_timeLastPreambleDetected()
+      m_timeLastPreambleDetected(),
+      m_rxAbstraction(RX_ABSTRACTION_FULL)
 {
     NS_LOG_FUNCTION(this);
     m_random = CreateObject<UniformRandomVariable>();
@@ -707,6 +896,19 @@ WifiPhy::SetPostReceptionErrorModel(const Ptr<ErrorModel> em)
     m_postReceptionErrorModel = em;
 }
 
+void
+WifiPhy::SetRxAbstraction(RxAbstraction rxAbstraction)
+{
+    NS_LOG_FUNCTION(this << rxAbstraction);
+    m_rxAbstraction = rxAbstraction;
+}
+
+WifiPhy::RxAbstraction
+WifiPhy::GetRxAbstraction() const
+{
+    return m_rxAbstraction;
+}
+
 void
 WifiPhy::SetFrameCaptureModel(const Ptr<FrameCaptureModel> model)
 {
@@ -1560,8 +1762,12 @@ WifiPhy::GetPayloadDuration(uint32_t size,
 Time
 WifiPhy::CalculatePhyPreambleAndHeaderDuration(const WifiTxVector& txVector)
 {
-    return GetStaticPhyEntity(txVector.GetModulationClass())
-        ->CalculatePhyPreambleAndHeaderDuration(txVector);
+    return GetCachedTxDuration(
+        GetTxDurationId(false, 0, txVector, WIFI_PHY_BAND_UNSPECIFIED, SU_STA_ID),
+        [&txVector]() {
+            return GetStaticPhyEntity(txVector.GetModulationClass())
+                ->CalculatePhyPreambleAndHeaderDuration(txVector);
+        });
 }
 
 Time
@@ -1570,11 +1776,13 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
-    NS_ASSERT(txVector.IsValid(band));
-    Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
-                    GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
-    NS_ASSERT(duration.IsStrictlyPositive());
-    return duration;
+    return GetCachedTxDuration(GetTxDurationId(true, size, txVector, band, staId), [&]() {
+        NS_ASSERT(txVector.IsValid(band));
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    });
 }
 
 Time
@@ -1595,6 +1803,28 @@ WifiPhy::CalculateTxDuration(const WifiConstPsduMap& psduMap,
         ->CalculateTxDuration(psduMap, txVector, band);
 }
 
+void
+WifiPhy::SetTxDurationCacheCapacity(std::size_t capacity)
+{
+    g_txDurationCache.capacity = capacity;
+    g_txDurationCache.durations.clear();
+}
+
+WifiPhy::TxDurationCacheStats
+WifiPhy::GetTxDurationCacheStats()
+{
+    auto stats = g_txDurationCache.stats;
+    stats.size = g_txDurationCache.durations.size();
+    return stats;
+}
+
+void
+WifiPhy::ResetTxDurationCache()
+{
+    g_txDurationCache.durations.clear();
+    g_txDurationCache.stats = {};
+}
+
 uint32_t
 WifiPhy::GetMaxPsduSize(WifiModulationClass modulation)
 {
@@ -292,6 +292,33 @@ class WIFI_EXPORT WifiPhy : public Object
      * preamble and PHY header.
      */
     static Time CalculatePhyPreambleAndHeaderDuration(const WifiTxVector& txVector);
+
+    /// Statistics of the cache of the PPDU durations
+    struct TxDurationCacheStats
+    {
+        uint64_t hits{0};    //!< number of durations found in the cache
+        uint64_t misses{0};  //!< number of durations computed and added to the cache
+        std::size_t size{0}; //!< number of durations in the cache
+    };
+
+    /**
+     * Set the maximum number of durations memoized by CalculateTxDuration and
+     * CalculatePhyPreambleAndHeaderDuration. The cache is shared by all the PHYs,
+     * only holds the durations of non-MU PPDUs and is emptied when it is full.
+     * The cache is emptied by this function, and disabled if the capacity is 0.
+     * The default capacity is 4096.
+     *
+     * @param capacity the maximum number of durations in the cache
+     */
+    static void SetTxDurationCacheCapacity(std::size_t capacity);
+    /**
+     * @return the statistics of the cache of the PPDU durations
+     */
+    static TxDurationCacheStats GetTxDurationCacheStats();
+    /**
+     * Empty the cache of the PPDU durations and reset its statistics.
+     */
+    static void ResetTxDurationCache();
     /**
      * @return the preamble detection duration, which is the time correlation needs to detect the
      * start of an incoming frame.
@@ -1142,6 +1169,25 @@ class WIFI_EXPORT WifiPhy : public Object
      */
     void SetWifiRadioEnergyModel(const Ptr<WifiRadioEnergyModel> wifiRadioEnergyModel);
 
+    /// Level of abstraction of the reception of the PHY payload
+    enum RxAbstraction
+    {
+        RX_ABSTRACTION_FULL = 0, //!< every MPDU is received at its own end, with its own PER
+        RX_ABSTRACTION_PPDU      //!< all the MPDUs are received at the end of the PPDU, with
+                                 //!< PERs derived from the effective SNR of the payload
+    };
+
+    /**
+     * Set the level of abstraction of the reception of the PHY payload.
+     *
+     * @param rxAbstraction the level of abstraction
+     */
+    void SetRxAbstraction(RxAbstraction rxAbstraction);
+    /**
+     * @return the level of abstraction of the reception of the PHY payload
+     */
+    RxAbstraction GetRxAbstraction() const;
+
     /**
      * @return the channel width
      */
@@ -1694,6 +1740,7 @@ class WIFI_EXPORT WifiPhy : public Object
     Ptr<ErrorModel> m_postReceptionErrorModel;            //!< Error model for receive packet events
     Time m_timeLastPreambleDetected; //!< Record the time the last preamble was detected
     bool m_notifyRxMacHeaderEnd;     //!< whether the PHY is capable of notifying MAC header RX end
+    RxAbstraction m_rxAbstraction;   //!< level of abstraction of the payload reception
 
     Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
 };
@@ -31,6 +31,8 @@
 #include "ns3/uinteger.h"
 #include "ns3/vht-configuration.h"
 
+#include <bit>
+
 namespace ns3
 {
 
@@ -529,7 +531,7 @@ WifiRemoteStationManager::RecordAssocRefused(Mac48Address address)
 uint16_t
 WifiRemoteStationManager::GetAssociationId(Mac48Address remoteAddress) const
 {
-    std::shared_ptr<WifiRemoteStationState> state;
+    WifiRemoteStationState* state = nullptr;
     if (!remoteAddress.IsGroup() &&
         (state = LookupState(remoteAddress))->m_state == WifiRemoteStationState::GOT_ASSOC_TX_OK)
     {
@@ -580,10 +582,12 @@ WifiRemoteStationManager::SetPsMode(const Mac48Address& address, bool isInPsMode
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address);
-        stateIt != m_states.end() && stateIt->second->m_mleCommonInfo)
+    if (auto idIt = m_stationIds.find(address); idIt != m_stationIds.end())
     {
-        return stateIt->second->m_mleCommonInfo->m_mldMacAddress;
+        if (const auto state = GetState(idIt->second); state->m_mleCommonInfo)
+        {
+            return state->m_mleCommonInfo->m_mldMacAddress;
+        }
     }
 
     return std::nullopt;
@@ -592,16 +596,33 @@ WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetAffiliatedStaAddress(const Mac48Address& mldAddress) const
 {
-    auto stateIt = m_states.find(mldAddress);
+    auto idIt = m_stationIds.find(mldAddress);
 
-    if (stateIt == m_states.end() || !stateIt->second->m_mleCommonInfo)
+    if (idIt == m_stationIds.end() || !GetState(idIt->second)->m_mleCommonInfo)
     {
         // MLD address not found
         return std::nullopt;
     }
 
-    NS_ASSERT(stateIt->second->m_mleCommonInfo->m_mldMacAddress == mldAddress);
-    return stateIt->second->m_address;
+    const auto state = GetState(idIt->second);
+    NS_ASSERT(state->m_mleCommonInfo->m_mldMacAddress == mldAddress);
+    return state->m_address;
+}
+
+std::optional<uint32_t>
+WifiRemoteStationManager::GetStationId(const Mac48Address& address) const
+{
+    if (auto idIt = m_stationIds.find(address); idIt != m_stationIds.end())
+    {
+        return idIt->second;
+    }
+    return std::nullopt;
+}
+
+uint32_t
+WifiRemoteStationManager::GetNStations() const
+{
+    return static_cast<uint32_t>(m_stations.size());
 }
 
 WifiTxVector
@@ -1483,17 +1504,37 @@ WifiRemoteStationManager::GetMostRecentRssi(Mac48Address address) const
     return std::nullopt;
 }
 
-std::shared_ptr<WifiRemoteStationState>
+WifiRemoteStationState*
+WifiRemoteStationManager::GetState(uint32_t id) const
+{
+    // slab i holds the states of the stations having an ID in [2^i - 1, 2^(i+1) - 1)
+    const auto slab = std::bit_width(id + 1) - 1;
+    NS_ASSERT(static_cast<std::size_t>(slab) < m_states.size());
+    return const_cast<WifiRemoteStationState*>(&m_states[slab][id + 1 - (1U << slab)]);
+}
+
+WifiRemoteStationState*
 WifiRemoteStationManager::LookupState(Mac48Address address) const
 {
-    if (const auto stateIt = m_states.find(address); stateIt != m_states.cend())
+    if (const auto idIt = m_stationIds.find(address); idIt != m_stationIds.cend())
     {
-        return stateIt->second;
+        return GetState(idIt->second);
     }
 
-    auto state = std::make_shared<WifiRemoteStationState>();
+    auto manager = const_cast<WifiRemoteStationManager*>(this);
+    const auto id = static_cast<uint32_t>(manager->m_stations.size());
+    if (m_states.empty() || m_states.back().size() == m_states.back().capacity())
+    {
+        // the current slab is full, allocate a new one twice as large
+        manager->m_states.emplace_back().reserve(std::size_t{1} << m_states.size());
+    }
+    auto state = &manager->m_states.back().emplace_back();
+    manager->m_stations.push_back(nullptr);
+    manager->m_stationIds.emplace(address, id);
+
     state->m_state = WifiRemoteStationState::BRAND_NEW;
     state->m_address = address;
+    state->m_id = id;
     state->m_aid = 0;
     state->m_operationalRateSet.push_back(GetDefaultMode());
     state->m_operationalMcsSet.push_back(GetDefaultMcs());
@@ -1516,7 +1557,6 @@ WifiRemoteStationManager::LookupState(Mac48Address address) const
     state->m_aggregation = false;
     state->m_qosSupported = false;
     state->m_isInPsMode = false;
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert({address, state});
     NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning new state");
     return state;
 }
@@ -1527,20 +1567,40 @@ WifiRemoteStationManager::Lookup(Mac48Address address) const
     NS_LOG_FUNCTION(this << address);
     NS_ASSERT(!address.IsGroup());
     NS_ASSERT(address != m_wifiMac->GetAddress());
-    auto stationIt = m_stations.find(address);
+    auto manager = const_cast<WifiRemoteStationManager*>(this);
+    auto state = LookupState(address);
+    // the given address may be the MLD address of the station, which has a distinct station
+    auto& station = (state->m_address == address) ? manager->m_stations[state->m_id]
+                                                   : manager->m_mldStations[address];
 
-    if (stationIt != m_stations.end())
+    if (station)
     {
-        return stationIt->second;
+        return station;
     }
 
-    WifiRemoteStation* station = DoCreateStation();
-    station->m_state = LookupState(address).get();
+    station = DoCreateStation();
+    station->m_state = state;
     station->m_rssiAndUpdateTimePair = std::make_pair(dBm_u{0}, Seconds(0));
-    const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
     return station;
 }
 
+template <class T>
+Ptr<const T>
+WifiRemoteStationManager::InternElement(const T& element)
+{
+    Buffer buffer;
+    buffer.AddAtEnd(element.GetSerializedSize());
+    element.Serialize(buffer.Begin());
+    std::string key(reinterpret_cast<const char*>(buffer.PeekData()), buffer.GetSize());
+
+    auto [it, inserted] = m_internedElements.try_emplace(std::move(key));
+    if (inserted)
+    {
+        it->second = Create<const T>(element);
+    }
+    return StaticCast<const T>(it->second);
+}
+
 void
 WifiRemoteStationManager::SetAssociationId(Mac48Address remoteAddress, uint16_t aid)
 {
@@ -1585,7 +1645,7 @@ WifiRemoteStationManager::AddStationHtCapabilities(Mac48Address from,
             AddSupportedMcs(from, mcs);
         }
     }
-    state->m_htCapabilities = Create<const HtCapabilities>(htCapabilities);
+    state->m_htCapabilities = InternElement(htCapabilities);
 }
 
 void
@@ -1607,7 +1667,7 @@ WifiRemoteStationManager::AddStationExtendedCapabilities(
 {
     NS_LOG_FUNCTION(this << from << extendedCapabilities);
     auto state = LookupState(from);
-    state->m_extendedCapabilities = Create<const ExtendedCapabilities>(extendedCapabilities);
+    state->m_extendedCapabilities = InternElement(extendedCapabilities);
 }
 
 void
@@ -1635,7 +1695,7 @@ WifiRemoteStationManager::AddStationVhtCapabilities(Mac48Address from,
             }
         }
     }
-    state->m_vhtCapabilities = Create<const VhtCapabilities>(vhtCapabilities);
+    state->m_vhtCapabilities = InternElement(vhtCapabilities);
 }
 
 void
@@ -1717,7 +1777,7 @@ WifiRemoteStationManager::AddStationHeCapabilities(Mac48Address from,
             AddSupportedMcs(from, mcs);
         }
     }
-    state->m_heCapabilities = Create<const HeCapabilities>(heCapabilities);
+    state->m_heCapabilities = InternElement(heCapabilities);
     SetQosSupport(from, true);
 }
 
@@ -1757,7 +1817,7 @@ WifiRemoteStationManager::AddStationHe6GhzCapabilities(
     // Used by all stations to record HE 6GHz band capabilities of remote stations
     NS_LOG_FUNCTION(this << from << he6GhzCapabilities);
     auto state = LookupState(from);
-    state->m_he6GhzBandCapabilities = Create<const He6GhzBandCapabilities>(he6GhzCapabilities);
+    state->m_he6GhzBandCapabilities = InternElement(he6GhzCapabilities);
     SetQosSupport(from, true);
 }
 
@@ -1829,10 +1889,11 @@ WifiRemoteStationManager::AddStationMleCommonInfo(
     NS_LOG_FUNCTION(this << from);
     auto state = LookupState(from);
     state->m_mleCommonInfo = mleCommonInfo;
-    // insert another entry in m_states indexed by the MLD address and pointing to the same state
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert_or_assign(
+    // map the MLD address to the ID of the station, so that the MLD address and the address of
+    // the station share the same state
+    const_cast<WifiRemoteStationManager*>(this)->m_stationIds.insert_or_assign(
         mleCommonInfo->m_mldMacAddress,
-        state);
+        state->m_id);
 }
 
 Ptr<const HtCapabilities>
@@ -1978,12 +2039,19 @@ void
 WifiRemoteStationManager::Reset()
 {
     NS_LOG_FUNCTION(this);
+    m_stationIds.clear();
     m_states.clear();
-    for (auto& state : m_stations)
+    for (auto station : m_stations)
     {
-        delete (state.second);
+        delete station;
     }
     m_stations.clear();
+    for (auto& [address, station] : m_mldStations)
+    {
+        delete station;
+    }
+    m_mldStations.clear();
+    m_internedElements.clear();
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
@@ -2521,9 +2589,9 @@ WifiRemoteStationManager::GetEmlsrSupported(const Mac48Address& address) const
 bool
 WifiRemoteStationManager::GetEmlsrEnabled(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address); stateIt != m_states.cend())
+    if (auto idIt = m_stationIds.find(address); idIt != m_stationIds.cend())
     {
-        return stateIt->second->m_emlsrEnabled;
+        return GetState(idIt->second)->m_emlsrEnabled;
     }
     return false;
 }
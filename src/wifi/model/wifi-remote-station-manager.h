@@ -34,7 +34,9 @@
 #include <list>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -103,6 +105,8 @@ struct WifiRemoteStationState
     WifiModeList m_operationalRateSet; //!< operational rate set
     WifiModeList m_operationalMcsSet;  //!< operational MCS set
     Mac48Address m_address;            //!< Mac48Address of the remote station
+    uint32_t m_id;                     /**< ID of the remote station, i.e., its index in the
+                                            station table of the manager */
     uint16_t m_aid;                    /**< AID of the remote station (unused if this object
                                             is installed on a non-AP station) */
     WifiRemoteStationInfo m_info;      //!< remote station info
@@ -160,16 +164,6 @@ class WifiRemoteStationManager : public Object
         CTS_TO_SELF
     };
 
-    /**
-     * A map of WifiRemoteStations with Mac48Address as key
-     */
-    using Stations = std::unordered_map<Mac48Address, WifiRemoteStation*, WifiAddressHash>;
-    /**
-     * A map of WifiRemoteStationStates with Mac48Address as key
-     */
-    using StationStates =
-        std::unordered_map<Mac48Address, std::shared_ptr<WifiRemoteStationState>, WifiAddressHash>;
-
     /**
      * Set up PHY associated with this device since it is the object that
      * knows the full set of transmit rates that are supported.
@@ -922,6 +916,23 @@ class WifiRemoteStationManager : public Object
      */
     std::optional<Mac48Address> GetAffiliatedStaAddress(const Mac48Address& mldAddress) const;
 
+    /**
+     * Get the ID of the given remote station, if the remote station is known. Station IDs are
+     * small integers assigned in increasing order (starting at 0) as remote stations become
+     * known and are not reused until this manager is reset, hence they can be used (e.g., by
+     * the MAC or by rate control algorithms) to index per-station information stored in arrays.
+     * The MLD address of a remote station has the same ID as the remote station.
+     *
+     * @param address the MAC address of the remote station
+     * @return the ID of the remote station, if the remote station is known
+     */
+    std::optional<uint32_t> GetStationId(const Mac48Address& address) const;
+
+    /**
+     * @return the number of remote stations known to this manager
+     */
+    uint32_t GetNStations() const;
+
     /**
      * @param header MAC header
      * @param allowedWidth the allowed width to send this packet
@@ -1560,7 +1571,25 @@ class WifiRemoteStationManager : public Object
      * @param address the address of the station
      * @return WifiRemoteStationState corresponding to the address
      */
-    std::shared_ptr<WifiRemoteStationState> LookupState(Mac48Address address) const;
+    WifiRemoteStationState* LookupState(Mac48Address address) const;
+    /**
+     * Return the state of the station having the given ID.
+     *
+     * @param id the ID of the station
+     * @return the state of the station having the given ID
+     */
+    WifiRemoteStationState* GetState(uint32_t id) const;
+    /**
+     * Return a pointer to the given information element that is shared with all the remote
+     * stations that advertised an identical information element. Information elements are
+     * considered identical if they are serialized the same way.
+     *
+     * @tparam T \deduced the type of the information element
+     * @param element the information element advertised by a remote station
+     * @return a pointer to an information element identical to the given one
+     */
+    template <class T>
+    Ptr<const T> InternElement(const T& element);
     /**
      * Return the station associated with the given address.
      *
@@ -1621,8 +1650,19 @@ class WifiRemoteStationManager : public Object
     WifiModeList m_bssBasicRateSet; //!< basic rate set
     WifiModeList m_bssBasicMcsSet;  //!< basic MCS set
 
-    StationStates m_states; //!< States of known stations
-    Stations m_stations;    //!< Information for each known stations
+    /// ID of every known remote station (an MLD address maps to the ID of the affiliated station)
+    std::unordered_map<Mac48Address, uint32_t, WifiAddressHash> m_stationIds;
+    /**
+     * States of the known remote stations, indexed by station ID. States are allocated in slabs
+     * of increasing size (slab i holds 2^i states) that are never resized, so that states are
+     * never moved and a few remote stations only take a few allocations.
+     */
+    std::vector<std::vector<WifiRemoteStationState>> m_states;
+    std::vector<WifiRemoteStation*> m_stations; //!< station (if created) of every known station
+    /// stations created for the MLD address of known stations
+    std::unordered_map<Mac48Address, WifiRemoteStation*, WifiAddressHash> m_mldStations;
+    /// information elements shared by remote stations, indexed by their serialization
+    std::unordered_map<std::string, Ptr<const WifiInformationElement>> m_internedElements;
 
     uint32_t m_maxSsrc;                //!< Maximum STA short retry count (SSRC)
     uint32_t m_maxSlrc;                //!< Maximum STA long retry count (SLRC)
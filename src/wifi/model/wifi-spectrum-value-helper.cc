@@ -25,6 +25,7 @@
 #include <numeric>
 #include <optional>
 #include <sstream>
+#include <tuple>
 
 namespace
 {
@@ -155,6 +156,129 @@ WifiSpectrumValueHelper::GetSpectrumModel(const std::vector<MHz_u>& centerFreque
     return ret;
 }
 
+/// The functions building transmit PSDs from a spectrum mask
+enum WifiPsdTemplateType : uint8_t
+{
+    WIFI_PSD_OFDM = 0,         //!< CreateOfdmTxPowerSpectralDensity
+    WIFI_PSD_DUPLICATED_20MHZ, //!< CreateDuplicated20MhzTxPowerSpectralDensity
+    WIFI_PSD_HT_OFDM,          //!< CreateHtOfdmTxPowerSpectralDensity
+    WIFI_PSD_HE_OFDM           //!< CreateHeOfdmTxPowerSpectralDensity
+};
+
+/// The parameters determining the shape of a transmit PSD, i.e. all but the transmit power
+struct WifiPsdTemplateId
+{
+    WifiPsdTemplateType type;               ///< the function building the PSD
+    std::vector<MHz_u> centerFrequencies;   ///< center frequency per segment
+    MHz_u channelWidth;                     ///< channel width
+    MHz_u guardBandwidth;                   ///< guard band width
+    dBr_u minInnerBand;                     ///< minimum relative power in the inner band
+    dBr_u minOuterBand;                     ///< minimum relative power in the outer band
+    dBr_u lowestPoint;                      ///< maximum relative power of the outermost subcarriers
+    std::vector<bool> puncturedSubchannels; ///< punctured 20 MHz subchannels
+};
+
+/**
+ * Less than operator
+ * @param lhs the left hand side PSD parameters to compare
+ * @param rhs the right hand side PSD parameters to compare
+ * @returns true if the left hand side PSD parameters are less than the right hand side ones
+ */
+bool
+operator<(const WifiPsdTemplateId& lhs, const WifiPsdTemplateId& rhs)
+{
+    return std::tie(lhs.type,
+                    lhs.centerFrequencies,
+                    lhs.channelWidth,
+                    lhs.guardBandwidth,
+                    lhs.minInnerBand,
+                    lhs.minOuterBand,
+                    lhs.lowestPoint,
+                    lhs.puncturedSubchannels) < std::tie(rhs.type,
+                                                         rhs.centerFrequencies,
+                                                         rhs.channelWidth,
+                                                         rhs.guardBandwidth,
+                                                         rhs.minInnerBand,
+                                                         rhs.minOuterBand,
+                                                         rhs.lowestPoint,
+                                                         rhs.puncturedSubchannels);
+}
+
+static std::map<WifiPsdTemplateId, Ptr<const SpectrumValue>>
+    g_wifiPsdTemplateMap; ///< transmit PSDs normalized to 1 W, by PSD parameters
+static bool g_wifiPsdTemplatesEnabled{true}; ///< whether the PSD templates are used
+static WifiSpectrumValueHelper::PsdTemplateStats
+    g_wifiPsdTemplateStats; ///< statistics of the PSD templates
+
+/**
+ * Get a transmit PSD from its template, if templates are enabled and the template exists.
+ *
+ * @param id the parameters of the PSD
+ * @param txPower the transmit power
+ * @return a copy of the template scaled to the transmit power, or a null pointer
+ */
+static Ptr<SpectrumValue>
+GetPsdFromTemplate(const WifiPsdTemplateId& id, Watt_u txPower)
+{
+    if (!g_wifiPsdTemplatesEnabled)
+    {
+        return nullptr;
+    }
+    const auto it = g_wifiPsdTemplateMap.find(id);
+    if (it == g_wifiPsdTemplateMap.cend())
+    {
+        ++g_wifiPsdTemplateStats.misses;
+        return nullptr;
+    }
+    ++g_wifiPsdTemplateStats.hits;
+    auto psd = Copy(it->second);
+    *psd *= txPower;
+    return psd;
+}
+
+/**
+ * Store the template of a transmit PSD that has been built, if templates are enabled.
+ *
+ * @param id the parameters of the PSD
+ * @param psd the PSD
+ * @param txPower the transmit power of the PSD
+ */
+static void
+AddPsdTemplate(WifiPsdTemplateId&& id, Ptr<const SpectrumValue> psd, Watt_u txPower)
+{
+    if (!g_wifiPsdTemplatesEnabled || txPower <= Watt_u{0})
+    {
+        return;
+    }
+    auto normalized = Copy(psd);
+    *normalized *= (1 / txPower);
+    g_wifiPsdTemplateMap.emplace(std::move(id), normalized);
+}
+
+void
+WifiSpectrumValueHelper::EnablePsdTemplates(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    g_wifiPsdTemplatesEnabled = enable;
+    g_wifiPsdTemplateMap.clear();
+}
+
+WifiSpectrumValueHelper::PsdTemplateStats
+WifiSpectrumValueHelper::GetPsdTemplateStats()
+{
+    auto stats = g_wifiPsdTemplateStats;
+    stats.size = g_wifiPsdTemplateMap.size();
+    return stats;
+}
+
+void
+WifiSpectrumValueHelper::ResetPsdTemplates()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_wifiPsdTemplateMap.clear();
+    g_wifiPsdTemplateStats = {};
+}
+
 // Power allocated to 71 center subbands out of 135 total subbands in the band
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(MHz_u centerFrequency,
@@ -196,6 +320,19 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPower << guardBandwidth << minInnerBand
                                     << minOuterBand << lowestPoint);
+    WifiPsdTemplateId key{WIFI_PSD_OFDM,
+                          {centerFrequency},
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {}};
+    if (auto psd = GetPsdFromTemplate(key, txPower))
+    {
+        return psd;
+    }
+
     Hz_u carrierSpacing{0};
     uint32_t innerSlopeWidth = 0;
     switch (static_cast<uint16_t>(channelWidth))
@@ -255,6 +392,7 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddPsdTemplate(std::move(key), c, txPower);
     return c;
 }
 
@@ -276,6 +414,19 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiPsdTemplateId key{WIFI_PSD_DUPLICATED_20MHZ,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels};
+    if (auto psd = GetPsdFromTemplate(key, txPower))
+    {
+        return psd;
+    }
+
     const Hz_u carrierSpacing{312500};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -361,6 +512,7 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddPsdTemplate(std::move(key), c, txPower);
     return c;
 }
 
@@ -381,6 +533,19 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiPsdTemplateId key{WIFI_PSD_HT_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {}};
+    if (auto psd = GetPsdFromTemplate(key, txPower))
+    {
+        return psd;
+    }
+
     const Hz_u carrierSpacing{312500};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -451,6 +616,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddPsdTemplate(std::move(key), c, txPower);
     return c;
 }
 
@@ -495,6 +661,19 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiPsdTemplateId key{WIFI_PSD_HE_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels};
+    if (auto psd = GetPsdFromTemplate(key, txPower))
+    {
+        return psd;
+    }
+
     const Hz_u carrierSpacing{78125};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -628,6 +807,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
+    AddPsdTemplate(std::move(key), c, txPower);
     return c;
 }
 
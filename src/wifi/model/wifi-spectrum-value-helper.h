@@ -58,6 +58,34 @@ class WifiSpectrumValueHelper
                                                Hz_u carrierSpacing,
                                                MHz_u guardBandwidth);
 
+    /// Statistics of the templates of the transmit PSDs
+    struct PsdTemplateStats
+    {
+        uint64_t hits{0};    //!< number of PSDs obtained by scaling a template
+        uint64_t misses{0};  //!< number of PSDs built from their spectrum mask
+        std::size_t size{0}; //!< number of templates
+    };
+
+    /**
+     * Enable or disable the templates of the transmit PSDs built from a spectrum mask
+     * (OFDM, duplicated 20 MHz, HT and HE PSDs). When enabled (the default), each PSD that
+     * is built is also kept, normalized to 1 W, for its parameters other than the transmit
+     * power. The next PSDs with the same parameters are then copied from the template and
+     * scaled by their transmit power, instead of building the spectrum mask again. The
+     * templates are emptied by this function.
+     *
+     * @param enable whether the templates of the transmit PSDs are used
+     */
+    static void EnablePsdTemplates(bool enable);
+    /**
+     * @return the statistics of the templates of the transmit PSDs
+     */
+    static PsdTemplateStats GetPsdTemplateStats();
+    /**
+     * Empty the templates of the transmit PSDs and reset their statistics.
+     */
+    static void ResetPsdTemplates();
+
     /**
      * Create a transmit power spectral density corresponding to DSSS
      *
@@ -9,12 +9,17 @@
 
 #include "yans-error-rate-model.h"
 
+#include "error-rate-lookup-table.h"
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <cmath>
+#include <map>
 
 namespace ns3
 {
@@ -23,13 +28,31 @@ NS_LOG_COMPONENT_DEFINE("YansErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED(YansErrorRateModel);
 
+/// The lookup tables shared by all the instances, indexed by constellation size and code rate
+static std::map<std::pair<uint16_t, WifiCodeRate>, ErrorRateLookupTable> g_yansLookupTables;
+
 TypeId
 YansErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::YansErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::YansErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<YansErrorRateModel>()
+            .AddAttribute("UseLookupTables",
+                          "Whether the chunk success rates are interpolated from tables of the "
+                          "model sampled on a dense Eb/No grid, which are built on first use and "
+                          "shared by all the instances, rather than evaluated analytically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker())
+            .AddAttribute("LookupTableTolerance",
+                          "If strictly positive, every chunk success rate read from the lookup "
+                          "tables is also evaluated analytically and the simulation is aborted "
+                          "if both differ by more than this tolerance.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansErrorRateModel::m_lookupTableTolerance),
+                          MakeDoubleChecker<double>(0, 1));
     return tid;
 }
 
@@ -183,219 +206,265 @@ YansErrorRateModel::GetFecQamBer(double snr,
 }
 
 double
-YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
-                                          const WifiTxVector& txVector,
-                                          double snr,
-                                          uint64_t nbits,
-                                          uint8_t numRxAntennas,
-                                          WifiPpduField field,
-                                          uint16_t staId) const
+YansErrorRateModel::CalculateChunkSuccessRate(WifiMode mode,
+                                              double snr,
+                                              uint64_t nbits,
+                                              MHz_u signalSpread,
+                                              uint64_t phyRate) const
 {
-    NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
-    if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
+    if (mode.GetConstellationSize() == 2)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
+        {
+            return GetFecBpskBer(snr,
+                                 nbits,
+                                 signalSpread, // signal spread
+                                 phyRate,      // PHY rate
+                                 10,           // dFree
+                                 11);          // adFree
+        }
+        else
+        {
+            return GetFecBpskBer(snr,
+                                 nbits,
+                                 signalSpread, // signal spread
+                                 phyRate,      // PHY rate
+                                 5,            // dFree
+                                 8);           // adFree
+        }
+    }
+    else if (mode.GetConstellationSize() == 4)
     {
-        uint64_t phyRate;
-        if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
         {
-            phyRate = mode.GetPhyRate(txVector.GetChannelWidth() >= MHz_u{40}
-                                          ? MHz_u{20}
-                                          : txVector.GetChannelWidth()); // This is the PHY header
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4,            // m
+                                10,           // dFree
+                                11,           // adFree
+                                0);           // adFreePlusOne
         }
         else
         {
-            phyRate = mode.GetPhyRate(txVector, staId);
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4,            // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
         }
-        if (mode.GetConstellationSize() == 2)
+    }
+    else if (mode.GetConstellationSize() == 16)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                16,           // m
+                                10,           // dFree
+                                11,           // adFree
+                                0);           // adFreePlusOne
+        }
+        else
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                16,           // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
+        }
+    }
+    else if (mode.GetConstellationSize() == 64)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
+        {
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                6,            // dFree
+                                1,            // adFree
+                                16);          // adFreePlusOne
+        }
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
+        {
+            // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                4,            // dFree
+                                14,           // adFree
+                                69);          // adFreePlusOne
+        }
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth(), // signal spread
-                                     phyRate,                    // PHY rate
-                                     10,                         // dFree
-                                     11);                        // adFree
-            }
-            else
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth(), // signal spread
-                                     phyRate,                    // PHY rate
-                                     5,                          // dFree
-                                     8);                         // adFree
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                64,           // m
+                                5,            // dFree
+                                8,            // adFree
+                                31);          // adFreePlusOne
         }
-        else if (mode.GetConstellationSize() == 4)
+    }
+    else if (mode.GetConstellationSize() == 256)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4,                          // m
-                                    10,                         // dFree
-                                    11,                         // adFree
-                                    0);                         // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4,                          // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                256,          // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
         }
-        else if (mode.GetConstellationSize() == 16)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    16,                         // m
-                                    10,                         // dFree
-                                    11,                         // adFree
-                                    0);                         // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    16,                         // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                256,          // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
         }
-        else if (mode.GetConstellationSize() == 64)
+    }
+    else if (mode.GetConstellationSize() == 1024)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    6,                          // dFree
-                                    1,                          // adFree
-                                    16);                        // adFreePlusOne
-            }
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69);                        // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    64,                         // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31);                        // adFreePlusOne
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                1024,         // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
         }
-        else if (mode.GetConstellationSize() == 256)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    256,                        // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    256,                        // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                1024,         // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
         }
-        else if (mode.GetConstellationSize() == 1024)
+    }
+    else if (mode.GetConstellationSize() == 4096)
+    {
+        if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    1024,                       // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    1024,                       // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4096,         // m
+                                4,            // dFree
+                                14,           // adFree
+                                69            // adFreePlusOne
+            );
         }
-        else if (mode.GetConstellationSize() == 4096)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4096,                       // m
-                                    4,                          // dFree
-                                    14,                         // adFree
-                                    69                          // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth(), // signal spread
-                                    phyRate,                    // PHY rate
-                                    4096,                       // m
-                                    5,                          // dFree
-                                    8,                          // adFree
-                                    31                          // adFreePlusOne
-                );
-            }
+            return GetFecQamBer(snr,
+                                nbits,
+                                signalSpread, // signal spread
+                                phyRate,      // PHY rate
+                                4096,         // m
+                                5,            // dFree
+                                8,            // adFree
+                                31            // adFreePlusOne
+            );
         }
     }
     return 0;
 }
 
+double
+YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                          const WifiTxVector& txVector,
+                                          double snr,
+                                          uint64_t nbits,
+                                          uint8_t numRxAntennas,
+                                          WifiPpduField field,
+                                          uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM)
+    {
+        return 0;
+    }
+    uint64_t phyRate;
+    if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
+    {
+        phyRate = mode.GetPhyRate(txVector.GetChannelWidth() >= MHz_u{40}
+                                      ? MHz_u{20}
+                                      : txVector.GetChannelWidth()); // This is the PHY header
+    }
+    else
+    {
+        phyRate = mode.GetPhyRate(txVector, staId);
+    }
+    const auto signalSpread = txVector.GetChannelWidth();
+    if (m_useLookupTables)
+    {
+        // the model only depends on the SNR through Eb/No, hence the tables are indexed by Eb/No
+        const auto ebNo = snr * signalSpread * 1e6 / phyRate;
+        const auto key = std::make_pair(mode.GetConstellationSize(), mode.GetCodeRate());
+        auto it = g_yansLookupTables.find(key);
+        if (it == g_yansLookupTables.end())
+        {
+            it = g_yansLookupTables
+                     .emplace(key,
+                              ErrorRateLookupTable([this, mode](double bitEbNo) {
+                                  return CalculateChunkSuccessRate(mode,
+                                                                   bitEbNo,
+                                                                   1,
+                                                                   MHz_u{1},
+                                                                   1000000);
+                              }))
+                     .first;
+        }
+        if (const auto csr = it->second.GetChunkSuccessRate(ebNo, nbits))
+        {
+            NS_ABORT_MSG_IF(
+                m_lookupTableTolerance > 0 &&
+                    std::abs(*csr - CalculateChunkSuccessRate(mode,
+                                                              snr,
+                                                              nbits,
+                                                              signalSpread,
+                                                              phyRate)) > m_lookupTableTolerance,
+                "Chunk success rate of the lookup table for "
+                    << mode << " at SNR=" << snr << " and nbits=" << nbits
+                    << " differs from the analytical one by more than " << m_lookupTableTolerance);
+            return *csr;
+        }
+    }
+    return CalculateChunkSuccessRate(mode, snr, nbits, signalSpread, phyRate);
+}
+
 } // namespace ns3
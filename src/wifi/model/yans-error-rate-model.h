@@ -58,6 +58,22 @@ class YansErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Return the success rate of a chunk evaluated with the analytical model.
+     *
+     * @param mode the Wi-Fi mode applicable to this chunk
+     * @param snr SNR ratio (not dB)
+     * @param nbits the number of bits in the chunk
+     * @param signalSpread the signal spread
+     * @param phyRate the PHY rate (bps)
+     *
+     * @return the success rate of the chunk
+     */
+    double CalculateChunkSuccessRate(WifiMode mode,
+                                     double snr,
+                                     uint64_t nbits,
+                                     MHz_u signalSpread,
+                                     uint64_t phyRate) const;
     /**
      * Return BER of BPSK with the given parameters.
      *
@@ -154,6 +170,9 @@ class YansErrorRateModel : public ErrorRateModel
                         uint32_t dfree,
                         uint32_t adFree,
                         uint32_t adFreePlusOne) const;
+
+    bool m_useLookupTables;        //!< whether chunk success rates are read from lookup tables
+    double m_lookupTableTolerance; //!< tolerance of the validation of the lookup tables
 };
 
 } // namespace ns3
@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +23,9 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace ns3
 {
 
@@ -46,7 +50,17 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("SpatialIndexCellSize",
+                          "If positive, the size (m) of the side of the cells of a spatial "
+                          "index of the PHYs, used to deliver PPDUs only to the PHYs that may "
+                          "detect them. It is best set close to the transmission range. The "
+                          "index requires a PropagationLossModel providing a maximum range "
+                          "and, for the PHYs in range, gives the same results unless the "
+                          "PropagationDelayModel draws random delays.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_indexCellSize),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -61,6 +75,14 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_index.Clear();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -81,44 +103,92 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    if (m_indexCellSize > 0)
     {
-        if (sender != (*i))
+        for (auto i : GetReceiverCandidates(senderMobility, ppdu, txPower))
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            SendTo(sender, senderMobility, m_phyList[i], ppdu, txPower);
         }
+        return;
+    }
+    for (const auto& receiver : m_phyList)
+    {
+        SendTo(sender, senderMobility, receiver, ppdu, txPower);
     }
 }
 
+std::vector<uint32_t>
+YansWifiChannel::GetReceiverCandidates(Ptr<MobilityModel> senderMobility,
+                                       Ptr<const WifiPpdu> ppdu,
+                                       dBm_u txPower) const
+{
+    NS_LOG_FUNCTION(this << senderMobility << ppdu << txPower);
+    if (m_index.GetCellSize() != m_indexCellSize)
+    {
+        m_index.SetCellSize(m_indexCellSize);
+    }
+    while (m_index.GetN() < m_phyList.size())
+    {
+        m_index.Add(m_phyList[m_index.GetN()]->GetMobility());
+    }
+
+    // Receive discards the signals weaker than the normalized RX sensitivity
+    // of the receiver, net of its RX gain
+    dBm_u threshold = std::numeric_limits<dBm_u>::infinity();
+    for (const auto& phy : m_phyList)
+    {
+        threshold = std::min(threshold, phy->GetRxSensitivity() - phy->GetRxGain());
+    }
+    threshold += RatioToDb(ppdu->GetTxChannelWidth() / MHz_u{20});
+    const meter_u range = m_loss->GetMaxRange(txPower, threshold);
+    NS_LOG_DEBUG("range=" << range << "m for txPower=" << txPower << "dBm, threshold="
+                          << threshold << "dBm");
+    return m_index.GetCandidates(senderMobility->GetPosition(), range);
+}
+
+void
+YansWifiChannel::SendTo(Ptr<YansWifiPhy> sender,
+                        Ptr<MobilityModel> senderMobility,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower) const
+{
+    if (sender == receiver)
+    {
+        return;
+    }
+    // For now don't account for inter channel interference nor channel bonding
+    if (receiver->GetChannelNumber() != sender->GetChannelNumber())
+    {
+        return;
+    }
+
+    auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPower);
+}
+
 void
 YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, dBm_u rxPower)
 {
@@ -12,6 +12,7 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid-index.h"
 
 namespace ns3
 {
@@ -32,6 +33,13 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * If the SpatialIndexCellSize attribute is positive, the positions of the
+ * YansWifiPhy objects are indexed in a grid (see ns3::MobilityGridIndex) and
+ * a PPDU is only delivered to the YansWifiPhy objects within the range
+ * returned by PropagationLossModel::GetMaxRange for the lowest sensitivity
+ * of the YansWifiPhy objects; the others would have discarded it as too weak
+ * on arrival, without firing any trace source other than SignalArrival.
  */
 class YansWifiChannel : public Channel
 {
@@ -104,9 +112,41 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Schedule the reception of a PPDU by a YansWifiPhy.
+     *
+     * @param sender the PHY object from which the packet is originating
+     * @param senderMobility the mobility model of the sender
+     * @param receiver the PHY object to which the packet is delivered
+     * @param ppdu the PPDU being sent
+     * @param txPower the TX power associated to the packet being sent
+     */
+    void SendTo(Ptr<YansWifiPhy> sender,
+                Ptr<MobilityModel> senderMobility,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                dBm_u txPower) const;
+
+    /**
+     * Get the indices, in the PHY list, of the YansWifiPhy objects that may
+     * detect a PPDU, according to the spatial index.
+     *
+     * @param senderMobility the mobility model of the sender
+     * @param ppdu the PPDU being sent
+     * @param txPower the TX power associated to the packet being sent
+     * @return the indices of the YansWifiPhy objects, in increasing order
+     */
+    std::vector<uint32_t> GetReceiverCandidates(Ptr<MobilityModel> senderMobility,
+                                                Ptr<const WifiPpdu> ppdu,
+                                                dBm_u txPower) const;
+
+    void DoDispose() override;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    meter_u m_indexCellSize;            //!< Size of the cells of the spatial index, or 0
+    mutable MobilityGridIndex m_index;  //!< Spatial index of the PHYs, built on first use
 };
 
 } // namespace ns3
@@ -21,6 +21,8 @@
 
 #include <list>
 #include <numeric>
+#include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -2569,6 +2571,144 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the PPDU durations memoized by WifiPhy are those computed
+ * without the cache, and the statistics of the cache.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Check the cache of the PPDU durations")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    std::vector<WifiTxVector> txVectors;
+    for (auto [mode, preamble, width] :
+         {std::tuple{DsssPhy::GetDsssRate11Mbps(), WIFI_PREAMBLE_SHORT, MHz_u{22}},
+          std::tuple{OfdmPhy::GetOfdmRate54Mbps(), WIFI_PREAMBLE_LONG, MHz_u{20}},
+          std::tuple{HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, MHz_u{40}},
+          std::tuple{VhtPhy::GetVhtMcs8(), WIFI_PREAMBLE_VHT_SU, MHz_u{80}},
+          std::tuple{HePhy::GetHeMcs11(), WIFI_PREAMBLE_HE_SU, MHz_u{160}}})
+    {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        txVector.SetPreambleType(preamble);
+        txVector.SetChannelWidth(width);
+        txVector.SetGuardInterval(NanoSeconds(800));
+        txVector.SetNss(1);
+        txVector.SetNTx(1);
+        txVectors.push_back(txVector);
+        if (mode.GetModulationClass() >= WIFI_MOD_CLASS_VHT)
+        {
+            txVector.SetNss(2);
+            txVector.SetNTx(2);
+            txVectors.push_back(txVector);
+        }
+        if (mode.GetModulationClass() >= WIFI_MOD_CLASS_HT)
+        {
+            txVector.SetGuardInterval(NanoSeconds(mode.GetModulationClass() == WIFI_MOD_CLASS_HE
+                                                      ? 3200
+                                                      : 400));
+            txVectors.push_back(txVector);
+        }
+    }
+    const std::vector<uint32_t> sizes{14, 1536, 65535};
+    const auto band = WIFI_PHY_BAND_5GHZ;
+
+    // durations computed without the cache
+    WifiPhy::SetTxDurationCacheCapacity(0);
+    WifiPhy::ResetTxDurationCache();
+    std::vector<Time> expected;
+    for (const auto& txVector : txVectors)
+    {
+        const auto txBand = (txVector.GetModulationClass() == WIFI_MOD_CLASS_DSSS)
+                                ? WIFI_PHY_BAND_2_4GHZ
+                                : band;
+        for (auto size : sizes)
+        {
+            expected.push_back(WifiPhy::CalculateTxDuration(size, txVector, txBand));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheStats().misses, 0, "Cache not disabled");
+
+    // durations computed twice with the cache
+    WifiPhy::SetTxDurationCacheCapacity(1000);
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        const auto before = WifiPhy::GetTxDurationCacheStats();
+        std::size_t i = 0;
+        for (const auto& txVector : txVectors)
+        {
+            const auto txBand = (txVector.GetModulationClass() == WIFI_MOD_CLASS_DSSS)
+                                    ? WIFI_PHY_BAND_2_4GHZ
+                                    : band;
+            for (auto size : sizes)
+            {
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, txVector, txBand),
+                                      expected[i++],
+                                      "Unexpected duration for " << txVector << " and size "
+                                                                 << size);
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector),
+                                      expected[i - 1] - WifiPhy::GetPayloadDuration(size,
+                                                                                     txVector,
+                                                                                     txBand),
+                                      "Unexpected preamble and header duration");
+            }
+        }
+        const auto after = WifiPhy::GetTxDurationCacheStats();
+        if (pass == 0)
+        {
+            // a TX duration and a preamble and header duration per TXVECTOR and size are
+            // added; the latter is also computed, once per TXVECTOR, on the first miss
+            NS_TEST_EXPECT_MSG_EQ(after.misses - before.misses,
+                                  expected.size() + txVectors.size(),
+                                  "Unexpected number of misses");
+            NS_TEST_EXPECT_MSG_EQ(after.size,
+                                  expected.size() + txVectors.size(),
+                                  "Unexpected number of durations in the cache");
+        }
+        else
+        {
+            NS_TEST_EXPECT_MSG_EQ(after.misses, before.misses, "Unexpected miss");
+            NS_TEST_EXPECT_MSG_EQ(after.hits - before.hits,
+                                  2 * expected.size(),
+                                  "Unexpected number of hits");
+        }
+    }
+
+    // the cache is emptied when it is full
+    WifiPhy::SetTxDurationCacheCapacity(4);
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        const auto& txVector = txVectors[i / sizes.size()];
+        const auto txBand = (txVector.GetModulationClass() == WIFI_MOD_CLASS_DSSS)
+                                ? WIFI_PHY_BAND_2_4GHZ
+                                : band;
+        NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(sizes[i % sizes.size()],
+                                                           txVector,
+                                                           txBand),
+                              expected[i],
+                              "Unexpected duration with a full cache");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(WifiPhy::GetTxDurationCacheStats().size,
+                                    4,
+                                    "Cache capacity exceeded");
+    }
+
+    WifiPhy::SetTxDurationCacheCapacity(4096);
+    WifiPhy::ResetTxDurationCache();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -2588,6 +2728,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     const auto p80OrLow80 = true;
     const auto s80OrHigh80 = false;
     for (const auto p160 :
@@ -14,11 +14,15 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/eht-phy.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/ofdm-phy.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1011,6 +1015,73 @@ std::map<std::pair<uint8_t /* mcs */, uint32_t /* size */>,
          }},
 };
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the chunk success rates read from the lookup tables of the
+ * NIST and YANS error rate models match the analytical ones.
+ */
+class WifiErrorRateModelsTestCaseLookupTables : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseLookupTables();
+
+  private:
+    void DoRun() override;
+};
+
+WifiErrorRateModelsTestCaseLookupTables::WifiErrorRateModelsTestCaseLookupTables()
+    : TestCase("Check the lookup tables of the error rate models")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTables::DoRun()
+{
+    std::vector<WifiMode> modes{OfdmPhy::GetOfdmRate6Mbps(), OfdmPhy::GetOfdmRate9Mbps()};
+    for (uint8_t mcs = 0; mcs < 8; mcs++)
+    {
+        modes.push_back(HtPhy::GetHtMcs(mcs));
+    }
+    modes.push_back(VhtPhy::GetVhtMcs8());
+    modes.push_back(VhtPhy::GetVhtMcs9());
+    modes.push_back(HePhy::GetHeMcs10());
+    modes.push_back(HePhy::GetHeMcs11());
+    modes.push_back(EhtPhy::GetEhtMcs12());
+    modes.push_back(EhtPhy::GetEhtMcs13());
+
+    for (const auto& typeName : {"ns3::NistErrorRateModel", "ns3::YansErrorRateModel"})
+    {
+        ObjectFactory factory(typeName);
+        auto analytical = factory.Create<ErrorRateModel>();
+        factory.Set("UseLookupTables", BooleanValue(true));
+        auto tabulated = factory.Create<ErrorRateModel>();
+
+        for (const auto& mode : modes)
+        {
+            WifiTxVector txVector;
+            txVector.SetMode(mode);
+            // use SNR values that do not fall on the grid of the tables
+            for (dB_u snr{-5}; snr < dB_u{50}; snr += dB_u{0.0137})
+            {
+                for (uint64_t size : {14, 1500, 65535})
+                {
+                    const auto expected =
+                        analytical->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), size * 8);
+                    const auto csr =
+                        tabulated->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), size * 8);
+                    NS_TEST_ASSERT_MSG_EQ_TOL(csr,
+                                              expected,
+                                              1e-5,
+                                              typeName << " " << mode << " snr=" << snr
+                                                       << "dB size=" << size);
+                }
+            }
+        }
+    }
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1120,6 +1191,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseLookupTables, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
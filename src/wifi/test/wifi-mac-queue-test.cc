@@ -417,6 +417,174 @@ WifiExtractExpiredMpdusTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test extraction of expired MPDUs when expiry times are set out of order
+ *
+ * This test verifies that the MAC queue container keeps track of whether the MPDUs of
+ * a container queue are sorted by expiry time: MPDUs with expired lifetime queued behind
+ * an inflight MPDU with a later expiry time must be extracted, while a container queue
+ * whose first MPDU has not expired is known to hold no MPDU with expired lifetime. The
+ * size in bytes of the container queues is also checked.
+ */
+class WifiMacQueueExpiryOrderTest : public TestCase
+{
+  public:
+    WifiMacQueueExpiryOrderTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Enqueue a new MPDU into the container.
+     *
+     * @param rxAddr Receiver Address of the MPDU
+     * @param inflight whether the MPDU is inflight
+     * @param expiryTime the expiry time for the MPDU
+     * @return an iterator pointing to the enqueued MPDU
+     */
+    WifiMacQueueContainer::iterator Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime);
+
+    WifiMacQueueContainer m_container; //!< MAC queue container
+    uint16_t m_currentSeqNo{0};        //!< sequence number of current MPDU
+    Mac48Address m_txAddr;             //!< Transmitter Address of MPDUs
+};
+
+WifiMacQueueExpiryOrderTest::WifiMacQueueExpiryOrderTest()
+    : TestCase("Test extraction of expired MPDUs with unordered expiry times")
+{
+}
+
+WifiMacQueueContainer::iterator
+WifiMacQueueExpiryOrderTest::Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime)
+{
+    WifiMacHeader header(WIFI_MAC_QOSDATA);
+    header.SetAddr1(rxAddr);
+    header.SetAddr2(m_txAddr);
+    header.SetQosTid(0);
+    header.SetSequenceNumber(m_currentSeqNo++);
+    auto mpdu = Create<WifiMpdu>(Create<Packet>(100), header);
+
+    auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+    auto elemIt = m_container.insert(m_container.GetQueue(queueId).cend(), mpdu);
+    m_container.SetExpiryTime(elemIt, expiryTime);
+    if (inflight)
+    {
+        elemIt->inflights.emplace(0, mpdu);
+    }
+    elemIt->deleter = [](auto mpdu) {};
+    return elemIt;
+}
+
+void
+WifiMacQueueExpiryOrderTest::DoRun()
+{
+    m_txAddr = Mac48Address::Allocate();
+    auto rxAddr1 = Mac48Address::Allocate();
+    auto rxAddr2 = Mac48Address::Allocate();
+    WifiContainerQueueId queueId1{WIFI_QOSDATA_QUEUE, WifiRcvAddr::UNICAST, rxAddr1, 0};
+    WifiContainerQueueId queueId2{WIFI_QOSDATA_QUEUE, WifiRcvAddr::UNICAST, rxAddr2, 0};
+
+    // MPDUs sorted by expiry time; the expiry time of MPDU 1 is then changed
+    // without breaking the order
+    Enqueue(rxAddr1, true, MilliSeconds(30));
+    auto it = Enqueue(rxAddr1, false, MilliSeconds(50));
+    Enqueue(rxAddr1, false, MilliSeconds(60));
+    m_container.SetExpiryTime(it, MilliSeconds(40));
+
+    // MPDU 4 has an earlier expiry time than the inflight MPDU 3
+    Enqueue(rxAddr2, true, MilliSeconds(30));
+    Enqueue(rxAddr2, false, MilliSeconds(10));
+    Enqueue(rxAddr2, false, MilliSeconds(60));
+
+    const auto mpduSize = m_container.GetQueue(queueId1).front().mpdu->GetSize();
+    NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId1),
+                          3 * mpduSize,
+                          "Unexpected size of container queue 1");
+    NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId2),
+                          3 * mpduSize,
+                          "Unexpected size of container queue 2");
+
+    Simulator::Schedule(MilliSeconds(20), [&]() {
+        auto [first1, last1] = m_container.ExtractExpiredMpdus(queueId1);
+        NS_TEST_EXPECT_MSG_EQ((first1 == last1), true, "Did not expect expired MPDUs in queue 1");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId1),
+                              3 * mpduSize,
+                              "Unexpected size of container queue 1");
+
+        // MPDU 3 not extracted because inflight, MPDU 4 extracted
+        auto [first2, last2] = m_container.ExtractExpiredMpdus(queueId2);
+        NS_TEST_EXPECT_MSG_EQ((first2 != last2), true, "Expected one MPDU extracted");
+        NS_TEST_EXPECT_MSG_EQ(first2->mpdu->GetHeader().GetSequenceNumber(),
+                              4,
+                              "Unexpected extracted MPDU");
+        first2++;
+        NS_TEST_EXPECT_MSG_EQ((first2 == last2), true, "Did not expect other expired MPDUs");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId2),
+                              2 * mpduSize,
+                              "Unexpected size of container queue 2");
+    });
+
+    Simulator::Schedule(MilliSeconds(45), [&]() {
+        // MPDU 0 not extracted because inflight, MPDU 1 extracted
+        auto [first, last] = m_container.ExtractAllExpiredMpdus();
+        NS_TEST_EXPECT_MSG_EQ((first != last), true, "Expected one MPDU extracted");
+        NS_TEST_EXPECT_MSG_EQ(first->mpdu->GetHeader().GetSequenceNumber(),
+                              1,
+                              "Unexpected extracted MPDU");
+        first++;
+        NS_TEST_EXPECT_MSG_EQ((first == last), true, "Did not expect other expired MPDUs");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId1),
+                              2 * mpduSize,
+                              "Unexpected size of container queue 1");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId2),
+                              2 * mpduSize,
+                              "Unexpected size of container queue 2");
+
+        // remove all the MPDUs; the memory of the erased elements is reused by the
+        // elements inserted afterwards
+        for (const auto& queueId : {queueId1, queueId2})
+        {
+            while (!m_container.GetQueue(queueId).empty())
+            {
+                m_container.erase(m_container.GetQueue(queueId).cbegin());
+            }
+            NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId),
+                                  0,
+                                  "Unexpected size of empty container queue");
+        }
+        auto [firstExp, lastExp] = m_container.GetAllExpiredMpdus();
+        while (firstExp != lastExp)
+        {
+            firstExp = m_container.erase(firstExp);
+        }
+
+        Enqueue(rxAddr2, false, MilliSeconds(55));
+        Enqueue(rxAddr2, false, MilliSeconds(70));
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId2),
+                              2 * mpduSize,
+                              "Unexpected size of container queue 2");
+    });
+
+    Simulator::Schedule(MilliSeconds(60), [&]() {
+        auto [first, last] = m_container.ExtractExpiredMpdus(queueId2);
+        NS_TEST_EXPECT_MSG_EQ((first != last), true, "Expected one MPDU extracted");
+        NS_TEST_EXPECT_MSG_EQ(first->mpdu->GetHeader().GetSequenceNumber(),
+                              6,
+                              "Unexpected extracted MPDU");
+        first++;
+        NS_TEST_EXPECT_MSG_EQ((first == last), true, "Did not expect other expired MPDUs");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId2).size(),
+                              1,
+                              "Unexpected number of MPDUs in container queue 2");
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -525,6 +693,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacQueueExpiryOrderTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiMacQueueFlushTest, TestCase::Duration::QUICK);
 }
 
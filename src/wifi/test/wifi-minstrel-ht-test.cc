@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/position-allocator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <array>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiMinstrelHtTest");
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the rates selected by Minstrel-HT
+ *
+ * An HE AP with two antennas sends packets to four HE stations placed at increasing distances,
+ * so that Minstrel-HT selects different rates (and numbers of spatial streams) for each of them
+ * and samples the rates of many groups. The number of data frames transmitted by the AP to each
+ * station with each MCS and number of spatial streams is compared to a reference, which ensures
+ * that changes to the implementation of Minstrel-HT (such as the layout of its statistics) do not
+ * change the selected rates. The test is run with and without A-MPDU aggregation, in order to
+ * cover both the A-MPDU and the single MPDU reports of the transmission outcome.
+ */
+class MinstrelHtRateSelectionTest : public TestCase
+{
+  public:
+    /// Number of data frames transmitted per MCS (index = MCS + 12 * (NSS - 1))
+    using TxCounts = std::array<uint32_t, 24>;
+
+    /**
+     * Constructor
+     * @param ampdu whether A-MPDU aggregation is enabled
+     * @param expected the expected number of data frames per MCS and NSS for every station
+     */
+    MinstrelHtRateSelectionTest(bool ampdu, const std::vector<TxCounts>& expected);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when the AP PHY starts transmitting a PSDU.
+     * @param psduMap the PSDU map
+     * @param txVector the TXVECTOR used to transmit the PSDU map
+     * @param txPowerW the transmit power (W)
+     */
+    void Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+
+    bool m_ampdu;                     ///< whether A-MPDU aggregation is enabled
+    std::vector<TxCounts> m_expected; ///< expected data frames per station
+    std::vector<TxCounts> m_counts;   ///< data frames transmitted per station
+    NetDeviceContainer m_staDevices;  ///< station devices
+};
+
+MinstrelHtRateSelectionTest::MinstrelHtRateSelectionTest(bool ampdu,
+                                                         const std::vector<TxCounts>& expected)
+    : TestCase(std::string("Check rates selected by Minstrel-HT ") +
+               (ampdu ? "with" : "without") + " A-MPDU aggregation"),
+      m_ampdu(ampdu),
+      m_expected(expected)
+{
+}
+
+void
+MinstrelHtRateSelectionTest::Transmit(WifiConstPsduMap psduMap,
+                                      WifiTxVector txVector,
+                                      double txPowerW)
+{
+    const auto& hdr = psduMap.begin()->second->GetHeader(0);
+    if (!hdr.IsQosData())
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < m_staDevices.GetN(); i++)
+    {
+        if (hdr.GetAddr1() == m_staDevices.Get(i)->GetAddress())
+        {
+            m_counts[i][txVector.GetMode().GetMcsValue() + 12 * (txVector.GetNss() - 1)]++;
+        }
+    }
+}
+
+void
+MinstrelHtRateSelectionTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    const uint32_t nStations = 4;
+
+    NodeContainer ap(1);
+    NodeContainer stas(nStations);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    phy.Set("Antennas", UintegerValue(2));
+    phy.Set("MaxSupportedTxSpatialStreams", UintegerValue(2));
+    phy.Set("MaxSupportedRxSpatialStreams", UintegerValue(2));
+
+    WifiMacHelper mac;
+    Ssid ssid("minstrel-ht");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    auto apDevice = wifi.Install(phy, mac, ap);
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    m_staDevices = wifi.Install(phy, mac, stas);
+    int64_t streamNumber = 100;
+    streamNumber += WifiHelper::AssignStreams(apDevice, streamNumber);
+    streamNumber += WifiHelper::AssignStreams(m_staDevices, streamNumber);
+
+    if (!m_ampdu)
+    {
+        auto apMac = DynamicCast<WifiNetDevice>(apDevice.Get(0))->GetMac();
+        apMac->SetAttribute("BE_MaxAmpduSize", UintegerValue(0));
+    }
+
+    MobilityHelper mobility;
+    auto positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        positions->Add(Vector(5 + 12 * i, 0, 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(ap);
+    mobility.Install(stas);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(ap);
+    packetSocket.Install(stas);
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(m_staDevices.Get(i)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(1000));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+        client->SetStartTime(Seconds(0.5) + MilliSeconds(i));
+        client->SetStopTime(Seconds(1.5));
+        ap.Get(0)->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        stas.Get(i)->AddApplication(server);
+    }
+
+    m_counts.assign(nStations, TxCounts{});
+    DynamicCast<WifiNetDevice>(apDevice.Get(0))
+        ->GetPhy()
+        ->TraceConnectWithoutContext(
+            "PhyTxPsduBegin",
+            MakeCallback(&MinstrelHtRateSelectionTest::Transmit, this));
+
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_counts.size(), m_expected.size(), "Unexpected number of stations");
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        for (std::size_t j = 0; j < m_counts[i].size(); j++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(m_counts[i][j],
+                                  m_expected[i][j],
+                                  "Unexpected number of data frames sent to station "
+                                      << i << " with MCS " << j % 12 << " and " << j / 12 + 1
+                                      << " spatial streams");
+        }
+    }
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Minstrel-HT Test Suite
+ */
+class WifiMinstrelHtTestSuite : public TestSuite
+{
+  public:
+    WifiMinstrelHtTestSuite();
+};
+
+WifiMinstrelHtTestSuite::WifiMinstrelHtTestSuite()
+    : TestSuite("wifi-minstrel-ht", Type::UNIT)
+{
+    AddTestCase(new MinstrelHtRateSelectionTest(
+                    true,
+                    {{0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 51, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 440, 170},
+                     {0, 0, 0, 0, 0, 0, 29, 1, 1, 2, 4, 1, 0, 0, 0, 0, 1, 2, 413, 186, 1, 3, 3, 2},
+                     {0, 0, 3, 0, 42, 0, 251, 1, 1, 2, 2, 2, 0, 0, 162, 0, 172, 0, 8, 2, 2, 3, 3, 1},
+                     {3, 0, 12, 0, 2, 0, 157, 2, 2, 3, 0, 2, 0, 0, 511, 0, 2, 0, 3, 3, 3, 3, 0, 1}}),
+                TestCase::Duration::QUICK);
+    AddTestCase(new MinstrelHtRateSelectionTest(
+                    false,
+                    {{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 76, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1348, 370},
+                     {1, 0, 0, 0, 0, 0, 82, 0, 1, 7, 7, 8, 1, 0, 0, 0, 1, 2, 349, 1134, 6, 8, 8, 9},
+                     {2, 0, 0, 0, 28, 0, 161, 1, 1, 2, 2, 1, 0, 0, 141, 0, 161, 0, 9, 2, 2, 3, 3, 1},
+                     {5, 0, 5, 0, 0, 0, 131, 1, 0, 0, 0, 0, 0, 0, 75, 0, 0, 0, 3, 1, 0, 0, 0, 0}}),
+                TestCase::Duration::QUICK);
+}
+
+static WifiMinstrelHtTestSuite g_wifiMinstrelHtTestSuite; ///< the test suite
@@ -3961,6 +3961,257 @@ TestAmpduReception::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief PPDU reception abstraction test
+ *
+ * An A-MPDU made of 3 MPDUs is received with the Full and the Ppdu levels of abstraction
+ * of the payload reception (see WifiPhy::RxAbstraction). Without interference, all the
+ * MPDUs are received in both cases, and with an interferer as strong as the A-MPDU during
+ * the whole payload, all the MPDUs are lost in both cases. When the interferer only overlaps
+ * the last MPDU, only the last MPDU is lost with the Full abstraction, whereas the
+ * interference is spread over the whole payload by the effective SNR of the Ppdu
+ * abstraction, which is then high enough to receive all the MPDUs. In all cases, the PHY
+ * is in RX state during the payload and the per-MPDU notifications match the statuses
+ * reported at the end of the PSDU.
+ */
+class TestRxAbstraction : public WifiPhyReceptionTest
+{
+  public:
+    TestRxAbstraction();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+
+    /**
+     * RX success function
+     * @param psdu the PSDU
+     * @param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+     * @param txVector the transmit vector
+     * @param statusPerMpdu reception status per MPDU
+     */
+    void RxSuccess(Ptr<const WifiPsdu> psdu,
+                   RxSignalInfo rxSignalInfo,
+                   const WifiTxVector& txVector,
+                   const std::vector<bool>& statusPerMpdu);
+    /**
+     * RX failure function
+     * @param psdu the PSDU
+     */
+    void RxFailure(Ptr<const WifiPsdu> psdu);
+
+    /**
+     * Send an A-MPDU made of 3 MPDUs of 1000, 1100 and 1200 bytes.
+     * @param rxPower the receive power
+     */
+    void SendAmpdu(dBm_u rxPower);
+
+    /**
+     * Set the level of abstraction of the payload reception and reset the counters.
+     * @param rxAbstraction the level of abstraction
+     */
+    void Reset(WifiPhy::RxAbstraction rxAbstraction);
+
+    /**
+     * Check the outcome of the reception of the A-MPDU.
+     * @param expectedStatusPerMpdu the expected reception status of every MPDU (all false if
+     *                              the PSDU is expected to be lost)
+     */
+    void CheckResults(std::vector<bool> expectedStatusPerMpdu);
+
+    std::size_t m_rxMpdus{0};          ///< number of MPDUs notified before the end of the PSDU
+    std::vector<bool> m_statusPerMpdu; ///< reception status per MPDU at the end of the PSDU
+    std::size_t m_rxFailures{0};       ///< number of PSDUs that were not received
+};
+
+TestRxAbstraction::TestRxAbstraction()
+    : WifiPhyReceptionTest("PPDU reception abstraction test")
+{
+}
+
+void
+TestRxAbstraction::RxSuccess(Ptr<const WifiPsdu> psdu,
+                             RxSignalInfo rxSignalInfo,
+                             const WifiTxVector& txVector,
+                             const std::vector<bool>& statusPerMpdu)
+{
+    NS_LOG_FUNCTION(this << *psdu << rxSignalInfo << txVector);
+    if (statusPerMpdu.empty())
+    {
+        // notification of a single MPDU of the A-MPDU
+        ++m_rxMpdus;
+        return;
+    }
+    m_statusPerMpdu = statusPerMpdu;
+}
+
+void
+TestRxAbstraction::RxFailure(Ptr<const WifiPsdu> psdu)
+{
+    NS_LOG_FUNCTION(this << *psdu);
+    ++m_rxFailures;
+}
+
+void
+TestRxAbstraction::SendAmpdu(dBm_u rxPower)
+{
+    WifiTxVector txVector = WifiTxVector(HePhy::GetHeMcs0(),
+                                         0,
+                                         WIFI_PREAMBLE_HE_SU,
+                                         NanoSeconds(800),
+                                         1,
+                                         1,
+                                         0,
+                                         MHz_u{20},
+                                         true);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+
+    std::vector<Ptr<WifiMpdu>> mpduList;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(1000 + i * 100);
+        mpduList.push_back(Create<WifiMpdu>(p, hdr));
+    }
+    Ptr<WifiPsdu> psdu = Create<WifiPsdu>(mpduList);
+
+    Time txDuration =
+        SpectrumWifiPhy::CalculateTxDuration(psdu->GetSize(), txVector, m_phy->GetPhyBand());
+
+    Ptr<WifiPpdu> ppdu =
+        Create<HePpdu>(psdu, txVector, m_phy->GetOperatingChannel(), txDuration, m_uid++);
+
+    Ptr<SpectrumValue> txPowerSpectrum =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(FREQUENCY,
+                                                                    CHANNEL_WIDTH,
+                                                                    DbmToW(rxPower),
+                                                                    GUARD_WIDTH);
+
+    Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters>();
+    txParams->psd = txPowerSpectrum;
+    txParams->txPhy = nullptr;
+    txParams->duration = txDuration;
+    txParams->ppdu = ppdu;
+
+    m_phy->StartRx(txParams, nullptr);
+}
+
+void
+TestRxAbstraction::Reset(WifiPhy::RxAbstraction rxAbstraction)
+{
+    m_phy->SetRxAbstraction(rxAbstraction);
+    m_rxMpdus = 0;
+    m_statusPerMpdu.clear();
+    m_rxFailures = 0;
+}
+
+void
+TestRxAbstraction::CheckResults(std::vector<bool> expectedStatusPerMpdu)
+{
+    const auto expectedRxMpdus =
+        std::count(expectedStatusPerMpdu.cbegin(), expectedStatusPerMpdu.cend(), true);
+    NS_TEST_ASSERT_MSG_EQ(m_rxMpdus, expectedRxMpdus, "Unexpected number of MPDUs notified");
+    if (expectedRxMpdus == 0)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxFailures, 1, "The PSDU should not have been received");
+        NS_TEST_ASSERT_MSG_EQ(m_statusPerMpdu.empty(), true, "No status expected");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxFailures, 0, "The PSDU should have been received");
+        NS_TEST_ASSERT_MSG_EQ((m_statusPerMpdu == expectedStatusPerMpdu),
+                              true,
+                              "Unexpected reception status per MPDU");
+    }
+}
+
+void
+TestRxAbstraction::DoSetup()
+{
+    WifiPhyReceptionTest::DoSetup();
+    m_phy->SetReceiveOkCallback(MakeCallback(&TestRxAbstraction::RxSuccess, this));
+    m_phy->SetReceiveErrorCallback(MakeCallback(&TestRxAbstraction::RxFailure, this));
+}
+
+void
+TestRxAbstraction::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 0;
+    m_phy->AssignStreams(streamNumber);
+    const dBm_u rxPower{-30};
+
+    // the A-MPDU lasts about 3.21 ms: 44 us of preamble and PHY header, then MPDUs of about
+    // 0.96 ms, 1.06 ms and 1.15 ms
+    const auto midPayload = MicroSeconds(1600);
+    const auto afterPpdu = MicroSeconds(3300);
+    auto start = Seconds(1);
+    for (const auto rxAbstraction : {WifiPhy::RX_ABSTRACTION_FULL, WifiPhy::RX_ABSTRACTION_PPDU})
+    {
+        // no interference: all MPDUs are received
+        Simulator::Schedule(start, &TestRxAbstraction::Reset, this, rxAbstraction);
+        Simulator::Schedule(start, &TestRxAbstraction::SendAmpdu, this, rxPower);
+        Simulator::Schedule(start + midPayload,
+                            &TestRxAbstraction::CheckPhyState,
+                            this,
+                            WifiPhyState::RX);
+        Simulator::Schedule(start + afterPpdu,
+                            &TestRxAbstraction::CheckPhyState,
+                            this,
+                            WifiPhyState::IDLE);
+        Simulator::Schedule(start + afterPpdu,
+                            &TestRxAbstraction::CheckResults,
+                            this,
+                            std::vector<bool>{true, true, true});
+        start += Seconds(1);
+
+        // interferer stronger than the A-MPDU during the whole payload: all MPDUs are lost
+        Simulator::Schedule(start, &TestRxAbstraction::Reset, this, rxAbstraction);
+        Simulator::Schedule(start, &TestRxAbstraction::SendAmpdu, this, rxPower);
+        Simulator::Schedule(start + MicroSeconds(50),
+                            &TestRxAbstraction::SendPacket,
+                            this,
+                            rxPower + dB_u{3},
+                            4000,
+                            0);
+        Simulator::Schedule(start + midPayload,
+                            &TestRxAbstraction::CheckPhyState,
+                            this,
+                            WifiPhyState::RX);
+        Simulator::Schedule(start + afterPpdu,
+                            &TestRxAbstraction::CheckResults,
+                            this,
+                            std::vector<bool>{false, false, false});
+        start += Seconds(1);
+
+        // interferer as strong as the A-MPDU during the last MPDU only
+        Simulator::Schedule(start, &TestRxAbstraction::Reset, this, rxAbstraction);
+        Simulator::Schedule(start, &TestRxAbstraction::SendAmpdu, this, rxPower);
+        Simulator::Schedule(start + MicroSeconds(2200),
+                            &TestRxAbstraction::SendPacket,
+                            this,
+                            rxPower,
+                            1000,
+                            0);
+        Simulator::Schedule(start + afterPpdu,
+                            &TestRxAbstraction::CheckResults,
+                            this,
+                            rxAbstraction == WifiPhy::RX_ABSTRACTION_FULL
+                                ? std::vector<bool>{true, true, false}
+                                : std::vector<bool>{true, true, true});
+        start += Seconds(1);
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -5040,6 +5291,7 @@ WifiPhyReceptionTestSuite::WifiPhyReceptionTestSuite()
     AddTestCase(new TestSimpleFrameCaptureModel, TestCase::Duration::QUICK);
     AddTestCase(new TestPhyHeadersReception, TestCase::Duration::QUICK);
     AddTestCase(new TestAmpduReception, TestCase::Duration::QUICK);
+    AddTestCase(new TestRxAbstraction, TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedModulationReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedBandwidthReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestPrimary20CoveredByPpdu(), TestCase::Duration::QUICK);
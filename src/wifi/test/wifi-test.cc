@@ -14,6 +14,7 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -49,6 +50,7 @@
 #include "ns3/yans-wifi-phy.h"
 
 #include <optional>
+#include <vector>
 
 using namespace ns3;
 
@@ -3976,6 +3978,124 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the spatial index of the YansWifiChannel delivers the
+ * PPDUs to the same receivers as without it.
+ *
+ * Stations are placed along a line, 50 m apart, and each of them sends a
+ * broadcast frame in turn; the last station is then moved next to the first
+ * one and sends another frame. The frames received by each station must be
+ * the same with and without the spatial index, while the signals arriving at
+ * the stations out of range are only notified without it.
+ */
+class YansWifiChannelSpatialIndexTest : public TestCase
+{
+  public:
+    YansWifiChannelSpatialIndexTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario.
+     * @param cellSize the size of the cells of the spatial index, or 0
+     * @param received the number of frames received by each station
+     * @return the number of signals arrived at the stations
+     */
+    uint32_t RunScenario(double cellSize, std::vector<uint32_t>& received);
+};
+
+YansWifiChannelSpatialIndexTest::YansWifiChannelSpatialIndexTest()
+    : TestCase("Test the spatial index of the YansWifiChannel")
+{
+}
+
+uint32_t
+YansWifiChannelSpatialIndexTest::RunScenario(double cellSize, std::vector<uint32_t>& received)
+{
+    const uint32_t nStations = 12;
+    NodeContainer nodes(nStations);
+
+    YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
+    Ptr<YansWifiChannel> channel = channelHelper.Create();
+    channel->SetAttribute("SpatialIndexCellSize", DoubleValue(cellSize));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    auto positions = CreateObject<ListPositionAllocator>();
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        positions->Add(Vector(50.0 * i, 0, 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(nodes);
+
+    received.assign(nStations, 0);
+    uint32_t arrivals = 0;
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        auto dev = DynamicCast<WifiNetDevice>(devices.Get(i));
+        Callback<void, Ptr<const Packet>> rxEnd = [&received, i](Ptr<const Packet>) {
+            received[i]++;
+        };
+        dev->GetPhy()->TraceConnectWithoutContext("PhyRxEnd", rxEnd);
+        Callback<void, Ptr<const WifiPpdu>, double, Time> arrival =
+            [&arrivals](Ptr<const WifiPpdu>, double, Time) { arrivals++; };
+        dev->GetPhy()->TraceConnectWithoutContext("SignalArrival", arrival);
+        Simulator::Schedule(Seconds(1) + MilliSeconds(10 * i), [dev]() {
+            dev->Send(Create<Packet>(100), dev->GetBroadcast(), 1);
+        });
+    }
+
+    auto last = DynamicCast<WifiNetDevice>(devices.Get(nStations - 1));
+    Simulator::Schedule(Seconds(1.5), [last]() {
+        last->GetNode()->GetObject<MobilityModel>()->SetPosition(Vector(0, 25, 0));
+    });
+    Simulator::Schedule(Seconds(1.6), [last]() {
+        last->Send(Create<Packet>(100), last->GetBroadcast(), 1);
+    });
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy();
+    return arrivals;
+}
+
+void
+YansWifiChannelSpatialIndexTest::DoRun()
+{
+    std::vector<uint32_t> expected;
+    uint32_t allArrivals = RunScenario(0, expected);
+    std::vector<uint32_t> received;
+    uint32_t indexedArrivals = RunScenario(100, received);
+
+    // station 0 receives at least the frames of its neighbor and of the moved station
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(expected[0], 2, "Station 0 should receive frames");
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(received[i],
+                              expected[i],
+                              "Unexpected number of frames received by station " << i);
+    }
+    NS_TEST_EXPECT_MSG_LT(indexedArrivals,
+                          allArrivals,
+                          "The signals out of range should not be delivered");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -4010,6 +4130,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelSpatialIndexTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
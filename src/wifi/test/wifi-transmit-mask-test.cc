@@ -15,6 +15,9 @@
 #include "ns3/wifi-standards.h"
 
 #include <cmath>
+#include <functional>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace ns3;
@@ -301,6 +304,167 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test that the transmit PSDs obtained from the templates of WifiSpectrumValueHelper
+ * are the same as the PSDs built from the spectrum masks, whatever the transmit power.
+ */
+class WifiPsdTemplateTestCase : public TestCase
+{
+  public:
+    WifiPsdTemplateTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A function building a transmit PSD for a given transmit power
+    using PsdBuilder = std::function<Ptr<SpectrumValue>(Watt_u)>;
+
+    /**
+     * Check that two PSDs are equal
+     *
+     * @param actual the actual PSD
+     * @param expected the expected PSD
+     * @param description the description of the PSD
+     */
+    void CheckPsd(Ptr<const SpectrumValue> actual,
+                  Ptr<const SpectrumValue> expected,
+                  const std::string& description);
+};
+
+WifiPsdTemplateTestCase::WifiPsdTemplateTestCase()
+    : TestCase("Check the templates of the transmit PSDs")
+{
+}
+
+void
+WifiPsdTemplateTestCase::CheckPsd(Ptr<const SpectrumValue> actual,
+                                  Ptr<const SpectrumValue> expected,
+                                  const std::string& description)
+{
+    NS_TEST_ASSERT_MSG_EQ(actual->GetSpectrumModelUid(),
+                          expected->GetSpectrumModelUid(),
+                          "Unexpected spectrum model for " << description);
+    for (std::size_t i = 0; i < expected->GetValuesN(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL((*actual)[i],
+                                  (*expected)[i],
+                                  1e-12 * (*expected)[i],
+                                  "Unexpected value of subcarrier " << i << " for " << description);
+    }
+}
+
+void
+WifiPsdTemplateTestCase::DoRun()
+{
+    const std::vector<bool> punctured{false, true, false, false};
+    const std::vector<std::pair<std::string, PsdBuilder>> builders{
+        {"OFDM 20 MHz",
+         [](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(5180,
+                                                                              20,
+                                                                              txPower,
+                                                                              20,
+                                                                              -20,
+                                                                              -28,
+                                                                              -40);
+         }},
+        {"non-HT duplicate 80 MHz",
+         [](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity({5210},
+                                                                                         80,
+                                                                                         txPower,
+                                                                                         80,
+                                                                                         -20,
+                                                                                         -28,
+                                                                                         -40);
+         }},
+        {"HT 40 MHz",
+         [](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity({5190},
+                                                                                40,
+                                                                                txPower,
+                                                                                40,
+                                                                                -20,
+                                                                                -28,
+                                                                                -40);
+         }},
+        {"HE 80 MHz",
+         [](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210,
+                                                                                80,
+                                                                                txPower,
+                                                                                80,
+                                                                                -20,
+                                                                                -28,
+                                                                                -40);
+         }},
+        {"HE 80 MHz punctured",
+         [punctured](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210,
+                                                                                80,
+                                                                                txPower,
+                                                                                80,
+                                                                                -20,
+                                                                                -28,
+                                                                                -40,
+                                                                                punctured);
+         }},
+        {"HE 80+80 MHz",
+         [](Watt_u txPower) {
+             return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
+                 std::vector<MHz_u>{5530, 5690},
+                 160,
+                 txPower,
+                 160,
+                 -20,
+                 -28,
+                 -40);
+         }},
+    };
+    const std::vector<Watt_u> txPowers{0.1, 0.02, 0.1};
+
+    // build the expected PSDs from the spectrum masks
+    WifiSpectrumValueHelper::EnablePsdTemplates(false);
+    WifiSpectrumValueHelper::ResetPsdTemplates();
+    std::vector<std::vector<Ptr<SpectrumValue>>> expected;
+    for (const auto& [description, builder] : builders)
+    {
+        auto& psds = expected.emplace_back();
+        for (const auto txPower : txPowers)
+        {
+            psds.push_back(builder(txPower));
+        }
+    }
+    auto stats = WifiSpectrumValueHelper::GetPsdTemplateStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.hits + stats.misses,
+                          0,
+                          "The templates should not be looked up when disabled");
+
+    WifiSpectrumValueHelper::EnablePsdTemplates(true);
+    for (std::size_t i = 0; i < builders.size(); ++i)
+    {
+        const auto& [description, builder] = builders.at(i);
+        for (std::size_t j = 0; j < txPowers.size(); ++j)
+        {
+            auto psd = builder(txPowers.at(j));
+            CheckPsd(psd, expected.at(i).at(j), description);
+            // the PSD may be modified by its user without affecting the template
+            *psd *= 0.5;
+        }
+    }
+    stats = WifiSpectrumValueHelper::GetPsdTemplateStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.misses, builders.size(), "Unexpected number of PSDs built");
+    NS_TEST_EXPECT_MSG_EQ(stats.hits,
+                          builders.size() * (txPowers.size() - 1),
+                          "Unexpected number of PSDs obtained from a template");
+    NS_TEST_EXPECT_MSG_EQ(stats.size, builders.size(), "Unexpected number of templates");
+
+    WifiSpectrumValueHelper::ResetPsdTemplates();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1989,4 +2153,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
                                                prec,
                                                puncturedSubchannels),
                 TestCase::Duration::QUICK);
+
+    AddTestCase(new WifiPsdTemplateTestCase, TestCase::Duration::QUICK);
 }
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to compare the shaping of many flows with a single
+// CarouselQueueDisc and with a TbfQueueDisc per flow: each of the 'flows' flows
+// enqueues a backlog of 'n' packets, which are released at 'rate'. The wall
+// clock time, the number of simulator events and the mean error of the time
+// at which the last packet of each flow is released are reported.
+// Sample usage:  ./ns3 run 'bench-carousel --flows=10000 --n=10'
+
+#include "ns3/carousel-queue-disc.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tbf-queue-disc.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * A queue disc item carrying the index of its flow.
+ */
+class BenchItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * @param p the packet
+     * @param flow the flow of the packet
+     */
+    BenchItem(Ptr<Packet> p, uint32_t flow)
+        : QueueDiscItem(p, Address(), 0),
+          m_flow(flow)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    uint32_t Hash(uint32_t perturbation) const override
+    {
+        return m_flow;
+    }
+
+  private:
+    uint32_t m_flow; //!< the flow of the packet
+};
+
+/// Results of a run
+struct Results
+{
+    std::vector<Time> start; //!< the start time of each flow
+    std::vector<Time> last;  //!< the time the last packet of each flow is released
+    uint32_t nSent{0};       //!< the number of released packets
+};
+
+/**
+ * Enqueue the backlog of a flow and run the queue disc.
+ * @param queue the queue disc
+ * @param flow the flow
+ * @param n the number of packets
+ * @param size the size of the packets
+ */
+static void
+EnqueueBacklog(Ptr<QueueDisc> queue, uint32_t flow, uint32_t n, uint32_t size)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(Create<BenchItem>(Create<Packet>(size), flow));
+    }
+    queue->Run();
+}
+
+/**
+ * Run a scenario and print the results.
+ * @param name the name of the scenario
+ * @param queues the queue discs (one for all the flows, or one per flow)
+ * @param flows the number of flows
+ * @param n the number of packets per flow
+ * @param size the size of the packets
+ * @param rate the rate of each flow
+ */
+static void
+RunScenario(std::string name,
+            std::vector<Ptr<QueueDisc>> queues,
+            uint32_t flows,
+            uint32_t n,
+            uint32_t size,
+            DataRate rate)
+{
+    Results results;
+    results.start.resize(flows);
+    results.last.resize(flows);
+    for (auto& queue : queues)
+    {
+        queue->SetSendCallback([&results](Ptr<QueueDiscItem> item) {
+            results.last[item->Hash(0)] = Simulator::Now();
+            results.nSent++;
+        });
+        queue->Initialize();
+    }
+    for (uint32_t flow = 0; flow < flows; flow++)
+    {
+        // staggered flow starts
+        results.start[flow] = MicroSeconds(10 * (flow % 1000));
+        Simulator::Schedule(results.start[flow],
+                            &EnqueueBacklog,
+                            queues[flow % queues.size()],
+                            flow,
+                            n,
+                            size);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t elapsedMs = timer.End();
+
+    // the first packet of a flow is released at once
+    Time expected = rate.CalculateBytesTxTime(size) * (n - 1);
+    double error = 0;
+    for (uint32_t flow = 0; flow < flows; flow++)
+    {
+        error += std::abs((results.last[flow] - results.start[flow] - expected).GetMicroSeconds());
+    }
+
+    std::cout << name << ": " << results.nSent << " packets in " << elapsedMs << " ms, "
+              << Simulator::GetEventCount() << " events, mean error "
+              << error / flows << " us" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t flows = 10000;
+    uint32_t n = 10;
+    uint32_t size = 1000;
+    DataRate rate("1Mbps");
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Compare the shaping of many flows with CarouselQueueDisc and TbfQueueDisc");
+    cmd.AddValue("flows", "number of flows", flows);
+    cmd.AddValue("n", "number of packets per flow", n);
+    cmd.AddValue("size", "size of the packets", size);
+    cmd.AddValue("rate", "rate of each flow", rate);
+    cmd.Parse(argc, argv);
+
+    // the horizon of the timing wheel must cover the backlog of a flow
+    Time slotDuration = MicroSeconds(100);
+    Time horizon = rate.CalculateBytesTxTime(size) * n;
+    uint32_t numSlots = horizon.GetTimeStep() / slotDuration.GetTimeStep() + 1;
+    Ptr<CarouselQueueDisc> carousel = CreateObjectWithAttributes<CarouselQueueDisc>(
+        "MaxSize",
+        QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, flows * n)),
+        "DefaultRate",
+        DataRateValue(rate),
+        "NumSlots",
+        UintegerValue(numSlots),
+        "SlotDuration",
+        TimeValue(slotDuration));
+    RunScenario("Carousel", {carousel}, flows, n, size, rate);
+
+    std::vector<Ptr<QueueDisc>> tbfs;
+    for (uint32_t flow = 0; flow < flows; flow++)
+    {
+        tbfs.push_back(CreateObjectWithAttributes<TbfQueueDisc>(
+            "MaxSize",
+            QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, n)),
+            "Burst",
+            UintegerValue(size),
+            "Rate",
+            DataRateValue(rate)));
+    }
+    RunScenario("TBF per flow", tbfs, flows, n, size, rate);
+    return 0;
+}
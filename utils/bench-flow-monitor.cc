@@ -0,0 +1,249 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the FlowMonitor bookkeeping with many
+// flows and packets in flight: every millisecond, 'rate' packets spread over
+// 'flows' flows (one packet out of ten belonging to ten heavy flows) are
+// reported as transmitted, and are reported as received after a delay between
+// 'delay' and 'delay' + 1 ms, except one every 'lossEvery', which the monitor
+// eventually considers lost. The monitor runs with exact per-flow statistics
+// and then with sketches; the wall clock time of the simulation and of the
+// final XML serialization, the delay quantiles and the bytes of the heavy
+// flows are reported for both.
+// Sample usage:  ./ns3 run 'bench-flow-monitor --flows=1000000 --samplingRatio=0.01'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * A probe reporting the packets of the benchmark.
+ */
+class BenchProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the flow monitor
+     */
+    BenchProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+
+    /**
+     * Report a packet as transmitted.
+     * @param flowId the flow of the packet
+     * @param packetId the id of the packet
+     */
+    void Tx(FlowId flowId, FlowPacketId packetId)
+    {
+        m_flowMonitor->ReportFirstTx(this, flowId, packetId, 1000);
+    }
+
+    /**
+     * Report a packet as received.
+     * @param flowId the flow of the packet
+     * @param packetId the id of the packet
+     */
+    void Rx(FlowId flowId, FlowPacketId packetId)
+    {
+        m_flowMonitor->ReportLastRx(this, flowId, packetId, 1000);
+    }
+};
+
+/// State of the traffic generator
+struct Generator
+{
+    Ptr<BenchProbe> tx;         //!< the probe of the transmitted packets
+    Ptr<BenchProbe> rx;         //!< the probe of the received packets
+    uint32_t flows;             //!< the number of flows
+    uint32_t rate;              //!< packets per millisecond
+    uint32_t lossEvery;         //!< one packet out of lossEvery is lost
+    Time delay;                 //!< the minimum delay of the packets
+    uint64_t sent{0};           //!< the number of packets sent
+    std::vector<double> delays; //!< the delays of the received packets
+    /// the reception time, the transmission time and the sequence number of
+    /// the packets in flight
+    std::priority_queue<std::tuple<Time, Time, uint64_t>,
+                        std::vector<std::tuple<Time, Time, uint64_t>>,
+                        std::greater<>>
+        inFlight;
+
+    /**
+     * @param seq the sequence number of a packet
+     * @return the flow of the packet
+     */
+    FlowId GetFlow(uint64_t seq) const
+    {
+        return (seq % 10 == 0 ? (seq / 10) % 10 : 10 + seq % flows);
+    }
+};
+
+/**
+ * Report the packets transmitted and received during a millisecond.
+ * @param gen the generator
+ */
+static void
+Generate(Generator* gen)
+{
+    Time now = Simulator::Now();
+    while (!gen->inFlight.empty() && std::get<0>(gen->inFlight.top()) <= now)
+    {
+        auto [rxTime, txTime, seq] = gen->inFlight.top();
+        gen->inFlight.pop();
+        gen->rx->Rx(gen->GetFlow(seq), seq);
+        gen->delays.push_back((now - txTime).GetSeconds());
+    }
+    for (uint32_t i = 0; i < gen->rate; i++)
+    {
+        uint64_t seq = gen->sent++;
+        gen->tx->Tx(gen->GetFlow(seq), seq);
+        if (seq % gen->lossEvery != 0)
+        {
+            gen->inFlight.emplace(now + gen->delay + MicroSeconds(seq * 7919 % 1000), now, seq);
+        }
+    }
+    Simulator::Schedule(MilliSeconds(1), &Generate, gen);
+}
+
+/**
+ * Run the benchmark and print the results.
+ * @param name the name of the scenario
+ * @param monitor the flow monitor
+ * @param flows the number of flows
+ * @param rate the number of packets transmitted per millisecond
+ * @param lossEvery one packet out of lossEvery is lost
+ * @param delay the minimum delay of the packets
+ * @param duration the simulated time
+ */
+static void
+RunScenario(std::string name,
+            Ptr<FlowMonitor> monitor,
+            uint32_t flows,
+            uint32_t rate,
+            uint32_t lossEvery,
+            Time delay,
+            Time duration)
+{
+    Generator gen;
+    gen.tx = CreateObject<BenchProbe>(monitor);
+    gen.rx = CreateObject<BenchProbe>(monitor);
+    gen.flows = flows;
+    gen.rate = rate;
+    gen.lossEvery = lossEvery;
+    gen.delay = delay;
+    Simulator::Schedule(Seconds(0), &Generate, &gen);
+    Simulator::Stop(duration);
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    monitor->StopRightNow();
+    int64_t runMs = timer.End();
+
+    timer.Start();
+    std::size_t xmlSize = monitor->SerializeToXmlString(0, false, false).size();
+    int64_t xmlMs = timer.End();
+
+    std::cout << name << ": " << gen.sent << " packets in " << runMs << " ms, " << xmlSize
+              << " bytes of XML in " << xmlMs << " ms" << std::endl;
+
+    std::sort(gen.delays.begin(), gen.delays.end());
+    DdSketch sketch = monitor->GetDelaySketch();
+    for (double q : {0.5, 0.99})
+    {
+        double exact = gen.delays[static_cast<std::size_t>(q * (gen.delays.size() - 1))];
+        std::cout << "  delay quantile " << q << ": " << exact * 1e3 << " ms";
+        if (sketch.GetCount() > 0)
+        {
+            std::cout << ", estimated " << sketch.GetQuantile(q) * 1e3 << " ms";
+        }
+        std::cout << std::endl;
+    }
+
+    // each heavy flow sends one packet out of 100
+    uint64_t heavyBytes = gen.sent / 100 * 1000;
+    const auto& stats = monitor->GetFlowStats();
+    auto heavyHitters = monitor->GetHeavyHitters(0.005);
+    std::cout << "  heavy flows: " << heavyBytes << " bytes each";
+    if (!stats.empty())
+    {
+        std::cout << ", measured " << stats.at(0).txBytes;
+    }
+    if (!heavyHitters.empty())
+    {
+        std::cout << ", " << heavyHitters.size() << " heavy hitters estimated "
+                  << heavyHitters.back().second << " to " << heavyHitters.front().second;
+    }
+    std::cout << std::endl;
+    Simulator::Destroy();
+    monitor->Dispose();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t flows = 100000;
+    uint32_t rate = 200;
+    uint32_t lossEvery = 100;
+    Time delay = MilliSeconds(50);
+    double duration = 10;
+    double samplingRatio = 0.01;
+    uint32_t maxTrackedPackets = 0;
+    std::string snapshotFile;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the FlowMonitor bookkeeping with many flows");
+    cmd.AddValue("flows", "number of flows", flows);
+    cmd.AddValue("rate", "number of packets transmitted per millisecond", rate);
+    cmd.AddValue("lossEvery", "one packet out of lossEvery is never received", lossEvery);
+    cmd.AddValue("delay", "minimum delay of the packets", delay);
+    cmd.AddValue("duration", "simulated time in seconds", duration);
+    cmd.AddValue("samplingRatio", "FlowMonitor::SamplingRatio with sketches", samplingRatio);
+    cmd.AddValue("maxTrackedPackets", "FlowMonitor::MaxTrackedPackets", maxTrackedPackets);
+    cmd.AddValue("snapshotFile", "FlowMonitor::SnapshotFile of the exact run", snapshotFile);
+    cmd.Parse(argc, argv);
+
+    RunScenario("Exact",
+                CreateObjectWithAttributes<FlowMonitor>("MaxTrackedPackets",
+                                                        UintegerValue(maxTrackedPackets),
+                                                        "EnableHistograms",
+                                                        BooleanValue(false),
+                                                        "SnapshotFile",
+                                                        StringValue(snapshotFile)),
+                flows,
+                rate,
+                lossEvery,
+                delay,
+                Seconds(duration));
+    RunScenario("Sketches",
+                CreateObjectWithAttributes<FlowMonitor>("MaxTrackedPackets",
+                                                        UintegerValue(maxTrackedPackets),
+                                                        "EnableSketches",
+                                                        BooleanValue(true),
+                                                        "SamplingRatio",
+                                                        DoubleValue(samplingRatio)),
+                flows,
+                rate,
+                lossEvery,
+                delay,
+                Seconds(duration));
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the per-packet cost of a saturated
+// flow queueing queue disc (FqCoDel by default, or FqPie or FqCobalt): packets
+// of 'flows' flows are enqueued 'ratio' times faster than they are dequeued,
+// so that most of them are dropped because the queue disc is over its limit,
+// and the drops are accounted for. The packets are hashed into 'buckets' flow
+// queues, possibly with the set associative hash.
+// Sample usage:  ./ns3 run 'bench-fq-codel --n=10000000 --flows=100000 --buckets=65536'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-queue-disc-item.h"
+#include "ns3/object-factory.h"
+#include "ns3/queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 10000000;
+    std::string type = "ns3::FqCoDelQueueDisc";
+    uint32_t flows = 1024;
+    uint32_t buckets = 1024;
+    bool setAssociativeHash = false;
+    uint32_t ratio = 4;
+    std::string maxSize = "10240p";
+    bool verbose = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the per-packet cost of a saturated flow queueing queue disc");
+    cmd.AddValue("type", "type of the queue disc", type);
+    cmd.AddValue("n", "number of enqueued packets", n);
+    cmd.AddValue("flows", "number of flows", flows);
+    cmd.AddValue("buckets", "number of flow queues of the queue disc", buckets);
+    cmd.AddValue("setAssociativeHash",
+                 "whether to use the set associative hash",
+                 setAssociativeHash);
+    cmd.AddValue("ratio", "number of enqueued packets for each dequeued packet", ratio);
+    cmd.AddValue("maxSize", "maximum size of the queue disc", maxSize);
+    cmd.AddValue("verbose", "print the statistics of the queue disc", verbose);
+    cmd.Parse(argc, argv);
+
+    ObjectFactory factory(type);
+    factory.Set("MaxSize", StringValue(maxSize));
+    factory.Set("Flows", UintegerValue(buckets));
+    factory.Set("EnableSetAssociativeHash", BooleanValue(setAssociativeHash));
+    Ptr<QueueDisc> queueDisc = factory.Create<QueueDisc>();
+    queueDisc->Initialize();
+
+    Ipv4Header hdr;
+    hdr.SetPayloadSize(1000);
+    hdr.SetSource(Ipv4Address("10.0.0.1"));
+    hdr.SetProtocol(17);
+    Ptr<Packet> packet = Create<Packet>(1000);
+    Address dest;
+
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        hdr.SetDestination(Ipv4Address(0x0b000000 + i % flows));
+        queueDisc->Enqueue(Create<Ipv4QueueDiscItem>(packet, dest, 0, hdr));
+        if (i % ratio == 0)
+        {
+            queueDisc->Dequeue();
+        }
+    }
+    int64_t elapsedMs = timer.End();
+
+    const QueueDisc::Stats& stats = queueDisc->GetStats();
+    std::cout << n << " packets, " << stats.nTotalDroppedPackets << " dropped, in " << elapsedMs
+              << " ms (" << elapsedMs * 1e6 / n << " ns per packet), "
+              << queueDisc->GetNQueueDiscClasses() << " flow queues" << std::endl;
+    if (verbose)
+    {
+        std::cout << stats;
+    }
+    Simulator::Destroy();
+    return 0;
+}
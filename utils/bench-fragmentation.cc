@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the IPv4 and IPv6 fragmentation and
+// reassembly: 'n' UDP datagrams of 'size' bytes are sent over a link of the
+// given MTU, and fragmented and reassembled on the way. IPv6 is only run on
+// the links with an MTU of at least 1280 bytes, the IPv6 minimum MTU.
+// Sample usage:  ./ns3 run 'bench-fragmentation --n=1000 --size=65000'
+
+#include "ns3/command-line.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Run the benchmark on a single link.
+ * @param ipv6 true to use IPv6, false to use IPv4
+ * @param mtu the MTU of the link
+ * @param n the number of datagrams
+ * @param size the size of the datagrams
+ * @param realPayload true to send real bytes instead of zero-filled (virtual) payloads
+ */
+static void
+BenchLink(bool ipv6, uint16_t mtu, uint32_t n, uint32_t size, bool realPayload)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetDeviceAttribute("Mtu", UintegerValue(mtu));
+    devHelper.SetNetDevicePointToPointMode(true);
+    NetDeviceContainer devices = devHelper.Install(nodes);
+
+    Address destination;
+    if (ipv6)
+    {
+        Ipv6AddressHelper address;
+        address.SetBase(Ipv6Address("2001::"), Ipv6Prefix(64));
+        Ipv6InterfaceContainer interfaces = address.Assign(devices);
+        destination = Inet6SocketAddress(interfaces.GetAddress(1, 1), 9);
+    }
+    else
+    {
+        Ipv4AddressHelper address;
+        address.SetBase("10.0.0.0", "255.255.255.0");
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+        destination = InetSocketAddress(interfaces.GetAddress(1), 9);
+    }
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    Ptr<Socket> receiver = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    if (ipv6)
+    {
+        receiver->Bind(Inet6SocketAddress(Ipv6Address::GetAny(), 9));
+    }
+    else
+    {
+        receiver->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    }
+    uint32_t received = 0;
+    receiver->SetRecvCallback([&received](Ptr<Socket> socket) {
+        while (socket->Recv())
+        {
+            received++;
+        }
+    });
+
+    Ptr<Socket> sender = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    sender->Connect(destination);
+    std::vector<uint8_t> payload(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        payload[i] = i;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // IPv6 addresses are usable once the Duplicate Address Detection is over
+        Simulator::Schedule(Seconds(2) + MilliSeconds(i), [=, &payload]() {
+            sender->Send(realPayload ? Create<Packet>(payload.data(), size)
+                                     : Create<Packet>(size));
+        });
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t elapsedMs = timer.End();
+
+    std::cout << (ipv6 ? "IPv6" : "IPv4") << " MTU " << mtu << ": " << received << "/" << n
+              << " datagrams of " << size << " bytes in " << elapsedMs << " ms" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000;
+    uint32_t size = 65000;
+    bool realPayload = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the IPv4 and IPv6 fragmentation and reassembly");
+    cmd.AddValue("n", "number of datagrams", n);
+    cmd.AddValue("size", "size of the datagrams (at most 65507)", size);
+    cmd.AddValue("realPayload", "send real bytes instead of zero-filled payloads", realPayload);
+    cmd.Parse(argc, argv);
+
+    for (uint16_t mtu : {1280, 576})
+    {
+        BenchLink(false, mtu, n, size, realPayload);
+        if (mtu >= 1280)
+        {
+            BenchLink(true, mtu, n, size, realPayload);
+        }
+    }
+    return 0;
+}
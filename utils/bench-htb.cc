@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the cost of an HtbQueueDisc with many
+// classes: 'leaves' leaf classes, spread among 'inner' inner classes under a
+// root class of rate 'rate', are backlogged with 'n' packets each. Every leaf
+// is assured an equal share of the rate and may borrow up to the whole rate.
+// The queue disc is run for half the time needed to release the backlog, and
+// the wall clock time, the number of simulator events and the mean deviation
+// of the number of packets released per leaf from the fair share are reported.
+// Sample usage:  ./ns3 run 'bench-htb --leaves=1000 --inner=10'
+
+#include "ns3/command-line.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/htb-queue-disc.h"
+#include "ns3/integer.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * A queue disc item carrying the index of its class.
+ */
+class BenchItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     * @param p the packet
+     * @param cls the class of the packet
+     */
+    BenchItem(Ptr<Packet> p, uint32_t cls)
+        : QueueDiscItem(p, Address(), 0),
+          m_class(cls)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    uint32_t Hash(uint32_t perturbation) const override
+    {
+        return m_class;
+    }
+
+  private:
+    uint32_t m_class; //!< the class of the packet
+};
+
+/**
+ * A packet filter returning the class of the bench items.
+ */
+class BenchFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override
+    {
+        return true;
+    }
+
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override
+    {
+        return item->Hash(0);
+    }
+};
+
+/**
+ * Add a class to the queue disc.
+ * @param queue the queue disc
+ * @param parent the index of the parent class
+ * @param rate the assured rate
+ * @param ceil the maximum rate
+ * @param limit the capacity of the queue disc of the class in packets
+ */
+static void
+AddClass(Ptr<HtbQueueDisc> queue, int32_t parent, DataRate rate, DataRate ceil, uint32_t limit)
+{
+    Ptr<QueueDisc> qd = CreateObjectWithAttributes<FifoQueueDisc>(
+        "MaxSize",
+        QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, limit)));
+    qd->Initialize();
+    Ptr<HtbClass> c = CreateObjectWithAttributes<HtbClass>("Parent",
+                                                           IntegerValue(parent),
+                                                           "Rate",
+                                                           DataRateValue(rate),
+                                                           "Ceil",
+                                                           DataRateValue(ceil));
+    c->SetQueueDisc(qd);
+    queue->AddQueueDiscClass(c);
+}
+
+/**
+ * Enqueue the backlog of all the leaves and run the queue disc.
+ * @param queue the queue disc
+ * @param first the index of the first leaf class
+ * @param leaves the number of leaves
+ * @param n the number of packets per leaf
+ * @param size the size of the packets
+ */
+static void
+EnqueueBacklog(Ptr<QueueDisc> queue, uint32_t first, uint32_t leaves, uint32_t n, uint32_t size)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        for (uint32_t leaf = 0; leaf < leaves; leaf++)
+        {
+            queue->Enqueue(Create<BenchItem>(Create<Packet>(size), first + leaf));
+        }
+    }
+    queue->Run();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t leaves = 1000;
+    uint32_t inner = 10;
+    uint32_t n = 100;
+    uint32_t size = 1000;
+    DataRate rate("1Gbps");
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Measure the cost of an HtbQueueDisc with many classes");
+    cmd.AddValue("leaves", "number of leaf classes", leaves);
+    cmd.AddValue("inner", "number of inner classes (0 to attach the leaves to the root)", inner);
+    cmd.AddValue("n", "number of packets per leaf", n);
+    cmd.AddValue("size", "size of the packets", size);
+    cmd.AddValue("rate", "rate of the root class", rate);
+    cmd.Parse(argc, argv);
+
+    Ptr<HtbQueueDisc> queue = CreateObject<HtbQueueDisc>();
+    queue->AddPacketFilter(CreateObject<BenchFilter>());
+    AddClass(queue, -1, rate, rate, 1);
+    for (uint32_t i = 0; i < inner; i++)
+    {
+        AddClass(queue, 0, DataRate(rate.GetBitRate() / inner), rate, 1);
+    }
+    uint32_t first = 1 + inner;
+    for (uint32_t leaf = 0; leaf < leaves; leaf++)
+    {
+        int32_t parent = (inner > 0 ? 1 + leaf % inner : 0);
+        AddClass(queue, parent, DataRate(rate.GetBitRate() / leaves), rate, n);
+    }
+
+    std::vector<uint32_t> sent(first + leaves, 0);
+    uint32_t nSent = 0;
+    queue->SetSendCallback([&sent, &nSent](Ptr<QueueDiscItem> item) {
+        sent[item->Hash(0)]++;
+        nSent++;
+    });
+    queue->Initialize();
+
+    Simulator::Schedule(Seconds(0), &EnqueueBacklog, queue, first, leaves, n, size);
+    Time duration = rate.CalculateBytesTxTime(size) * (leaves * n / 2);
+    Simulator::Stop(duration);
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t elapsedMs = timer.End();
+
+    double fairShare = static_cast<double>(nSent) / leaves;
+    double error = 0;
+    for (uint32_t leaf = 0; leaf < leaves; leaf++)
+    {
+        error += std::abs(sent[first + leaf] - fairShare);
+    }
+
+    std::cout << leaves << " leaves, " << inner << " inner classes: " << nSent << " packets in "
+              << elapsedMs << " ms, " << Simulator::GetEventCount() << " events, mean deviation "
+              << error / leaves << " packets from a fair share of " << fairShare << std::endl;
+    Simulator::Destroy();
+    return 0;
+}
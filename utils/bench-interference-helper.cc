@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the InterferenceHelper: 'ppdus'
+// 802.11a PPDUs arrive on a single band, with about 'overlap' of them being
+// received at any time. A PPDU is received whenever no other PPDU is being
+// received, and the SNR and PER of its PHY header and payload are computed at
+// the end of its reception, as done by the PHY entities. The wall clock time,
+// the number of PPDUs successfully received and their mean SNR are reported.
+// The NIST or YANS error rate model is used first analytically and then with
+// its lookup tables; the TableBasedErrorRateModel is used once.
+// Sample usage:  ./ns3 run 'bench-interference-helper --ppdus=100000 --overlap=50'
+
+#include "ns3/command-line.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/ofdm-ppdu.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/table-based-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+#include "ns3/yans-error-rate-model.h"
+
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/// The state of the benchmark
+struct BenchState
+{
+    Ptr<InterferenceHelper> interference;  //!< the interference helper
+    WifiSpectrumBandInfo band;             //!< the band
+    Ptr<UniformRandomVariable> rxPower;    //!< the RX power of the PPDUs (dBm)
+    Ptr<Event> rxEvent;                    //!< the event being received, if any
+    uint32_t received{0};                  //!< the number of PPDUs received
+    uint32_t success{0};                   //!< the number of PPDUs successfully received
+    double snrSum{0};                      //!< the sum of the payload SNRs (dB)
+    Time preambleAndHeader;                //!< the duration of the preamble and header
+};
+
+/**
+ * End the reception of a PPDU
+ * @param state the state of the benchmark
+ */
+static void
+EndRx(BenchState* state)
+{
+    const auto& event = state->rxEvent;
+    const auto header =
+        state->interference->CalculatePhyHeaderSnrPer(event,
+                                                      MHz_u{20},
+                                                      state->band,
+                                                      WIFI_PPDU_FIELD_NON_HT_HEADER);
+    const auto payload = state->interference->CalculatePayloadSnrPer(
+        event,
+        MHz_u{20},
+        state->band,
+        SU_STA_ID,
+        {Time{0}, event->GetDuration() - state->preambleAndHeader});
+    state->received++;
+    state->snrSum += RatioToDb(payload.snr);
+    if (header.per < 0.5 && payload.per < 0.5)
+    {
+        state->success++;
+    }
+    state->interference->NotifyRxEnd(Simulator::Now(), WIFI_SPECTRUM_5_GHZ);
+    state->rxEvent = nullptr;
+}
+
+/**
+ * Start the reception of a PPDU
+ * @param state the state of the benchmark
+ * @param ppdu the PPDU
+ */
+static void
+StartRx(BenchState* state, Ptr<const WifiPpdu> ppdu)
+{
+    RxPowerWattPerChannelBand rxPower{{state->band, DbmToW(state->rxPower->GetValue())}};
+    auto event = state->interference->Add(ppdu,
+                                          ppdu->GetTxDuration(),
+                                          rxPower,
+                                          WIFI_SPECTRUM_5_GHZ);
+    if (!state->rxEvent)
+    {
+        state->interference->NotifyRxStart(WIFI_SPECTRUM_5_GHZ);
+        state->rxEvent = event;
+        Simulator::Schedule(ppdu->GetTxDuration(), &EndRx, state);
+    }
+}
+
+/**
+ * Run the benchmark
+ * @param ppdus the number of PPDUs
+ * @param overlap the average number of overlapping PPDUs
+ * @param errorModel the error rate model (nist, yans or table)
+ * @param lookupTables whether the lookup tables of the error rate model are used
+ */
+static void
+BenchInterference(uint32_t ppdus,
+                  uint32_t overlap,
+                  const std::string& errorModel,
+                  bool lookupTables)
+{
+    BenchState state;
+    state.interference = CreateObject<InterferenceHelper>();
+    state.interference->SetNoiseFigure(DbToRatio(7));
+    Ptr<ErrorRateModel> model;
+    if (errorModel == "table")
+    {
+        model = CreateObject<TableBasedErrorRateModel>();
+    }
+    else if (errorModel == "yans")
+    {
+        model = CreateObjectWithAttributes<YansErrorRateModel>("UseLookupTables",
+                                                               BooleanValue(lookupTables));
+    }
+    else
+    {
+        model = CreateObjectWithAttributes<NistErrorRateModel>("UseLookupTables",
+                                                               BooleanValue(lookupTables));
+    }
+    state.interference->SetErrorRateModel(model);
+    state.band = {{{1, 64}}, {{MHzToHz(MHz_u{5170}), MHzToHz(MHz_u{5190})}}};
+    state.interference->AddBand(state.band);
+    state.rxPower = CreateObject<UniformRandomVariable>();
+    state.rxPower->SetAttribute("Min", DoubleValue(-100));
+    state.rxPower->SetAttribute("Max", DoubleValue(-40));
+    state.rxPower->SetStream(1);
+
+    WifiPhyOperatingChannel channel;
+    channel.SetDefault(MHz_u{20}, WIFI_STANDARD_80211a, WIFI_PHY_BAND_5GHZ);
+    WifiTxVector txVector{OfdmPhy::GetOfdmRate24Mbps(),
+                          0,
+                          WIFI_PREAMBLE_LONG,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          MHz_u{20},
+                          false};
+    state.preambleAndHeader = WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    Ptr<Packet> packet = Create<Packet>(1000);
+    Time start;
+    for (uint32_t i = 0; i < ppdus; i++)
+    {
+        auto ppdu = Create<OfdmPpdu>(Create<WifiPsdu>(packet, hdr), txVector, channel, i);
+        Simulator::Schedule(start, &StartRx, &state, ppdu);
+        start += ppdu->GetTxDuration() / overlap;
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t runMs = timer.End();
+
+    std::cout << errorModel << (lookupTables ? " with lookup tables" : "") << ", " << ppdus
+              << " PPDUs, " << state.received << " received, " << state.success
+              << " successfully, mean SNR " << state.snrSum / state.received
+              << " dB: " << runMs << " ms" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t ppdus = 100000;
+    uint32_t overlap = 50;
+    std::string errorModel = "nist";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the InterferenceHelper");
+    cmd.AddValue("ppdus", "number of PPDUs", ppdus);
+    cmd.AddValue("overlap", "average number of overlapping PPDUs", overlap);
+    cmd.AddValue("errorModel", "error rate model (nist, yans or table)", errorModel);
+    cmd.Parse(argc, argv);
+
+    if (errorModel == "table")
+    {
+        BenchInterference(ppdus, overlap, errorModel, false);
+    }
+    else
+    {
+        BenchInterference(ppdus, overlap, errorModel, false);
+        BenchInterference(ppdus, overlap, errorModel, true);
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the ARP and NDISC caches: insertion,
+// lookup and removal of 'n' neighbors, and the population of the caches of
+// a LAN of 'nodes' nodes through the NeighborCacheHelper.
+// Sample usage:  ./ns3 run 'bench-neighbor-cache --n=10000 --nodes=200'
+
+#include "ns3/arp-cache.h"
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ndisc-cache.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Run the ARP cache benchmark.
+ * @param n the number of neighbors
+ * @param lookups the number of lookup rounds over all the neighbors
+ */
+static void
+BenchArp(uint32_t n, uint32_t lookups)
+{
+    std::vector<Ipv4Address> addresses;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        addresses.emplace_back(0x0a000000 + i);
+    }
+
+    Ptr<ArpCache> cache = CreateObject<ArpCache>();
+    SystemWallClockMs timer;
+
+    timer.Start();
+    for (const auto& address : addresses)
+    {
+        ArpCache::Entry* entry = cache->Add(address);
+        entry->SetMacAddress(Mac48Address::Allocate());
+        entry->MarkAutoGenerated();
+    }
+    int64_t addMs = timer.End();
+
+    uint64_t found = 0;
+    timer.Start();
+    for (uint32_t r = 0; r < lookups; r++)
+    {
+        for (const auto& address : addresses)
+        {
+            found += (cache->Lookup(address) != nullptr);
+        }
+    }
+    int64_t lookupMs = timer.End();
+
+    timer.Start();
+    for (const auto& address : addresses)
+    {
+        cache->Remove(cache->Lookup(address));
+    }
+    int64_t removeMs = timer.End();
+
+    std::cout << "ArpCache:   add " << addMs << " ms, " << found << " lookups " << lookupMs
+              << " ms, remove " << removeMs << " ms" << std::endl;
+    cache->Dispose();
+}
+
+/**
+ * Run the NDISC cache benchmark.
+ * @param n the number of neighbors
+ * @param lookups the number of lookup rounds over all the neighbors
+ */
+static void
+BenchNdisc(uint32_t n, uint32_t lookups)
+{
+    std::vector<Ipv6Address> addresses;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        addresses.push_back(Ipv6Address::MakeAutoconfiguredAddress(Mac48Address::Allocate(),
+                                                                   Ipv6Address("2001::")));
+    }
+
+    Ptr<NdiscCache> cache = CreateObject<NdiscCache>();
+    SystemWallClockMs timer;
+
+    timer.Start();
+    for (const auto& address : addresses)
+    {
+        NdiscCache::Entry* entry = cache->Add(address);
+        entry->SetMacAddress(Mac48Address::Allocate());
+        entry->MarkAutoGenerated();
+    }
+    int64_t addMs = timer.End();
+
+    uint64_t found = 0;
+    timer.Start();
+    for (uint32_t r = 0; r < lookups; r++)
+    {
+        for (const auto& address : addresses)
+        {
+            found += (cache->Lookup(address) != nullptr);
+        }
+    }
+    int64_t lookupMs = timer.End();
+
+    timer.Start();
+    for (const auto& address : addresses)
+    {
+        cache->Remove(cache->Lookup(address));
+    }
+    int64_t removeMs = timer.End();
+
+    std::cout << "NdiscCache: add " << addMs << " ms, " << found << " lookups " << lookupMs
+              << " ms, remove " << removeMs << " ms" << std::endl;
+    cache->Dispose();
+}
+
+/**
+ * Run the NeighborCacheHelper benchmark on a single LAN.
+ * @param nodes the number of nodes in the LAN
+ */
+static void
+BenchPopulate(uint32_t nodes)
+{
+    NodeContainer lan;
+    lan.Create(nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(lan);
+
+    InternetStackHelper internet;
+    internet.Install(lan);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.0.0.0");
+    ipv4.Assign(devices);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001::"), Ipv6Prefix(64));
+    ipv6.Assign(devices);
+
+    NeighborCacheHelper neighborCache;
+    SystemWallClockMs timer;
+    timer.Start();
+    neighborCache.PopulateNeighborCache();
+    int64_t populateMs = timer.End();
+
+    timer.Start();
+    neighborCache.FlushAutoGenerated();
+    int64_t flushMs = timer.End();
+
+    std::cout << "NeighborCacheHelper: populate " << populateMs << " ms, flush " << flushMs
+              << " ms (" << nodes << " nodes)" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 10000;
+    uint32_t lookups = 100;
+    uint32_t nodes = 200;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the ARP and NDISC neighbor caches");
+    cmd.AddValue("n", "number of neighbors in the cache", n);
+    cmd.AddValue("lookups", "number of lookup rounds over all the neighbors", lookups);
+    cmd.AddValue("nodes", "number of nodes in the LAN populated by NeighborCacheHelper", nodes);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-neighbor-cache with n=" << n << std::endl;
+    BenchArp(n, lookups);
+    BenchNdisc(n, lookups);
+    if (nodes > 0)
+    {
+        BenchPopulate(nodes);
+    }
+    return 0;
+}
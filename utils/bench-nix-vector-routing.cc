@@ -0,0 +1,143 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the nix-vector routing setup time
+// and cache memory on a k-ary fat-tree datacenter topology: every host
+// computes the routes toward 'flows' random hosts.
+// Sample usage:  ./ns3 run 'bench-nix-vector-routing --k=8 --flows=64'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-routing.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Run the benchmark on a fat-tree.
+ * @param k the number of ports of the switches
+ * @param flows the number of destinations per host
+ * @param maxCacheMemory the MaxCacheMemory attribute (0 means unlimited)
+ */
+static void
+BenchFatTree(uint32_t k, uint32_t flows, uint64_t maxCacheMemory)
+{
+    Config::SetDefault("ns3::Ipv4NixVectorRouting::MaxCacheMemory",
+                       UintegerValue(maxCacheMemory));
+
+    uint32_t half = k / 2;
+    NodeContainer core;
+    NodeContainer aggregation;
+    NodeContainer edge;
+    NodeContainer hosts;
+    core.Create(half * half);
+    aggregation.Create(k * half);
+    edge.Create(k * half);
+    hosts.Create(k * half * half);
+
+    Ipv4NixVectorHelper nixRouting;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(nixRouting);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(NodeContainer(core, aggregation, edge, hosts));
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    std::vector<Ipv4Address> hostAddresses;
+
+    auto connect = [&](Ptr<Node> a, Ptr<Node> b) {
+        NetDeviceContainer devices = devHelper.Install(NodeContainer(a, b));
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+        address.NewNetwork();
+        return interfaces;
+    };
+
+    for (uint32_t pod = 0; pod < k; pod++)
+    {
+        for (uint32_t i = 0; i < half; i++)
+        {
+            Ptr<Node> edgeSwitch = edge.Get(pod * half + i);
+            for (uint32_t h = 0; h < half; h++)
+            {
+                Ptr<Node> host = hosts.Get((pod * half + i) * half + h);
+                hostAddresses.push_back(connect(host, edgeSwitch).GetAddress(0));
+            }
+            for (uint32_t j = 0; j < half; j++)
+            {
+                connect(edgeSwitch, aggregation.Get(pod * half + j));
+            }
+        }
+        for (uint32_t j = 0; j < half; j++)
+        {
+            for (uint32_t c = 0; c < half; c++)
+            {
+                connect(aggregation.Get(pod * half + j), core.Get(j * half + c));
+            }
+        }
+    }
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+    uint64_t routes = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t i = 0; i < hosts.GetN(); i++)
+    {
+        Ptr<Ipv4RoutingProtocol> rp = hosts.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol();
+        for (uint32_t f = 0; f < flows; f++)
+        {
+            Ipv4Header header;
+            header.SetDestination(
+                hostAddresses[random->GetInteger(0, hostAddresses.size() - 1)]);
+            Socket::SocketErrno sockerr;
+            routes += (rp->RouteOutput(nullptr, header, nullptr, sockerr) != nullptr);
+        }
+    }
+    int64_t setupMs = timer.End();
+
+    uint64_t memory = 0;
+    for (uint32_t i = 0; i < hosts.GetN(); i++)
+    {
+        memory += hosts.Get(i)->GetObject<Ipv4NixVectorRouting>()->GetCacheMemoryUsage();
+    }
+
+    std::cout << "fat-tree k=" << k << " (" << hosts.GetN() << " hosts), max cache memory "
+              << maxCacheMemory << " B: " << routes << " routes in " << setupMs << " ms, "
+              << memory / 1024 << " KiB of caches" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t k = 8;
+    uint32_t flows = 64;
+    uint64_t maxCacheMemory = 16384;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the nix-vector routing on a fat-tree topology");
+    cmd.AddValue("k", "number of ports of the fat-tree switches (even)", k);
+    cmd.AddValue("flows", "number of destinations per host", flows);
+    cmd.AddValue("maxCacheMemory",
+                 "per-node cache memory limit of the second run, in bytes",
+                 maxCacheMemory);
+    cmd.Parse(argc, argv);
+
+    BenchFatTree(k, flows, 0);
+    BenchFatTree(k, flows, maxCacheMemory);
+    return 0;
+}
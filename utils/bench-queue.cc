@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the enqueue/dequeue throughput of the
+// queues at different depths: for each depth, a queue is filled with 'depth'
+// packets, then 'n' packets are enqueued and as many are dequeued, one by one,
+// so that the queue stays at the given depth. The time per enqueue/dequeue
+// pair is reported for a std::list and a RingBuffer container, and for a
+// DropTailQueue<Packet> (whose container is a RingBuffer).
+// Sample usage:  ./ns3 run 'bench-queue --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <list>
+
+using namespace ns3;
+
+/**
+ * Benchmark a container at the given depth.
+ * @tparam Container \deduced the type of the container
+ * @param container the container
+ * @param depth the number of packets in the container
+ * @param n the number of enqueue/dequeue pairs
+ * @param packet the packet to enqueue
+ * @return the elapsed time in ms
+ */
+template <typename Container>
+int64_t
+RunContainer(Container& container, uint32_t depth, uint32_t n, Ptr<Packet> packet)
+{
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        container.insert(container.end(), packet);
+    }
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        container.insert(container.end(), packet);
+        container.erase(container.begin());
+    }
+    return timer.End();
+}
+
+/**
+ * Benchmark a DropTailQueue at the given depth.
+ * @param depth the number of packets in the queue
+ * @param n the number of enqueue/dequeue pairs
+ * @param packet the packet to enqueue
+ * @return the elapsed time in ms
+ */
+static int64_t
+RunDropTailQueue(uint32_t depth, uint32_t n, Ptr<Packet> packet)
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, depth + 1));
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        queue->Enqueue(packet);
+    }
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(packet);
+        queue->Dequeue();
+    }
+    int64_t elapsedMs = timer.End();
+    queue->Dispose();
+    return elapsedMs;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the enqueue/dequeue throughput of the queues at different depths");
+    cmd.AddValue("n", "number of enqueue/dequeue pairs per depth", n);
+    cmd.Parse(argc, argv);
+
+    Ptr<Packet> packet = Create<Packet>(1000);
+
+    std::cout << "depth\tstd::list (ns)\tRingBuffer (ns)\tDropTailQueue (ns)" << std::endl;
+    for (uint32_t depth : {10, 100, 1000, 10000, 100000})
+    {
+        std::list<Ptr<Packet>> list;
+        int64_t listMs = RunContainer(list, depth, n, packet);
+        RingBuffer<Ptr<Packet>> ring;
+        int64_t ringMs = RunContainer(ring, depth, n, packet);
+        int64_t queueMs = RunDropTailQueue(depth, n, packet);
+        std::cout << depth << "\t" << listMs * 1e6 / n << "\t" << ringMs * 1e6 / n << "\t"
+                  << queueMs * 1e6 / n << std::endl;
+    }
+    return 0;
+}
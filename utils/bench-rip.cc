@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the RIP convergence on a large
+// topology: 'rows' x 'cols' routers are connected in a grid, each link being
+// a /30 network, and RIP is run until every router has a route to the two
+// opposite corners of the grid. The wall-clock time and the simulated
+// convergence time are reported.
+// Sample usage:  ./ns3 run 'bench-rip --rows=40 --cols=50'
+
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+#include "ns3/neighbor-cache-helper.h"
+#include "ns3/rip-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Check if a router has a route to a destination.
+ * @param node the router
+ * @param destination the destination
+ * @return true if the router has a route
+ */
+static bool
+HasRoute(Ptr<Node> node, Ipv4Address destination)
+{
+    Ptr<Ipv4RoutingProtocol> routing = node->GetObject<Ipv4>()->GetRoutingProtocol();
+    Ipv4Header header;
+    header.SetDestination(destination);
+    Socket::SocketErrno sockerr;
+    return routing->RouteOutput(nullptr, header, nullptr, sockerr) != nullptr;
+}
+
+/**
+ * Check the convergence, and schedule the next check if not converged.
+ * @param nodes the routers
+ * @param first an address of the first router
+ * @param last an address of the last router
+ * @param interval the interval between the checks
+ * @param convergence the convergence time, set when converged
+ */
+static void
+CheckConvergence(NodeContainer nodes,
+                 Ipv4Address first,
+                 Ipv4Address last,
+                 Time interval,
+                 Time* convergence)
+{
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        if ((i != 0 && !HasRoute(nodes.Get(i), first)) ||
+            (i != nodes.GetN() - 1 && !HasRoute(nodes.Get(i), last)))
+        {
+            Simulator::Schedule(interval,
+                                &CheckConvergence,
+                                nodes,
+                                first,
+                                last,
+                                interval,
+                                convergence);
+            return;
+        }
+    }
+    *convergence = Simulator::Now();
+    Simulator::Stop();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t rows = 40;
+    uint32_t cols = 50;
+    Time stopTime = Seconds(600);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the RIP convergence on a grid of routers");
+    cmd.AddValue("rows", "number of rows of the grid", rows);
+    cmd.AddValue("cols", "number of columns of the grid", cols);
+    cmd.AddValue("stopTime", "maximum simulated time", stopTime);
+    cmd.Parse(argc, argv);
+
+    NodeContainer nodes;
+    nodes.Create(rows * cols);
+
+    RipHelper rip;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(rip);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    uint32_t nLinks = 0;
+    Ipv4Address first;
+    Ipv4Address last;
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        for (uint32_t c = 0; c < cols; c++)
+        {
+            uint32_t i = r * cols + c;
+            for (uint32_t j : {i + 1, i + cols})
+            {
+                if ((j == i + 1 && c + 1 == cols) || (j == i + cols && r + 1 == rows))
+                {
+                    continue;
+                }
+                Ipv4InterfaceContainer interfaces =
+                    address.Assign(devHelper.Install(NodeContainer(nodes.Get(i), nodes.Get(j))));
+                address.NewNetwork();
+                nLinks++;
+                if (i == 0)
+                {
+                    first = interfaces.GetAddress(0);
+                }
+                if (j == nodes.GetN() - 1)
+                {
+                    last = interfaces.GetAddress(1);
+                }
+            }
+        }
+    }
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    Time convergence;
+    Simulator::Schedule(Seconds(1),
+                        &CheckConvergence,
+                        nodes,
+                        first,
+                        last,
+                        Seconds(1),
+                        &convergence);
+    Simulator::Stop(stopTime);
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    int64_t elapsedMs = timer.End();
+
+    std::cout << rows * cols << " routers, " << nLinks << " links: ";
+    if (convergence.IsZero())
+    {
+        std::cout << "not converged after " << stopTime.As(Time::S);
+    }
+    else
+    {
+        std::cout << "converged after " << convergence.As(Time::S);
+    }
+    std::cout << " (simulated), " << elapsedMs << " ms (wall clock)" << std::endl;
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the cost of the channel access
+// procedure in a dense BSS: each of 'stations' stations sends 'size' bytes
+// packets to the access point every 'interval' on each of 'acs' Access
+// Categories (AC_BE, AC_BK, AC_VI, AC_VO, in this order), during 'duration'
+// seconds, so that many EDCAFs contend for the medium. The wall clock time,
+// the number of simulator events executed, the number of heap allocations and
+// the number of bytes received by the access point are reported.
+// Sample usage:  ./ns3 run 'bench-wifi-channel-access --stations=50 --acs=4'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0; //!< number of heap allocations
+
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param acs the number of Access Categories used by every station
+ * @param size the size of the packets (bytes)
+ * @param interval the interval between two packets sent by a station on an AC
+ * @param duration the duration of the traffic
+ */
+static void
+BenchChannelAccess(uint32_t stations, uint32_t acs, uint32_t size, Time interval, Time duration)
+{
+    RngSeedManager::SetSeed(50);
+    RngSeedManager::SetRun(50);
+
+    NodeContainer ap(1);
+    NodeContainer stas(stations);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs7"),
+                                 "ControlMode",
+                                 StringValue("HeMcs0"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    WifiMacHelper mac;
+    Ssid ssid("bench-wifi-channel-access");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, ap);
+    mac.SetType("ns3::StaWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "MaxMissedBeacons",
+                UintegerValue(std::numeric_limits<uint32_t>::max()));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, stas);
+    WifiHelper::AssignStreams(apDevice, 10);
+    WifiHelper::AssignStreams(staDevices, 100);
+
+    MobilityHelper mobility;
+    mobility.Install(ap);
+    mobility.Install(stas);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(ap);
+    packetSocket.Install(stas);
+    uint64_t rxBytes = 0;
+    // a TID mapped to AC_BE, AC_BK, AC_VI and AC_VO, respectively
+    const std::array<uint8_t, 4> tids{0, 1, 5, 7};
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(staDevices.Get(i)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(apDevice.Get(0)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        for (uint32_t ac = 0; ac < acs; ac++)
+        {
+            auto client = CreateObject<PacketSocketClient>();
+            client->SetRemote(socketAddr);
+            client->SetAttribute("PacketSize", UintegerValue(size));
+            client->SetAttribute("MaxPackets", UintegerValue(0));
+            client->SetAttribute("Interval", TimeValue(interval));
+            client->SetAttribute("Priority", UintegerValue(tids[ac]));
+            client->SetStartTime(Seconds(1) + MicroSeconds(10 * (i * acs + ac)));
+            client->SetStopTime(Seconds(1) + duration);
+            stas.Get(i)->AddApplication(client);
+        }
+    }
+
+    PacketSocketAddress socketAddr;
+    socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+    socketAddr.SetProtocol(1);
+    auto server = CreateObject<PacketSocketServer>();
+    server->SetLocal(socketAddr);
+    server->TraceConnectWithoutContext(
+        "Rx",
+        Callback<void, Ptr<const Packet>, const Address&>(
+            [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                rxBytes += packet->GetSize();
+            }));
+    ap.Get(0)->AddApplication(server);
+
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t allocations = g_allocations;
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    allocations = g_allocations - allocations;
+    int64_t runMs = timer.End();
+
+    std::cout << stations << " stations, " << acs << " ACs: " << runMs << " ms, "
+              << Simulator::GetEventCount() << " events, " << allocations << " allocations, "
+              << rxBytes << " bytes received" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 100;
+    uint32_t acs = 2;
+    uint32_t size = 1000;
+    Time interval = MilliSeconds(2);
+    Time duration = Seconds(1);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the channel access procedure in a dense BSS");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("acs", "number of Access Categories used by every station (1 to 4)", acs);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("interval", "interval between two packets sent by a station on an AC", interval);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(acs < 1 || acs > 4, "The number of ACs must be between 1 and 4");
+    BenchChannelAccess(stations, acs, size, interval, duration);
+
+    return 0;
+}
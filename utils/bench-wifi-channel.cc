@@ -0,0 +1,151 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the benefit of the spatial index of the
+// wifi channels: 'stations' ad hoc stations are placed at random in a square
+// of side 'side' meters, and each of them sends 'packets' broadcast frames at
+// random times during one second. The scenario is run on a YansWifiChannel or,
+// if 'spectrum' is set, on a MultiModelSpectrumChannel, first without and then
+// with the spatial index, and the wall clock time, the number of simulator
+// events and the number of frames received are reported for both runs.
+// Sample usage:  ./ns3 run 'bench-wifi-channel --stations=1000'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/position-allocator.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param side the side of the square (m)
+ * @param packets the number of frames sent per station
+ * @param spectrum whether a MultiModelSpectrumChannel is used
+ * @param maxLossDb the MaxLossDb attribute of the spectrum channel
+ * @param cellSize the size of the cells of the spatial index (m), or 0
+ */
+static void
+BenchChannel(uint32_t stations,
+             double side,
+             uint32_t packets,
+             bool spectrum,
+             double maxLossDb,
+             double cellSize)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes(stations);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+
+    NetDeviceContainer devices;
+    if (spectrum)
+    {
+        auto channel = CreateObjectWithAttributes<MultiModelSpectrumChannel>(
+            "MaxLossDb",
+            DoubleValue(maxLossDb),
+            "SpatialIndexCellSize",
+            DoubleValue(cellSize));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        SpectrumWifiPhyHelper phy;
+        phy.SetChannel(channel);
+        devices = wifi.Install(phy, mac, nodes);
+    }
+    else
+    {
+        auto channel = YansWifiChannelHelper::Default().Create();
+        channel->SetAttribute("SpatialIndexCellSize", DoubleValue(cellSize));
+        YansWifiPhyHelper phy;
+        phy.SetChannel(channel);
+        devices = wifi.Install(phy, mac, nodes);
+    }
+    wifi.AssignStreams(devices, 100);
+
+    auto positions = CreateObjectWithAttributes<RandomRectanglePositionAllocator>(
+        "X",
+        StringValue("ns3::UniformRandomVariable[Min=0|Max=" + std::to_string(side) + "]"),
+        "Y",
+        StringValue("ns3::UniformRandomVariable[Min=0|Max=" + std::to_string(side) + "]"));
+    positions->AssignStreams(200);
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(nodes);
+
+    uint64_t received = 0;
+    Callback<void, Ptr<const Packet>> rxEnd = [&received](Ptr<const Packet>) { received++; };
+    Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable>();
+    start->SetStream(1);
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        auto dev = DynamicCast<WifiNetDevice>(devices.Get(i));
+        dev->GetPhy()->TraceConnectWithoutContext("PhyRxEnd", rxEnd);
+        for (uint32_t p = 0; p < packets; p++)
+        {
+            Simulator::Schedule(Seconds(1 + start->GetValue()), [dev]() {
+                dev->Send(Create<Packet>(100), dev->GetBroadcast(), 1);
+            });
+        }
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(Seconds(2.1));
+    Simulator::Run();
+    int64_t runMs = timer.End();
+
+    std::cout << (spectrum ? "spectrum" : "yans") << " channel, "
+              << (cellSize > 0 ? "spatial index" : "no index") << ": " << runMs << " ms, "
+              << Simulator::GetEventCount() << " events, " << received << " frames received"
+              << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 1000;
+    double side = 3000;
+    uint32_t packets = 5;
+    bool spectrum = false;
+    double maxLossDb = 130;
+    double cellSize = 250;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the spatial index of the wifi channels");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("side", "side of the square in which the stations are placed (m)", side);
+    cmd.AddValue("packets", "number of frames sent per station", packets);
+    cmd.AddValue("spectrum", "use a MultiModelSpectrumChannel", spectrum);
+    cmd.AddValue("maxLossDb", "MaxLossDb attribute of the spectrum channel", maxLossDb);
+    cmd.AddValue("cellSize", "size of the cells of the spatial index (m)", cellSize);
+    cmd.Parse(argc, argv);
+
+    BenchChannel(stations, side, packets, spectrum, maxLossDb, 0);
+    BenchChannel(stations, side, packets, spectrum, maxLossDb, cellSize);
+
+    return 0;
+}
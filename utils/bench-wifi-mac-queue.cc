@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the performance of the WifiMacQueue of
+// a saturated 802.11ax access point: the access point sends 'size' bytes
+// packets to each of its 'stations' stations as fast as possible during
+// 'duration' seconds, so that its queue holds one container queue per station
+// and A-MPDUs are transmitted to each of them. The wall clock time, the number
+// of heap allocations and the number of bytes received are reported. Then, the
+// operations performed on the MAC queue container at each transmission opportunity
+// are replayed directly for 'rounds' rounds: for each of the 'stations' container
+// queues, which hold 'depth' MPDUs among which the first 'inflight' are inflight,
+// expired MPDUs are looked for, the first MPDU is dequeued (acknowledged) and a
+// new MPDU is enqueued.
+// Sample usage:  ./ns3 run 'bench-wifi-mac-queue --stations=128'
+
+#include "ns3/command-line.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-mac-queue-container.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0; //!< number of heap allocations
+
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param size the size of the packets (bytes)
+ * @param interval the interval between two packets sent to a station
+ * @param duration the duration of the traffic
+ * @param mode the data mode
+ */
+static void
+BenchMacQueue(uint32_t stations,
+              uint32_t size,
+              Time interval,
+              Time duration,
+              const std::string& mode)
+{
+    RngSeedManager::SetSeed(30);
+    RngSeedManager::SetRun(30);
+
+    NodeContainer ap(1);
+    NodeContainer stas(stations);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(mode),
+                                 "ControlMode",
+                                 StringValue("HeMcs0"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    WifiMacHelper mac;
+    Ssid ssid("bench-wifi-mac-queue");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, ap);
+    mac.SetType("ns3::StaWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "MaxMissedBeacons",
+                UintegerValue(std::numeric_limits<uint32_t>::max()));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, stas);
+    WifiHelper::AssignStreams(apDevice, 10);
+    WifiHelper::AssignStreams(staDevices, 100);
+
+    MobilityHelper mobility;
+    mobility.Install(ap);
+    mobility.Install(stas);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(ap);
+    packetSocket.Install(stas);
+    uint64_t rxBytes = 0;
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(staDevices.Get(i)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(size));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(interval));
+        client->SetStartTime(Seconds(1) + MicroSeconds(10 * i));
+        client->SetStopTime(Seconds(1) + duration);
+        ap.Get(0)->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext(
+            "Rx",
+            Callback<void, Ptr<const Packet>, const Address&>(
+                [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                    rxBytes += packet->GetSize();
+                }));
+        stas.Get(i)->AddApplication(server);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t allocations = g_allocations;
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    allocations = g_allocations - allocations;
+    int64_t runMs = timer.End();
+
+    std::cout << stations << " stations: " << runMs << " ms, " << allocations
+              << " allocations, " << rxBytes << " bytes received" << std::endl;
+    Simulator::Destroy();
+}
+
+/**
+ * Replay the operations performed on the MAC queue container
+ * @param stations the number of container queues
+ * @param depth the number of MPDUs in each container queue
+ * @param inflight the number of inflight MPDUs at the head of each container queue
+ * @param rounds the number of rounds
+ */
+static void
+BenchContainer(uint32_t stations, uint32_t depth, uint32_t inflight, uint32_t rounds)
+{
+    WifiMacQueueContainer container;
+    const auto txAddr = Mac48Address::Allocate();
+    std::vector<WifiContainerQueueId> queueIds;
+    // iterator to the last inflight MPDU of each container queue
+    std::vector<WifiMacQueueContainer::iterator> lastInflight;
+    uint16_t seqNo = 0;
+    Callback<void, Ptr<WifiMpdu>> deleter = [](Ptr<WifiMpdu>) {};
+
+    auto enqueue = [&](Ptr<WifiMpdu> mpdu) {
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        auto it = container.insert(container.GetQueue(queueId).cend(), mpdu);
+        container.SetExpiryTime(it, Seconds(1));
+        it->deleter = deleter;
+        return it;
+    };
+
+    for (uint32_t s = 0; s < stations; s++)
+    {
+        WifiMacHeader header(WIFI_MAC_QOSDATA);
+        header.SetAddr1(Mac48Address::Allocate());
+        header.SetAddr2(txAddr);
+        header.SetQosTid(0);
+        for (uint32_t i = 0; i < depth; i++)
+        {
+            header.SetSequenceNumber(seqNo++);
+            auto it = enqueue(Create<WifiMpdu>(Create<Packet>(1000), header));
+            if (i < inflight)
+            {
+                it->inflights.emplace(0, it->mpdu);
+                if (i == 0)
+                {
+                    queueIds.push_back(WifiMacQueueContainer::GetQueueId(it->mpdu));
+                    lastInflight.push_back(it);
+                }
+                lastInflight.back() = it;
+            }
+        }
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t allocations = g_allocations;
+    uint64_t bytes = 0;
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (uint32_t s = 0; s < stations; s++)
+        {
+            const auto& queueId = queueIds[s];
+            auto [first, last] = container.ExtractExpiredMpdus(queueId);
+            NS_ABORT_IF(first != last);
+            bytes += container.GetNBytes(queueId);
+            // the first MPDU is acknowledged and the next one becomes inflight; the
+            // acknowledged MPDU is enqueued again to avoid measuring its creation
+            auto mpdu = container.GetQueue(queueId).front().mpdu;
+            container.erase(container.GetQueue(queueId).cbegin());
+            ++lastInflight[s];
+            lastInflight[s]->inflights.emplace(0, lastInflight[s]->mpdu);
+            enqueue(mpdu);
+        }
+    }
+    allocations = g_allocations - allocations;
+    int64_t runMs = timer.End();
+
+    std::cout << stations << " container queues: " << rounds << " rounds in " << runMs
+              << " ms, " << allocations << " allocations (" << bytes / rounds / stations
+              << " bytes per queue)" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 64;
+    uint32_t size = 1000;
+    Time interval = MicroSeconds(500);
+    Time duration = Seconds(2);
+    std::string mode = "HeMcs9";
+    uint32_t depth = 256;
+    uint32_t inflight = 64;
+    uint32_t rounds = 20000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the WifiMacQueue of a saturated 802.11ax access point");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("interval", "interval between two packets sent to a station", interval);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.AddValue("mode", "data mode", mode);
+    cmd.AddValue("depth", "number of MPDUs per container queue (replay)", depth);
+    cmd.AddValue("inflight", "number of inflight MPDUs per container queue (replay)", inflight);
+    cmd.AddValue("rounds", "number of rounds (replay)", rounds);
+    cmd.Parse(argc, argv);
+
+    BenchMacQueue(stations, size, interval, duration, mode);
+    BenchContainer(stations, depth, inflight, rounds);
+
+    return 0;
+}
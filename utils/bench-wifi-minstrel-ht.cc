@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the cost of the statistics update of
+// Minstrel-HT in a dense BSS: an access point sends 'size' bytes packets to
+// each of its 'stations' stations every 'interval', during 'duration' seconds.
+// The stations are placed on a grid around the access point, so that they do
+// not all use the same rates, and both the access point and the stations use
+// Minstrel-HT, whose statistics are updated every 'update'. The wall clock
+// time, the number of bytes received and the number of rate changes are
+// reported. Then, the access point selects the rate of an A-MPDU for each of
+// its stations every millisecond, for 'rounds' rounds, and the outcome of the
+// transmission (given by a fixed per-station MCS threshold) is reported to its
+// Minstrel-HT manager directly. The wall clock time of these rounds and a
+// checksum of the selected rates (which allows to check that two versions of
+// Minstrel-HT select the same rates) are reported.
+// Sample usage:  ./ns3 run 'bench-wifi-minstrel-ht --stations=300'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/position-allocator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param distance the distance between two adjacent stations of the grid (m)
+ * @param size the size of the packets (bytes)
+ * @param interval the interval between two packets sent to a station
+ * @param duration the duration of the traffic
+ * @param update the interval between two updates of the Minstrel-HT statistics
+ * @param rounds the number of rounds of rate selections by the access point
+ */
+static void
+BenchMinstrelHt(uint32_t stations,
+                double distance,
+                uint32_t size,
+                Time interval,
+                Time duration,
+                Time update,
+                uint32_t rounds)
+{
+    RngSeedManager::SetSeed(40);
+    RngSeedManager::SetRun(40);
+
+    NodeContainer ap(1);
+    NodeContainer stas(stations);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager",
+                                 "UpdateStatistics",
+                                 TimeValue(update));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    WifiMacHelper mac;
+    Ssid ssid("bench-wifi-minstrel-ht");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, ap);
+    mac.SetType("ns3::StaWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "MaxMissedBeacons",
+                UintegerValue(std::numeric_limits<uint32_t>::max()));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, stas);
+    WifiHelper::AssignStreams(apDevice, 10);
+    WifiHelper::AssignStreams(staDevices, 100);
+
+    MobilityHelper mobility;
+    auto positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(stations)));
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        positions->Add(Vector((i % side + 1) * distance, (i / side + 1) * distance, 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(ap);
+    mobility.Install(stas);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(ap);
+    packetSocket.Install(stas);
+    uint64_t rxBytes = 0;
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(staDevices.Get(i)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(size));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(interval));
+        client->SetStartTime(Seconds(1) + MicroSeconds(10 * i));
+        client->SetStopTime(Seconds(1) + duration);
+        ap.Get(0)->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext(
+            "Rx",
+            Callback<void, Ptr<const Packet>, const Address&>(
+                [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                    rxBytes += packet->GetSize();
+                }));
+        stas.Get(i)->AddApplication(server);
+    }
+
+    uint64_t rateChanges = 0;
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/"
+        "$ns3::MinstrelHtWifiManager/Rate",
+        Callback<void, uint64_t, uint64_t>([&](uint64_t, uint64_t) { ++rateChanges; }));
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    int64_t runMs = timer.End();
+
+    std::cout << stations << " stations: " << runMs << " ms, " << rxBytes << " bytes received, "
+              << rateChanges << " rate changes" << std::endl;
+
+    // the access point selects the rate of an A-MPDU of 32 MPDUs for each station every
+    // millisecond; all the MPDUs sent to a station with an MCS above its threshold are lost
+    auto manager = DynamicCast<WifiNetDevice>(apDevice.Get(0))->GetRemoteStationManager();
+    WifiMacHeader header(WIFI_MAC_QOSDATA);
+    header.SetAddr2(Mac48Address::ConvertFrom(apDevice.Get(0)->GetAddress()));
+    header.SetQosTid(0);
+    uint64_t checksum = 0;
+    // the other events (e.g., beacons) are not accounted in the duration of the rounds
+    std::chrono::steady_clock::duration roundsDuration{0};
+    // leave time for the MPDUs queued by the access point to be transmitted or to expire
+    const auto start = Seconds(1);
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        Simulator::Schedule(start + MilliSeconds(r), [&]() {
+            const auto roundStart = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < stations; i++)
+            {
+                const auto address = Mac48Address::ConvertFrom(staDevices.Get(i)->GetAddress());
+                header.SetAddr1(address);
+                const auto txVector = manager->GetDataTxVector(header, MHz_u{80});
+                const auto mcs = txVector.GetMode().GetMcsValue();
+                checksum = checksum * 31 + mcs + 16 * txVector.GetNss();
+                const auto nSuccess = (mcs <= i % 12) ? 32 : 0;
+                manager->ReportAmpduTxStatus(address, nSuccess, 32 - nSuccess, 20, 20, txVector);
+            }
+            roundsDuration += std::chrono::steady_clock::now() - roundStart;
+        });
+    }
+    Simulator::Stop(start + MilliSeconds(rounds));
+    Simulator::Run();
+
+    std::cout << stations << " stations: " << rounds << " rounds of rate selection in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(roundsDuration).count()
+              << " ms (checksum " << checksum << ")" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 200;
+    double distance = 4;
+    uint32_t size = 1000;
+    Time interval = MilliSeconds(2);
+    Time duration = Seconds(2);
+    Time update = MilliSeconds(50);
+    uint32_t rounds = 2000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the statistics update of Minstrel-HT in a dense BSS");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("distance", "distance between two adjacent stations of the grid (m)", distance);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("interval", "interval between two packets sent to a station", interval);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.AddValue("update", "interval between two updates of the Minstrel-HT statistics", update);
+    cmd.AddValue("rounds", "number of rounds of rate selections by the access point", rounds);
+    cmd.Parse(argc, argv);
+
+    BenchMinstrelHt(stations, distance, size, interval, duration, update, rounds);
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the benefit of the templates of the
+// transmit PSDs of WifiSpectrumValueHelper: 'bss' BSSs, each made of an access
+// point and 'stations' stations, share a MultiModelSpectrumChannel. The BSSs
+// are placed 'distance' meters apart on a line and operate on the channel
+// given by 'channels' (a list of channel numbers, used in turn by the BSSs).
+// Every station sends 'size' bytes packets to its access point as fast as
+// possible during 'duration' seconds. The scenario is run with the templates
+// disabled and then enabled, and the wall clock time, the number of heap
+// allocations, the number of bytes received and the number of PSDs obtained
+// from a template are reported. Then, 'psds' HE PSDs of each channel width
+// from 20 MHz to 160 MHz are built directly, without and with the templates.
+// Sample usage:  ./ns3 run 'bench-wifi-psd --bss=6 --channels=36,40,44'
+
+#include "ns3/command-line.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/position-allocator.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0; //!< number of heap allocations
+
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Run the scenario
+ * @param bss the number of BSSs
+ * @param stations the number of stations per BSS
+ * @param channels the channel numbers of the BSSs
+ * @param distance the distance between two consecutive BSSs (m)
+ * @param size the size of the packets (bytes)
+ * @param duration the duration of the traffic
+ * @param templates whether the templates of the transmit PSDs are used
+ */
+static void
+BenchPsd(uint32_t bss,
+         uint32_t stations,
+         const std::vector<uint16_t>& channels,
+         double distance,
+         uint32_t size,
+         Time duration,
+         bool templates)
+{
+    RngSeedManager::SetSeed(20);
+    RngSeedManager::SetRun(20);
+    WifiSpectrumValueHelper::EnablePsdTemplates(templates);
+    WifiSpectrumValueHelper::ResetPsdTemplates();
+
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs7"),
+                                 "ControlMode",
+                                 StringValue("HeMcs0"));
+    SpectrumWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+
+    NodeContainer nodes;
+    NetDeviceContainer apDevices;
+    NetDeviceContainer staDevices;
+    auto positions = CreateObject<ListPositionAllocator>();
+    for (uint32_t b = 0; b < bss; b++)
+    {
+        std::ostringstream settings;
+        settings << "{" << channels.at(b % channels.size()) << ", 0, BAND_5GHZ, 0}";
+        phy.Set("ChannelSettings", StringValue(settings.str()));
+        Ssid ssid("bench-wifi-psd-" + std::to_string(b));
+        NodeContainer ap(1);
+        NodeContainer stas(stations);
+        mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+        apDevices.Add(wifi.Install(phy, mac, ap));
+        mac.SetType("ns3::StaWifiMac",
+                    "Ssid",
+                    SsidValue(ssid),
+                    "MaxMissedBeacons",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()));
+        staDevices.Add(wifi.Install(phy, mac, stas));
+        nodes.Add(ap);
+        nodes.Add(stas);
+        positions->Add(Vector(b * distance, 0, 0));
+        for (uint32_t i = 0; i < stations; i++)
+        {
+            positions->Add(Vector(b * distance + 1 + i % 5, 1 + i / 5, 0));
+        }
+    }
+    WifiHelper::AssignStreams(apDevices, 10);
+    WifiHelper::AssignStreams(staDevices, 100);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+    uint64_t rxBytes = 0;
+    for (uint32_t i = 0; i < staDevices.GetN(); i++)
+    {
+        auto apDevice = apDevices.Get(i / stations);
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(staDevices.Get(i)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(apDevice->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(size));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+        client->SetStartTime(Seconds(1) + MilliSeconds(i));
+        client->SetStopTime(Seconds(1) + duration);
+        staDevices.Get(i)->GetNode()->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext(
+            "Rx",
+            Callback<void, Ptr<const Packet>, const Address&>(
+                [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                    rxBytes += packet->GetSize();
+                }));
+        apDevice->GetNode()->AddApplication(server);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t allocations = g_allocations;
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    allocations = g_allocations - allocations;
+    int64_t runMs = timer.End();
+
+    const auto stats = WifiSpectrumValueHelper::GetPsdTemplateStats();
+    std::cout << (templates ? "PSD templates" : "no PSD templates") << ": " << runMs << " ms, "
+              << allocations << " allocations, " << rxBytes << " bytes received";
+    if (templates)
+    {
+        std::cout << ", " << stats.hits << " PSDs from " << stats.size << " templates, "
+                  << stats.misses << " PSDs built";
+    }
+    std::cout << std::endl;
+    Simulator::Destroy();
+}
+
+/**
+ * Build HE transmit PSDs directly
+ * @param psds the number of PSDs built per channel width
+ * @param templates whether the templates of the transmit PSDs are used
+ */
+static void
+BenchBuildPsds(uint32_t psds, bool templates)
+{
+    WifiSpectrumValueHelper::EnablePsdTemplates(templates);
+    WifiSpectrumValueHelper::ResetPsdTemplates();
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t allocations = g_allocations;
+    std::size_t bands = 0;
+    for (const auto& [width, frequency] : {std::make_pair(MHz_u{20}, MHz_u{5180}),
+                                          std::make_pair(MHz_u{40}, MHz_u{5190}),
+                                          std::make_pair(MHz_u{80}, MHz_u{5210}),
+                                          std::make_pair(MHz_u{160}, MHz_u{5250})})
+    {
+        for (uint32_t i = 0; i < psds; i++)
+        {
+            auto psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(frequency,
+                                                                                   width,
+                                                                                   0.1,
+                                                                                   width);
+            bands += psd->GetValuesN();
+        }
+    }
+    allocations = g_allocations - allocations;
+    int64_t runMs = timer.End();
+    std::cout << (templates ? "PSD templates" : "no PSD templates") << ": " << 4 * psds
+              << " HE PSDs (" << bands << " bands) built in " << runMs << " ms, " << allocations
+              << " allocations" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t bss = 4;
+    uint32_t stations = 4;
+    std::string channelList = "36,40";
+    double distance = 20;
+    uint32_t size = 1500;
+    Time duration = Seconds(2);
+    uint32_t psds = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the templates of the transmit PSDs on overlapping BSSs");
+    cmd.AddValue("bss", "number of BSSs", bss);
+    cmd.AddValue("stations", "number of stations per BSS", stations);
+    cmd.AddValue("channels", "comma-separated channel numbers of the BSSs", channelList);
+    cmd.AddValue("distance", "distance between two consecutive BSSs (m)", distance);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.AddValue("psds", "number of HE PSDs built directly per channel width", psds);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint16_t> channels;
+    std::istringstream iss(channelList);
+    std::string channelNumber;
+    while (std::getline(iss, channelNumber, ','))
+    {
+        channels.push_back(static_cast<uint16_t>(std::stoi(channelNumber)));
+    }
+
+    BenchPsd(bss, stations, channels, distance, size, duration, false);
+    BenchPsd(bss, stations, channels, distance, size, duration, true);
+    BenchBuildPsds(psds, false);
+    BenchBuildPsds(psds, true);
+
+    return 0;
+}
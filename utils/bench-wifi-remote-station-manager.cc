@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the memory footprint and the lookup
+// cost of the WifiRemoteStationManager of an access point with many associated
+// stations. The information recorded by the access point upon the association
+// of 'stations' 802.11ax stations (supported modes, capabilities and state) is
+// passed to the remote station manager ('manager') of the access point, then
+// the number of heap allocations and the number of heap bytes in use that are
+// due to these stations are reported. Then, for 'rounds' rounds, the access
+// point selects the TXVECTOR of a Data frame addressed to each station, checks
+// the capabilities of the station and reports the successful transmission of
+// an A-MPDU; the wall clock time of these rounds is reported.
+// Sample usage:  ./ns3 run 'bench-wifi-remote-station-manager --stations=1000'
+
+#include "ns3/command-line.h"
+#include "ns3/node-container.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0; //!< number of heap allocations
+static int64_t g_bytesInUse = 0;   //!< number of heap bytes in use
+
+/// size of the header storing the size of an allocated block (keeps the blocks aligned)
+static constexpr std::size_t ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    g_bytesInUse += size;
+    if (auto p = static_cast<char*>(std::malloc(size + ALLOC_HEADER_SIZE)))
+    {
+        *reinterpret_cast<std::size_t*>(p) = size;
+        return p + ALLOC_HEADER_SIZE;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    if (p)
+    {
+        auto block = static_cast<char*>(p) - ALLOC_HEADER_SIZE;
+        g_bytesInUse -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param manager the type of the remote station manager
+ * @param rounds the number of rounds of TXVECTOR selections by the access point
+ */
+static void
+BenchRemoteStationManager(uint32_t stations, const std::string& manager, uint32_t rounds)
+{
+    RngSeedManager::SetSeed(60);
+    RngSeedManager::SetRun(60);
+
+    NodeContainer ap(1);
+    NodeContainer sta(1);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager(manager);
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+    WifiMacHelper mac;
+    Ssid ssid("bench-wifi-remote-station-manager");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, ap);
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevice = wifi.Install(phy, mac, sta);
+
+    auto apDev = DynamicCast<WifiNetDevice>(apDevice.Get(0));
+    auto apManager = apDev->GetRemoteStationManager();
+    auto apPhy = apDev->GetPhy();
+    // the capabilities advertised by all the stations
+    auto staMac = DynamicCast<WifiNetDevice>(staDevice.Get(0))->GetMac();
+    const auto htCapabilities = staMac->GetHtCapabilities(0);
+    const auto extendedCapabilities = staMac->GetExtendedCapabilities();
+    const auto vhtCapabilities = staMac->GetVhtCapabilities(0);
+    const auto heCapabilities = staMac->GetHeCapabilities(0);
+
+    std::vector<Mac48Address> addresses;
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        addresses.push_back(Mac48Address::Allocate());
+    }
+
+    // record the information carried by the Association Request of every station, as done by
+    // the AP MAC, and select a TXVECTOR for every station, so that the stations used by the
+    // rate control algorithm are created
+    WifiMacHeader header(WIFI_MAC_QOSDATA);
+    header.SetAddr2(apDev->GetMac()->GetAddress());
+    header.SetQosTid(0);
+    uint64_t allocations = g_allocations;
+    int64_t bytesInUse = g_bytesInUse;
+    for (uint32_t i = 0; i < stations; i++)
+    {
+        const auto& address = addresses[i];
+        apManager->RecordWaitAssocTxOk(address);
+        for (const auto& mode : apPhy->GetModeList())
+        {
+            apManager->AddSupportedMode(address, mode);
+        }
+        apManager->AddStationHtCapabilities(address, htCapabilities);
+        apManager->AddStationExtendedCapabilities(address, extendedCapabilities);
+        apManager->AddStationVhtCapabilities(address, vhtCapabilities);
+        for (const auto& mcs : apPhy->GetMcsList(WIFI_MOD_CLASS_VHT))
+        {
+            if (vhtCapabilities.IsSupportedTxMcs(mcs.GetMcsValue()))
+            {
+                apManager->AddSupportedMcs(address, mcs);
+            }
+        }
+        apManager->AddStationHeCapabilities(address, heCapabilities);
+        for (const auto& mcs : apPhy->GetMcsList(WIFI_MOD_CLASS_HE))
+        {
+            if (heCapabilities.IsSupportedTxMcs(mcs.GetMcsValue()))
+            {
+                apManager->AddSupportedMcs(address, mcs);
+            }
+        }
+        apManager->SetAssociationId(address, static_cast<uint16_t>(i % 2007 + 1));
+        apManager->RecordGotAssocTxOk(address);
+        header.SetAddr1(address);
+        apManager->GetDataTxVector(header, apPhy->GetChannelWidth());
+    }
+    allocations = g_allocations - allocations;
+    bytesInUse = g_bytesInUse - bytesInUse;
+
+    std::cout << stations << " stations: " << allocations << " allocations, " << bytesInUse
+              << " bytes in use (" << bytesInUse / stations << " bytes per station)" << std::endl;
+
+    SystemWallClockMs timer;
+    timer.Start();
+    uint64_t checksum = 0;
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (const auto& address : addresses)
+        {
+            header.SetAddr1(address);
+            const auto txVector = apManager->GetDataTxVector(header, apPhy->GetChannelWidth());
+            if (apManager->IsAssociated(address) && apManager->GetHeSupported(address))
+            {
+                checksum += txVector.GetMode().GetMcsValue() + txVector.GetNss();
+            }
+            apManager->ReportAmpduTxStatus(address, 1, 0, 20, 20, txVector);
+        }
+    }
+    int64_t runMs = timer.End();
+
+    std::cout << stations << " stations: " << rounds << " rounds of TXVECTOR selection in "
+              << runMs << " ms (checksum " << checksum << ")" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 2000;
+    std::string manager = "ns3::MinstrelHtWifiManager";
+    uint32_t rounds = 200;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the remote station manager of an AP with many associated stations");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("manager", "type of the remote station manager", manager);
+    cmd.AddValue("rounds", "number of rounds of TXVECTOR selections", rounds);
+    cmd.Parse(argc, argv);
+
+    BenchRemoteStationManager(stations, manager, rounds);
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to compare the accuracy and the speed of the levels
+// of abstraction of the payload reception of WifiPhy (RxAbstraction attribute):
+// 'bss' co-channel HE BSSs, each made of an access point and 'stations'
+// stations, share a YansWifiChannel. The BSSs are placed 'distance' meters
+// apart on a line. Every station sends 'size' bytes packets to its access
+// point as fast as possible during 'duration' seconds, so that A-MPDUs are
+// transmitted and collide with the transmissions of the other BSSs. The
+// scenario is run with the Full and then the Ppdu abstraction, and the wall
+// clock time, the number of simulator events and the throughput are reported.
+// Sample usage:  ./ns3 run 'bench-wifi-rx-abstraction --bss=8 --stations=10'
+
+#include "ns3/command-line.h"
+#include "ns3/enum.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/position-allocator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Run the scenario
+ * @param bss the number of BSSs
+ * @param stations the number of stations per BSS
+ * @param distance the distance between two consecutive BSSs (m)
+ * @param size the size of the packets (bytes)
+ * @param duration the duration of the traffic
+ * @param mode the data mode
+ * @param rxAbstraction the level of abstraction of the payload reception
+ */
+static void
+BenchRxAbstraction(uint32_t bss,
+                   uint32_t stations,
+                   double distance,
+                   uint32_t size,
+                   Time duration,
+                   const std::string& mode,
+                   WifiPhy::RxAbstraction rxAbstraction)
+{
+    RngSeedManager::SetSeed(30);
+    RngSeedManager::SetRun(30);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(mode),
+                                 "ControlMode",
+                                 StringValue("HeMcs0"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{36, 0, BAND_5GHZ, 0}"));
+    phy.Set("RxAbstraction", EnumValue(rxAbstraction));
+    WifiMacHelper mac;
+
+    NodeContainer nodes;
+    NetDeviceContainer apDevices;
+    NetDeviceContainer staDevices;
+    auto positions = CreateObject<ListPositionAllocator>();
+    for (uint32_t b = 0; b < bss; b++)
+    {
+        Ssid ssid("bench-wifi-rx-abstraction-" + std::to_string(b));
+        NodeContainer ap(1);
+        NodeContainer stas(stations);
+        mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+        apDevices.Add(wifi.Install(phy, mac, ap));
+        mac.SetType("ns3::StaWifiMac",
+                    "Ssid",
+                    SsidValue(ssid),
+                    "MaxMissedBeacons",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()));
+        staDevices.Add(wifi.Install(phy, mac, stas));
+        nodes.Add(ap);
+        nodes.Add(stas);
+        positions->Add(Vector(b * distance, 0, 0));
+        for (uint32_t i = 0; i < stations; i++)
+        {
+            positions->Add(Vector(b * distance + 1 + i % 5, 1 + i / 5, 0));
+        }
+    }
+    WifiHelper::AssignStreams(apDevices, 10);
+    WifiHelper::AssignStreams(staDevices, 100);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+    uint64_t rxBytes = 0;
+    for (uint32_t i = 0; i < staDevices.GetN(); i++)
+    {
+        auto apDevice = apDevices.Get(i / stations);
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(staDevices.Get(i)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(apDevice->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(size));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+        client->SetStartTime(Seconds(1) + MilliSeconds(i));
+        client->SetStopTime(Seconds(1) + duration);
+        staDevices.Get(i)->GetNode()->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext(
+            "Rx",
+            Callback<void, Ptr<const Packet>, const Address&>(
+                [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                    rxBytes += packet->GetSize();
+                }));
+        apDevice->GetNode()->AddApplication(server);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    const auto events = Simulator::GetEventCount();
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    int64_t runMs = timer.End();
+
+    std::cout << (rxAbstraction == WifiPhy::RX_ABSTRACTION_FULL ? "Full" : "Ppdu") << ": "
+              << runMs << " ms, " << Simulator::GetEventCount() - events << " events, "
+              << rxBytes * 8 / duration.GetSeconds() / 1e6 << " Mbps" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t bss = 4;
+    uint32_t stations = 5;
+    double distance = 30;
+    uint32_t size = 300;
+    Time duration = Seconds(2);
+    std::string mode = "HeMcs5";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Compare the levels of abstraction of the payload reception on co-channel BSSs");
+    cmd.AddValue("bss", "number of BSSs", bss);
+    cmd.AddValue("stations", "number of stations per BSS", stations);
+    cmd.AddValue("distance", "distance between two consecutive BSSs (m)", distance);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.AddValue("mode", "data mode", mode);
+    cmd.Parse(argc, argv);
+
+    BenchRxAbstraction(bss, stations, distance, size, duration, mode, WifiPhy::RX_ABSTRACTION_FULL);
+    BenchRxAbstraction(bss, stations, distance, size, duration, mode, WifiPhy::RX_ABSTRACTION_PPDU);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to measure the benefit of the cache of the PPDU
+// durations of WifiPhy. It replays the saturated infrastructure scenario of
+// the wifi-bianchi example: 'stations' stations send 'size' bytes packets to
+// an access point as fast as possible during 'duration' seconds. The scenario
+// is run with the cache disabled and then enabled, and the wall clock time,
+// the number of bytes received and the hit rate of the cache are reported.
+// Sample usage:  ./ns3 run 'bench-wifi-tx-duration --stations=20'
+
+#include "ns3/command-line.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Run the scenario
+ * @param stations the number of stations
+ * @param size the size of the packets (bytes)
+ * @param duration the duration of the traffic
+ * @param standard the Wi-Fi standard
+ * @param mode the data mode
+ * @param cacheCapacity the capacity of the cache of the PPDU durations
+ */
+static void
+BenchTxDuration(uint32_t stations,
+                uint32_t size,
+                Time duration,
+                const std::string& standard,
+                const std::string& mode,
+                std::size_t cacheCapacity)
+{
+    RngSeedManager::SetSeed(10);
+    RngSeedManager::SetRun(10);
+    WifiPhy::SetTxDurationCacheCapacity(cacheCapacity);
+    WifiPhy::ResetTxDurationCache();
+
+    NodeContainer nodes(stations + 1);
+    WifiHelper wifi;
+    wifi.SetStandard(standard);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(mode),
+                                 "ControlMode",
+                                 StringValue(mode));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    Ssid ssid("bench-wifi-tx-duration");
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes.Get(0));
+    mac.SetType("ns3::StaWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "MaxMissedBeacons",
+                UintegerValue(std::numeric_limits<uint32_t>::max()));
+    for (uint32_t i = 1; i <= stations; i++)
+    {
+        devices.Add(wifi.Install(phy, mac, nodes.Get(i)));
+    }
+    WifiHelper::AssignStreams(devices, 10);
+
+    MobilityHelper mobility;
+    mobility.Install(nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+    uint64_t rxBytes = 0;
+    for (uint32_t i = 1; i <= stations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(devices.Get(i)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(devices.Get(0)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(size));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+        client->SetStartTime(Seconds(1) + MilliSeconds(i));
+        client->SetStopTime(Seconds(1) + duration);
+        nodes.Get(i)->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext(
+            "Rx",
+            Callback<void, Ptr<const Packet>, const Address&>(
+                [&rxBytes](Ptr<const Packet> packet, const Address&) {
+                    rxBytes += packet->GetSize();
+                }));
+        nodes.Get(0)->AddApplication(server);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(Seconds(1) + duration);
+    Simulator::Run();
+    int64_t runMs = timer.End();
+
+    const auto stats = WifiPhy::GetTxDurationCacheStats();
+    std::cout << (cacheCapacity > 0 ? "cache" : "no cache") << ": " << runMs << " ms, "
+              << rxBytes << " bytes received";
+    if (cacheCapacity > 0)
+    {
+        std::cout << ", " << stats.hits << " hits, " << stats.misses << " misses ("
+                  << 100.0 * stats.hits / std::max<uint64_t>(stats.hits + stats.misses, 1)
+                  << "% hit rate)";
+    }
+    std::cout << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t stations = 10;
+    uint32_t size = 1500;
+    Time duration = Seconds(5);
+    std::string standard = "11ax";
+    std::string mode = "HeMcs7";
+    uint32_t cacheCapacity = 4096;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the cache of the PPDU durations on a saturated BSS");
+    cmd.AddValue("stations", "number of stations", stations);
+    cmd.AddValue("size", "size of the packets (bytes)", size);
+    cmd.AddValue("duration", "duration of the traffic", duration);
+    cmd.AddValue("standard", "Wi-Fi standard", standard);
+    cmd.AddValue("mode", "data and control mode", mode);
+    cmd.AddValue("cacheCapacity", "capacity of the cache of the PPDU durations", cacheCapacity);
+    cmd.Parse(argc, argv);
+
+    BenchTxDuration(stations, size, duration, standard, mode, 0);
+    BenchTxDuration(stations, size, duration, standard, mode, cacheCapacity);
+
+    return 0;
+}